@@ -92,6 +92,11 @@ SOFTWARE.
 // this option need c++17
 #ifndef USE_STD_FILESYSTEM
 #include <dirent.h>
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif  // __linux__
 #endif  // USE_STD_FILESYSTEM
 #define PATH_SEP '/'
 #endif  // _IGFD_UNIX_
@@ -312,6 +317,18 @@ SOFTWARE.
 #ifndef DisplayMode_ThumbailsList_ImageHeight
 #define DisplayMode_ThumbailsList_ImageHeight 32.0f
 #endif  // DisplayMode_ThumbailsList_ImageHeight
+#ifndef THUMBNAILS_THREADS_COUNT
+// 0 => count of hardware threads - 1, between 1 and 4
+#define THUMBNAILS_THREADS_COUNT 0
+#endif  // THUMBNAILS_THREADS_COUNT
+#ifndef THUMBNAILS_CACHE_DIR_NAME
+// sub directory of ImGuiHelper::getCacheDir() for the thumbnails disk cache
+#define THUMBNAILS_CACHE_DIR_NAME "ImGuiFileDialog"
+#endif  // THUMBNAILS_CACHE_DIR_NAME
+#ifndef THUMBNAILS_CACHE_MAX_SIZE
+// max size in bytes of the thumbnails disk cache, the oldest entries are removed above it, 0 for no limit
+#define THUMBNAILS_CACHE_MAX_SIZE (64U * 1024U * 1024U)
+#endif  // THUMBNAILS_CACHE_MAX_SIZE
 #ifndef IMGUI_RADIO_BUTTON
 inline bool inRadioButton(const char* vLabel, bool vToggled) {
     bool pressed = false;
@@ -745,6 +762,66 @@ public:
         }
         return res;
     }
+#if defined(__linux__) && defined(SYS_getdents64)
+    // the entries are read by big chunks with getdents64 (readdir do it by 32k chunks)
+    // and the types are resolved with fstatat, relative to the opened dir, only when getdents64 can't give it
+    bool ScanDirectoryEntries(const std::string& vPath, const std::function<bool(const std::string&, const IGFD::FileType&)>& vEntryFunc) override {
+        struct LinuxDirent64 {  // not exposed by the libc
+            ino64_t d_ino;
+            off64_t d_off;
+            unsigned short d_reclen;
+            unsigned char d_type;
+            char d_name[1];
+        };
+        const int dirFd = open(vPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dirFd < 0) {
+            return true;  // like ScanDirectory, a dir who can't be opened is empty
+        }
+        bool res = true;
+        std::vector<char> buffer(256U * 1024U);
+        while (res) {
+            const long countBytes = syscall(SYS_getdents64, dirFd, buffer.data(), buffer.size());
+            if (countBytes <= 0) {
+                break;
+            }
+            for (long pos = 0; pos < countBytes && res;) {
+                const auto* ent = reinterpret_cast<const LinuxDirent64*>(buffer.data() + pos);
+                pos += ent->d_reclen;
+                unsigned char type = ent->d_type;
+                struct stat sb = {};
+                if (type == DT_UNKNOWN) {  // some file systems (like xfs or nfs) don't give the type
+                    if (!fstatat(dirFd, ent->d_name, &sb, AT_SYMLINK_NOFOLLOW)) {
+                        type = S_ISLNK(sb.st_mode) ? DT_LNK : S_ISDIR(sb.st_mode) ? DT_DIR : S_ISREG(sb.st_mode) ? DT_REG : DT_UNKNOWN;
+                    }
+                }
+                IGFD::FileType fileType;
+                switch (type) {
+                    case DT_DIR: fileType.SetContent(IGFD::FileType::ContentType::Directory); break;
+                    case DT_REG: fileType.SetContent(IGFD::FileType::ContentType::File); break;
+                    case DT_LNK: {
+                        fileType.SetSymLink(true);
+                        // by default if we can't figure out the target type.
+                        fileType.SetContent(IGFD::FileType::ContentType::LinkToUnknown);
+                        if (!fstatat(dirFd, ent->d_name, &sb, 0)) {  // follow the link
+                            if (S_ISREG(sb.st_mode)) {
+                                fileType.SetContent(IGFD::FileType::ContentType::File);
+                            } else if (S_ISDIR(sb.st_mode)) {
+                                fileType.SetContent(IGFD::FileType::ContentType::Directory);
+                            }
+                        }
+                        break;
+                    }
+                    default: break;  // leave it invalid (devices, etc.)
+                }
+                if (fileType.isValid()) {
+                    res = vEntryFunc(ent->d_name, fileType);
+                }
+            }
+        }
+        close(dirFd);
+        return res;
+    }
+#endif  // __linux__ && SYS_getdents64
     bool IsDirectory(const std::string& vFilePathName) override {
         return (opendir(vFilePathName.c_str()) != nullptr);
     }
@@ -1671,6 +1748,12 @@ IGFD::FileManager::FileManager() {
     //m_FileSystemPtr = std::make_unique<FILE_SYSTEM_OVERRIDE>();
 }
 
+IGFD::FileManager::~FileManager() {
+    // the scan threads use m_FileSystemPtr, so they must be finished before it is destroyed
+    m_StopScanDir();
+    m_JoinFinishedScanDirThreads(true);
+}
+
 void IGFD::FileManager::OpenCurrentPath(const FileDialogInternal& vFileDialogInternal) {
     showDrives = false;
     ClearComposer();
@@ -1684,12 +1767,13 @@ void IGFD::FileManager::OpenCurrentPath(const FileDialogInternal& vFileDialogInt
 }
 
 void IGFD::FileManager::SortFields(const FileDialogInternal& vFileDialogInternal) {
-    m_SortFields(vFileDialogInternal, m_FileList, m_FilteredFileList);
+    m_SortFields(vFileDialogInternal, m_FileList, m_FileArena, m_FilteredFileList);
 }
 
 void IGFD::FileManager::m_SortFields(const FileDialogInternal& vFileDialogInternal,
-    std::vector<std::shared_ptr<FileInfos>>& vFileInfosList,
-    std::vector<std::shared_ptr<FileInfos>>& vFileInfosFilteredList) {
+    const std::vector<std::shared_ptr<FileInfos>>& vFileInfosList,
+    FileListArena& vFileListArena,
+    FilteredFileList& vFileInfosFilteredList) {
     if (sortingField != SortingFieldEnum::FIELD_NONE) {
         headerFileName = tableHeaderFileNameString;
         headerFileType = tableHeaderFileTypeString;
@@ -1699,193 +1783,282 @@ void IGFD::FileManager::m_SortFields(const FileDialogInternal& vFileDialogIntern
         headerFileThumbnails = tableHeaderFileThumbnailsString;
 #endif  // #ifdef USE_THUMBNAILS
     }
-    if (sortingField == SortingFieldEnum::FIELD_FILENAME) {
-        if (sortingDirection[0]) {
 #ifdef USE_CUSTOM_SORTING_ICON
-            headerFileName = tableHeaderAscendingIcon + headerFileName;
-#endif  // USE_CUSTOM_SORTING_ICON
-            std::sort(
-                vFileInfosList.begin(), vFileInfosList.end(), [](const std::shared_ptr<FileInfos>& a, const std::shared_ptr<FileInfos>& b) -> bool {
-                    if (!a.use_count() || !b.use_count())
-                        return false;
-                    // tofix : this code fail in c:\\Users with the link "All users". got a invalid comparator
-                    /*
-                    // use code from
-                    https://github.com/jackm97/ImGuiFileDialog/commit/bf40515f5a1de3043e60562dc1a494ee7ecd3571
-                    // strict ordering for file/directory types beginning in '.'
-                    // common on _IGFD_WIN_ platforms
-                    if (a->fileNameExt[0] == '.' && b->fileNameExt[0] != '.')
-                        return false;
-                    if (a->fileNameExt[0] != '.' && b->fileNameExt[0] == '.')
-                        return true;
-                    if (a->fileNameExt[0] == '.' && b->fileNameExt[0] == '.')
-                    {
-                        return (stricmp(a->fileNameExt.c_str(), b->fileNameExt.c_str()) < 0); // sort in insensitive
-                    case
-                    }
-                    */
-                    if (a->fileType != b->fileType)
-                        return (a->fileType < b->fileType);                                // directories first
-                    return (stricmp(a->fileNameExt.c_str(), b->fileNameExt.c_str()) < 0);  // sort in insensitive case
-                });
-        } else {
-#ifdef USE_CUSTOM_SORTING_ICON
-            headerFileName = tableHeaderDescendingIcon + headerFileName;
-#endif  // USE_CUSTOM_SORTING_ICON
-            std::sort(
-                vFileInfosList.begin(), vFileInfosList.end(), [](const std::shared_ptr<FileInfos>& a, const std::shared_ptr<FileInfos>& b) -> bool {
-                    if (!a.use_count() || !b.use_count())
-                        return false;
-                    // tofix : this code fail in c:\\Users with the link "All users". got a invalid comparator
-                    /*
-                    // use code from
-                    https://github.com/jackm97/ImGuiFileDialog/commit/bf40515f5a1de3043e60562dc1a494ee7ecd3571
-                    // strict ordering for file/directory types beginning in '.'
-                    // common on _IGFD_WIN_ platforms
-                    if (a->fileNameExt[0] == '.' && b->fileNameExt[0] != '.')
-                        return false;
-                    if (a->fileNameExt[0] != '.' && b->fileNameExt[0] == '.')
-                        return true;
-                    if (a->fileNameExt[0] == '.' && b->fileNameExt[0] == '.')
-                    {
-                        return (stricmp(a->fileNameExt.c_str(), b->fileNameExt.c_str()) > 0); // sort in insensitive
-                    case
-                    }
-                    */
-                    if (a->fileType != b->fileType)
-                        return (a->fileType > b->fileType);                                // directories last
-                    return (stricmp(a->fileNameExt.c_str(), b->fileNameExt.c_str()) > 0);  // sort in insensitive case
-                });
-        }
+    if (sortingField == SortingFieldEnum::FIELD_FILENAME) {
+        headerFileName = (sortingDirection[0] ? tableHeaderAscendingIcon : tableHeaderDescendingIcon) + headerFileName;
     } else if (sortingField == SortingFieldEnum::FIELD_TYPE) {
-        if (sortingDirection[1]) {
-#ifdef USE_CUSTOM_SORTING_ICON
-            headerFileType = tableHeaderAscendingIcon + headerFileType;
-#endif  // USE_CUSTOM_SORTING_ICON
-            std::sort(
-                vFileInfosList.begin(), vFileInfosList.end(), [](const std::shared_ptr<FileInfos>& a, const std::shared_ptr<FileInfos>& b) -> bool {
-                    if (!a.use_count() || !b.use_count())
-                        return false;
-                    if (a->fileType != b->fileType)
-                        return (a->fileType < b->fileType);              // directory in first
-                    return (a->fileExtLevels[0] < b->fileExtLevels[0]);  // else
-                });
-        } else {
-#ifdef USE_CUSTOM_SORTING_ICON
-            headerFileType = tableHeaderDescendingIcon + headerFileType;
-#endif  // USE_CUSTOM_SORTING_ICON
-            std::sort(
-                vFileInfosList.begin(), vFileInfosList.end(), [](const std::shared_ptr<FileInfos>& a, const std::shared_ptr<FileInfos>& b) -> bool {
-                    if (!a.use_count() || !b.use_count())
-                        return false;
-                    if (a->fileType != b->fileType)
-                        return (a->fileType > b->fileType);              // directory in last
-                    return (a->fileExtLevels[0] > b->fileExtLevels[0]);  // else
-                });
-        }
+        headerFileType = (sortingDirection[1] ? tableHeaderAscendingIcon : tableHeaderDescendingIcon) + headerFileType;
     } else if (sortingField == SortingFieldEnum::FIELD_SIZE) {
-        if (sortingDirection[2]) {
-#ifdef USE_CUSTOM_SORTING_ICON
-            headerFileSize = tableHeaderAscendingIcon + headerFileSize;
-#endif  // USE_CUSTOM_SORTING_ICON
-            std::sort(
-                vFileInfosList.begin(), vFileInfosList.end(), [](const std::shared_ptr<FileInfos>& a, const std::shared_ptr<FileInfos>& b) -> bool {
-                    if (!a.use_count() || !b.use_count())
-                        return false;
-                    if (a->fileType != b->fileType)
-                        return (a->fileType < b->fileType);  // directory in first
-                    return (a->fileSize < b->fileSize);      // else
-                });
-        } else {
-#ifdef USE_CUSTOM_SORTING_ICON
-            headerFileSize = tableHeaderDescendingIcon + headerFileSize;
-#endif  // USE_CUSTOM_SORTING_ICON
-            std::sort(
-                vFileInfosList.begin(), vFileInfosList.end(), [](const std::shared_ptr<FileInfos>& a, const std::shared_ptr<FileInfos>& b) -> bool {
-                    if (!a.use_count() || !b.use_count())
-                        return false;
-                    if (a->fileType != b->fileType)
-                        return (a->fileType > b->fileType);  // directory in last
-                    return (a->fileSize > b->fileSize);      // else
-                });
-        }
+        headerFileSize = (sortingDirection[2] ? tableHeaderAscendingIcon : tableHeaderDescendingIcon) + headerFileSize;
     } else if (sortingField == SortingFieldEnum::FIELD_DATE) {
-        if (sortingDirection[3]) {
-#ifdef USE_CUSTOM_SORTING_ICON
-            headerFileDate = tableHeaderAscendingIcon + headerFileDate;
-#endif  // USE_CUSTOM_SORTING_ICON
-            std::sort(
-                vFileInfosList.begin(), vFileInfosList.end(), [](const std::shared_ptr<FileInfos>& a, const std::shared_ptr<FileInfos>& b) -> bool {
-                    if (!a.use_count() || !b.use_count())
-                        return false;
-                    if (a->fileType != b->fileType)
-                        return (a->fileType < b->fileType);        // directory in first
-                    return (a->fileModifDate < b->fileModifDate);  // else
-                });
-        } else {
-#ifdef USE_CUSTOM_SORTING_ICON
-            headerFileDate = tableHeaderDescendingIcon + headerFileDate;
-#endif  // USE_CUSTOM_SORTING_ICON
-            std::sort(
-                vFileInfosList.begin(), vFileInfosList.end(), [](const std::shared_ptr<FileInfos>& a, const std::shared_ptr<FileInfos>& b) -> bool {
-                    if (!a.use_count() || !b.use_count())
-                        return false;
-                    if (a->fileType != b->fileType)
-                        return (a->fileType > b->fileType);        // directory in last
-                    return (a->fileModifDate > b->fileModifDate);  // else
-                });
-        }
+        headerFileDate = (sortingDirection[3] ? tableHeaderAscendingIcon : tableHeaderDescendingIcon) + headerFileDate;
     }
 #ifdef USE_THUMBNAILS
     else if (sortingField == SortingFieldEnum::FIELD_THUMBNAILS) {
-        // we will compare thumbnails by :
-        // 1) width
-        // 2) height
-
-        if (sortingDirection[4]) {
-#ifdef USE_CUSTOM_SORTING_ICON
-            headerFileThumbnails = tableHeaderAscendingIcon + headerFileThumbnails;
-#endif  // USE_CUSTOM_SORTING_ICON
-            std::sort(
-                vFileInfosList.begin(), vFileInfosList.end(), [](const std::shared_ptr<FileInfos>& a, const std::shared_ptr<FileInfos>& b) -> bool {
-                    if (!a.use_count() || !b.use_count())
-                        return false;
-                    if (a->fileType != b->fileType)
-                        return (a->fileType.isDir());  // directory in first
-                    if (a->thumbnailInfo.textureWidth == b->thumbnailInfo.textureWidth)
-                        return (a->thumbnailInfo.textureHeight < b->thumbnailInfo.textureHeight);
-                    return (a->thumbnailInfo.textureWidth < b->thumbnailInfo.textureWidth);
-                });
-        }
-
-        else {
-#ifdef USE_CUSTOM_SORTING_ICON
-            headerFileThumbnails = tableHeaderDescendingIcon + headerFileThumbnails;
+        headerFileThumbnails = (sortingDirection[4] ? tableHeaderAscendingIcon : tableHeaderDescendingIcon) + headerFileThumbnails;
+    }
+#endif  // USE_THUMBNAILS
 #endif  // USE_CUSTOM_SORTING_ICON
-            std::sort(
-                vFileInfosList.begin(), vFileInfosList.end(), [](const std::shared_ptr<FileInfos>& a, const std::shared_ptr<FileInfos>& b) -> bool {
-                    if (!a.use_count() || !b.use_count())
-                        return false;
-                    if (a->fileType != b->fileType)
-                        return (!a->fileType.isDir());  // directory in last
-                    if (a->thumbnailInfo.textureWidth == b->thumbnailInfo.textureWidth)
-                        return (a->thumbnailInfo.textureHeight > b->thumbnailInfo.textureHeight);
-                    return (a->thumbnailInfo.textureWidth > b->thumbnailInfo.textureWidth);
-                });
+
+    const auto comparator = m_GetSortingComparator(vFileInfosList, vFileListArena);
+    const bool needDetails = sortingField == SortingFieldEnum::FIELD_SIZE || sortingField == SortingFieldEnum::FIELD_DATE;
+    const bool isFileList = &vFileInfosList == &m_FileList;
+    if (isFileList) {
+        // a previous sorting by size or date is replaced
+        m_PendingDetailsRows.clear();
+        m_PendingDetailsIdx = 0U;
+        if (m_ScanDirState.use_count()) {
+            m_ScanDirState->needDetails = needDetails;  // the next entries will come with their size and date
+        }
+    }
+    if (comparator.field != SortingFieldEnum::FIELD_NONE && vFileInfosList.size() > 1U) {
+        if (needDetails) {
+            // size and date are retrieved lazily, so all are needed for sort on it
+            // for the file list, the missing ones are retrieved by chunks in the next frames, then the rows are sorted
+            for (size_t row = 0U; row < vFileInfosList.size(); ++row) {
+                if (isFileList && !vFileInfosList[row]->isDetailsCompleted) {
+                    m_PendingDetailsRows.push_back((uint32_t)row);
+                } else {
+                    m_CompleteFileInfos(vFileInfosList[row]);
+                    vFileListArena.setDetails(row, *vFileInfosList[row]);
+                }
+            }
+        }
+        if (m_PendingDetailsRows.empty() || !isFileList) {
+            // the rows are sorted, the file list is not modified
+            m_SortRows(vFileListArena.sortedRows, comparator);
+            ++vFileListArena.generation;
+        }
+    }
+
+    m_ApplyFilteringOnFileList(vFileDialogInternal, vFileListArena, vFileInfosFilteredList);
+}
+
+IGFD::FileManager::FileListComparator IGFD::FileManager::m_GetSortingComparator(
+    const std::vector<std::shared_ptr<FileInfos>>& vFileInfosList, const FileListArena& vFileListArena) const {
+    FileListComparator res;
+    res.arena = &vFileListArena;
+    res.list = &vFileInfosList;
+    const auto fieldIdx = (size_t)sortingField - 1U;  // sortingDirection start at FIELD_FILENAME
+    if (sortingField != SortingFieldEnum::FIELD_NONE && fieldIdx < IM_ARRAYSIZE(sortingDirection)) {
+        res.field = sortingField;
+        res.ascending = sortingDirection[fieldIdx];
+    }
+    return res;
+}
+
+void IGFD::FileManager::m_SortRows(std::vector<uint32_t>& vRows, const FileListComparator& vComparator) {
+    std::vector<SortingItem> items;
+    items.reserve(vRows.size());
+    for (const auto& row : vRows) {
+        items.push_back(vComparator.getItem(row));
+    }
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    std::sort(items.begin(), items.end(), vComparator);
+#else
+    const size_t countThreads = (std::min)((size_t)std::thread::hardware_concurrency(), items.size() / (SORT_PARALLEL_MIN_ENTRIES / 2U));
+    if (items.size() < SORT_PARALLEL_MIN_ENTRIES || countThreads < 2U) {
+        std::sort(items.begin(), items.end(), vComparator);
+    } else {
+        m_SortItemsInThreads(items, vComparator, countThreads);
+    }
+#endif
+    for (size_t idx = 0U; idx < items.size(); ++idx) {
+        vRows[idx] = items[idx].row;
+    }
+}
+
+void IGFD::FileManager::m_SortItemsInThreads(std::vector<SortingItem>& vItems, const FileListComparator& vComparator, size_t vCountThreads) {
+    // each thread sort a chunk, then the chunks are merged two by two, the merges of a pass are also in threads
+    const size_t countThreads = vCountThreads;  // >= 2
+    std::vector<size_t> bounds(countThreads + 1U);
+    for (size_t idx = 0U; idx <= countThreads; ++idx) {
+        bounds[idx] = vItems.size() * idx / countThreads;
+    }
+    auto begin = vItems.begin();
+    std::vector<std::thread> threads;
+    for (size_t idx = 1U; idx < countThreads; ++idx) {
+        threads.emplace_back([begin, &bounds, &vComparator, idx]() {
+            std::sort(begin + (std::ptrdiff_t)bounds[idx], begin + (std::ptrdiff_t)bounds[idx + 1U], vComparator);
+        });
+    }
+    std::sort(begin, begin + (std::ptrdiff_t)bounds[1U], vComparator);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t width = 1U; width < countThreads; width *= 2U) {
+        threads.clear();
+        for (size_t idx = 0U; idx + width < countThreads; idx += width * 2U) {
+            const auto first = begin + (std::ptrdiff_t)bounds[idx];
+            const auto middle = begin + (std::ptrdiff_t)bounds[idx + width];
+            const auto last = begin + (std::ptrdiff_t)bounds[(std::min)(idx + width * 2U, countThreads)];
+            threads.emplace_back([first, middle, last, &vComparator]() {
+                std::inplace_merge(first, middle, last, vComparator);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+}
+
+// 8 first chars of a '\0' terminated string, the first char in the high byte, so the keys have the order of the strings
+static uint64_t GetStringKey(const char* vStr) {
+    uint64_t res = 0U;
+    for (size_t idx = 0U; idx < 8U; ++idx) {
+        res <<= 8U;
+        if (*vStr) {
+            res |= (uint8_t)*vStr++;
         }
     }
+    return res;
+}
+
+// 15 first chars of a '\0' terminated string in two keys, with the type of the file in the high byte of the first one
+static void GetTypedStringKeys(const char* vStr, int8_t vType, uint64_t* vKeys) {
+    char chars[15] = {};
+    for (size_t idx = 0U; idx < 15U && vStr[idx]; ++idx) {
+        chars[idx] = vStr[idx];
+    }
+    vKeys[0] = (uint64_t)(uint8_t)(vType + 1);
+    vKeys[1] = 0U;
+    for (size_t idx = 0U; idx < 7U; ++idx) {
+        vKeys[0] = (vKeys[0] << 8U) | (uint8_t)chars[idx];
+    }
+    for (size_t idx = 7U; idx < 15U; ++idx) {
+        vKeys[1] = (vKeys[1] << 8U) | (uint8_t)chars[idx];
+    }
+}
+
+// compare two strings at the same offset than their keys, the keys are compared first
+static bool IsStringLess(const std::vector<char>& vStrings, uint32_t vOffsetA, uint64_t vKeyA, uint32_t vOffsetB, uint64_t vKeyB) {
+    if (vKeyA != vKeyB)
+        return vKeyA < vKeyB;
+    if (!(vKeyA & 0xFFU))  // the two strings end in the key, so are equals
+        return false;
+    return strcmp(&vStrings[vOffsetA + 8U], &vStrings[vOffsetB + 8U]) < 0;
+}
+
+size_t IGFD::FileManager::FileListArena::size() const {
+    return nameOffsets.size();
+}
+
+void IGFD::FileManager::FileListArena::clear() {
+    names.clear();
+    namesLowerCase.clear();
+    exts.clear();
+    nameOffsets.clear();
+    extOffsets.clear();
+    nameKeys.clear();
+    extKeys.clear();
+    types.clear();
+    sizes.clear();
+    dates.clear();
+    sortedRows.clear();
+    ++generation;
+}
+
+void IGFD::FileManager::FileListArena::add(const FileInfos& vInfos) {
+    sortedRows.push_back((uint32_t)nameOffsets.size());
+    const auto nameOffset = (uint32_t)names.size();
+    names.insert(names.end(), vInfos.fileNameExt.c_str(), vInfos.fileNameExt.c_str() + vInfos.fileNameExt.size() + 1U);
+    namesLowerCase.insert(namesLowerCase.end(), vInfos.fileNameExt_optimized.c_str(),
+        vInfos.fileNameExt_optimized.c_str() + vInfos.fileNameExt_optimized.size() + 1U);
+    const auto extOffset = (uint32_t)exts.size();
+    const auto& ext = vInfos.fileExtLevels[0];
+    exts.insert(exts.end(), ext.c_str(), ext.c_str() + ext.size() + 1U);
+    nameOffsets.push_back(nameOffset);
+    extOffsets.push_back(extOffset);
+    nameKeys.push_back(GetStringKey(vInfos.fileNameExt_optimized.c_str()));
+    extKeys.push_back(GetStringKey(ext.c_str()));
+    int8_t type = -1;
+    if (vInfos.fileType.isDir())
+        type = 0;
+    else if (vInfos.fileType.isFile())
+        type = 1;
+    else if (vInfos.fileType.isLinkToUnknown())
+        type = 2;
+    types.push_back(type);
+    sizes.push_back(vInfos.fileSize);
+    dates.push_back(vInfos.fileModifTime);
+    ++generation;
+}
+
+void IGFD::FileManager::FileListArena::setDetails(size_t vRow, const FileInfos& vInfos) {
+    sizes[vRow] = vInfos.fileSize;
+    dates[vRow] = vInfos.fileModifTime;
+}
+
+IGFD::FileManager::SortingItem IGFD::FileManager::FileListComparator::getItem(uint32_t vRow) const {
+    static const uint64_t maxValue = (1ULL << 56U) - 1U;  // the high byte is for the type
+    const auto& datas = *arena;
+    SortingItem res;
+    res.row = vRow;
+    res.keys[0] = (uint64_t)(uint8_t)(datas.types[vRow] + 1) << 56U;
+    res.keys[1] = 0U;
+    switch (field) {
+        case SortingFieldEnum::FIELD_FILENAME: GetTypedStringKeys(&datas.namesLowerCase[datas.nameOffsets[vRow]], datas.types[vRow], res.keys); break;
+        case SortingFieldEnum::FIELD_TYPE: GetTypedStringKeys(&datas.exts[datas.extOffsets[vRow]], datas.types[vRow], res.keys); break;
+        case SortingFieldEnum::FIELD_SIZE: res.keys[0] |= (std::min)((uint64_t)datas.sizes[vRow], maxValue); break;
+        case SortingFieldEnum::FIELD_DATE: {
+            // signed time to unsigned, then clamped, still ordered
+            const uint64_t date = (uint64_t)datas.dates[vRow] + (1ULL << 55U);
+            res.keys[0] |= (datas.dates[vRow] < -(1LL << 55U)) ? 0U : (std::min)(date, maxValue);
+            break;
+        }
+#ifdef USE_THUMBNAILS
+        case SortingFieldEnum::FIELD_THUMBNAILS: {
+            // width, then height
+            const auto& thumb = (*list)[vRow]->thumbnailInfo;
+            res.keys[0] |= ((uint64_t)(std::max)(thumb.textureWidth, 0) << 24U) | (uint64_t)(std::min)((std::max)(thumb.textureHeight, 0), 0xFFFFFF);
+            break;
+        }
 #endif  // USE_THUMBNAILS
+        default: break;
+    }
+    return res;
+}
 
-    m_ApplyFilteringOnFileList(vFileDialogInternal, vFileInfosList, vFileInfosFilteredList);
+bool IGFD::FileManager::FileListComparator::less(uint32_t vRowA, uint32_t vRowB) const {
+    const auto& datas = *arena;
+    if (datas.types[vRowA] != datas.types[vRowB]) {
+        return datas.types[vRowA] < datas.types[vRowB];  // directory in first
+    }
+    switch (field) {
+        case SortingFieldEnum::FIELD_FILENAME:  // sort in insensitive case
+            return IsStringLess(datas.namesLowerCase, datas.nameOffsets[vRowA], datas.nameKeys[vRowA], datas.nameOffsets[vRowB], datas.nameKeys[vRowB]);
+        case SortingFieldEnum::FIELD_TYPE:
+            return IsStringLess(datas.exts, datas.extOffsets[vRowA], datas.extKeys[vRowA], datas.extOffsets[vRowB], datas.extKeys[vRowB]);
+        case SortingFieldEnum::FIELD_SIZE: return datas.sizes[vRowA] < datas.sizes[vRowB];
+        case SortingFieldEnum::FIELD_DATE: return datas.dates[vRowA] < datas.dates[vRowB];
+#ifdef USE_THUMBNAILS
+        case SortingFieldEnum::FIELD_THUMBNAILS: {
+            // we will compare thumbnails by :
+            // 1) width
+            // 2) height
+            const auto& thumbA = (*list)[vRowA]->thumbnailInfo;
+            const auto& thumbB = (*list)[vRowB]->thumbnailInfo;
+            if (thumbA.textureWidth == thumbB.textureWidth)
+                return thumbA.textureHeight < thumbB.textureHeight;
+            return thumbA.textureWidth < thumbB.textureWidth;
+        }
+#endif  // USE_THUMBNAILS
+        default: return false;
+    }
 }
 
 void IGFD::FileManager::ClearFileLists() {
-    m_FilteredFileList.clear();
+    m_StopScanDir();
+    m_PendingDetailsRows.clear();
+    m_PendingDetailsIdx = 0U;
+    m_FilteredFileList.rows.clear();
+    m_FileArena.clear();
     m_FileList.clear();
 }
 
 void IGFD::FileManager::ClearPathLists() {
-    m_FilteredPathList.clear();
+    m_FilteredPathList.rows.clear();
+    m_PathArena.clear();
     m_PathList.clear();
 }
 
@@ -1921,8 +2094,9 @@ void IGFD::FileManager::m_AddFile(
 
     vFileDialogInternal.filterManager.m_FillFileStyle(infos);
 
-    m_CompleteFileInfos(infos);
+    // size and date are retrieved lazily, see CompleteFileInfos
     m_FileList.push_back(infos);
+    m_FileArena.add(*infos);
 }
 
 void IGFD::FileManager::m_AddPath(
@@ -1953,8 +2127,8 @@ void IGFD::FileManager::m_AddPath(
 
     vFileDialogInternal.filterManager.m_FillFileStyle(infos);
 
-    m_CompleteFileInfos(infos);
     m_PathList.push_back(infos);
+    m_PathArena.add(*infos);
 }
 
 void IGFD::FileManager::ScanDir(const FileDialogInternal& vFileDialogInternal, const std::string& vPath) {
@@ -1972,12 +2146,212 @@ void IGFD::FileManager::ScanDir(const FileDialogInternal& vFileDialogInternal, c
 
         ClearFileLists();
 
-        const auto& files = m_FileSystemPtr->ScanDirectory(vPath);
-        for (const auto& file : files) {
-            m_AddFile(vFileDialogInternal, path, file.fileNameExt, file.fileType);
+        // will set the headers
+        m_SortFields(vFileDialogInternal, m_FileList, m_FileArena, m_FilteredFileList);
+
+        // the entries are added to the file list by UpdateScanDir, as soon as the thread find them
+        m_ScanDirState = std::make_shared<ScanDirState>();
+        m_ScanDirState->path = vPath;
+        m_ScanDirState->filesPath = path;
+        m_ScanDirState->needDetails = sortingField == SortingFieldEnum::FIELD_SIZE || sortingField == SortingFieldEnum::FIELD_DATE;
+        m_ScanDirPath = path;
+        m_ScanDirEntries.clear();
+        m_ScanDirEntriesIdx = 0U;
+        m_CountScannedEntries = 0U;
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+        m_ThreadScanDirFunc(m_FileSystemPtr.get(), m_ScanDirState);
+#else
+        m_ScanDirThread = std::thread(&IGFD::FileManager::m_ThreadScanDirFunc, m_FileSystemPtr.get(), m_ScanDirState);
+#endif
+        UpdateScanDir(vFileDialogInternal);
+    }
+}
+
+void IGFD::FileManager::m_ThreadScanDirFunc(IFileSystem* vFileSystemPtr, std::shared_ptr<ScanDirState> vState) {
+    std::vector<ScanDirEntry> batch;
+    batch.reserve(SCAN_DIR_BATCH_SIZE);
+    auto flushBatch = [&vState, &batch]() {
+        if (!batch.empty()) {
+            // write => thread concurency issues
+            std::lock_guard<std::mutex> lock(vState->entriesMutex);
+            if (vState->entries.empty()) {
+                vState->entries.swap(batch);
+            } else {
+                vState->entries.insert(vState->entries.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+            }
+            batch.clear();
+        }
+    };
+    vFileSystemPtr->ScanDirectoryEntries(vState->path, [&vState, &batch, &flushBatch](const std::string& vFileName, const FileType& vFileType) -> bool {
+        if (vState->cancelled) {
+            return false;
+        }
+        batch.emplace_back();
+        auto& entry = batch.back();
+        entry.fileName = vFileName;
+        entry.fileType = vFileType;
+        if (vState->needDetails) {  // stat here, instead of for each entry added by the ui thread
+            entry.isDetailsCompleted = true;
+            if (vFileName != "." && vFileName != "..") {
+                entry.isDetailsValid = m_GetFileDetails(vState->filesPath + std::string(1u, PATH_SEP) + vFileName, vFileType.isDir(), &entry.fileSize, &entry.fileModifTime);
+            }
         }
+        ++vState->countEntries;
+        if (batch.size() >= SCAN_DIR_BATCH_SIZE) {
+            flushBatch();
+        }
+        return true;
+    });
+    flushBatch();
+    vState->working = false;
+}
 
-        m_SortFields(vFileDialogInternal, m_FileList, m_FilteredFileList);
+bool IGFD::FileManager::UpdateScanDir(const FileDialogInternal& vFileDialogInternal) {
+    m_JoinFinishedScanDirThreads(false);
+    m_UpdatePendingDetails(vFileDialogInternal);
+
+    if (!m_ScanDirState.use_count()) {
+        return false;
+    }
+
+    const bool working = m_ScanDirState->working;  // read before the entries, so no entry can be missed when finished
+    if (m_ScanDirEntriesIdx >= m_ScanDirEntries.size()) {
+        m_ScanDirEntries.clear();
+        m_ScanDirEntriesIdx = 0U;
+        // write => thread concurency issues
+        std::lock_guard<std::mutex> lock(m_ScanDirState->entriesMutex);
+        m_ScanDirEntries.swap(m_ScanDirState->entries);
+    }
+
+    if (m_ScanDirEntries.empty()) {
+        if (!working && m_ScanDirThread.joinable()) {
+            m_ScanDirThread.join();
+        }
+        return false;
+    }
+
+    // the entries are added by chunks, for keep the ui responsive with huge directories
+    const size_t firstNewFile = m_FileList.size();
+    const size_t countEntries = (std::min)(m_ScanDirEntries.size() - m_ScanDirEntriesIdx, (size_t)SCAN_DIR_MAX_ENTRIES_PER_FRAME);
+    for (size_t idx = m_ScanDirEntriesIdx; idx < m_ScanDirEntriesIdx + countEntries; ++idx) {
+        const auto& entry = m_ScanDirEntries[idx];
+        const size_t row = m_FileList.size();
+        m_AddFile(vFileDialogInternal, m_ScanDirPath, entry.fileName, entry.fileType);
+        if (entry.isDetailsCompleted && row < m_FileList.size()) {  // the file was added
+            auto& infos = *m_FileList[row];
+            infos.isDetailsCompleted = true;
+            if (entry.isDetailsValid) {
+                m_SetFileDetails(infos, entry.fileSize, entry.fileModifTime);
+            }
+            m_FileArena.setDetails(row, infos);
+        }
+    }
+    m_ScanDirEntriesIdx += countEntries;
+    m_CountScannedEntries += countEntries;
+
+    // the file list is already sorted, so only the new files are sorted, then merged
+    const auto comparator = m_GetSortingComparator(m_FileList, m_FileArena);
+    if (comparator.field != SortingFieldEnum::FIELD_NONE && firstNewFile < m_FileList.size()) {
+        if (sortingField == SortingFieldEnum::FIELD_SIZE || sortingField == SortingFieldEnum::FIELD_DATE) {
+            // the entries found before the sorting was on size or date have no details, they are retrieved by the next frames
+            for (size_t row = firstNewFile; row < m_FileList.size(); ++row) {
+                if (!m_FileList[row]->isDetailsCompleted) {
+                    m_PendingDetailsRows.push_back((uint32_t)row);
+                }
+            }
+        }
+        // else the whole list is sorted when the pending details are retrieved
+        if (m_PendingDetailsRows.empty()) {
+            auto& rows = m_FileArena.sortedRows;  // the new rows was added at the end
+            const auto firstNewFileIt = rows.begin() + (std::ptrdiff_t)firstNewFile;
+            std::sort(firstNewFileIt, rows.end(), comparator);
+            std::inplace_merge(rows.begin(), firstNewFileIt, rows.end(), comparator);
+            ++m_FileArena.generation;
+        }
+    }
+    m_ApplyFilteringOnFileList(vFileDialogInternal, m_FileArena, m_FilteredFileList);
+
+    return true;
+}
+
+void IGFD::FileManager::m_UpdatePendingDetails(const FileDialogInternal& vFileDialogInternal) {
+    if (m_PendingDetailsRows.empty()) {
+        return;
+    }
+
+    // by chunks, for keep the ui responsive with huge directories
+    const size_t countRows = (std::min)(m_PendingDetailsRows.size() - m_PendingDetailsIdx, (size_t)SCAN_DIR_MAX_DETAILS_PER_FRAME);
+    for (size_t idx = m_PendingDetailsIdx; idx < m_PendingDetailsIdx + countRows; ++idx) {
+        const uint32_t row = m_PendingDetailsRows[idx];
+        m_CompleteFileInfos(m_FileList[row]);
+        m_FileArena.setDetails(row, *m_FileList[row]);
+    }
+    m_PendingDetailsIdx += countRows;
+
+    if (m_PendingDetailsIdx >= m_PendingDetailsRows.size()) {
+        m_PendingDetailsRows.clear();
+        m_PendingDetailsIdx = 0U;
+        const auto comparator = m_GetSortingComparator(m_FileList, m_FileArena);
+        if (comparator.field != SortingFieldEnum::FIELD_NONE) {
+            m_SortRows(m_FileArena.sortedRows, comparator);
+            ++m_FileArena.generation;
+        }
+        m_ApplyFilteringOnFileList(vFileDialogInternal, m_FileArena, m_FilteredFileList);
+    }
+}
+
+void IGFD::FileManager::m_StopScanDir() {
+    if (m_ScanDirState.use_count()) {
+        m_ScanDirState->cancelled = true;
+        if (m_ScanDirThread.joinable()) {
+            // the thread can be blocked in a slow file system call, so it will be joined when finished
+            m_CancelledScanDirThreads.emplace_back(std::move(m_ScanDirThread), m_ScanDirState);
+        }
+        m_ScanDirState.reset();
+    }
+    m_ScanDirEntries.clear();
+    m_ScanDirEntriesIdx = 0U;
+    m_CountScannedEntries = 0U;
+}
+
+void IGFD::FileManager::m_JoinFinishedScanDirThreads(bool vWaitAll) {
+    for (auto it = m_CancelledScanDirThreads.begin(); it != m_CancelledScanDirThreads.end();) {
+        if (vWaitAll || !it->second->working) {
+            it->first.join();
+            it = m_CancelledScanDirThreads.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool IGFD::FileManager::IsScanDirStarted() {
+    return m_ScanDirState.use_count() != 0;
+}
+
+bool IGFD::FileManager::IsScanDirWorking() {
+    // the thread is joined by UpdateScanDir only when all its entries was fetched
+    return m_ScanDirState.use_count() && (m_ScanDirThread.joinable() || m_ScanDirEntriesIdx < m_ScanDirEntries.size());
+}
+
+bool IGFD::FileManager::IsFileDetailsPending() {
+    return !m_PendingDetailsRows.empty();
+}
+
+void IGFD::FileManager::DrawScanDirProgress() {
+    if (IsScanDirWorking()) {
+        // the count of entries is unknown until the end of the scan, so show the entries added vs found
+        const size_t countFound = m_ScanDirState->countEntries;  // read => no thread concurency issues
+        const auto p = countFound ? (float)((double)m_CountScannedEntries / (double)countFound) : 0.0f;
+        snprintf(variadicBuffer, MAX_FILE_DIALOG_NAME_BUFFER, "%zu/%zu", m_CountScannedEntries, countFound);
+        ImGui::ProgressBar(p, ImVec2(100, 0), variadicBuffer);
+        ImGui::SameLine();
+    } else if (IsFileDetailsPending()) {
+        // the sorting by size or date wait for the details of these files
+        const auto p = (float)((double)m_PendingDetailsIdx / (double)m_PendingDetailsRows.size());
+        snprintf(variadicBuffer, MAX_FILE_DIALOG_NAME_BUFFER, "%zu/%zu", m_PendingDetailsIdx, m_PendingDetailsRows.size());
+        ImGui::ProgressBar(p, ImVec2(100, 0), variadicBuffer);
+        ImGui::SameLine();
     }
 }
 
@@ -1999,7 +2373,7 @@ void IGFD::FileManager::m_ScanDirForPathSelection(const FileDialogInternal& vFil
             }
         }
 
-        m_SortFields(vFileDialogInternal, m_PathList, m_FilteredPathList);
+        m_SortFields(vFileDialogInternal, m_PathList, m_PathArena, m_FilteredPathList);
     }
 }
 
@@ -2024,6 +2398,7 @@ bool IGFD::FileManager::GetDrives() {
 
             if (!info->fileNameExt.empty()) {
                 m_FileList.push_back(info);
+                m_FileArena.add(*info);
             }
         }
         showDrives = true;
@@ -2059,30 +2434,30 @@ std::shared_ptr<IGFD::FileInfos> IGFD::FileManager::GetFullFileAt(size_t vIdx) {
 }
 
 bool IGFD::FileManager::IsFilteredListEmpty() {
-    return m_FilteredFileList.empty();
+    return m_FilteredFileList.rows.empty();
 }
 
 bool IGFD::FileManager::IsPathFilteredListEmpty() {
-    return m_FilteredPathList.empty();
+    return m_FilteredPathList.rows.empty();
 }
 
 size_t IGFD::FileManager::GetFilteredListSize() {
-    return m_FilteredFileList.size();
+    return m_FilteredFileList.rows.size();
 }
 
 size_t IGFD::FileManager::GetPathFilteredListSize() {
-    return m_FilteredPathList.size();
+    return m_FilteredPathList.rows.size();
 }
 
 std::shared_ptr<IGFD::FileInfos> IGFD::FileManager::GetFilteredFileAt(size_t vIdx) {
-    if (vIdx < m_FilteredFileList.size())
-        return m_FilteredFileList[vIdx];
+    if (vIdx < m_FilteredFileList.rows.size())
+        return m_FileList[m_FilteredFileList.rows[vIdx]];
     return nullptr;
 }
 
 std::shared_ptr<IGFD::FileInfos> IGFD::FileManager::GetFilteredPathAt(size_t vIdx) {
-    if (vIdx < m_FilteredPathList.size())
-        return m_FilteredPathList[vIdx];
+    if (vIdx < m_FilteredPathList.rows.size())
+        return m_PathList[m_FilteredPathList.rows[vIdx]];
     return nullptr;
 }
 
@@ -2108,25 +2483,81 @@ void IGFD::FileManager::ClearAll() {
     ClearPathLists();
 }
 void IGFD::FileManager::ApplyFilteringOnFileList(const FileDialogInternal& vFileDialogInternal) {
-    m_ApplyFilteringOnFileList(vFileDialogInternal, m_FileList, m_FilteredFileList);
+    m_ApplyFilteringOnFileList(vFileDialogInternal, m_FileArena, m_FilteredFileList);
+}
+
+// search vTag in [vStart, vEnd)
+static const char* FindInBuffer(const char* vStart, const char* vEnd, const std::string& vTag) {
+    const size_t tagLen = vTag.size();
+    while ((size_t)(vEnd - vStart) >= tagLen) {
+        const char* found = (const char*)memchr(vStart, vTag[0], (size_t)(vEnd - vStart) - tagLen + 1U);
+        if (!found)
+            return nullptr;
+        if (!memcmp(found + 1, vTag.c_str() + 1, tagLen - 1U))
+            return found;
+        vStart = found + 1;
+    }
+    return nullptr;
 }
 
 void IGFD::FileManager::m_ApplyFilteringOnFileList(const FileDialogInternal& vFileDialogInternal,
-    std::vector<std::shared_ptr<FileInfos>>& vFileInfosList,
-    std::vector<std::shared_ptr<FileInfos>>& vFileInfosFilteredList) {
-    vFileInfosFilteredList.clear();
-    for (const auto& file : vFileInfosList) {
-        if (!file.use_count())
-            continue;
-        bool show = true;
-        if (!file->SearchForTag(vFileDialogInternal.searchManager.searchTag))  // if search tag
-            show = false;
-        // disabled by Dicky, allow filter display even Directory
-        //if (dLGDirectoryMode && !file->fileType.isDir())
-        //    show = false;
-        if (show)
-            vFileInfosFilteredList.push_back(file);
+    const FileListArena& vFileListArena,
+    FilteredFileList& vFileInfosFilteredList) {
+    const auto& tag = vFileDialogInternal.searchManager.searchTag;
+    const bool isUpToDate = (vFileInfosFilteredList.generation == vFileListArena.generation);
+    if (isUpToDate && tag == vFileInfosFilteredList.searchTag) {
+        return;
+    }
+
+    auto& rows = vFileInfosFilteredList.rows;
+    const auto& arena = vFileListArena;
+    if (tag.empty()) {  // if tag is empty => its a special case but all is found
+        rows = arena.sortedRows;
+    } else {
+        // same as FileInfos::SearchForTag : a tag without upper case is found in the lower case name if it is found in the name,
+        // and a tag with upper case can only be found in the name, so only one of the names need to be searched
+        const auto& buffer = (tag == Utils::LowerCaseString(tag)) ? arena.namesLowerCase : arena.names;
+        auto isParentDir = [&arena](uint32_t vRow) -> bool {
+            const char* name = &arena.names[arena.nameOffsets[vRow]];
+            return arena.types[vRow] == 0 && name[0] == '.' && name[1] == '.' && name[2] == '\0';
+        };
+        if (isUpToDate && tag.find(vFileInfosFilteredList.searchTag) != std::string::npos) {
+            // the tag was extended, so the files shown are a part of the previous ones
+            const char* tagStr = tag.c_str();
+            rows.erase(std::remove_if(rows.begin(), rows.end(),
+                           [&arena, &buffer, &isParentDir, tagStr](uint32_t vRow) {
+                               return !isParentDir(vRow) && !strstr(&buffer[arena.nameOffsets[vRow]], tagStr);
+                           }),
+                rows.end());
+        } else {
+            // the names are searched in one pass, then the rows who was found are taken in the sorting order
+            const size_t countRows = arena.size();
+            std::vector<uint8_t> found(countRows, 0U);
+            const char* start = buffer.data();
+            const char* end = start + buffer.size();
+            size_t row = 0U;
+            for (const char* pos = FindInBuffer(start, end, tag); pos != nullptr;) {
+                const auto offset = (uint32_t)(pos - start);
+                while (row + 1U < countRows && arena.nameOffsets[row + 1U] <= offset) {
+                    ++row;
+                }
+                found[row] = 1U;
+                if (row + 1U >= countRows)
+                    break;
+                pos = FindInBuffer(start + arena.nameOffsets[row + 1U], end, tag);  // next name
+            }
+            rows.clear();
+            for (const auto& sortedRow : arena.sortedRows) {
+                // disabled by Dicky, allow filter display even Directory
+                //if (dLGDirectoryMode && !file->fileType.isDir())
+                //    show = false;
+                if (found[sortedRow] || isParentDir(sortedRow))
+                    rows.push_back(sortedRow);
+            }
+        }
     }
+    vFileInfosFilteredList.searchTag = tag;
+    vFileInfosFilteredList.generation = vFileListArena.generation;
 }
 
 std::string IGFD::FileManager::m_RoundNumber(double vvalue, int n) {
@@ -2161,10 +2592,16 @@ std::string IGFD::FileManager::m_FormatFileSize(size_t vByteSize) {
     return "";
 }
 
+void IGFD::FileManager::CompleteFileInfos(const std::shared_ptr<FileInfos>& vInfos) {
+    m_CompleteFileInfos(vInfos);
+}
+
 void IGFD::FileManager::m_CompleteFileInfos(const std::shared_ptr<FileInfos>& vInfos) {
-    if (!vInfos.use_count())
+    if (!vInfos.use_count() || vInfos->isDetailsCompleted)
         return;
 
+    vInfos->isDetailsCompleted = true;
+
     if (vInfos->fileNameExt != "." && vInfos->fileNameExt != "..") {
         // _stat struct :
         // dev_t     st_dev;     /* ID of device containing file */
@@ -2187,31 +2624,47 @@ void IGFD::FileManager::m_CompleteFileInfos(const std::shared_ptr<FileInfos>& vI
         if (vInfos->fileType.isFile() || vInfos->fileType.isLinkToUnknown() || vInfos->fileType.isDir())
             fpn = vInfos->filePath + std::string(1u, PATH_SEP) + vInfos->fileNameExt;
 
-        struct stat statInfos = {};
-        char timebuf[100];
-        int result = stat(fpn.c_str(), &statInfos);
-        if (!result) {
-            if (!vInfos->fileType.isDir()) {
-                vInfos->fileSize = (size_t)statInfos.st_size;
-                vInfos->formatedFileSize = m_FormatFileSize(vInfos->fileSize);
-            }
+        size_t fileSize = 0U;
+        int64_t fileModifTime = 0;
+        if (m_GetFileDetails(fpn, vInfos->fileType.isDir(), &fileSize, &fileModifTime)) {
+            m_SetFileDetails(*vInfos, fileSize, fileModifTime);
+        }
+    }
+}
 
-            size_t len = 0;
+bool IGFD::FileManager::m_GetFileDetails(const std::string& vFilePathName, bool vIsDir, size_t* vOutSize, int64_t* vOutModifTime) {
+    struct stat statInfos = {};
+    if (stat(vFilePathName.c_str(), &statInfos)) {
+        return false;
+    }
+    *vOutSize = vIsDir ? 0U : (size_t)statInfos.st_size;
+    *vOutModifTime = (int64_t)statInfos.st_mtime;
+    return true;
+}
+
+void IGFD::FileManager::m_SetFileDetails(FileInfos& vInfos, size_t vSize, int64_t vModifTime) {
+    if (!vInfos.fileType.isDir()) {
+        vInfos.fileSize = vSize;
+        vInfos.formatedFileSize = m_FormatFileSize(vInfos.fileSize);
+    }
+
+    char timebuf[100];
+    const time_t modifTime = (time_t)vModifTime;
+    size_t len = 0;
 #ifdef _MSC_VER
-            struct tm _tm;
-            errno_t err = localtime_s(&_tm, &statInfos.st_mtime);
-            if (!err)
-                len = strftime(timebuf, 99, DateTimeFormat, &_tm);
+    struct tm _tm;
+    errno_t err = localtime_s(&_tm, &modifTime);
+    if (!err)
+        len = strftime(timebuf, 99, DateTimeFormat, &_tm);
 #else   // _MSC_VER
-            struct tm* _tm = localtime(&statInfos.st_mtime);
-            if (_tm)
-                len = strftime(timebuf, 99, DateTimeFormat, _tm);
+    struct tm* _tm = localtime(&modifTime);
+    if (_tm)
+        len = strftime(timebuf, 99, DateTimeFormat, _tm);
 #endif  // _MSC_VER
-            if (len) {
-                vInfos->fileModifDate = std::string(timebuf, len);
-            }
-        }
+    if (len) {
+        vInfos.fileModifDate = std::string(timebuf, len);
     }
+    vInfos.fileModifTime = vModifTime;
 }
 
 void IGFD::FileManager::m_RemoveFileNameInSelection(const std::string& vFileName) {
@@ -2386,6 +2839,7 @@ bool IGFD::FileManager::SelectDirectory(const std::shared_ptr<FileInfos>& vInfos
 }
 
 void IGFD::FileManager::SelectFileName(const FileDialogInternal& vFileDialogInternal, const std::shared_ptr<FileInfos>& vInfos) {
+    (void)vFileDialogInternal;  // the search is already applied on m_FilteredFileList
     if (!vInfos.use_count())
         return;
 
@@ -2416,42 +2870,21 @@ void IGFD::FileManager::SelectFileName(const FileDialogInternal& vFileDialogInte
             bool startMultiSelection = false;
             std::string fileNameToSelect = vInfos->fileNameExt;
             std::string savedLastSelectedFileName;  // for invert selection mode
-            for (const auto& file : m_FileList) {
+            for (const auto& row : m_FilteredFileList.rows) {
+                const auto& file = m_FileList[row];
                 if (!file.use_count())
                     continue;
 
-                bool canTake = true;
-                if (!file->SearchForTag(vFileDialogInternal.searchManager.searchTag))
-                    canTake = false;
-                if (canTake)  // if not filtered, we will take files who are filtered by the dialog
-                {
-                    if (file->fileNameExt == m_LastSelectedFileName) {
-                        startMultiSelection = true;
-                        m_m_AddFileNameInSelection(m_LastSelectedFileName, false);
-                    } else if (startMultiSelection) {
-                        if (dLGcountSelectionMax == 0)  // infinite selection
-                        {
+                if (file->fileNameExt == m_LastSelectedFileName) {
+                    startMultiSelection = true;
+                    m_m_AddFileNameInSelection(m_LastSelectedFileName, false);
+                } else if (startMultiSelection) {
+                    if (dLGcountSelectionMax == 0)  // infinite selection
+                    {
+                        m_m_AddFileNameInSelection(file->fileNameExt, false);
+                    } else {  // selection limited by size
+                        if (m_SelectedFileNames.size() < dLGcountSelectionMax) {
                             m_m_AddFileNameInSelection(file->fileNameExt, false);
-                        } else {  // selection limited by size
-                            if (m_SelectedFileNames.size() < dLGcountSelectionMax) {
-                                m_m_AddFileNameInSelection(file->fileNameExt, false);
-                            } else {
-                                startMultiSelection = false;
-                                if (!savedLastSelectedFileName.empty())
-                                    m_LastSelectedFileName = savedLastSelectedFileName;
-                                break;
-                            }
-                        }
-                    }
-
-                    if (file->fileNameExt == fileNameToSelect) {
-                        if (!startMultiSelection)  // we are before the last Selected FileName, so we must inverse
-                        {
-                            savedLastSelectedFileName = m_LastSelectedFileName;
-                            m_LastSelectedFileName = fileNameToSelect;
-                            fileNameToSelect = savedLastSelectedFileName;
-                            startMultiSelection = true;
-                            m_m_AddFileNameInSelection(m_LastSelectedFileName, false);
                         } else {
                             startMultiSelection = false;
                             if (!savedLastSelectedFileName.empty())
@@ -2460,6 +2893,22 @@ void IGFD::FileManager::SelectFileName(const FileDialogInternal& vFileDialogInte
                         }
                     }
                 }
+
+                if (file->fileNameExt == fileNameToSelect) {
+                    if (!startMultiSelection)  // we are before the last Selected FileName, so we must inverse
+                    {
+                        savedLastSelectedFileName = m_LastSelectedFileName;
+                        m_LastSelectedFileName = fileNameToSelect;
+                        fileNameToSelect = savedLastSelectedFileName;
+                        startMultiSelection = true;
+                        m_m_AddFileNameInSelection(m_LastSelectedFileName, false);
+                    } else {
+                        startMultiSelection = false;
+                        if (!savedLastSelectedFileName.empty())
+                            m_LastSelectedFileName = savedLastSelectedFileName;
+                        break;
+                    }
+                }
             }
         }
     } else {
@@ -2777,10 +3226,18 @@ void IGFD::FileDialogInternal::ResetForNewDialog() {
 IGFD::ThumbnailFeature::ThumbnailFeature() {
 #ifdef USE_THUMBNAILS
     m_DisplayMode = DisplayModeEnum::FILE_LIST;
+    const std::string cacheDir = ImGuiHelper::getCacheDir();
+    if (!cacheDir.empty()) {
+        m_ThumbnailsCacheDir = cacheDir + std::string(1u, PATH_SEP) + THUMBNAILS_CACHE_DIR_NAME + std::string(1u, PATH_SEP) + "thumbnails";
+    }
 #endif
 }
 
-IGFD::ThumbnailFeature::~ThumbnailFeature() = default;
+IGFD::ThumbnailFeature::~ThumbnailFeature() {
+#ifdef USE_THUMBNAILS
+    m_StopThumbnailFileDatasExtraction();
+#endif
+}
 
 void IGFD::ThumbnailFeature::m_NewThumbnailFrame(FileDialogInternal& /*vFileDialogInternal*/) {
 #ifdef USE_THUMBNAILS
@@ -2807,107 +3264,398 @@ void IGFD::ThumbnailFeature::m_QuitThumbnailFrame(FileDialogInternal& vFileDialo
 
 #ifdef USE_THUMBNAILS
 void IGFD::ThumbnailFeature::m_StartThumbnailFileDatasExtraction() {
-    const bool res = m_ThumbnailGenerationThread.use_count() && m_ThumbnailGenerationThread->joinable();
-    if (!res) {
+    if (m_ThumbnailGenerationThreads.empty()) {
+        if (!m_ThumbnailsCacheDir.empty()) {
+            // create_directory is not recursive
+            const auto cacheDir = m_ThumbnailsCacheDir.substr(0, m_ThumbnailsCacheDir.find_last_of(PATH_SEP));
+            ImGuiHelper::create_directory(cacheDir.substr(0, cacheDir.find_last_of(PATH_SEP)));
+            ImGuiHelper::create_directory(cacheDir);
+            ImGuiHelper::create_directory(m_ThumbnailsCacheDir);
+        }
+        size_t countThreads = THUMBNAILS_THREADS_COUNT;
+        if (!countThreads) {
+            const size_t countHardwareThreads = std::thread::hardware_concurrency();
+            countThreads = (std::max)((size_t)1U, (std::min)((size_t)4U, countHardwareThreads ? countHardwareThreads - 1U : 1U));
+        }
+        m_ThumbnailFileDatasToGetMutex.lock();
         m_IsWorking = true;
-        m_CountFiles = 0U;
-        m_ThumbnailGenerationThread = std::shared_ptr<std::thread>(
-            new std::thread(&IGFD::ThumbnailFeature::m_ThreadThumbnailFileDatasExtractionFunc, this), [this](std::thread* obj) {
-                m_IsWorking = false;
-                if (obj)
-                    obj->join();
-            });
+        m_ThumbnailFileDatasToGetMutex.unlock();
+        for (size_t idx = 0U; idx < countThreads; ++idx) {
+            m_ThumbnailGenerationThreads.emplace_back(&IGFD::ThumbnailFeature::m_ThreadThumbnailFileDatasExtractionFunc, this);
+        }
     }
 }
 
 bool IGFD::ThumbnailFeature::m_StopThumbnailFileDatasExtraction() {
-    const bool res = m_ThumbnailGenerationThread.use_count() && m_ThumbnailGenerationThread->joinable();
+    const bool res = !m_ThumbnailGenerationThreads.empty();
     if (res) {
-        m_ThumbnailGenerationThread.reset();
+        m_ThumbnailFileDatasToGetMutex.lock();
+        m_IsWorking = false;
+        m_ThumbnailFileDatasToGetMutex.unlock();
+        m_ThumbnailFileDatasToGetCondition.notify_all();
+        for (auto& thread : m_ThumbnailGenerationThreads) {
+            thread.join();
+        }
+        m_ThumbnailGenerationThreads.clear();
     }
 
     return res;
 }
 
 void IGFD::ThumbnailFeature::m_ThreadThumbnailFileDatasExtractionFunc() {
-    m_CountFiles = 0U;
-    m_IsWorking = true;
-
-    // infinite loop while is thread working
-    while (m_IsWorking) {
-        if (!m_ThumbnailFileDatasToGet.empty()) {
-            std::shared_ptr<FileInfos> file = nullptr;
-            m_ThumbnailFileDatasToGetMutex.lock();
-            // get the first file in the list
-            file = (*m_ThumbnailFileDatasToGet.begin());
-            m_ThumbnailFileDatasToGetMutex.unlock();
-
-            // retrieve datas of the texture file if its an image file
-            if (file.use_count()) {
-                if (file->fileType.isFile())  //-V522
-                {
-                    //|| file->fileExtLevels == ".hdr" => format float so in few times
-                    if (file->SearchForExts(".png,.bmp,.tga,.jpg,.jpeg,.gif,.psd,.pic,.ppm,.pgm", true)) {
-                        auto fpn = file->filePath + std::string(1u, PATH_SEP) + file->fileNameExt;
-
-                        int w = 0;
-                        int h = 0;
-                        int chans = 0;
-                        uint8_t* datas = stbi_load(fpn.c_str(), &w, &h, &chans, STBI_rgb_alpha);
-                        if (datas) {
-                            if (w && h) {
-                                // resize with respect to glyph ratio
-                                const float ratioX = (float)w / (float)h;
-                                const float newX = DisplayMode_ThumbailsList_ImageHeight * ratioX;
-                                float newY = w / ratioX;
-                                if (newX < w)
-                                    newY = DisplayMode_ThumbailsList_ImageHeight;
-
-                                const auto newWidth = (int)newX;
-                                const auto newHeight = (int)newY;
-                                const auto newBufSize = (size_t)(newWidth * newHeight * 4U);  //-V112 //-V1028
-                                auto resizedData = new uint8_t[newBufSize];
-
-                                const int resizeSucceeded = stbir_resize_uint8(datas, w, h, 0, resizedData, newWidth, newHeight, 0,
-                                    4);  //-V112
-
-                                if (resizeSucceeded) {
-                                    auto th = &file->thumbnailInfo;
-
-                                    th->textureFileDatas = resizedData;
-                                    th->textureWidth = newWidth;
-                                    th->textureHeight = newHeight;
-                                    th->textureChannels = 4;  //-V112
-
-                                    // we set that at least, because will launch the gpu creation of the texture in the
-                                    // main thread
-                                    th->isReadyToUpload = true;
-
-                                    // need gpu loading
-                                    m_AddThumbnailToCreate(file);
-                                }
-                            } else {
-                                printf("image loading fail : w:%i h:%i c:%i\n", w, h, 4);  //-V112
-                            }
+    // sleep until a file is added or the pool is stopped
+    while (true) {
+        std::shared_ptr<FileInfos> file = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(m_ThumbnailFileDatasToGetMutex);
+            m_ThumbnailFileDatasToGetCondition.wait(lock, [this]() { return !m_IsWorking || !m_ThumbnailFileDatasToGet.empty(); });
+            if (!m_IsWorking) {
+                break;
+            }
+            // get the last asked file
+            file = m_ThumbnailFileDatasToGet.front();
+            m_ThumbnailFileDatasToGet.pop_front();
+        }
 
-                            stbi_image_free(datas);
-                        }
-                    }
+        // retrieve datas of the texture file if its an image file
+        if (file.use_count()) {
+            m_LoadThumbnailFileDatas(file);
+        }
+
+        // write => thread concurency issues
+        m_ThumbnailFileDatasToGetMutex.lock();
+        ++m_CountFiles;
+        m_ThumbnailFileDatasToGetMutex.unlock();
+    }
+}
+
+void IGFD::ThumbnailFeature::m_LoadThumbnailFileDatas(const std::shared_ptr<FileInfos>& vFileInfos) {
+    //|| file->fileExtLevels == ".hdr" => format float so in few times
+    if (!vFileInfos->fileType.isFile() || !vFileInfos->SearchForExts(".png,.bmp,.tga,.jpg,.jpeg,.gif,.psd,.pic,.ppm,.pgm", true))
+        return;
+
+    const auto fpn = vFileInfos->filePath + std::string(1u, PATH_SEP) + vFileInfos->fileNameExt;
+    auto th = &vFileInfos->thumbnailInfo;
+
+    // the cache entry is invalidated by any change of the file or of the thumbnail height
+    // the entry is named after the file only, so a changed file overwrites its old entry
+    std::string cacheKey;
+    std::string cacheFile;
+    if (!m_ThumbnailsCacheDir.empty()) {
+        struct stat statInfos = {};
+        if (!stat(fpn.c_str(), &statInfos)) {
+            cacheKey = m_GetThumbnailCacheKey(fpn, (long long)statInfos.st_mtime, (long long)statInfos.st_size);
+            uint64_t hash = 14695981039346656037ULL;  // fnv-1a
+            for (const char c : fpn) {
+                hash = (hash ^ (uint8_t)c) * 1099511628211ULL;
+            }
+            char hashBuffer[17];
+            snprintf(hashBuffer, 17, "%016llx", (unsigned long long)hash);
+            cacheFile = m_ThumbnailsCacheDir + std::string(1u, PATH_SEP) + hashBuffer + ".thumb";
+            if (m_ReadThumbnailCache(cacheFile, cacheKey, th)) {
+                // need gpu loading
+                m_AddThumbnailToCreate(vFileInfos);
+                return;
+            }
+        }
+    }
+
+    int w = 0;
+    int h = 0;
+    int chans = 0;
+    uint8_t* datas = nullptr;
+    if (vFileInfos->SearchForExts(".jpg,.jpeg", true)) {
+        // stb_image can't decode a jpeg at a reduced resolution (no dct scaling)
+        // but most camera pictures embed a small jpeg thumbnail in the exif datas, so we use it when big enough
+        std::ifstream file(fpn, std::ios::in | std::ios::binary);
+        if (file.is_open()) {
+            std::vector<uint8_t> fileDatas((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            datas = m_DecodeJpegExifThumbnail(fileDatas, (int)DisplayMode_ThumbailsList_ImageHeight, &w, &h);
+            if (!datas && !fileDatas.empty()) {
+                datas = stbi_load_from_memory(fileDatas.data(), (int)fileDatas.size(), &w, &h, &chans, STBI_rgb_alpha);
+            }
+        }
+    } else {
+        datas = stbi_load(fpn.c_str(), &w, &h, &chans, STBI_rgb_alpha);
+    }
+
+    if (datas) {
+        if (w && h) {
+            // resize with respect to glyph ratio
+            const float ratioX = (float)w / (float)h;
+            const float newX = DisplayMode_ThumbailsList_ImageHeight * ratioX;
+            float newY = w / ratioX;
+            if (newX < w)
+                newY = DisplayMode_ThumbailsList_ImageHeight;
+
+            const auto newWidth = (int)newX;
+            const auto newHeight = (int)newY;
+            const auto newBufSize = (size_t)(newWidth * newHeight * 4U);  //-V112 //-V1028
+            auto resizedData = new uint8_t[newBufSize];
+
+            const int resizeSucceeded = stbir_resize_uint8(datas, w, h, 0, resizedData, newWidth, newHeight, 0,
+                4);  //-V112
+
+            if (resizeSucceeded) {
+                th->textureFileDatas = resizedData;
+                th->textureWidth = newWidth;
+                th->textureHeight = newHeight;
+                th->textureChannels = 4;  //-V112
+
+                if (!cacheFile.empty()) {
+                    m_WriteThumbnailCache(cacheFile, cacheKey, th);
                 }
 
-                // peu importe le resultat on vire le fichier
-                // remove form this list
-                // write => thread concurency issues
-                m_ThumbnailFileDatasToGetMutex.lock();
-                m_ThumbnailFileDatasToGet.pop_front();
-                m_ThumbnailFileDatasToGetMutex.unlock();
+                // we set that at least, because will launch the gpu creation of the texture in the
+                // main thread
+                th->isReadyToUpload = true;
+
+                // need gpu loading
+                m_AddThumbnailToCreate(vFileInfos);
+            } else {
+                delete[] resizedData;
             }
         } else {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            printf("image loading fail : w:%i h:%i c:%i\n", w, h, 4);  //-V112
         }
+
+        stbi_image_free(datas);
     }
 }
 
+uint8_t* IGFD::ThumbnailFeature::m_DecodeJpegExifThumbnail(const std::vector<uint8_t>& vFileDatas, int vMinHeight, int* vWidth, int* vHeight) {
+    const uint8_t* datas = vFileDatas.data();
+    const size_t size = vFileDatas.size();
+    if (size < 4U || datas[0] != 0xFF || datas[1] != 0xD8) {  // SOI
+        return nullptr;
+    }
+
+    // search the APP1 exif segment, who is before the image datas
+    size_t pos = 2U;
+    while (pos + 4U <= size && datas[pos] == 0xFF && datas[pos + 1U] != 0xDA) {  // until SOS
+        const size_t segmentSize = ((size_t)datas[pos + 2U] << 8U) | datas[pos + 3U];
+        if (segmentSize < 2U || pos + 2U + segmentSize > size) {
+            return nullptr;
+        }
+        const uint8_t* segment = datas + pos + 4U;
+        const size_t segmentDatasSize = segmentSize - 2U;
+        if (datas[pos + 1U] == 0xE1 && segmentDatasSize > 14U && !memcmp(segment, "Exif\0\0", 6U)) {
+            // the exif datas is a tiff file : header, IFD0 (main image), IFD1 (thumbnail)
+            const uint8_t* tiff = segment + 6U;
+            const size_t tiffSize = segmentDatasSize - 6U;
+            const bool littleEndian = (tiff[0] == 'I');
+            auto read16 = [tiff, littleEndian](size_t vOffset) -> uint32_t {
+                return littleEndian ? (uint32_t)(tiff[vOffset] | (tiff[vOffset + 1U] << 8U)) : (uint32_t)((tiff[vOffset] << 8U) | tiff[vOffset + 1U]);
+            };
+            auto read32 = [&read16, littleEndian](size_t vOffset) -> uint32_t {
+                return littleEndian ? (read16(vOffset) | (read16(vOffset + 2U) << 16U)) : ((read16(vOffset) << 16U) | read16(vOffset + 2U));
+            };
+            auto nextIFD = [&](size_t vIFDOffset) -> size_t {
+                if (vIFDOffset + 2U > tiffSize)
+                    return 0U;
+                const size_t countEntries = read16(vIFDOffset);
+                const size_t nextOffset = vIFDOffset + 2U + countEntries * 12U;
+                return (nextOffset + 4U <= tiffSize) ? read32(nextOffset) : 0U;
+            };
+            const size_t ifd1 = nextIFD(read32(4U));
+            if (!ifd1 || ifd1 + 2U > tiffSize) {
+                return nullptr;
+            }
+            size_t thumbnailOffset = 0U;
+            size_t thumbnailSize = 0U;
+            const size_t countEntries = read16(ifd1);
+            for (size_t idx = 0U; idx < countEntries && ifd1 + 2U + idx * 12U + 12U <= tiffSize; ++idx) {
+                const size_t entry = ifd1 + 2U + idx * 12U;
+                const uint32_t tag = read16(entry);
+                if (tag == 0x0201) {  // JPEGInterchangeFormat
+                    thumbnailOffset = read32(entry + 8U);
+                } else if (tag == 0x0202) {  // JPEGInterchangeFormatLength
+                    thumbnailSize = read32(entry + 8U);
+                }
+            }
+            if (!thumbnailOffset || !thumbnailSize || thumbnailOffset + thumbnailSize > tiffSize) {
+                return nullptr;
+            }
+
+            // the thumbnail must be big enough, and can't be letterboxed (the ratio must be the ratio of the image)
+            int imageWidth = 0;
+            int imageHeight = 0;
+            int thumbnailWidth = 0;
+            int thumbnailHeight = 0;
+            int chans = 0;
+            if (!stbi_info_from_memory(datas, (int)size, &imageWidth, &imageHeight, &chans) ||
+                !stbi_info_from_memory(tiff + thumbnailOffset, (int)thumbnailSize, &thumbnailWidth, &thumbnailHeight, &chans) || !imageHeight ||
+                !thumbnailHeight || thumbnailHeight < vMinHeight) {
+                return nullptr;
+            }
+            const float imageRatio = (float)imageWidth / (float)imageHeight;
+            const float thumbnailRatio = (float)thumbnailWidth / (float)thumbnailHeight;
+            if (fabs(imageRatio - thumbnailRatio) > imageRatio * 0.02f) {
+                return nullptr;
+            }
+            return stbi_load_from_memory(tiff + thumbnailOffset, (int)thumbnailSize, vWidth, vHeight, &chans, STBI_rgb_alpha);
+        }
+        pos += 2U + segmentSize;
+    }
+    return nullptr;
+}
+
+// cache key : file path name|mtime|size|thumbnail height
+std::string IGFD::ThumbnailFeature::m_GetThumbnailCacheKey(const std::string& vFilePathName, long long vDate, long long vSize) {
+    return vFilePathName + "|" + std::to_string(vDate) + "|" + std::to_string(vSize) + "|" + std::to_string((int)DisplayMode_ThumbailsList_ImageHeight);
+}
+
+// cache file : "IGFDTHB1", key size, key, width, height, rgba datas
+bool IGFD::ThumbnailFeature::m_ReadThumbnailCacheKey(std::ifstream& vFile, std::string& vCacheKey) {
+    if (!vFile.is_open()) {
+        return false;
+    }
+    char magic[8] = {};
+    uint32_t keySize = 0U;
+    vFile.read(magic, 8);
+    vFile.read((char*)&keySize, sizeof(keySize));
+    if (!vFile || memcmp(magic, "IGFDTHB1", 8U) != 0 || keySize > 65536U) {
+        return false;
+    }
+    vCacheKey.assign(keySize, '\0');
+    vFile.read(&vCacheKey[0], keySize);
+    return !vFile.fail();
+}
+
+// an entry is stale when its file was changed or deleted, or when the thumbnail height changed
+bool IGFD::ThumbnailFeature::m_IsThumbnailCacheKeyStale(const std::string& vCacheKey) {
+    size_t pos = vCacheKey.size();
+    for (int i = 0; i < 3; ++i) {
+        if (pos == 0U || (pos = vCacheKey.rfind('|', pos - 1U)) == std::string::npos) {
+            return true;
+        }
+    }
+    const auto fpn = vCacheKey.substr(0, pos);
+    struct stat statInfos = {};
+    return stat(fpn.c_str(), &statInfos) != 0 || m_GetThumbnailCacheKey(fpn, (long long)statInfos.st_mtime, (long long)statInfos.st_size) != vCacheKey;
+}
+
+bool IGFD::ThumbnailFeature::m_ReadThumbnailCache(const std::string& vCacheFile, const std::string& vCacheKey, IGFD_Thumbnail_Info* vThumbnailInfo) {
+    std::ifstream file(vCacheFile, std::ios::in | std::ios::binary);
+    std::string key;
+    int32_t width = 0;
+    int32_t height = 0;
+    if (!m_ReadThumbnailCacheKey(file, key)) {
+        return false;
+    }
+    file.read((char*)&width, sizeof(width));
+    file.read((char*)&height, sizeof(height));
+    // the key is stored for avoid hash collisions
+    if (!file || key != vCacheKey || width <= 0 || height <= 0 || width > 16384 || height > 16384) {
+        return false;
+    }
+    const auto bufSize = (size_t)width * (size_t)height * 4U;  //-V112
+    auto datas = new uint8_t[bufSize];
+    file.read((char*)datas, (std::streamsize)bufSize);
+    if (!file) {
+        delete[] datas;
+        return false;
+    }
+    vThumbnailInfo->textureFileDatas = datas;
+    vThumbnailInfo->textureWidth = width;
+    vThumbnailInfo->textureHeight = height;
+    vThumbnailInfo->textureChannels = 4;  //-V112
+    vThumbnailInfo->isReadyToUpload = true;
+    return true;
+}
+
+void IGFD::ThumbnailFeature::m_WriteThumbnailCache(const std::string& vCacheFile, const std::string& vCacheKey, const IGFD_Thumbnail_Info* vThumbnailInfo) {
+    // written in a temporary file then renamed, so a thread or another process can't read a partial file
+    std::stringstream tmpFile;
+    tmpFile << vCacheFile << "." << std::this_thread::get_id() << ".tmp";
+    {
+        std::ofstream file(tmpFile.str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return;
+        }
+        const auto keySize = (uint32_t)vCacheKey.size();
+        const auto width = (int32_t)vThumbnailInfo->textureWidth;
+        const auto height = (int32_t)vThumbnailInfo->textureHeight;
+        file.write("IGFDTHB1", 8);
+        file.write((const char*)&keySize, sizeof(keySize));
+        file.write(vCacheKey.data(), keySize);
+        file.write((const char*)&width, sizeof(width));
+        file.write((const char*)&height, sizeof(height));
+        file.write((const char*)vThumbnailInfo->textureFileDatas, (std::streamsize)((size_t)width * (size_t)height * 4U));  //-V112
+        if (!file) {
+            file.close();
+            std::remove(tmpFile.str().c_str());
+            return;
+        }
+    }
+    if (std::rename(tmpFile.str().c_str(), vCacheFile.c_str()) != 0) {
+        std::remove(tmpFile.str().c_str());
+        return;
+    }
+    m_PruneThumbnailsCache(8U + sizeof(uint32_t) + vCacheKey.size() + 2U * sizeof(int32_t) +
+                           (size_t)vThumbnailInfo->textureWidth * (size_t)vThumbnailInfo->textureHeight * 4U);  //-V112
+}
+
+// keeps the disk cache under THUMBNAILS_CACHE_MAX_SIZE. the dir is only listed at the first write and when the size
+// goes over the limit : the entries of changed or deleted files are removed, then the oldest ones
+void IGFD::ThumbnailFeature::m_PruneThumbnailsCache(size_t vWrittenSize) {
+#if THUMBNAILS_CACHE_MAX_SIZE > 0
+    std::lock_guard<std::mutex> lock(m_ThumbnailsCacheMutex);
+    m_ThumbnailsCacheSize += vWrittenSize;
+    if (m_ThumbnailsCacheSizeKnown && m_ThumbnailsCacheSize <= (size_t)THUMBNAILS_CACHE_MAX_SIZE) {
+        return;
+    }
+    struct CacheEntry {
+        std::string filePathName;
+        size_t size;
+        time_t date;
+    };
+    std::vector<CacheEntry> entries;
+    size_t totalSize = 0U;
+    FILE_SYSTEM_OVERRIDE fileSystem;
+    for (const auto& infos : fileSystem.ScanDirectory(m_ThumbnailsCacheDir)) {
+        const auto& name = infos.fileNameExt;
+        // the temporary files of the other threads are skipped
+        if (!infos.fileType.isFile() || name.size() < 6U || name.compare(name.size() - 6U, 6U, ".thumb") != 0) {
+            continue;
+        }
+        const auto entryPath = m_ThumbnailsCacheDir + std::string(1u, PATH_SEP) + name;
+        struct stat statInfos = {};
+        if (stat(entryPath.c_str(), &statInfos)) {
+            continue;
+        }
+        std::string key;
+        bool stale = false;
+        {
+            std::ifstream file(entryPath, std::ios::in | std::ios::binary);
+            stale = !m_ReadThumbnailCacheKey(file, key) || m_IsThumbnailCacheKeyStale(key);
+        }
+        if (stale) {
+            std::remove(entryPath.c_str());
+            continue;
+        }
+        entries.push_back({entryPath, (size_t)statInfos.st_size, statInfos.st_mtime});
+        totalSize += (size_t)statInfos.st_size;
+    }
+    // down to 3/4 of the limit, so the dir is not listed again by the next writes
+    if (totalSize > (size_t)THUMBNAILS_CACHE_MAX_SIZE) {
+        std::sort(entries.begin(), entries.end(), [](const CacheEntry& a, const CacheEntry& b) { return a.date < b.date; });
+        for (const auto& entry : entries) {
+            if (totalSize <= (size_t)THUMBNAILS_CACHE_MAX_SIZE / 4U * 3U) {
+                break;
+            }
+            if (!std::remove(entry.filePathName.c_str())) {
+                totalSize -= entry.size;
+            }
+        }
+    }
+    m_ThumbnailsCacheSize = totalSize;
+    m_ThumbnailsCacheSizeKnown = true;
+#else
+    (void)vWrittenSize;
+#endif  // THUMBNAILS_CACHE_MAX_SIZE
+}
+
 void IGFD::ThumbnailFeature::m_VariadicProgressBar(float fraction, const ImVec2& size_arg, const char* fmt, ...) {
     va_list args;
     va_start(args, fmt);
@@ -2920,11 +3668,15 @@ void IGFD::ThumbnailFeature::m_VariadicProgressBar(float fraction, const ImVec2&
 }
 
 void IGFD::ThumbnailFeature::m_DrawThumbnailGenerationProgress() {
-    if (m_ThumbnailGenerationThread.use_count() && m_ThumbnailGenerationThread->joinable()) {
-        if (!m_ThumbnailFileDatasToGet.empty()) {
-            const auto p = (float)((double)m_CountFiles / (double)m_ThumbnailFileDatasToGet.size());  // read => no thread concurency issues
-            m_VariadicProgressBar(p, ImVec2(50, 0), "%u/%u", m_CountFiles,
-                (uint32_t)m_ThumbnailFileDatasToGet.size());  // read => no thread concurency issues
+    if (!m_ThumbnailGenerationThreads.empty()) {
+        // read => thread concurency issues
+        m_ThumbnailFileDatasToGetMutex.lock();
+        const uint32_t countFiles = m_CountFiles;
+        const uint32_t countFilesToGet = m_CountFilesToGet;
+        m_ThumbnailFileDatasToGetMutex.unlock();
+        if (countFiles < countFilesToGet) {
+            const auto p = (float)((double)countFiles / (double)countFilesToGet);
+            m_VariadicProgressBar(p, ImVec2(50, 0), "%u/%u", countFiles, countFilesToGet);
             ImGui::SameLine();
         }
     }
@@ -2937,9 +3689,16 @@ void IGFD::ThumbnailFeature::m_AddThumbnailToLoad(const std::shared_ptr<FileInfo
             if (vFileInfos->SearchForExts(".png,.bmp,.tga,.jpg,.jpeg,.gif,.psd,.pic,.ppm,.pgm", true)) {
                 // write => thread concurency issues
                 m_ThumbnailFileDatasToGetMutex.lock();
-                m_ThumbnailFileDatasToGet.push_back(vFileInfos);
+                if (m_CountFiles == m_CountFilesToGet) {  // the previous files are all done, restart the progress
+                    m_CountFiles = 0U;
+                    m_CountFilesToGet = 0U;
+                }
+                // the files are asked by the visible rows, so the last asked are the more urgent
+                m_ThumbnailFileDatasToGet.push_front(vFileInfos);
+                ++m_CountFilesToGet;
                 vFileInfos->thumbnailInfo.isLoadingOrLoaded = true;
                 m_ThumbnailFileDatasToGetMutex.unlock();
+                m_ThumbnailFileDatasToGetCondition.notify_one();
             }
         }
     }
@@ -2985,6 +3744,12 @@ void IGFD::ThumbnailFeature::m_DrawDisplayModeToolBar() {
 void IGFD::ThumbnailFeature::m_ClearThumbnails(FileDialogInternal& vFileDialogInternal) {
     // directory wil be changed so the file list will be erased
     if (vFileDialogInternal.fileManager.puPathClicked) {
+        // the files not yet started are not needed anymore
+        m_ThumbnailFileDatasToGetMutex.lock();
+        m_CountFilesToGet -= (uint32_t)m_ThumbnailFileDatasToGet.size();
+        m_ThumbnailFileDatasToGet.clear();
+        m_ThumbnailFileDatasToGetMutex.unlock();
+
         size_t count = vFileDialogInternal.fileManager.GetFullFileListSize();
         for (size_t idx = 0U; idx < count; idx++) {
             auto file = vFileDialogInternal.fileManager.GetFullFileAt(idx);
@@ -3006,17 +3771,30 @@ void IGFD::ThumbnailFeature::SetDestroyThumbnailCallback(const DestroyThumbnailF
     m_DestroyThumbnailFun = vCreateThumbnailFun;
 }
 
+void IGFD::ThumbnailFeature::SetThumbnailsCacheDir(const std::string& vCacheDir) {
+    // the threads read it without lock
+    const bool wasWorking = m_StopThumbnailFileDatasExtraction();
+    m_ThumbnailsCacheDir = vCacheDir;
+    if (wasWorking) {
+        m_StartThumbnailFileDatasExtraction();
+    }
+}
+
+const std::string& IGFD::ThumbnailFeature::GetThumbnailsCacheDir() const {
+    return m_ThumbnailsCacheDir;
+}
+
 void IGFD::ThumbnailFeature::ManageGPUThumbnails() {
     if (m_CreateThumbnailFun) {
-        if (!m_ThumbnailToCreate.empty()) {
-            for (const auto& file : m_ThumbnailToCreate) {
-                if (file.use_count()) {
-                    m_CreateThumbnailFun(&file->thumbnailInfo);
-                }
+        // the decoding threads can add files while we create the textures
+        std::list<std::shared_ptr<FileInfos>> thumbnailToCreate;
+        m_ThumbnailToCreateMutex.lock();
+        thumbnailToCreate.swap(m_ThumbnailToCreate);
+        m_ThumbnailToCreateMutex.unlock();
+        for (const auto& file : thumbnailToCreate) {
+            if (file.use_count()) {
+                m_CreateThumbnailFun(&file->thumbnailInfo);
             }
-            m_ThumbnailToCreateMutex.lock();
-            m_ThumbnailToCreate.clear();
-            m_ThumbnailToCreateMutex.unlock();
         }
     } else {
         printf(
@@ -3025,13 +3803,12 @@ void IGFD::ThumbnailFeature::ManageGPUThumbnails() {
     }
 
     if (m_DestroyThumbnailFun) {
-        if (!m_ThumbnailToDestroy.empty()) {
-            for (auto thumbnail : m_ThumbnailToDestroy) {
-                m_DestroyThumbnailFun(&thumbnail);
-            }
-            m_ThumbnailToDestroyMutex.lock();
-            m_ThumbnailToDestroy.clear();
-            m_ThumbnailToDestroyMutex.unlock();
+        std::list<IGFD_Thumbnail_Info> thumbnailToDestroy;
+        m_ThumbnailToDestroyMutex.lock();
+        thumbnailToDestroy.swap(m_ThumbnailToDestroy);
+        m_ThumbnailToDestroyMutex.unlock();
+        for (auto thumbnail : thumbnailToDestroy) {
+            m_DestroyThumbnailFun(&thumbnail);
         }
     } else {
         printf(
@@ -3985,7 +4762,7 @@ bool IGFD::FileDialog::Display(const std::string& vKey, ImGuiWindowFlags vFlags,
                 fdFilter.SetDefaultFilterIfNotDefined();
 
                 // init list of files
-                if (fdFile.IsFileListEmpty() && !fdFile.showDrives) {
+                if (fdFile.IsFileListEmpty() && !fdFile.showDrives && !fdFile.IsScanDirStarted()) {
                     if (fdFile.dLGpath != ".")  // Removes extension seperator in filename if we don't check
                         IGFD::Utils::ReplaceString(fdFile.dLGDefaultFileName, fdFile.dLGpath, "");  // local path
 
@@ -3997,6 +4774,9 @@ bool IGFD::FileDialog::Display(const std::string& vKey, ImGuiWindowFlags vFlags,
                     fdFile.ScanDir(m_FileDialogInternal, fdFile.dLGpath);
                 }
 
+                // add the files found since the last frame
+                fdFile.UpdateScanDir(m_FileDialogInternal);
+
                 // draw dialog parts
                 m_DrawHeader();        // bookmark, directory, path
                 m_DrawContent();       // bookmark, files view, side pane
@@ -4077,6 +4857,8 @@ void IGFD::FileDialog::m_DrawHeader() {
     }
 #endif  // USE_THUMBNAILS
 
+    m_FileDialogInternal.fileManager.DrawScanDirProgress();
+
     m_FileDialogInternal.searchManager.DrawSearchBar(m_FileDialogInternal);
 }
 
@@ -4550,6 +5332,8 @@ void IGFD::FileDialog::m_DrawFileListView(ImVec2 vSize) {
                     if (!infos.use_count())
                         continue;
 
+                    fdi.CompleteFileInfos(infos);  // only the visible rows need the size and date
+
                     m_BeginFileColorIconStyle(infos, _showColor, _str, &_font);
 
                     bool selected = fdi.IsFileNameSelected(infos->fileNameExt);  // found
@@ -4756,6 +5540,8 @@ void IGFD::FileDialog::m_DrawThumbnailsListView(ImVec2 vSize) {
                     if (!infos.use_count())
                         continue;
 
+                    fdi.CompleteFileInfos(infos);  // only the visible rows need the size and date
+
                     m_BeginFileColorIconStyle(infos, _showColor, _str, &_font);
 
                     bool selected = fdi.IsFileNameSelected(infos->fileNameExt);  // found
@@ -1001,6 +1001,13 @@ by ex for android, emscripten, or boost
 
 you can check the DemoApp who is using an override for the Boost::filesystem
 
+the directory scan is done in a thread, the files are shown as soon as found.
+the thread call IFileSystem::ScanDirectoryEntries, who call ScanDirectory by default.
+you can override it for give the entries one by one (like the Dirent interface on linux),
+it will be called from the scan thread, so it must be thread safe
+when the files are sorted by size or date, the scan thread retrieve them too (with stat), the ui thread
+retrieve only the ones of the files found before, by chunks of SCAN_DIR_MAX_DETAILS_PER_FRAME per frame
+
 ################################################################
 ## How to Integrate ImGuiFileDialog in your project
 ################################################################
@@ -1284,8 +1291,11 @@ struct IGFD_Thumbnail_Info {
 #include <regex>
 #include <array>
 #include <mutex>
+#include <atomic>
+#include <condition_variable>
 #include <thread>
 #include <cfloat>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -1343,6 +1353,22 @@ struct IGFD_Thumbnail_Info {
 #define EXT_MAX_LEVEL 10U
 #endif  // EXT_MAX_LEVEL
 
+#ifndef SCAN_DIR_BATCH_SIZE
+#define SCAN_DIR_BATCH_SIZE 512U  // count of entries the scan thread accumulates before handing them to the ui thread
+#endif  // SCAN_DIR_BATCH_SIZE
+
+#ifndef SCAN_DIR_MAX_ENTRIES_PER_FRAME
+#define SCAN_DIR_MAX_ENTRIES_PER_FRAME 8192U  // max count of scanned entries added to the file list per frame
+#endif  // SCAN_DIR_MAX_ENTRIES_PER_FRAME
+
+#ifndef SCAN_DIR_MAX_DETAILS_PER_FRAME
+#define SCAN_DIR_MAX_DETAILS_PER_FRAME 1024U  // max count of files whose size and date are retrieved by the ui thread per frame
+#endif  // SCAN_DIR_MAX_DETAILS_PER_FRAME
+
+#ifndef SORT_PARALLEL_MIN_ENTRIES
+#define SORT_PARALLEL_MIN_ENTRIES 65536U  // min count of entries of a file list for sort it on many threads
+#endif  // SORT_PARALLEL_MIN_ENTRIES
+
 #pragma endregion
 
 #pragma region IGFD NAMESPACE
@@ -1612,7 +1638,9 @@ public:
     size_t fileSize = 0U;                                            // for sorting operations
     std::string formatedFileSize;                                    // file size formated (10 o, 10 ko, 10 mo, 10 go)
     std::string fileModifDate;                                       // file user defined format of the date (data + time by default)
+    int64_t fileModifTime = 0;                                       // time of the last modification, for sorting operations
     std::shared_ptr<FileStyle> fileStyle = nullptr;                  // style of the file
+    bool isDetailsCompleted = false;                                 // size and date was retrieved (done lazily, see FileManager::CompleteFileInfos)
 #ifdef USE_THUMBNAILS
     IGFD_Thumbnail_Info thumbnailInfo;  // structre for the display for image file tetxure
 #endif                                  // USE_THUMBNAILS
@@ -1647,6 +1675,17 @@ public:
     virtual IGFD::Utils::PathStruct ParsePathFileName(const std::string& vPathFileName) = 0;
     // will return a list of files inside a path
     virtual std::vector<IGFD::FileInfos> ScanDirectory(const std::string& vPath) = 0;
+    // will call vEntryFunc for each file inside a path, as soon as found. stop the scan if vEntryFunc return false
+    // called from the scan thread, so it must not touch any state shared with the ui thread
+    // return false if the scan was stopped
+    virtual bool ScanDirectoryEntries(const std::string& vPath, const std::function<bool(const std::string&, const IGFD::FileType&)>& vEntryFunc) {
+        for (const auto& file : ScanDirectory(vPath)) {
+            if (!vEntryFunc(file.fileNameExt, file.fileType)) {
+                return false;
+            }
+        }
+        return true;
+    }
     // say if the path is well a directory
     virtual bool IsDirectory(const std::string& vFilePathName) = 0;
     // return a drive list on windows, bu can be used on android or linux for give to the suer a list of root dir
@@ -1668,6 +1707,86 @@ public:                            // types
         FIELD_THUMBNAILS,          // sorted by thumbnails (comparaison by width then by height)
     };
 
+    // flat copy of the fields used for sort and filter a file list, one row per file, in the order of the file list
+    // the rows are compared and searched without following the shared_ptr of each file, and are never moved :
+    // the sorting is only the order of the rows in sortedRows
+    struct FileListArena {
+        std::vector<char> names;            // file names, '\0' terminated, in the order of the rows
+        std::vector<char> namesLowerCase;   // file names in lower case, at the same offsets than in names
+        std::vector<char> exts;             // file extentions (first level), '\0' terminated
+        std::vector<uint32_t> nameOffsets;  // offset of the name of a row in names and namesLowerCase
+        std::vector<uint32_t> extOffsets;   // offset of the extention of a row in exts
+        std::vector<uint64_t> nameKeys;     // 8 first chars of the lower case name
+        std::vector<uint64_t> extKeys;      // 8 first chars of the extention
+        std::vector<int8_t> types;          // content type of the file, in the sort order of FileType
+        std::vector<size_t> sizes;          // file size, valid only when the details of the file was completed
+        std::vector<int64_t> dates;         // file modification time, valid only when the details of the file was completed
+        std::vector<uint32_t> sortedRows;   // the rows in the order of the sorting, a new row is added at the end
+        size_t generation = 1U;             // changed by each modification, for know if a filtered list is outdated
+
+        size_t size() const;
+        void clear();
+        void add(const FileInfos& vInfos);                          // add a row at the end
+        void setDetails(size_t vRow, const FileInfos& vInfos);      // update size and date of a row
+    };
+
+    // rows of a file list kept by the search, in the order of the sorting
+    struct FilteredFileList {
+        std::vector<uint32_t> rows;  // rows of the file list and of its arena
+        std::string searchTag;       // search tag of this filtering, the next filtering can start from rows if it contains it
+        size_t generation = 0U;      // generation of the arena filtered, 0 => never filtered
+    };
+
+    // a row with the first criterias of its order, so most of the comparisons of a sort don't read the arena
+    struct SortingItem {
+        uint64_t keys[2];  // file type, then the start of the sorting field
+        uint32_t row;
+    };
+
+    // compare two rows of a file list by the sorting field
+    struct FileListComparator {
+        const FileListArena* arena = nullptr;
+        const std::vector<std::shared_ptr<FileInfos>>* list = nullptr;  // only for the thumbnails sizes
+        SortingFieldEnum field = SortingFieldEnum::FIELD_NONE;
+        bool ascending = true;
+
+        bool less(uint32_t vRowA, uint32_t vRowB) const;
+        SortingItem getItem(uint32_t vRow) const;  // items with the same keys must be compared by their rows
+        bool operator()(uint32_t vRowA, uint32_t vRowB) const {
+            return ascending ? less(vRowA, vRowB) : less(vRowB, vRowA);
+        }
+        bool operator()(const SortingItem& vItemA, const SortingItem& vItemB) const {
+            if (vItemA.keys[0] != vItemB.keys[0])
+                return ascending ? vItemA.keys[0] < vItemB.keys[0] : vItemA.keys[0] > vItemB.keys[0];
+            if (vItemA.keys[1] != vItemB.keys[1])
+                return ascending ? vItemA.keys[1] < vItemB.keys[1] : vItemA.keys[1] > vItemB.keys[1];
+            return (*this)(vItemA.row, vItemB.row);
+        }
+    };
+
+    // an entry found by the scan thread, with its size and date when the sorting need them
+    struct ScanDirEntry {
+        std::string fileName;
+        FileType fileType;
+        bool isDetailsCompleted = false;  // the scan thread tried to retrieve size and date
+        bool isDetailsValid = false;      // size and date was retrieved
+        size_t fileSize = 0U;
+        int64_t fileModifTime = 0;
+    };
+
+    // state shared between the ui thread and the scan thread of one directory
+    // a scan thread keep a ref on it, so a cancelled scan can finish without blocking the ui
+    struct ScanDirState {
+        std::string path;                                                 // path to scan
+        std::string filesPath;                                            // path of the files found, for retrieve their size and date
+        std::atomic<bool> cancelled{false};                               // the ui ask to stop the scan
+        std::atomic<bool> working{true};                                  // the scan thread is running
+        std::atomic<bool> needDetails{false};                             // sorted by size or date, the scan thread retrieve them
+        std::atomic<size_t> countEntries{0U};                             // count entries found by the scan thread
+        std::mutex entriesMutex;                                          // lock entries
+        std::vector<ScanDirEntry> entries;                                // entries found, waiting to be added to the file list
+    };
+
 #ifdef NEED_TO_BE_PUBLIC_FOR_TESTS
 public:
 #else
@@ -1675,16 +1794,27 @@ private:
 #endif
     std::string m_CurrentPath;                                   // current path (to be decomposed in m_CurrentPathDecomposition
     std::vector<std::string> m_CurrentPathDecomposition;         // part words
-    std::vector<std::shared_ptr<FileInfos>> m_FileList;          // base container
-    std::vector<std::shared_ptr<FileInfos>> m_FilteredFileList;  // filtered container (search, sorting, etc..)
+    std::vector<std::shared_ptr<FileInfos>> m_FileList;          // base container, in the order of the scan
+    FileListArena m_FileArena;                                   // sort and search datas of m_FileList
+    FilteredFileList m_FilteredFileList;                         // filtered container (search, sorting, etc..)
     std::vector<std::shared_ptr<FileInfos>> m_PathList;          // base container for path selection
-    std::vector<std::shared_ptr<FileInfos>> m_FilteredPathList;  // filtered container for path selection (search, sorting, etc..)
+    FileListArena m_PathArena;                                   // sort and search datas of m_PathList
+    FilteredFileList m_FilteredPathList;                         // filtered container for path selection (search, sorting, etc..)
     std::vector<std::string>::iterator m_PopupComposedPath;      // iterator on m_CurrentPathDecomposition for Current Path popup
     std::string m_LastSelectedFileName;                          // for shift multi selection
     std::set<std::string> m_SelectedFileNames;                   // the user selection of FilePathNames
     bool m_CreateDirectoryMode = false;                          // for create directory widget
     std::string m_FileSystemName;
     std::unique_ptr<IFileSystem> m_FileSystemPtr = nullptr;
+    std::shared_ptr<ScanDirState> m_ScanDirState = nullptr;                  // state of the current directory scan
+    std::thread m_ScanDirThread;                                             // current directory scan thread
+    std::string m_ScanDirPath;                                               // path of the files added by the current scan
+    std::vector<std::pair<std::thread, std::shared_ptr<ScanDirState>>> m_CancelledScanDirThreads;  // cancelled scans, joined when finished
+    std::vector<ScanDirEntry> m_ScanDirEntries;                              // entries fetched from the scan thread, not yet added
+    size_t m_ScanDirEntriesIdx = 0U;                                         // next entry of m_ScanDirEntries to add
+    size_t m_CountScannedEntries = 0U;                                       // count of entries added to the file list for the current scan
+    std::vector<uint32_t> m_PendingDetailsRows;                              // rows of m_FileList without size and date, sorted on them when all retrieved
+    size_t m_PendingDetailsIdx = 0U;                                         // next row of m_PendingDetailsRows to complete
 
 public:
     bool inputPathActivated = false;                             // show input for path edition
@@ -1724,6 +1854,8 @@ private:
     static std::string m_RoundNumber(double vvalue, int n);                        // custom rounding number
     static std::string m_FormatFileSize(size_t vByteSize);                         // format file size field
     static void m_CompleteFileInfos(const std::shared_ptr<FileInfos>& FileInfos);  // set time and date infos of a file (detail view mode)
+    static bool m_GetFileDetails(const std::string& vFilePathName, bool vIsDir, size_t* vOutSize, int64_t* vOutModifTime);  // stat a file, thread safe
+    static void m_SetFileDetails(FileInfos& vInfos, size_t vSize, int64_t vModifTime);  // set and format the size and date of a file
     void m_RemoveFileNameInSelection(const std::string& vFileName);                // selection : remove a file name
     void m_m_AddFileNameInSelection(const std::string& vFileName, bool vSetLastSelectionFileName);  // selection : add a file name
     void m_AddFile(const FileDialogInternal& vFileDialogInternal,
@@ -1740,14 +1872,24 @@ private:
         std::vector<std::string>::iterator vPathIter);  // open the popup list of paths
     void m_SetCurrentPath(std::vector<std::string>::iterator vPathIter);  // set the current path, update the path bar
     void m_ApplyFilteringOnFileList(const FileDialogInternal& vFileDialogInternal,
-        std::vector<std::shared_ptr<FileInfos>>& vFileInfosList,
-        std::vector<std::shared_ptr<FileInfos>>& vFileInfosFilteredList);
+        const FileListArena& vFileListArena,
+        FilteredFileList& vFileInfosFilteredList);  // narrow the last filtering when the search tag was only extended
     void m_SortFields(const FileDialogInternal& vFileDialogInternal,
-        std::vector<std::shared_ptr<FileInfos>>& vFileInfosList,
-        std::vector<std::shared_ptr<FileInfos>>& vFileInfosFilteredList);  // will sort a column
+        const std::vector<std::shared_ptr<FileInfos>>& vFileInfosList,
+        FileListArena& vFileListArena,
+        FilteredFileList& vFileInfosFilteredList);  // will sort a column
+    FileListComparator m_GetSortingComparator(const std::vector<std::shared_ptr<FileInfos>>& vFileInfosList,
+        const FileListArena& vFileListArena) const;  // comparator of the current sorting field
+    static void m_SortRows(std::vector<uint32_t>& vRows, const FileListComparator& vComparator);  // sort on many threads if big
+    static void m_SortItemsInThreads(std::vector<SortingItem>& vItems, const FileListComparator& vComparator, size_t vCountThreads);
+    void m_StopScanDir();                                                  // cancel the current directory scan, without waiting it
+    void m_JoinFinishedScanDirThreads(bool vWaitAll);                      // join the cancelled scan threads who are finished
+    static void m_ThreadScanDirFunc(IFileSystem* vFileSystemPtr, std::shared_ptr<ScanDirState> vState);  // scan thread
+    void m_UpdatePendingDetails(const FileDialogInternal& vFileDialogInternal);  // complete some pending rows, sort when all are done
 
 public:
     FileManager();
+    ~FileManager();
     bool IsComposerEmpty();
     size_t GetComposerSize();
     bool IsFileListEmpty();
@@ -1783,7 +1925,12 @@ public:
         const std::shared_ptr<FileInfos>& vInfos);  // select filename
     void SetCurrentDir(const std::string& vPath);   // define current directory for scan
     void ScanDir(const FileDialogInternal& vFileDialogInternal,
-        const std::string& vPath);  // scan the directory for retrieve the file list
+        const std::string& vPath);  // scan the directory for retrieve the file list, in a thread
+    bool UpdateScanDir(const FileDialogInternal& vFileDialogInternal);  // add the scanned entries to the file list, to call each frame
+    bool IsScanDirStarted();                                  // a scan was started since the last clear of the file list
+    bool IsScanDirWorking();                                  // the scan of the current directory is not finished
+    bool IsFileDetailsPending();                              // a sorting by size or date wait for the details of some files
+    void CompleteFileInfos(const std::shared_ptr<FileInfos>& vInfos);  // retrieve size and date of a file if not done (for visible rows)
 
     std::string GetResultingPath();
     std::string GetResultingFileName(FileDialogInternal& vFileDialogInternal, IGFD_ResultMode vFlag);
@@ -1792,6 +1939,7 @@ public:
 
     void DrawDirectoryCreation(const FileDialogInternal& vFileDialogInternal);  // draw directory creation widget
     void DrawPathComposer(const FileDialogInternal& vFileDialogInternal); 
+    void DrawScanDirProgress();                                                 // draw the progress of the directory scan
 
     IFileSystem* GetFileSystemInstance() {
         return m_FileSystemPtr.get();
@@ -1879,11 +2027,17 @@ protected:
     enum class DisplayModeEnum { FILE_LIST = 0, THUMBNAILS_LIST, THUMBNAILS_GRID };
 
 private:
-    uint32_t m_CountFiles = 0U;
-    bool m_IsWorking = false;
-    std::shared_ptr<std::thread> m_ThumbnailGenerationThread = nullptr;
-    std::list<std::shared_ptr<FileInfos>> m_ThumbnailFileDatasToGet;  // base container
-    std::mutex m_ThumbnailFileDatasToGetMutex;
+    uint32_t m_CountFiles = 0U;                                          // count of thumbnails done since the queue was empty
+    uint32_t m_CountFilesToGet = 0U;                                     // count of thumbnails asked since the queue was empty
+    bool m_IsWorking = false;                                            // the threads must continue to wait for files
+    std::vector<std::thread> m_ThumbnailGenerationThreads;               // the pool of decoding threads
+    std::list<std::shared_ptr<FileInfos>> m_ThumbnailFileDatasToGet;    // last asked first, so the visible rows are done first
+    std::mutex m_ThumbnailFileDatasToGetMutex;                           // lock the 4 above members
+    std::condition_variable m_ThumbnailFileDatasToGetCondition;          // wake a thread when a file is added or when stopping
+    std::string m_ThumbnailsCacheDir;                                    // thumbnails disk cache, disabled if empty
+    size_t m_ThumbnailsCacheSize = 0U;                                   // size of the disk cache entries
+    bool m_ThumbnailsCacheSizeKnown = false;                             // the cache dir was listed once
+    std::mutex m_ThumbnailsCacheMutex;                                   // lock the 2 above members
     std::list<std::shared_ptr<FileInfos>> m_ThumbnailToCreate;  // base container
     std::mutex m_ThumbnailToCreateMutex;
     std::list<IGFD_Thumbnail_Info> m_ThumbnailToDestroy;  // base container
@@ -1897,12 +2051,20 @@ protected:
 
 private:
     void m_VariadicProgressBar(float fraction, const ImVec2& size_arg, const char* fmt, ...);
+    void m_LoadThumbnailFileDatas(const std::shared_ptr<FileInfos>& vFileInfos);  // decode, resize and cache a thumbnail
+    static uint8_t* m_DecodeJpegExifThumbnail(const std::vector<uint8_t>& vFileDatas, int vMinHeight, int* vWidth, int* vHeight);
+    static std::string m_GetThumbnailCacheKey(const std::string& vFilePathName, long long vDate, long long vSize);
+    static bool m_ReadThumbnailCacheKey(std::ifstream& vFile, std::string& vCacheKey);
+    static bool m_IsThumbnailCacheKeyStale(const std::string& vCacheKey);
+    static bool m_ReadThumbnailCache(const std::string& vCacheFile, const std::string& vCacheKey, IGFD_Thumbnail_Info* vThumbnailInfo);
+    void m_WriteThumbnailCache(const std::string& vCacheFile, const std::string& vCacheKey, const IGFD_Thumbnail_Info* vThumbnailInfo);
+    void m_PruneThumbnailsCache(size_t vWrittenSize);  // keep the disk cache under THUMBNAILS_CACHE_MAX_SIZE
 
 protected:
     // will be call in cpu zone (imgui computations, will call a texture file retrieval thread)
-    void m_StartThumbnailFileDatasExtraction();                               // start the thread who will get byte buffer from image files
-    bool m_StopThumbnailFileDatasExtraction();                                // stop the thread who will get byte buffer from image files
-    void m_ThreadThumbnailFileDatasExtractionFunc();                          // the thread who will get byte buffer from image files
+    void m_StartThumbnailFileDatasExtraction();                               // start the threads who will get byte buffer from image files
+    bool m_StopThumbnailFileDatasExtraction();                                // stop the threads who will get byte buffer from image files
+    void m_ThreadThumbnailFileDatasExtractionFunc();                          // a thread who will get byte buffer from image files
     void m_DrawThumbnailGenerationProgress();                                 // a little progressbar who will display the texture gen status
     void m_AddThumbnailToLoad(const std::shared_ptr<FileInfos>& vFileInfos);  // add texture to load in the thread
     void m_AddThumbnailToCreate(const std::shared_ptr<FileInfos>& vFileInfos);
@@ -1913,6 +2075,8 @@ protected:
 public:
     void SetCreateThumbnailCallback(const CreateThumbnailFun& vCreateThumbnailFun);
     void SetDestroyThumbnailCallback(const DestroyThumbnailFun& vCreateThumbnailFun);
+    void SetThumbnailsCacheDir(const std::string& vCacheDir);  // directory of the thumbnails disk cache, empty for disable it
+    const std::string& GetThumbnailsCacheDir() const;
 
     // must be call in gpu zone (rendering, possibly one rendering thread)
     void ManageGPUThumbnails();  // in gpu rendering zone, whill create or destroy texture
@@ -28,6 +28,12 @@
 //#define DONT_DEFINE_AGAIN__STB_IMAGE_RESIZE_IMPLEMENTATION
 //#define IMGUI_RADIO_BUTTON RadioButton
 //#define DisplayMode_ThumbailsList_ImageHeight 32.0f
+// count of thumbnails decoding threads, 0 for the count of hardware threads - 1 (max 4)
+//#define THUMBNAILS_THREADS_COUNT 0
+// sub directory of ImGuiHelper::getCacheDir() for the thumbnails disk cache
+//#define THUMBNAILS_CACHE_DIR_NAME "ImGuiFileDialog"
+// max size in bytes of the thumbnails disk cache, the oldest entries are removed above it, 0 for no limit
+//#define THUMBNAILS_CACHE_MAX_SIZE (64U * 1024U * 1024U)
 //#define tableHeaderFileThumbnailsString "Thumbnails"
 //#define DisplayMode_FilesList_ButtonString "FL"
 //#define DisplayMode_FilesList_ButtonHelp "File List"
@@ -3,35 +3,1194 @@
 #include <string>
 #include <regex>
 #include <cmath>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include "TextEditor.h"
 
-#define IMGUI_DEFINE_MATH_OPERATORS
-#include "imgui.h" // for imGui::GetCurrentWindow()
-#include "imgui_internal.h"
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.h" // for imGui::GetCurrentWindow()
+#include "imgui_internal.h"
+
+#ifndef isascii
+#define isascii(a) ((unsigned)(a) < 128)
+#endif
+
+#if defined(IMGUI_ENABLE_SSE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define TEXTEDITOR_SSE2
+#endif
+
+// TODO
+// - multiline comments vs single-line: latter is blocking start of a ML
+
+// Size of the add buffers, larger insertions get a buffer of their own
+static const size_t kAddBufferSize = 64 * 1024;
+
+TextEditor::Document::Document()
+	: mRoot(0)
+	, mSeed(0x9E3779B9u)
+	, mMapped(false)
+	, mMappedSize(0)
+	, mVersion(0)
+{
+	Clear();
+}
+
+TextEditor::Document::~Document()
+{
+	Clear();
+}
+
+void TextEditor::Document::Clear()
+{
+	for (size_t i = 0; i < mBuffers.size(); ++i)
+	{
+		if (i == 0 && mMapped)
+		{
+#ifdef _WIN32
+			UnmapViewOfFile(mBuffers[0].mData);
+#else
+			munmap(mBuffers[0].mData, mMappedSize);
+#endif
+		}
+		else
+			free(mBuffers[i].mData);
+	}
+	mBuffers.resize(1);
+	mBuffers[0] = Buffer();
+	mNodes.resize(1);
+	mNodes[0] = Node();
+	mFreeNodes.clear();
+	mRoot = 0;
+	mMapped = false;
+	mMappedSize = 0;
+	++mVersion;
+}
+
+void TextEditor::Document::SetText(const char* aText, size_t aSize)
+{
+	Clear();
+	Buffer& buffer = mBuffers[0];
+	if (aSize > 0)
+	{
+		buffer.mData = (char*)malloc(aSize);
+		memcpy(buffer.mData, aText, aSize);
+		buffer.mSize = buffer.mCapacity = aSize;
+		IndexBuffer(buffer, 0);
+		mRoot = NewNode(0, 0, aSize);
+	}
+}
+
+// The file is mapped as the original text and never written, edits stay in memory.
+// Changes made to the file by other processes while it is open may show up in the document.
+bool TextEditor::Document::Open(const char* aPath)
+{
+	char* data = nullptr;
+	size_t size = 0;
+#ifdef _WIN32
+	HANDLE file = CreateFileA(aPath, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize))
+	{
+		CloseHandle(file);
+		return false;
+	}
+	size = (size_t)fileSize.QuadPart;
+	if (size > 0)
+	{
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping != nullptr)
+		{
+			data = (char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+		}
+	}
+	CloseHandle(file);
+#else
+	int file = open(aPath, O_RDONLY);
+	if (file < 0)
+		return false;
+	struct stat st;
+	if (fstat(file, &st) != 0)
+	{
+		close(file);
+		return false;
+	}
+	size = (size_t)st.st_size;
+	if (size > 0)
+	{
+		void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+		if (mapping != MAP_FAILED)
+			data = (char*)mapping;
+	}
+	close(file);
+#endif
+	if (size > 0 && data == nullptr)
+		return false;
+
+	Clear();
+	Buffer& buffer = mBuffers[0];
+	buffer.mData = data;
+	buffer.mSize = buffer.mCapacity = size;
+	mMapped = size > 0;
+	mMappedSize = size;
+	if (size > 0)
+	{
+		IndexBuffer(buffer, 0);
+		mRoot = NewNode(0, 0, size);
+	}
+	return true;
+}
+
+void TextEditor::Document::IndexBuffer(Buffer& aBuffer, size_t aFrom)
+{
+	const char* data = aBuffer.mData;
+	for (const char* p = data + aFrom, *end = data + aBuffer.mSize; p < end; ++p)
+	{
+		p = (const char*)memchr(p, '\n', end - p);
+		if (p == nullptr)
+			break;
+		aBuffer.mLineBreaks.push_back(p - data);
+	}
+}
+
+void TextEditor::Document::Append(const char* aText, size_t aSize, int* aBuffer, size_t* aStart)
+{
+	if (mBuffers.size() == 1 || mBuffers.back().mCapacity - mBuffers.back().mSize < aSize)
+	{
+		Buffer buffer;
+		buffer.mCapacity = ImMax(kAddBufferSize, aSize);
+		buffer.mData = (char*)malloc(buffer.mCapacity);
+		mBuffers.push_back(std::move(buffer));
+	}
+	Buffer& buffer = mBuffers.back();
+	memcpy(buffer.mData + buffer.mSize, aText, aSize);
+	*aBuffer = (int)mBuffers.size() - 1;
+	*aStart = buffer.mSize;
+	buffer.mSize += aSize;
+	IndexBuffer(buffer, *aStart);
+}
+
+int TextEditor::Document::NewNode(int aBuffer, size_t aStart, size_t aLength)
+{
+	int node;
+	if (!mFreeNodes.empty())
+	{
+		node = mFreeNodes.back();
+		mFreeNodes.pop_back();
+	}
+	else
+	{
+		node = (int)mNodes.size();
+		mNodes.push_back(Node());
+	}
+	// xorshift priorities keep the tree balanced on average
+	mSeed ^= mSeed << 13;
+	mSeed ^= mSeed >> 17;
+	mSeed ^= mSeed << 5;
+	Node& n = mNodes[node];
+	n.mLeft = n.mRight = 0;
+	n.mPriority = mSeed;
+	n.mBuffer = aBuffer;
+	SetPiece(node, aStart, aLength);
+	Update(node);
+	return node;
+}
+
+void TextEditor::Document::FreeNodes(int aNode)
+{
+	if (aNode == 0)
+		return;
+	FreeNodes(mNodes[aNode].mLeft);
+	FreeNodes(mNodes[aNode].mRight);
+	mFreeNodes.push_back(aNode);
+}
+
+void TextEditor::Document::SetPiece(int aNode, size_t aStart, size_t aLength)
+{
+	Node& n = mNodes[aNode];
+	const std::vector<size_t>& breaks = mBuffers[n.mBuffer].mLineBreaks;
+	const size_t first = std::lower_bound(breaks.begin(), breaks.end(), aStart) - breaks.begin();
+	const size_t last = std::lower_bound(breaks.begin() + first, breaks.end(), aStart + aLength) - breaks.begin();
+	n.mStart = aStart;
+	n.mLength = aLength;
+	n.mFirstBreak = first;
+	n.mBreaks = last - first;
+}
+
+void TextEditor::Document::Update(int aNode)
+{
+	Node& n = mNodes[aNode];
+	const Node& left = mNodes[n.mLeft];
+	const Node& right = mNodes[n.mRight];
+	n.mTotalLength = left.mTotalLength + n.mLength + right.mTotalLength;
+	n.mTotalBreaks = left.mTotalBreaks + n.mBreaks + right.mTotalBreaks;
+}
+
+// Splits the tree in the first aOffset bytes and the rest, cutting the piece that holds aOffset in two
+void TextEditor::Document::Split(int aNode, size_t aOffset, int& aLeft, int& aRight)
+{
+	if (aNode == 0)
+	{
+		aLeft = aRight = 0;
+		return;
+	}
+	const size_t leftLength = mNodes[mNodes[aNode].mLeft].mTotalLength;
+	const size_t length = mNodes[aNode].mLength;
+	if (aOffset <= leftLength)
+	{
+		int left, right;
+		Split(mNodes[aNode].mLeft, aOffset, left, right);
+		mNodes[aNode].mLeft = right;
+		Update(aNode);
+		aLeft = left;
+		aRight = aNode;
+	}
+	else if (aOffset >= leftLength + length)
+	{
+		int left, right;
+		Split(mNodes[aNode].mRight, aOffset - leftLength - length, left, right);
+		mNodes[aNode].mRight = left;
+		Update(aNode);
+		aLeft = aNode;
+		aRight = right;
+	}
+	else
+	{
+		// the tail gets a priority of its own, pieces cut many times would otherwise make a list of equal priorities
+		const size_t cut = aOffset - leftLength;
+		const int tail = NewNode(mNodes[aNode].mBuffer, mNodes[aNode].mStart + cut, length - cut);
+		Node& n = mNodes[aNode];
+		const int right = n.mRight;
+		n.mRight = 0;
+		SetPiece(aNode, n.mStart, cut);
+		Update(aNode);
+		aLeft = aNode;
+		aRight = Merge(tail, right);
+	}
+}
+
+int TextEditor::Document::Merge(int aLeft, int aRight)
+{
+	if (aLeft == 0)
+		return aRight;
+	if (aRight == 0)
+		return aLeft;
+	if (mNodes[aLeft].mPriority > mNodes[aRight].mPriority)
+	{
+		const int right = Merge(mNodes[aLeft].mRight, aRight);
+		mNodes[aLeft].mRight = right;
+		Update(aLeft);
+		return aLeft;
+	}
+	const int left = Merge(aLeft, mNodes[aRight].mLeft);
+	mNodes[aRight].mLeft = left;
+	Update(aRight);
+	return aRight;
+}
+
+// Grows the last piece of the tree when the bytes follow it in the same buffer, as when typing
+bool TextEditor::Document::ExtendLast(int aNode, int aBuffer, size_t aStart, size_t aLength)
+{
+	if (aNode == 0)
+		return false;
+	Node& n = mNodes[aNode];
+	if (n.mRight != 0)
+	{
+		if (!ExtendLast(n.mRight, aBuffer, aStart, aLength))
+			return false;
+	}
+	else
+	{
+		if (n.mBuffer != aBuffer || n.mStart + n.mLength != aStart)
+			return false;
+		SetPiece(aNode, n.mStart, n.mLength + aLength);
+	}
+	Update(aNode);
+	return true;
+}
+
+int TextEditor::Document::FindPiece(size_t aOffset, size_t* aPieceStart) const
+{
+	int node = mRoot;
+	size_t base = 0;
+	while (node != 0)
+	{
+		const Node& n = mNodes[node];
+		const size_t leftLength = mNodes[n.mLeft].mTotalLength;
+		if (aOffset < base + leftLength)
+			node = n.mLeft;
+		else if (aOffset < base + leftLength + n.mLength)
+		{
+			*aPieceStart = base + leftLength;
+			return node;
+		}
+		else
+		{
+			base += leftLength + n.mLength;
+			node = n.mRight;
+		}
+	}
+	return 0;
+}
+
+size_t TextEditor::Document::GetLineStart(int aLine) const
+{
+	if (aLine <= 0)
+		return 0;
+	// the line starts after the aLine-th line break
+	size_t breaks = (size_t)aLine;
+	size_t base = 0;
+	int node = mRoot;
+	while (node != 0)
+	{
+		const Node& n = mNodes[node];
+		const Node& left = mNodes[n.mLeft];
+		if (breaks <= left.mTotalBreaks)
+		{
+			node = n.mLeft;
+			continue;
+		}
+		breaks -= left.mTotalBreaks;
+		base += left.mTotalLength;
+		if (breaks <= n.mBreaks)
+			return base + mBuffers[n.mBuffer].mLineBreaks[n.mFirstBreak + breaks - 1] - n.mStart + 1;
+		breaks -= n.mBreaks;
+		base += n.mLength;
+		node = n.mRight;
+	}
+	return GetSize();
+}
+
+size_t TextEditor::Document::GetLineEnd(int aLine) const
+{
+	const size_t start = GetLineStart(aLine);
+	size_t end = aLine + 1 < GetLineCount() ? GetLineStart(aLine + 1) - 1 : GetSize();
+	if (end > start && GetChar(end - 1) == '\r')
+		--end;
+	return end;
+}
+
+int TextEditor::Document::GetLineAt(size_t aOffset) const
+{
+	size_t base = 0, breaks = 0;
+	int node = mRoot;
+	while (node != 0)
+	{
+		const Node& n = mNodes[node];
+		const Node& left = mNodes[n.mLeft];
+		if (aOffset < base + left.mTotalLength)
+		{
+			node = n.mLeft;
+			continue;
+		}
+		base += left.mTotalLength;
+		breaks += left.mTotalBreaks;
+		if (aOffset < base + n.mLength)
+		{
+			const std::vector<size_t>& lineBreaks = mBuffers[n.mBuffer].mLineBreaks;
+			auto first = lineBreaks.begin() + n.mFirstBreak;
+			breaks += std::lower_bound(first, first + n.mBreaks, n.mStart + aOffset - base) - first;
+			break;
+		}
+		base += n.mLength;
+		breaks += n.mBreaks;
+		node = n.mRight;
+	}
+	return (int)breaks;
+}
+
+char TextEditor::Document::GetChar(size_t aOffset) const
+{
+	size_t pieceStart;
+	const int node = FindPiece(aOffset, &pieceStart);
+	if (node == 0)
+		return '\0';
+	const Node& n = mNodes[node];
+	return mBuffers[n.mBuffer].mData[n.mStart + aOffset - pieceStart];
+}
+
+const char* TextEditor::Document::GetLine(int aLine, int* aSize, std::string& aScratch) const
+{
+	const size_t start = GetLineStart(aLine);
+	const size_t end = aLine + 1 < GetLineCount() ? GetLineStart(aLine + 1) - 1 : GetSize();
+	const char* text = "";
+	if (end > start)
+	{
+		size_t pieceStart;
+		const Node& n = mNodes[FindPiece(start, &pieceStart)];
+		if (end <= pieceStart + n.mLength)
+			text = mBuffers[n.mBuffer].mData + n.mStart + start - pieceStart;
+		else
+		{
+			aScratch.clear();
+			GetText(start, end, aScratch);
+			text = aScratch.data();
+		}
+	}
+	size_t size = end - start;
+	if (size > 0 && text[size - 1] == '\r')
+		--size;
+	*aSize = (int)size;
+	return text;
+}
+
+void TextEditor::Document::CollectText(int aNode, size_t aBase, size_t aStart, size_t aEnd, std::string& aOut) const
+{
+	if (aNode == 0)
+		return;
+	const Node& n = mNodes[aNode];
+	const size_t pieceStart = aBase + mNodes[n.mLeft].mTotalLength;
+	const size_t pieceEnd = pieceStart + n.mLength;
+	if (aStart < pieceStart)
+		CollectText(n.mLeft, aBase, aStart, aEnd, aOut);
+	if (aStart < pieceEnd && aEnd > pieceStart)
+	{
+		const size_t from = ImMax(aStart, pieceStart), to = ImMin(aEnd, pieceEnd);
+		aOut.append(mBuffers[n.mBuffer].mData + n.mStart + from - pieceStart, to - from);
+	}
+	if (aEnd > pieceEnd)
+		CollectText(n.mRight, pieceEnd, aStart, aEnd, aOut);
+}
+
+void TextEditor::Document::GetText(size_t aStart, size_t aEnd, std::string& aOut) const
+{
+	aEnd = ImMin(aEnd, GetSize());
+	if (aStart >= aEnd)
+		return;
+	aOut.reserve(aOut.size() + aEnd - aStart);
+	CollectText(mRoot, 0, aStart, aEnd, aOut);
+}
+
+void TextEditor::Document::CollectPieces(int aNode, size_t aBase, size_t aStart, Snapshot& aOut) const
+{
+	if (aNode == 0)
+		return;
+	const Node& n = mNodes[aNode];
+	const size_t pieceStart = aBase + mNodes[n.mLeft].mTotalLength;
+	const size_t pieceEnd = pieceStart + n.mLength;
+	if (aStart < pieceStart)
+		CollectPieces(n.mLeft, aBase, aStart, aOut);
+	if (aStart < pieceEnd)
+	{
+		const size_t from = ImMax(aStart, pieceStart);
+		aOut.mPieces.push_back(std::make_pair(mBuffers[n.mBuffer].mData + n.mStart + from - pieceStart, pieceEnd - from));
+	}
+	CollectPieces(n.mRight, pieceEnd, aStart, aOut);
+}
+
+void TextEditor::Document::GetSnapshot(size_t aFrom, Snapshot& aOut) const
+{
+	aOut.mPieces.clear();
+	aOut.mVersion = mVersion;
+	CollectPieces(mRoot, 0, aFrom, aOut);
+}
+
+void TextEditor::Document::CollectPieces(int aNode, size_t aBase, size_t aStart, size_t aEnd, std::vector<Piece>& aOut) const
+{
+	if (aNode == 0)
+		return;
+	const Node& n = mNodes[aNode];
+	const size_t pieceStart = aBase + mNodes[n.mLeft].mTotalLength;
+	const size_t pieceEnd = pieceStart + n.mLength;
+	if (aStart < pieceStart)
+		CollectPieces(n.mLeft, aBase, aStart, aEnd, aOut);
+	if (aStart < pieceEnd && aEnd > pieceStart)
+	{
+		const size_t from = ImMax(aStart, pieceStart), to = ImMin(aEnd, pieceEnd);
+		Piece piece;
+		piece.mBuffer = n.mBuffer;
+		piece.mStart = n.mStart + from - pieceStart;
+		piece.mLength = to - from;
+		if (!aOut.empty() && aOut.back().mBuffer == piece.mBuffer && aOut.back().mStart + aOut.back().mLength == piece.mStart)
+			aOut.back().mLength += piece.mLength;
+		else
+			aOut.push_back(piece);
+	}
+	if (aEnd > pieceEnd)
+		CollectPieces(n.mRight, pieceEnd, aStart, aEnd, aOut);
+}
+
+void TextEditor::Document::GetPieces(size_t aStart, size_t aEnd, std::vector<Piece>& aOut) const
+{
+	aEnd = ImMin(aEnd, GetSize());
+	if (aStart < aEnd)
+		CollectPieces(mRoot, 0, aStart, aEnd, aOut);
+}
+
+// Returns the number of line breaks of a piece, and the offset in its buffer of the last one
+size_t TextEditor::Document::CountLineBreaks(const Piece& aPiece, size_t* aLastBreak) const
+{
+	const std::vector<size_t>& breaks = mBuffers[aPiece.mBuffer].mLineBreaks;
+	const auto first = std::lower_bound(breaks.begin(), breaks.end(), aPiece.mStart);
+	const auto last = std::lower_bound(first, breaks.end(), aPiece.mStart + aPiece.mLength);
+	if (last != first)
+		*aLastBreak = *(last - 1);
+	return last - first;
+}
+
+void TextEditor::Document::Insert(size_t aOffset, const char* aText, size_t aSize)
+{
+	if (aSize == 0)
+		return;
+	int left, right;
+	Split(mRoot, ImMin(aOffset, GetSize()), left, right);
+	int buffer;
+	size_t start;
+	Append(aText, aSize, &buffer, &start);
+	if (!ExtendLast(left, buffer, start, aSize))
+		left = Merge(left, NewNode(buffer, start, aSize));
+	mRoot = Merge(left, right);
+	++mVersion;
+}
+
+// Inserts bytes already stored in the buffers without copying them
+void TextEditor::Document::InsertPieces(size_t aOffset, const Piece* aPieces, size_t aCount)
+{
+	if (aCount == 0)
+		return;
+	int left, right;
+	Split(mRoot, ImMin(aOffset, GetSize()), left, right);
+	for (size_t i = 0; i < aCount; ++i)
+	{
+		const Piece& piece = aPieces[i];
+		if (piece.mLength > 0 && !ExtendLast(left, piece.mBuffer, piece.mStart, piece.mLength))
+			left = Merge(left, NewNode(piece.mBuffer, piece.mStart, piece.mLength));
+	}
+	mRoot = Merge(left, right);
+	++mVersion;
+}
+
+void TextEditor::Document::Erase(size_t aStart, size_t aEnd)
+{
+	aEnd = ImMin(aEnd, GetSize());
+	if (aStart >= aEnd)
+		return;
+	int left, middle, right;
+	Split(mRoot, aStart, left, middle);
+	Split(middle, aEnd - aStart, middle, right);
+	FreeNodes(middle);
+	mRoot = Merge(left, right);
+	++mVersion;
+}
+
+// Heap memory of the document, a mapped file is not counted
+size_t TextEditor::Document::GetMemoryUsage() const
+{
+	size_t size = mNodes.capacity() * sizeof(Node) + mFreeNodes.capacity() * sizeof(int);
+	for (size_t i = 0; i < mBuffers.size(); ++i)
+	{
+		if (i != 0 || !mMapped)
+			size += mBuffers[i].mCapacity;
+		size += mBuffers[i].mLineBreaks.capacity() * sizeof(size_t);
+	}
+	return size;
+}
+
+// NFA of the token rules built from their regular expressions, a state either moves to mNext on the bytes
+// of mSet or to the states of mEpsilon without reading anything
+struct TokenNfa
+{
+	struct State
+	{
+		uint64_t mSet[4];
+		int mNext;
+		std::vector<int> mEpsilon;
+		int mRule;
+
+		State() : mNext(-1), mRule(-1) { mSet[0] = mSet[1] = mSet[2] = mSet[3] = 0; }
+		bool Has(int c) const { return (mSet[c >> 6] >> (c & 63)) & 1; }
+		void Add(int c) { mSet[c >> 6] |= 1ull << (c & 63); }
+	};
+
+	// Fragment of the NFA, the text matched by it leads from mStart to mEnd
+	struct Fragment
+	{
+		int mStart, mEnd;
+	};
+
+	std::vector<State> mStates;
+	const char* mPos;
+	const char* mEnd;
+	bool mFailed;
+
+	int NewState()
+	{
+		mStates.emplace_back();
+		return (int)mStates.size() - 1;
+	}
+
+	Fragment Epsilon()
+	{
+		Fragment f = { NewState(), NewState() };
+		mStates[f.mStart].mEpsilon.push_back(f.mEnd);
+		return f;
+	}
+
+	Fragment Fail()
+	{
+		mFailed = true;
+		return Epsilon();
+	}
+
+	bool Eat(char c)
+	{
+		if (mPos < mEnd && *mPos == c)
+		{
+			++mPos;
+			return true;
+		}
+		return false;
+	}
+
+	// Bytes of the escapes standing for a class of characters, false for a single character
+	static bool AddClassEscape(State& aState, char aEscape)
+	{
+		State set;
+		switch (aEscape)
+		{
+		case 'd': case 'D': for (int c = '0'; c <= '9'; ++c) set.Add(c); break;
+		case 'w': case 'W': for (int c = 0; c < 128; ++c) if (isalnum(c) || c == '_') set.Add(c); break;
+		case 's': case 'S': for (int c : { ' ', '\t', '\n', '\r', '\f', '\v' }) set.Add(c); break;
+		default: return false;
+		}
+		const bool negate = isupper((unsigned char)aEscape) != 0;
+		for (int i = 0; i < 4; ++i)
+			aState.mSet[i] |= negate ? ~set.mSet[i] : set.mSet[i];
+		return true;
+	}
+
+	// Character of an escape other than a class, -1 for the escapes the scanner doesn't support
+	int EscapedChar(char aEscape)
+	{
+		switch (aEscape)
+		{
+		case 't': return '\t';
+		case 'n': return '\n';
+		case 'r': return '\r';
+		case 'f': return '\f';
+		case 'v': return '\v';
+		case '0': return 0;
+		case 'x':
+		{
+			int value = 0;
+			for (int i = 0; i < 2; ++i, ++mPos)
+			{
+				if (mPos == mEnd || !isxdigit((unsigned char)*mPos))
+					return -1;
+				value = value * 16 + (isdigit((unsigned char)*mPos) ? *mPos - '0' : (tolower((unsigned char)*mPos) - 'a' + 10));
+			}
+			return value;
+		}
+		default:
+			// back references, word boundaries and unicode escapes
+			if (isalnum((unsigned char)aEscape))
+				return -1;
+			return (unsigned char)aEscape;
+		}
+	}
+
+	Fragment Set(const State& aSet)
+	{
+		Fragment f = { NewState(), NewState() };
+		memcpy(mStates[f.mStart].mSet, aSet.mSet, sizeof(aSet.mSet));
+		mStates[f.mStart].mNext = f.mEnd;
+		return f;
+	}
+
+	Fragment ParseClass()
+	{
+		State set;
+		const bool negate = Eat('^');
+		int previous = -1;	// last single character, the start of a range
+		while (mPos < mEnd && *mPos != ']')
+		{
+			int c = (unsigned char)*mPos++;
+			if (c == '\\')
+			{
+				if (mPos == mEnd)
+					return Fail();
+				const char escape = *mPos++;
+				if (AddClassEscape(set, escape))
+				{
+					previous = -1;
+					continue;
+				}
+				c = escape == 'b' ? '\b' : EscapedChar(escape);
+				if (c < 0)
+					return Fail();
+			}
+			else if (c == '-' && previous >= 0 && mPos < mEnd && *mPos != ']')
+			{
+				int last = (unsigned char)*mPos++;
+				if (last == '\\')
+				{
+					if (mPos == mEnd || (last = EscapedChar(*mPos++)) < 0)
+						return Fail();
+				}
+				if (last < previous)
+					return Fail();
+				for (int i = previous; i <= last; ++i)
+					set.Add(i);
+				previous = -1;
+				continue;
+			}
+			set.Add(c);
+			previous = c;
+		}
+		if (!Eat(']'))
+			return Fail();
+		if (negate)
+			for (int i = 0; i < 4; ++i)
+				set.mSet[i] = ~set.mSet[i];
+		return Set(set);
+	}
+
+	Fragment ParseAtom()
+	{
+		State set;
+		const char c = *mPos++;
+		switch (c)
+		{
+		case '(':
+		{
+			if (Eat('?') && !Eat(':'))
+				return Fail();
+			Fragment f = ParseAlternation();
+			if (!Eat(')'))
+				return Fail();
+			return f;
+		}
+		case '[':
+			return ParseClass();
+		case '.':
+			for (int i = 0; i < 256; ++i)
+				if (i != '\n' && i != '\r')
+					set.Add(i);
+			return Set(set);
+		case '\\':
+		{
+			if (mPos == mEnd)
+				return Fail();
+			const char escape = *mPos++;
+			if (!AddClassEscape(set, escape))
+			{
+				const int e = EscapedChar(escape);
+				if (e < 0)
+					return Fail();
+				set.Add(e);
+			}
+			return Set(set);
+		}
+		case '^': case '$': case ')': case '*': case '+': case '?': case '{': case '|':
+			return Fail();
+		default:
+			set.Add((unsigned char)c);
+			return Set(set);
+		}
+	}
+
+	Fragment Concat(Fragment a, Fragment b)
+	{
+		mStates[a.mEnd].mEpsilon.push_back(b.mStart);
+		return { a.mStart, b.mEnd };
+	}
+
+	// a{aMin,aMax}, aMax < 0 for no limit. The atom is parsed again from aAtom for each copy.
+	Fragment Repeat(Fragment a, const char* aAtom, int aMin, int aMax)
+	{
+		const char* after = mPos;
+		Fragment result = Epsilon();
+		const int copies = aMax < 0 ? std::max(aMin, 1) : aMax;
+		for (int i = 0; i < copies && !mFailed; ++i)
+		{
+			Fragment f = a;
+			if (i > 0)
+			{
+				mPos = aAtom;
+				f = ParseAtom();
+			}
+			if (i >= aMin)
+				mStates[f.mStart].mEpsilon.push_back(f.mEnd);	// optional copy
+			if (aMax < 0 && i == copies - 1)
+				mStates[f.mEnd].mEpsilon.push_back(f.mStart);	// the last copy loops
+			result = Concat(result, f);
+		}
+		mPos = after;
+		return result;
+	}
+
+	int ParseCount()
+	{
+		int value = -1;
+		while (mPos < mEnd && isdigit((unsigned char)*mPos) && value < 1000)
+			value = (value < 0 ? 0 : value * 10) + (*mPos++ - '0');
+		return value;
+	}
+
+	Fragment ParseRepetition()
+	{
+		const char* atom = mPos;
+		Fragment f = ParseAtom();
+		int low, high;
+		if (mFailed)
+			return f;
+		else if (Eat('*'))
+			low = 0, high = -1;
+		else if (Eat('+'))
+			low = 1, high = -1;
+		else if (Eat('?'))
+			low = 0, high = 1;
+		else if (Eat('{'))
+		{
+			low = ParseCount();
+			high = Eat(',') ? ParseCount() : low;
+			if (low < 0 || !Eat('}') || (high >= 0 && high < low) || high > 100)
+				return Fail();
+		}
+		else
+			return f;
+		// lazy quantifiers have no longest match, and a quantifier applies to an atom only
+		if (mPos < mEnd && (*mPos == '?' || *mPos == '*' || *mPos == '+' || *mPos == '{'))
+			return Fail();
+		return Repeat(f, atom, low, high);
+	}
+
+	Fragment ParseSequence()
+	{
+		Fragment f = Epsilon();
+		while (!mFailed && mPos < mEnd && *mPos != '|' && *mPos != ')')
+			f = Concat(f, ParseRepetition());
+		return f;
+	}
+
+	Fragment ParseAlternation()
+	{
+		Fragment f = ParseSequence();
+		while (!mFailed && Eat('|'))
+		{
+			Fragment alternative = ParseSequence();
+			Fragment both = { NewState(), NewState() };
+			mStates[both.mStart].mEpsilon.push_back(f.mStart);
+			mStates[both.mStart].mEpsilon.push_back(alternative.mStart);
+			mStates[f.mEnd].mEpsilon.push_back(both.mEnd);
+			mStates[alternative.mEnd].mEpsilon.push_back(both.mEnd);
+			f = both;
+		}
+		return f;
+	}
+
+	// Adds a rule to the NFA from state 0, false when its expression isn't supported
+	bool AddRule(const std::string& aExpression, int aRule)
+	{
+		mPos = aExpression.data();
+		mEnd = mPos + aExpression.size();
+		mFailed = false;
+		Fragment f = ParseAlternation();
+		if (mFailed || mPos != mEnd)
+			return false;
+		mStates[0].mEpsilon.push_back(f.mStart);
+		mStates[f.mEnd].mRule = aRule;
+		return true;
+	}
+
+	// Adds to aSet the states reached from it without reading a byte, the set is kept sorted
+	void Close(std::vector<int>& aSet, std::vector<char>& aSeen) const
+	{
+		for (size_t i = 0; i < aSet.size(); ++i)
+			for (int next : mStates[aSet[i]].mEpsilon)
+				if (!aSeen[next])
+				{
+					aSeen[next] = 1;
+					aSet.push_back(next);
+				}
+		for (int s : aSet)
+			aSeen[s] = 0;
+		std::sort(aSet.begin(), aSet.end());
+	}
+};
+
+bool TextEditor::TokenScanner::Compile(const LanguageDefinition::TokenRegexStrings& aRules, bool aIgnoreCase)
+{
+	Clear();
+	if (aRules.empty())
+		return false;
+
+	TokenNfa nfa;
+	nfa.NewState();
+	for (size_t i = 0; i < aRules.size(); ++i)
+		if (!nfa.AddRule(aRules[i].first, (int)i))
+			return false;
+	if (aIgnoreCase)
+	{
+		for (auto& state : nfa.mStates)
+			for (int c = 'a'; c <= 'z'; ++c)
+				if (state.Has(c) || state.Has(c - 'a' + 'A'))
+				{
+					state.Add(c);
+					state.Add(c - 'a' + 'A');
+				}
+	}
+
+	// bytes found in the same sets of every state are one class
+	memset(mClasses, 0, sizeof(mClasses));
+	mClassCount = 1;
+	for (auto& state : nfa.mStates)
+	{
+		if (state.mNext < 0)
+			continue;
+		int split[256][2];
+		memset(split, -1, sizeof(split));
+		int count = 0;
+		for (int c = 0; c < 256; ++c)
+		{
+			int& to = split[mClasses[c]][state.Has(c)];
+			if (to < 0)
+				to = count++;
+			mClasses[c] = (uint8_t)to;
+		}
+		mClassCount = count;
+	}
+	int representatives[256];
+	for (int c = 255; c >= 0; --c)
+		representatives[mClasses[c]] = c;
+
+	// subset construction, a DFA state is the set of NFA states reached by the same bytes
+	const int kMaxStates = 4096;
+	std::map<std::vector<int>, int> states;
+	std::vector<std::vector<int>> pending;
+	std::vector<char> seen(nfa.mStates.size(), 0);
+	std::vector<int> set(1, 0);
+	nfa.Close(set, seen);
+	states[set] = 0;
+	pending.push_back(set);
+	for (size_t s = 0; s < pending.size(); ++s)
+	{
+		int rule = -1;
+		for (int n : pending[s])
+			if (nfa.mStates[n].mRule >= 0 && (rule < 0 || nfa.mStates[n].mRule < rule))
+				rule = nfa.mStates[n].mRule;
+		mAccept.push_back(rule);
+		mNext.resize(pending.size() * mClassCount, -1);
+		for (int k = 0; k < mClassCount; ++k)
+		{
+			set.clear();
+			for (int n : pending[s])
+			{
+				const auto& state = nfa.mStates[n];
+				if (state.mNext >= 0 && state.Has(representatives[k]) && !seen[state.mNext])
+				{
+					seen[state.mNext] = 1;
+					set.push_back(state.mNext);
+				}
+			}
+			if (set.empty())
+				continue;
+			nfa.Close(set, seen);
+			auto it = states.find(set);
+			if (it == states.end())
+			{
+				if ((int)pending.size() == kMaxStates)
+				{
+					Clear();
+					return false;
+				}
+				it = states.insert(std::make_pair(set, (int)pending.size())).first;
+				pending.push_back(set);
+			}
+			mNext[s * mClassCount + k] = it->second;
+		}
+	}
+	mNext.resize(pending.size() * mClassCount, -1);
+	return true;
+}
+
+void TextEditor::TokenScanner::Clear()
+{
+	mNext.clear();
+	mAccept.clear();
+	mClassCount = 0;
+}
+
+// Rule of the longest token starting at aBegin and its end, -1 when no rule matches a token of one byte or more
+int TextEditor::TokenScanner::Match(const char* aBegin, const char* aEnd, const char*& aTokenEnd) const
+{
+	int rule = -1;
+	int state = 0;
+	for (auto p = aBegin; p != aEnd; )
+	{
+		state = mNext[state * mClassCount + mClasses[(uint8_t)*p++]];
+		if (state < 0)
+			break;
+		if (mAccept[state] >= 0)
+		{
+			rule = mAccept[state];
+			aTokenEnd = p;
+		}
+	}
+	return rule;
+}
 
-#ifndef isascii
-#define isascii(a) ((unsigned)(a) < 128)
-#endif
+static uint32_t HashName(const char* aName, int aSize, uint32_t aSeed, bool aCaseSensitive)
+{
+	uint32_t hash = 2166136261u ^ (aSeed * 0x9e3779b9u);
+	for (int i = 0; i < aSize; ++i)
+	{
+		const uint8_t c = (uint8_t)aName[i];
+		hash = (hash ^ (aCaseSensitive ? c : (uint8_t)toupper(c))) * 16777619u;
+	}
+	return hash ^ (hash >> 15);
+}
 
-// TODO
-// - multiline comments vs single-line: latter is blocking start of a ML
+// Hash and displace: names are grouped in buckets by a first hash, then the buckets from the largest one
+// look for a seed of the second hash sending all their names to free slots
+void TextEditor::KeywordTable::Build(const LanguageDefinition& aLanguage)
+{
+	std::map<std::string, int> kinds;
+	for (auto& k : aLanguage.mKeywords)
+		kinds[k] |= Kind_Keyword;
+	for (auto& k : aLanguage.mIdentifiers)
+		kinds[k.first] |= Kind_Identifier;
+	for (auto& k : aLanguage.mPreprocIdentifiers)
+		kinds[k.first] |= Kind_PreprocIdentifier;
+
+	mCaseSensitive = aLanguage.mCaseSensitive;
+	mNames.clear();
+	std::vector<Slot> names;
+	for (auto& k : kinds)
+	{
+		// the names of a language without case are looked up uppercased, others can't be found
+		const bool upper = std::none_of(k.first.begin(), k.first.end(), [](char c) { return islower((uint8_t)c) != 0; });
+		if (k.first.size() > 0xffff || (!mCaseSensitive && !upper))
+			continue;
+		names.push_back({ (uint32_t)mNames.size(), (uint16_t)k.first.size(), (uint8_t)k.second });
+		mNames += k.first;
+	}
+
+	const int bucketCount = std::max(1, (int)names.size() / 4);
+	std::vector<std::vector<int>> buckets(bucketCount);
+	for (int i = 0; i < (int)names.size(); ++i)
+		buckets[HashName(&mNames[names[i].mOffset], names[i].mSize, 0, mCaseSensitive) % bucketCount].push_back(i);
+	std::vector<int> order(bucketCount);
+	for (int i = 0; i < bucketCount; ++i)
+		order[i] = i;
+	std::sort(order.begin(), order.end(), [&](int a, int b) { return buckets[a].size() > buckets[b].size(); });
+
+	for (size_t slotCount = names.size() + names.size() / 4 + 1; ; slotCount += slotCount / 4 + 1)
+	{
+		mSeeds.assign(bucketCount, 0);
+		mSlots.assign(slotCount, Slot{ 0, 0, 0 });
+		std::vector<size_t> taken;
+		bool placed = true;
+		for (int b : order)
+		{
+			auto& bucket = buckets[b];
+			uint32_t seed = 1;
+			for (; seed < 65536; ++seed)
+			{
+				taken.clear();
+				for (int n : bucket)
+				{
+					const size_t slot = HashName(&mNames[names[n].mOffset], names[n].mSize, seed, mCaseSensitive) % slotCount;
+					if (mSlots[slot].mKinds != 0 || std::find(taken.begin(), taken.end(), slot) != taken.end())
+						break;
+					taken.push_back(slot);
+				}
+				if (taken.size() == bucket.size())
+					break;
+			}
+			if (seed == 65536)
+			{
+				placed = false;
+				break;
+			}
+			mSeeds[b] = seed;
+			for (size_t i = 0; i < bucket.size(); ++i)
+				mSlots[taken[i]] = names[bucket[i]];
+		}
+		if (placed)
+			break;
+	}
+}
+
+int TextEditor::KeywordTable::Find(const char* aName, int aSize) const
+{
+	if (mSlots.empty())
+		return 0;
+	const uint32_t seed = mSeeds[HashName(aName, aSize, 0, mCaseSensitive) % mSeeds.size()];
+	const Slot& slot = mSlots[HashName(aName, aSize, seed, mCaseSensitive) % mSlots.size()];
+	if (slot.mSize != aSize)
+		return 0;
+	const char* name = &mNames[slot.mOffset];
+	for (int i = 0; i < aSize; ++i)
+		if (name[i] != (mCaseSensitive ? aName[i] : (char)toupper((uint8_t)aName[i])))
+			return 0;
+	return slot.mKinds;
+}
+
+// Span holding the byte aIndex of a line, bytes before the first span have the default color
+static TextEditor::ColorSpan GetSpanAt(const TextEditor::ColorLine& aColors, int aIndex)
+{
+	auto it = std::upper_bound(aColors.begin(), aColors.end(), aIndex, [](int a, const TextEditor::ColorSpan& s) { return a < s.mStart; });
+	return it == aColors.begin() ? TextEditor::ColorSpan() : *(it - 1);
+}
+
+static void AddSpan(TextEditor::ColorLine& aColors, const TextEditor::ColorSpan& aSpan)
+{
+	if (!aColors.empty() && aColors.back().mStart == aSpan.mStart)
+		aColors.pop_back();
+	const TextEditor::ColorSpan previous = aColors.empty() ? TextEditor::ColorSpan() : aColors.back();
+	if (!previous.SameColor(aSpan))
+		aColors.push_back(aSpan);
+}
 
-template<class InputIt1, class InputIt2, class BinaryPredicate>
-bool equals(InputIt1 first1, InputIt1 last1,
-	InputIt2 first2, InputIt2 last2, BinaryPredicate p)
+// Drops the spans starting at aEnd or after
+static void TruncateSpans(TextEditor::ColorLine& aColors, int aEnd)
 {
-	for (; first1 != last1 && first2 != last2; ++first1, ++first2)
+	auto it = std::lower_bound(aColors.begin(), aColors.end(), aEnd, [](const TextEditor::ColorSpan& s, int a) { return s.mStart < a; });
+	aColors.erase(it, aColors.end());
+}
+
+// Appends the colors of the bytes of aFrom from aStart to the end of the line, moved by aShift
+static void AppendSpans(TextEditor::ColorLine& aTo, const TextEditor::ColorLine& aFrom, int aStart, int aShift)
+{
+	auto it = std::upper_bound(aFrom.begin(), aFrom.end(), aStart, [](int a, const TextEditor::ColorSpan& s) { return a < s.mStart; });
+	TextEditor::ColorSpan span = it == aFrom.begin() ? TextEditor::ColorSpan() : *(it - 1);
+	span.mStart = aStart + aShift;
+	AddSpan(aTo, span);
+	for (; it != aFrom.end(); ++it)
 	{
-		if (!p(*first1, *first2))
-			return false;
+		span = *it;
+		span.mStart += aShift;
+		AddSpan(aTo, span);
 	}
-	return first1 == last1 && first2 == last2;
 }
 
 TextEditor::TextEditor()
 	: mLineSpacing(1.0f)
+	, mLineCacheNext(0)
+	, mLineMetrics(1)
+	, mMetricsFont(nullptr)
+	, mMetricsFontSize(0.0f)
 	, mUndoIndex(0)
+	, mUndoMemory(0)
+	, mUndoBudget(16 << 20)
 	, mTabSize(4)
 	, mOverwrite(false)
 	, mReadOnly(false)
@@ -43,35 +1202,57 @@ TextEditor::TextEditor()
 	, mTextStart(20.0f)
 	, mLeftMargin(10)
 	, mCursorPositionChanged(false)
-	, mColorRangeMin(0)
-	, mColorRangeMax(0)
 	, mSelectionMode(SelectionMode::Normal)
-	, mCheckComments(true)
 	, mHandleKeyboardInputs(true)
 	, mHandleMouseInputs(true)
 	, mIgnoreImGuiChild(false)
 	, mShowWhitespaces(true)
 	, mShowShortTabGlyphs(false)
+	, mColorizeStart(0)
+	, mColorizeEnd(0)
+	, mColorizeRestart(true)
+	, mColorizeVersion(0)
+	, mColorizeOldState(0)
+	, mColorizerBudget(2.0f)
+	, mColorizerThreaded(true)
+	, mColorizeJobPending(false)
+	, mColorizerStop(false)
+	, mColorizeJobId(0)
+	, mFindVersion(0)
+	, mFindThreads(ImMax(1, (int)std::thread::hardware_concurrency()))
+	, mFindId(0)
+	, mFindNextChunk(0)
+	, mFindChunksDone(0)
 	, mStartTime(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
 	, mLastClick(-1.0f)
     , mSelecting(false)
 {
+	for (auto& cache : mLineCache)
+		cache.mLine = -1;
+	mLineInfos.resize(1);
 	SetPalette(GetDarkPalette());
 	SetLanguageDefinition(LanguageDefinition::HLSL());
-	mLines.push_back(Line());
 }
 
 TextEditor::~TextEditor()
 {
+	StopColorizer();
+	StopFind();
 }
 
 void TextEditor::SetLanguageDefinition(const LanguageDefinition & aLanguageDef)
 {
+	// the colorizer thread reads the language definition
+	StopColorizer();
 	mLanguageDefinition = aLanguageDef;
 	mRegexList.clear();
 
-	for (auto& r : mLanguageDefinition.mTokenRegexStrings)
-		mRegexList.push_back(std::make_pair(std::regex(r.first, std::regex_constants::optimize), r.second));
+	if (!mTokenScanner.Compile(mLanguageDefinition.mTokenRegexStrings))
+	{
+		for (auto& r : mLanguageDefinition.mTokenRegexStrings)
+			mRegexList.push_back(std::make_pair(std::regex(r.first, std::regex_constants::optimize), r.second));
+	}
+	mKeywordTable.Build(mLanguageDefinition);
 
 	Colorize();
 }
@@ -84,38 +1265,7 @@ void TextEditor::SetPalette(const Palette & aValue)
 std::string TextEditor::GetText(const Coordinates & aStart, const Coordinates & aEnd) const
 {
 	std::string result;
-
-	auto lstart = aStart.mLine;
-	auto lend = aEnd.mLine;
-	auto istart = GetCharacterIndex(aStart);
-	auto iend = GetCharacterIndex(aEnd);
-	size_t s = 0;
-
-	for (size_t i = lstart; i < lend; i++)
-		s += mLines[i].size();
-
-	result.reserve(s + s / 8);
-
-	while (istart < iend || lstart < lend)
-	{
-		if (lstart >= (int)mLines.size())
-			break;
-
-		auto& line = mLines[lstart];
-		if (istart < (int)line.size())
-		{
-			result += line[istart].mChar;
-			istart++;
-		}
-		else
-		{
-			istart = 0;
-			++lstart;
-			result += '\n';
-		}
-	}
-    // NOTE: added this so it doesn't append an extra new line at the end
-    //result.pop_back();
+	mDocument.GetText(GetOffset(aStart), GetOffset(aEnd), result);
 	return result;
 }
 
@@ -128,23 +1278,15 @@ TextEditor::Coordinates TextEditor::SanitizeCoordinates(const Coordinates & aVal
 {
 	auto line = aValue.mLine;
 	auto column = aValue.mColumn;
-	if (line >= (int)mLines.size())
+	if (line >= GetTotalLines())
 	{
-		if (mLines.empty())
-		{
-			line = 0;
-			column = 0;
-		}
-		else
-		{
-			line = (int)mLines.size() - 1;
-			column = GetLineMaxColumn(line);
-		}
+		line = GetTotalLines() - 1;
+		column = GetLineMaxColumn(line);
 		return Coordinates(line, column);
 	}
 	else
 	{
-		column = mLines.empty() ? 0 : ImMin(column, GetLineMaxColumn(line));
+		column = ImMin(column, GetLineMaxColumn(line));
 		return Coordinates(line, column);
 	}
 }
@@ -206,15 +1348,16 @@ static inline int ImTextCharToUtf8(char* buf, int buf_size, unsigned int c)
 
 void TextEditor::Advance(Coordinates & aCoordinates) const
 {
-	if (aCoordinates.mLine < (int)mLines.size())
+	if (aCoordinates.mLine < GetTotalLines())
 	{
-		auto& line = mLines[aCoordinates.mLine];
+		int size;
+		auto line = GetLineText(aCoordinates.mLine, &size);
 		auto cindex = GetCharacterIndex(aCoordinates);
 
-		if (cindex + 1 < (int)line.size())
+		if (cindex + 1 < size)
 		{
-			auto delta = UTF8CharLength(line[cindex].mChar);
-			cindex = ImMin(cindex + delta, (int)line.size() - 1);
+			auto delta = UTF8CharLength(line[cindex]);
+			cindex = ImMin(cindex + delta, size - 1);
 		}
 		else
 		{
@@ -235,32 +1378,31 @@ void TextEditor::DeleteRange(const Coordinates & aStart, const Coordinates & aEn
 	if (aEnd == aStart)
 		return;
 
-	auto start = GetCharacterIndex(aStart);
-	auto end = GetCharacterIndex(aEnd);
+	const size_t startOffset = GetOffset(aStart);
+	const size_t endOffset = GetOffset(aEnd);
+	if (startOffset >= endOffset)
+		return;
+
+	const int startLine = mDocument.GetLineAt(startOffset);
+	const int endLine = mDocument.GetLineAt(endOffset);
+	const int start = (int)(startOffset - mDocument.GetLineStart(startLine));
+	const int end = (int)(endOffset - mDocument.GetLineStart(endLine));
 
-	if (aStart.mLine == aEnd.mLine)
+	InvalidateLineWidth(startLine);
+	auto& firstColors = mLineInfos[startLine].mColors;
+	if (startLine == endLine)
 	{
-		auto& line = mLines[aStart.mLine];
-		auto n = GetLineMaxColumn(aStart.mLine);
-		if (aEnd.mColumn >= n)
-			line.erase(line.begin() + start, line.end());
-		else
-			line.erase(line.begin() + start, line.begin() + end);
+		ColorLine colors(firstColors);
+		TruncateSpans(firstColors, start);
+		AppendSpans(firstColors, colors, end, start - end);
 	}
 	else
 	{
-		auto& firstLine = mLines[aStart.mLine];
-		auto& lastLine = mLines[aEnd.mLine];
-
-		firstLine.erase(firstLine.begin() + start, firstLine.end());
-		lastLine.erase(lastLine.begin(), lastLine.begin() + end);
-
-		if (aStart.mLine < aEnd.mLine)
-			firstLine.insert(firstLine.end(), lastLine.begin(), lastLine.end());
-
-		if (aStart.mLine < aEnd.mLine)
-			RemoveLine(aStart.mLine + 1, aEnd.mLine + 1);
+		TruncateSpans(firstColors, start);
+		AppendSpans(firstColors, mLineInfos[endLine].mColors, end, start - end);
+		RemoveLines(startLine + 1, endLine + 1);
 	}
+	mDocument.Erase(startOffset, endOffset);
 
 	mTextChanged = true;
 }
@@ -269,64 +1411,230 @@ int TextEditor::InsertTextAt(Coordinates& /* inout */ aWhere, const char * aValu
 {
 	assert(!mReadOnly);
 
-	int cindex = GetCharacterIndex(aWhere);
-	int totalLines = 0;
-	while (*aValue != '\0')
+	// carriage returns are dropped, lines end with '\n' only
+	std::string text;
+	if (strchr(aValue, '\r') != nullptr)
 	{
-		assert(!mLines.empty());
+		for (auto p = aValue; *p != '\0'; ++p)
+			if (*p != '\r')
+				text.push_back(*p);
+		aValue = text.c_str();
+	}
 
-		if (*aValue == '\r')
-		{
-			// skip
-			++aValue;
-		}
-		else if (*aValue == '\n')
+	const int size = (int)strlen(aValue);
+	if (size == 0)
+		return 0;
+
+	int totalLines = 0;
+	int lastLineSize = size;
+	for (int i = 0; i < size; ++i)
+	{
+		if (aValue[i] == '\n')
 		{
-			if (cindex < (int)mLines[aWhere.mLine].size())
-			{
-				auto& newLine = InsertLine(aWhere.mLine + 1);
-				auto& line = mLines[aWhere.mLine];
-				newLine.insert(newLine.begin(), line.begin() + cindex, line.end());
-				line.erase(line.begin() + cindex, line.end());
-			}
-			else
-			{
-				InsertLine(aWhere.mLine + 1);
-			}
-			++aWhere.mLine;
-			aWhere.mColumn = 0;
-			cindex = 0;
 			++totalLines;
-			++aValue;
+			lastLineSize = size - i - 1;
 		}
-		else
+	}
+
+	const int cindex = GetCharacterIndex(aWhere);
+	const size_t offset = mDocument.GetLineStart(aWhere.mLine) + cindex;
+	InsertLineColors(aWhere.mLine, cindex, size, totalLines, lastLineSize);
+	mDocument.Insert(offset, aValue, size);
+
+	aWhere.mLine += totalLines;
+	aWhere.mColumn = GetCharacterColumn(aWhere.mLine, totalLines == 0 ? cindex + size : lastLineSize);
+	mTextChanged = true;
+
+	return totalLines;
+}
+
+// Inserts text stored in the document buffers, as the text put back by undo
+int TextEditor::InsertPiecesAt(Coordinates& /* inout */ aWhere, const std::vector<Document::Piece>& aPieces)
+{
+	assert(!mReadOnly);
+
+	int size = 0;
+	int totalLines = 0;
+	int lastLineSize = 0;
+	for (auto& piece : aPieces)
+	{
+		size_t lastBreak;
+		const int breaks = (int)mDocument.CountLineBreaks(piece, &lastBreak);
+		if (breaks > 0)
 		{
-			auto& line = mLines[aWhere.mLine];
-			auto d = UTF8CharLength(*aValue);
-			while (d-- > 0 && *aValue != '\0')
-				line.insert(line.begin() + cindex++, Glyph(*aValue++, PaletteIndex::Default));
-			aWhere.mColumn = GetCharacterColumn(aWhere.mLine, cindex);
+			totalLines += breaks;
+			lastLineSize = (int)(piece.mStart + piece.mLength - lastBreak - 1);
 		}
-
-		mTextChanged = true;
+		else
+			lastLineSize += (int)piece.mLength;
+		size += (int)piece.mLength;
 	}
+	if (size == 0)
+		return 0;
+
+	const int cindex = GetCharacterIndex(aWhere);
+	const size_t offset = mDocument.GetLineStart(aWhere.mLine) + cindex;
+	InsertLineColors(aWhere.mLine, cindex, size, totalLines, lastLineSize);
+	mDocument.InsertPieces(offset, aPieces.data(), aPieces.size());
+
+	aWhere.mLine += totalLines;
+	aWhere.mColumn = GetCharacterColumn(aWhere.mLine, totalLines == 0 ? cindex + size : lastLineSize);
+	mTextChanged = true;
 
 	return totalLines;
 }
 
+// Splits the colors of a line for aSize bytes inserted at aIndex, with aLines line breaks and aLastLineSize bytes
+// after the last one
+void TextEditor::InsertLineColors(int aLine, int aIndex, int aSize, int aLines, int aLastLineSize)
+{
+	InvalidateLineWidth(aLine);
+	auto& colors = mLineInfos[aLine].mColors;
+	ColorLine tail(colors);
+	TruncateSpans(colors, aIndex);
+	if (aLines == 0)
+	{
+		AppendSpans(colors, tail, aIndex, aSize);
+	}
+	else
+	{
+		InsertLines(aLine + 1, aLines);
+		AppendSpans(mLineInfos[aLine + aLines].mColors, tail, aIndex, aLastLineSize - aIndex);
+	}
+}
+
+// Records the text from aStart to aEnd before it is deleted, text added at aStart next goes in the same edit
+void TextEditor::RecordRemovedText(UndoRecord& aRecord, const Coordinates& aStart, const Coordinates& aEnd) const
+{
+	const size_t start = GetOffset(aStart), end = GetOffset(aEnd);
+	if (start >= end)
+		return;
+	UndoEdit edit;
+	edit.mOffset = start;
+	edit.mRemovedSize = end - start;
+	mDocument.GetPieces(edit.mOffset, end, edit.mRemoved);
+	aRecord.mEdits.push_back(std::move(edit));
+}
+
+void TextEditor::RecordAddedText(UndoRecord& aRecord, size_t aOffset, size_t aSize) const
+{
+	if (aSize == 0)
+		return;
+	if (aRecord.mEdits.empty() || aRecord.mEdits.back().mOffset != aOffset || aRecord.mEdits.back().mAddedSize != 0)
+	{
+		aRecord.mEdits.push_back(UndoEdit());
+		aRecord.mEdits.back().mOffset = aOffset;
+	}
+	auto& edit = aRecord.mEdits.back();
+	edit.mAddedSize = aSize;
+	mDocument.GetPieces(aOffset, aOffset + aSize, edit.mAdded);
+}
+
 void TextEditor::AddUndo(UndoRecord& aValue)
 {
 	assert(!mReadOnly);
-	//printf("AddUndo: (@%d.%d) +\'%s' [%d.%d .. %d.%d], -\'%s', [%d.%d .. %d.%d] (@%d.%d)\n",
-	//	aValue.mBefore.mCursorPosition.mLine, aValue.mBefore.mCursorPosition.mColumn,
-	//	aValue.mAdded.c_str(), aValue.mAddedStart.mLine, aValue.mAddedStart.mColumn, aValue.mAddedEnd.mLine, aValue.mAddedEnd.mColumn,
-	//	aValue.mRemoved.c_str(), aValue.mRemovedStart.mLine, aValue.mRemovedStart.mColumn, aValue.mRemovedEnd.mLine, aValue.mRemovedEnd.mColumn,
-	//	aValue.mAfter.mCursorPosition.mLine, aValue.mAfter.mCursorPosition.mColumn
-	//	);
 
-	mUndoBuffer.resize((size_t)(mUndoIndex + 1));
-	mUndoBuffer.back() = aValue;
-	++mUndoIndex;
+	if (aValue.mEdits.empty())
+		return;
+
+	while ((int)mUndoBuffer.size() > mUndoIndex)
+	{
+		mUndoMemory -= mUndoBuffer.back().GetMemoryUsage();
+		mUndoBuffer.pop_back();
+	}
+
+	const size_t memory = mUndoIndex > 0 ? mUndoBuffer.back().GetMemoryUsage() : 0;
+	if (mUndoIndex > 0 && CoalesceUndo(mUndoBuffer.back(), aValue))
+	{
+		mUndoMemory -= memory;
+		mUndoBuffer.back().mAfter = aValue.mAfter;
+	}
+	else
+	{
+		mUndoBuffer.push_back(std::move(aValue));
+		++mUndoIndex;
+	}
+	mUndoMemory += mUndoBuffer.back().GetMemoryUsage();
+	EvictUndo();
+}
+
+// Merges a typed or deleted character into the record before it when it follows it, typing stops merging at the
+// start of a word so undo goes back a word at a time
+bool TextEditor::CoalesceUndo(UndoRecord& aRecord, const UndoRecord& aNext) const
+{
+	if (!aRecord.mCoalesce || !aNext.mCoalesce || !(aRecord.mAfter == aNext.mBefore) || aRecord.mEdits.size() != 1 || aNext.mEdits.size() != 1)
+		return false;
+
+	auto& edit = aRecord.mEdits[0];
+	auto& next = aNext.mEdits[0];
+	auto append = [](std::vector<Document::Piece>& aTo, const std::vector<Document::Piece>& aFrom)
+	{
+		for (auto& piece : aFrom)
+		{
+			if (!aTo.empty() && aTo.back().mBuffer == piece.mBuffer && aTo.back().mStart + aTo.back().mLength == piece.mStart)
+				aTo.back().mLength += piece.mLength;
+			else
+				aTo.push_back(piece);
+		}
+	};
+
+	if (edit.mRemovedSize == 0 && next.mRemovedSize == 0 && edit.mAddedSize != 0 && next.mAddedSize != 0 && next.mOffset == edit.mOffset + edit.mAddedSize)
+	{
+		// typing
+		auto& last = edit.mAdded.back();
+		const char before = mDocument.GetPieceText(last)[last.mLength - 1];
+		const char after = mDocument.GetPieceText(next.mAdded.front())[0];
+		if (isspace((unsigned char)before) && !isspace((unsigned char)after))
+			return false;
+		append(edit.mAdded, next.mAdded);
+		edit.mAddedSize += next.mAddedSize;
+		return true;
+	}
+	if (edit.mAddedSize != 0 || next.mAddedSize != 0)
+		return false;
+	if (next.mOffset + next.mRemovedSize == edit.mOffset)
+	{
+		// backspace, the text removed comes before
+		std::vector<Document::Piece> removed(next.mRemoved);
+		append(removed, edit.mRemoved);
+		edit.mRemoved.swap(removed);
+		edit.mOffset = next.mOffset;
+		edit.mRemovedSize += next.mRemovedSize;
+		return true;
+	}
+	if (next.mOffset == edit.mOffset)
+	{
+		// delete, the text removed comes after
+		append(edit.mRemoved, next.mRemoved);
+		edit.mRemovedSize += next.mRemovedSize;
+		return true;
+	}
+	return false;
+}
+
+void TextEditor::SetUndoBudget(size_t aBytes)
+{
+	mUndoBudget = aBytes;
+	EvictUndo();
+}
+
+// Drops the oldest steps over the budget, then the steps to redo, the last one is kept even when over the budget alone
+void TextEditor::EvictUndo()
+{
+	while (mUndoMemory > mUndoBudget && mUndoBuffer.size() > 1)
+	{
+		if (mUndoIndex > 0)
+		{
+			mUndoMemory -= mUndoBuffer.front().GetMemoryUsage();
+			mUndoBuffer.pop_front();
+			--mUndoIndex;
+		}
+		else
+		{
+			mUndoMemory -= mUndoBuffer.back().GetMemoryUsage();
+			mUndoBuffer.pop_back();
+		}
+	}
 }
 
 TextEditor::Coordinates TextEditor::ScreenPosToCoordinates(const ImVec2& aPosition, bool aInsertionMode) const
@@ -339,9 +1647,10 @@ TextEditor::Coordinates TextEditor::ScreenPosToCoordinates(const ImVec2& aPositi
 
 	int columnCoord = 0;
 
-	if (lineNo >= 0 && lineNo < (int)mLines.size())
+	if (lineNo >= 0 && lineNo < GetTotalLines())
 	{
-		auto& line = mLines.at(lineNo);
+		int size;
+		auto line = GetLineText(lineNo, &size);
         //Fix for inability to click/go to the last column of a line, due to delta not being added when at the end of a line. Make sure to increment columnCoord with delta, before bailing of the while/for loop.
 		//int columnIndex = 0;
 		//std::string cumulatedString = "";
@@ -351,29 +1660,26 @@ TextEditor::Coordinates TextEditor::ScreenPosToCoordinates(const ImVec2& aPositi
 
 		// First we find the hovered column coord.
 		//while (mTextStart + columnX - (aInsertionMode ? 0.5f : 0.0f) * columnWidth < local.x && (size_t)columnIndex < line.size())
-        for (size_t columnIndex = 0; columnIndex < line.size(); ++columnIndex)
+        for (int columnIndex = 0; columnIndex < size;)
 		{
 			//columnCoord += delta;
             float columnWidth = 0.0f;
  			int delta = 0;
-			if (line[columnIndex].mChar == '\t')
+			if (line[columnIndex] == '\t')
 			{
 				float oldX = columnX;
 				columnX = (1.0f + std::floor((1.0f + columnX) / (float(mTabSize) * spaceSize))) * (float(mTabSize) * spaceSize);
 				columnWidth = columnX - oldX;
 				delta = columnCoord - (columnCoord / mTabSize) * mTabSize + mTabSize;
+				++columnIndex;
 			}
 			else
 			{
-				char buf[7];
-				auto d = UTF8CharLength(line[columnIndex].mChar);
-				int i = 0;
-				while (i < 6 && d-- > 0)
-					buf[i++] = line[columnIndex].mChar;
-				buf[i] = '\0';
-				columnWidth = ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, -1.0f, buf).x;
+				auto d = ImMin(UTF8CharLength(line[columnIndex]), size - columnIndex);
+				columnWidth = GetGlyphWidth(line + columnIndex, d);
 				columnX += columnWidth;
 				delta = 1;
+				columnIndex += d;
 			}
 			//++columnIndex;
             if (mTextStart + columnX - (aInsertionMode ? 0.5f : 0.0f) * columnWidth < local.x)
@@ -393,22 +1699,24 @@ TextEditor::Coordinates TextEditor::ScreenPosToCoordinates(const ImVec2& aPositi
 TextEditor::Coordinates TextEditor::FindWordStart(const Coordinates & aFrom) const
 {
 	Coordinates at = aFrom;
-	if (at.mLine >= (int)mLines.size())
+	if (at.mLine >= GetTotalLines())
 		return at;
 
-	auto& line = mLines[at.mLine];
+	int size;
+	auto line = GetLineText(at.mLine, &size);
+	auto& colors = mLineInfos[at.mLine].mColors;
 	auto cindex = GetCharacterIndex(at);
 
-	if (cindex >= (int)line.size())
+	if (cindex >= size)
 		return at;
 
-	while (cindex > 0 && isspace(line[cindex].mChar))
+	while (cindex > 0 && isspace(line[cindex]))
 		--cindex;
 
-	auto cstart = (PaletteIndex)line[cindex].mColorIndex;
+	auto cstart = GetSpanAt(colors, cindex).mColorIndex;
 	while (cindex > 0)
 	{
-		auto c = line[cindex].mChar;
+		auto c = line[cindex];
 		if ((c & 0xC0) != 0x80)	// not UTF code sequence 10xxxxxx
 		{
 			if (c <= 32 && isspace(c))
@@ -416,7 +1724,7 @@ TextEditor::Coordinates TextEditor::FindWordStart(const Coordinates & aFrom) con
 				cindex++;
 				break;
 			}
-			if (cstart != (PaletteIndex)line[size_t(cindex - 1)].mColorIndex)
+			if (cstart != GetSpanAt(colors, cindex - 1).mColorIndex)
 				break;
 		}
 		--cindex;
@@ -427,28 +1735,30 @@ TextEditor::Coordinates TextEditor::FindWordStart(const Coordinates & aFrom) con
 TextEditor::Coordinates TextEditor::FindWordEnd(const Coordinates & aFrom) const
 {
 	Coordinates at = aFrom;
-	if (at.mLine >= (int)mLines.size())
+	if (at.mLine >= GetTotalLines())
 		return at;
 
-	auto& line = mLines[at.mLine];
+	int size;
+	auto line = GetLineText(at.mLine, &size);
+	auto& colors = mLineInfos[at.mLine].mColors;
 	auto cindex = GetCharacterIndex(at);
 
-	if (cindex >= (int)line.size())
+	if (cindex >= size)
 		return at;
 
-	bool prevspace = (bool)!!isspace(line[cindex].mChar);
-	auto cstart = (PaletteIndex)line[cindex].mColorIndex;
-	while (cindex < (int)line.size())
+	bool prevspace = (bool)!!isspace(line[cindex]);
+	auto cstart = GetSpanAt(colors, cindex).mColorIndex;
+	while (cindex < size)
 	{
-		auto c = line[cindex].mChar;
+		auto c = line[cindex];
 		auto d = UTF8CharLength(c);
-		if (cstart != (PaletteIndex)line[cindex].mColorIndex)
+		if (cstart != GetSpanAt(colors, cindex).mColorIndex)
 			break;
 
 		if (prevspace != !!isspace(c))
 		{
 			if (isspace(c))
-				while (cindex < (int)line.size() && isspace(line[cindex].mChar))
+				while (cindex < size && isspace(line[cindex]))
 					++cindex;
 			break;
 		}
@@ -460,32 +1770,33 @@ TextEditor::Coordinates TextEditor::FindWordEnd(const Coordinates & aFrom) const
 TextEditor::Coordinates TextEditor::FindNextWord(const Coordinates & aFrom) const
 {
 	Coordinates at = aFrom;
-	if (at.mLine >= (int)mLines.size())
+	if (at.mLine >= GetTotalLines())
 		return at;
 
 	// skip to the next non-word character
 	auto cindex = GetCharacterIndex(aFrom);
 	bool isword = false;
 	bool skip = false;
-	if (cindex < (int)mLines[at.mLine].size())
+	int size;
+	auto line = GetLineText(at.mLine, &size);
+	if (cindex < size)
 	{
-		auto& line = mLines[at.mLine];
-		isword = !!isalnum(line[cindex].mChar);
+		isword = !!isalnum(line[cindex]);
 		skip = isword;
 	}
 
 	while (!isword || skip)
 	{
-		if (at.mLine >= mLines.size())
+		if (at.mLine >= GetTotalLines())
 		{
-			auto l = ImMax(0, (int) mLines.size() - 1);
+			auto l = GetTotalLines() - 1;
 			return Coordinates(l, GetLineMaxColumn(l));
 		}
 
-		auto& line = mLines[at.mLine];
-		if (cindex < (int)line.size())
+		line = GetLineText(at.mLine, &size);
+		if (cindex < size)
 		{
-			isword = isalnum(line[cindex].mChar);
+			isword = isalnum(line[cindex]);
 
 			if (isword && !skip)
 				return Coordinates(at.mLine, GetCharacterColumn(at.mLine, cindex));
@@ -507,34 +1818,78 @@ TextEditor::Coordinates TextEditor::FindNextWord(const Coordinates & aFrom) cons
 	return at;
 }
 
+const char* TextEditor::GetLineText(int aLine, int* aSize) const
+{
+	if (aLine < 0 || aLine >= GetTotalLines())
+	{
+		*aSize = 0;
+		return "";
+	}
+	const uint64_t version = mDocument.GetVersion();
+	for (auto& cache : mLineCache)
+	{
+		if (cache.mLine == aLine && cache.mVersion == version)
+		{
+			*aSize = cache.mSize;
+			return cache.mText.data();
+		}
+	}
+	// lines stored in one piece are read in place, the others are assembled in the oldest cache entry
+	auto& cache = mLineCache[mLineCacheNext];
+	auto text = mDocument.GetLine(aLine, aSize, cache.mText);
+	if (text == cache.mText.data())
+	{
+		cache.mLine = aLine;
+		cache.mVersion = version;
+		cache.mSize = *aSize;
+		mLineCacheNext = (mLineCacheNext + 1) % IM_ARRAYSIZE(mLineCache);
+	}
+	return text;
+}
+
+size_t TextEditor::GetOffset(const Coordinates& aCoordinates) const
+{
+	if (aCoordinates.mLine >= GetTotalLines())
+		return mDocument.GetSize();
+	return mDocument.GetLineStart(aCoordinates.mLine) + GetCharacterIndex(aCoordinates);
+}
+
+TextEditor::Coordinates TextEditor::GetCoordinates(size_t aOffset) const
+{
+	const int line = mDocument.GetLineAt(aOffset);
+	return Coordinates(line, GetCharacterColumn(line, (int)(aOffset - mDocument.GetLineStart(line))));
+}
+
 int TextEditor::GetCharacterIndex(const Coordinates& aCoordinates) const
 {
-	if (aCoordinates.mLine >= mLines.size())
+	if (aCoordinates.mLine >= GetTotalLines())
 		return -1;
-	auto& line = mLines[aCoordinates.mLine];
+	int size;
+	auto line = GetLineText(aCoordinates.mLine, &size);
 	int c = 0;
 	int i = 0;
-	for (; i < line.size() && c < aCoordinates.mColumn;)
+	for (; i < size && c < aCoordinates.mColumn;)
 	{
-		if (line[i].mChar == '\t')
+		if (line[i] == '\t')
 			c = (c / mTabSize) * mTabSize + mTabSize;
 		else
 			++c;
-		i += UTF8CharLength(line[i].mChar);
+		i += UTF8CharLength(line[i]);
 	}
-	return i;
+	return ImMin(i, size);
 }
 
 int TextEditor::GetCharacterColumn(int aLine, int aIndex) const
 {
-	if (aLine >= mLines.size())
+	if (aLine >= GetTotalLines())
 		return 0;
-	auto& line = mLines[aLine];
+	int size;
+	auto line = GetLineText(aLine, &size);
 	int col = 0;
 	int i = 0;
-	while (i < aIndex && i < (int)line.size())
+	while (i < aIndex && i < size)
 	{
-		auto c = line[i].mChar;
+		auto c = line[i];
 		i += UTF8CharLength(c);
 		if (c == '\t')
 			col = (col / mTabSize) * mTabSize + mTabSize;
@@ -546,24 +1901,29 @@ int TextEditor::GetCharacterColumn(int aLine, int aIndex) const
 
 int TextEditor::GetLineCharacterCount(int aLine) const
 {
-	if (aLine >= mLines.size())
+	if (aLine >= GetTotalLines())
 		return 0;
-	auto& line = mLines[aLine];
+	int size;
+	auto line = GetLineText(aLine, &size);
 	int c = 0;
-	for (unsigned i = 0; i < line.size(); c++)
-		i += UTF8CharLength(line[i].mChar);
+	for (int i = 0; i < size; c++)
+		i += UTF8CharLength(line[i]);
 	return c;
 }
 
 int TextEditor::GetLineMaxColumn(int aLine) const
 {
-	if (aLine >= mLines.size())
+	if (aLine >= GetTotalLines())
 		return 0;
-	auto& line = mLines[aLine];
+	auto& info = mLineInfos[aLine];
+	if (info.mMetrics == mLineMetrics)
+		return info.mColumns;
+	int size;
+	auto line = GetLineText(aLine, &size);
 	int col = 0;
-	for (unsigned i = 0; i < line.size(); )
+	for (int i = 0; i < size; )
 	{
-		auto c = line[i].mChar;
+		auto c = line[i];
 		if (c == '\t')
 			col = (col / mTabSize) * mTabSize + mTabSize;
 		else
@@ -575,100 +1935,82 @@ int TextEditor::GetLineMaxColumn(int aLine) const
 
 bool TextEditor::IsOnWordBoundary(const Coordinates & aAt) const
 {
-	if (aAt.mLine >= (int)mLines.size() || aAt.mColumn == 0)
+	if (aAt.mLine >= GetTotalLines() || aAt.mColumn == 0)
 		return true;
 
-	auto& line = mLines[aAt.mLine];
+	int size;
+	auto line = GetLineText(aAt.mLine, &size);
 	auto cindex = GetCharacterIndex(aAt);
-	if (cindex >= (int)line.size())
+	if (cindex >= size)
 		return true;
 
 	if (mColorizerEnabled)
-		return line[cindex].mColorIndex != line[size_t(cindex - 1)].mColorIndex;
+	{
+		auto& colors = mLineInfos[aAt.mLine].mColors;
+		return GetSpanAt(colors, cindex).mColorIndex != GetSpanAt(colors, cindex - 1).mColorIndex;
+	}
 
-	return isspace(line[cindex].mChar) != isspace(line[cindex - 1].mChar);
+	return isspace(line[cindex]) != isspace(line[cindex - 1]);
 }
 
-void TextEditor::RemoveLine(int aStart, int aEnd)
+// Markers are keyed by line number, from 1
+void TextEditor::InsertLines(int aIndex, int aCount)
 {
 	assert(!mReadOnly);
-	assert(aEnd >= aStart);
-	assert(mLines.size() > (size_t)(aEnd - aStart));
+
+	mLineInfos.insert(aIndex, aCount);
+	if (mColorizeEnd > aIndex)
+		mColorizeEnd += aCount;
+	if (mColorizeStart > aIndex && mColorizeStart != INT_MAX)
+		mColorizeStart += aCount;
 
 	ErrorMarkers etmp;
 	for (auto& i : mErrorMarkers)
-	{
-		ErrorMarkers::value_type e(i.first >= aStart ? i.first - 1 : i.first, i.second);
-		if (e.first >= aStart && e.first <= aEnd)
-			continue;
-		etmp.insert(e);
-	}
+		etmp.insert(ErrorMarkers::value_type(i.first > aIndex ? i.first + aCount : i.first, i.second));
 	mErrorMarkers = std::move(etmp);
 
 	Breakpoints btmp;
 	for (auto i : mBreakpoints)
-	{
-		if (i >= aStart && i <= aEnd)
-			continue;
-		btmp.insert(i >= aStart ? i - 1 : i);
-	}
+		btmp.insert(i > aIndex ? i + aCount : i);
 	mBreakpoints = std::move(btmp);
-
-	mLines.erase(mLines.begin() + aStart, mLines.begin() + aEnd);
-	assert(!mLines.empty());
-
-	mTextChanged = true;
 }
 
-void TextEditor::RemoveLine(int aIndex)
+void TextEditor::RemoveLines(int aStart, int aEnd)
 {
 	assert(!mReadOnly);
-	assert(mLines.size() > 1);
+	assert(aEnd >= aStart);
+	assert(mLineInfos.size() > aEnd - aStart);
 
 	ErrorMarkers etmp;
 	for (auto& i : mErrorMarkers)
 	{
-		ErrorMarkers::value_type e(i.first > aIndex ? i.first - 1 : i.first, i.second);
-		if (e.first - 1 == aIndex)
+		if (i.first > aStart && i.first <= aEnd)
 			continue;
-		etmp.insert(e);
+		etmp.insert(ErrorMarkers::value_type(i.first > aEnd ? i.first - (aEnd - aStart) : i.first, i.second));
 	}
 	mErrorMarkers = std::move(etmp);
 
 	Breakpoints btmp;
 	for (auto i : mBreakpoints)
 	{
-		if (i == aIndex)
+		if (i > aStart && i <= aEnd)
 			continue;
-		btmp.insert(i >= aIndex ? i - 1 : i);
+		btmp.insert(i > aEnd ? i - (aEnd - aStart) : i);
 	}
 	mBreakpoints = std::move(btmp);
 
-	mLines.erase(mLines.begin() + aIndex);
-	assert(!mLines.empty());
+	if (!mLineWidths.empty())
+		for (int line = aStart; line < aEnd; ++line)
+			InvalidateLineWidth(line);
+	mLineInfos.erase(aStart, aEnd - aStart);
+	if (mColorizeEnd > aStart)
+		mColorizeEnd = ImMax(aStart, mColorizeEnd - (aEnd - aStart));
+	if (mColorizeStart > aStart && mColorizeStart != INT_MAX)
+		mColorizeStart = ImMax(aStart, mColorizeStart - (aEnd - aStart));
 
 	mTextChanged = true;
 }
 
-TextEditor::Line& TextEditor::InsertLine(int aIndex)
-{
-	assert(!mReadOnly);
-
-	auto& result = *mLines.insert(mLines.begin() + aIndex, Line());
-
-	ErrorMarkers etmp;
-	for (auto& i : mErrorMarkers)
-		etmp.insert(ErrorMarkers::value_type(i.first >= aIndex ? i.first + 1 : i.first, i.second));
-	mErrorMarkers = std::move(etmp);
-
-	Breakpoints btmp;
-	for (auto i : mBreakpoints)
-		btmp.insert(i >= aIndex ? i + 1 : i);
-	mBreakpoints = std::move(btmp);
-
-	return result;
-}
-
 std::string TextEditor::GetWordUnderCursor() const
 {
 	auto c = GetCursorPosition();
@@ -685,22 +2027,24 @@ std::string TextEditor::GetWordAt(const Coordinates & aCoords) const
 	auto istart = GetCharacterIndex(start);
 	auto iend = GetCharacterIndex(end);
 
-	for (auto it = istart; it < iend; ++it)
-		r.push_back(mLines[aCoords.mLine][it].mChar);
+	int size;
+	auto line = GetLineText(aCoords.mLine, &size);
+	if (istart >= 0 && istart < iend)
+		r.assign(line + istart, ImMin(iend, size) - istart);
 
 	return r;
 }
 
-ImU32 TextEditor::GetGlyphColor(const Glyph & aGlyph) const
+ImU32 TextEditor::GetGlyphColor(const ColorSpan & aSpan) const
 {
 	if (!mColorizerEnabled)
 		return mPalette[(int)PaletteIndex::Default];
-	if (aGlyph.mComment)
+	if (aSpan.mFlags & GlyphFlags_Comment)
 		return mPalette[(int)PaletteIndex::Comment];
-	if (aGlyph.mMultiLineComment)
+	if (aSpan.mFlags & GlyphFlags_MultiLineComment)
 		return mPalette[(int)PaletteIndex::MultiLineComment];
-	auto const color = mPalette[(int)aGlyph.mColorIndex];
-	if (aGlyph.mPreprocessor)
+	auto const color = mPalette[(int)aSpan.mColorIndex];
+	if (aSpan.mFlags & GlyphFlags_Preprocessor)
 	{
 		const auto ppcolor = mPalette[(int)PaletteIndex::Preprocessor];
 		const int c0 = ((ppcolor & 0xff) + (color & 0xff)) / 2;
@@ -923,10 +2267,18 @@ void TextEditor::Render()
 	}
 
 	assert(mLineBuffer.empty());
+	UpdateFind();
+
+	// the lines are measured again with another font or size
+	if (ImGui::GetFont() != mMetricsFont || ImGui::GetFontSize() != mMetricsFontSize)
+	{
+		mMetricsFont = ImGui::GetFont();
+		mMetricsFontSize = ImGui::GetFontSize();
+		InvalidateLineWidths();
+	}
 
 	auto contentSize = ImGui::GetWindowContentRegionMax();
 	auto drawList = ImGui::GetWindowDrawList();
-	float longest(mTextStart);
 
 	if (mScrollToTop)
 	{
@@ -939,15 +2291,19 @@ void TextEditor::Render()
 	auto scrollY = ImGui::GetScrollY();
 
 	auto lineNo = (int)floor(scrollY / mCharAdvance.y);
-	auto globalLineMax = (int)mLines.size();
-	auto lineMax = ImMax(0, ImMin((int)mLines.size() - 1, lineNo + (int)floor((scrollY + contentSize.y) / mCharAdvance.y)));
+	auto globalLineMax = GetTotalLines();
+	auto lineMax = ImMax(0, ImMin(GetTotalLines() - 1, lineNo + (int)floor((scrollY + contentSize.y) / mCharAdvance.y)));
 
 	// Deduce mTextStart by evaluating mLines size (global lineMax) plus two spaces as text width
 	char buf[16];
 	snprintf(buf, 16, " %d ", globalLineMax);
 	mTextStart = ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, -1.0f, buf, nullptr, nullptr).x + mLeftMargin;
 
-	if (!mLines.empty())
+	mVisibleMatches.clear();
+	if (!mFindQuery.empty())
+		GetFoundMatches(mDocument.GetLineStart(lineNo), mDocument.GetLineEnd(lineMax) + 1, mVisibleMatches);
+	size_t nextMatch = 0;
+
 	{
 		float spaceSize = ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, -1.0f, " ", nullptr, nullptr).x;
 
@@ -956,12 +2312,30 @@ void TextEditor::Render()
 			ImVec2 lineStartScreenPos = ImVec2(cursorScreenPos.x, cursorScreenPos.y + lineNo * mCharAdvance.y);
 			ImVec2 textScreenPos = ImVec2(lineStartScreenPos.x + mTextStart, lineStartScreenPos.y);
 
-			auto& line = mLines[lineNo];
-			longest = ImMax(mTextStart + TextDistanceToLineStart(Coordinates(lineNo, GetLineMaxColumn(lineNo))), longest);
+			const float lineWidth = GetLineWidth(lineNo);
 			auto columnNo = 0;
 			Coordinates lineStartCoord(lineNo, 0);
 			Coordinates lineEndCoord(lineNo, GetLineMaxColumn(lineNo));
 
+			// Draw the matches of the search
+			const size_t lineStart = mDocument.GetLineStart(lineNo);
+			const size_t lineEnd = mDocument.GetLineEnd(lineNo);
+			while (nextMatch < mVisibleMatches.size() && mVisibleMatches[nextMatch].mOffset + mVisibleMatches[nextMatch].mLength <= lineStart)
+				++nextMatch;
+			for (size_t m = nextMatch; m < mVisibleMatches.size() && mVisibleMatches[m].mOffset < lineEnd; ++m)
+			{
+				const auto& match = mVisibleMatches[m];
+				const int from = (int)(ImMax(match.mOffset, lineStart) - lineStart);
+				const int to = (int)(ImMin(match.mOffset + match.mLength, lineEnd) - lineStart);
+				const float mstart = TextDistanceToLineStart(Coordinates(lineNo, GetCharacterColumn(lineNo, from)));
+				float mend = TextDistanceToLineStart(Coordinates(lineNo, GetCharacterColumn(lineNo, to)));
+				if (match.mOffset + match.mLength > lineEnd)
+					mend += mCharAdvance.x;
+				ImVec2 vstart(lineStartScreenPos.x + mTextStart + mstart, lineStartScreenPos.y);
+				ImVec2 vend(lineStartScreenPos.x + mTextStart + mend, lineStartScreenPos.y + mCharAdvance.y);
+				drawList->AddRectFilled(vstart, vend, mPalette[(int)PaletteIndex::FindMatch]);
+			}
+
 			// Draw selection for the current line
 			float sstart = -1.0f;
 			float ssend = -1.0f;
@@ -970,7 +2344,7 @@ void TextEditor::Render()
 			if (mState.mSelectionStart <= lineEndCoord)
 				sstart = mState.mSelectionStart > lineStartCoord ? TextDistanceToLineStart(mState.mSelectionStart) : 0.0f;
 			if (mState.mSelectionEnd > lineStartCoord)
-				ssend = TextDistanceToLineStart(mState.mSelectionEnd < lineEndCoord ? mState.mSelectionEnd : lineEndCoord);
+				ssend = mState.mSelectionEnd < lineEndCoord ? TextDistanceToLineStart(mState.mSelectionEnd) : lineWidth;
 
 			if (mState.mSelectionEnd.mLine > lineNo)
 				ssend += mCharAdvance.x;
@@ -1039,10 +2413,12 @@ void TextEditor::Render()
 						float width = 1.0f;
 						auto cindex = GetCharacterIndex(mState.mCursorPosition);
 						float cx = TextDistanceToLineStart(mState.mCursorPosition);
+						int size;
+						auto line = GetLineText(lineNo, &size);
 
-						if (mOverwrite && cindex < (int)line.size())
+						if (mOverwrite && cindex < size)
 						{
-							auto c = line[cindex].mChar;
+							auto c = line[cindex];
 							if (c == '\t')
 							{
 								auto x = (1.0f + std::floor((1.0f + cx) / (float(mTabSize) * spaceSize))) * (float(mTabSize) * spaceSize);
@@ -1051,7 +2427,7 @@ void TextEditor::Render()
 							else
 							{
 								char buf2[2];
-								buf2[0] = line[cindex].mChar;
+								buf2[0] = line[cindex];
 								buf2[1] = '\0';
 								width = ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, -1.0f, buf2).x;
 							}
@@ -1066,25 +2442,33 @@ void TextEditor::Render()
 			}
 
 			// Render colorized text
-			auto prevColor = line.empty() ? mPalette[(int)PaletteIndex::Default] : GetGlyphColor(line[0]);
+			int size;
+			auto line = GetLineText(lineNo, &size);
+			auto& colors = mLineInfos[lineNo].mColors;
+			ColorSpan span;
+			size_t nextSpan = 0;
+			auto prevColor = size == 0 ? mPalette[(int)PaletteIndex::Default] : GetGlyphColor(GetSpanAt(colors, 0));
 			ImVec2 bufferOffset;
+			float bufferWidth = 0.0f;
 
-			for (int i = 0; i < line.size();)
+			for (int i = 0; i < size;)
 			{
-				auto& glyph = line[i];
-				auto color = GetGlyphColor(glyph);
+				while (nextSpan < colors.size() && colors[nextSpan].mStart <= i)
+					span = colors[nextSpan++];
+				auto c = line[i];
+				auto color = GetGlyphColor(span);
 
-				if ((color != prevColor || glyph.mChar == '\t' || glyph.mChar == ' ') && !mLineBuffer.empty())
+				if ((color != prevColor || c == '\t' || c == ' ') && !mLineBuffer.empty())
 				{
 					const ImVec2 newOffset(textScreenPos.x + bufferOffset.x, textScreenPos.y + bufferOffset.y);
 					drawList->AddText(newOffset, prevColor, mLineBuffer.c_str());
-					auto textSize = ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, -1.0f, mLineBuffer.c_str(), nullptr, nullptr);
-					bufferOffset.x += textSize.x;
+					bufferOffset.x += bufferWidth;
+					bufferWidth = 0.0f;
 					mLineBuffer.clear();
 				}
 				prevColor = color;
 
-				if (glyph.mChar == '\t')
+				if (c == '\t')
 				{
 					auto oldX = bufferOffset.x;
 					bufferOffset.x = (1.0f + std::floor((1.0f + bufferOffset.x) / (float(mTabSize) * spaceSize))) * (float(mTabSize) * spaceSize);
@@ -1124,7 +2508,7 @@ void TextEditor::Render()
 						drawList->AddLine(p2, p4, 0x90909090);
 					}
 				}
-				else if (glyph.mChar == ' ')
+				else if (c == ' ')
 				{
 					if (mShowWhitespaces)
 					{
@@ -1138,9 +2522,10 @@ void TextEditor::Render()
 				}
 				else
 				{
-					auto l = UTF8CharLength(glyph.mChar);
-					while (l-- > 0)
-						mLineBuffer.push_back(line[i++].mChar);
+					auto l = ImMin(UTF8CharLength(c), size - i);
+					mLineBuffer.append(line + i, l);
+					bufferWidth += GetGlyphWidth(line + i, l);
+					i += l;
 				}
 				++columnNo;
 			}
@@ -1190,7 +2575,9 @@ void TextEditor::Render()
 	}
 
 
-	ImGui::Dummy(ImVec2((longest + 2), mLines.size() * mCharAdvance.y));
+	// the content is as wide as the widest line measured so far
+	const float longest = mTextStart + (mLineWidths.empty() ? 0.0f : mLineWidths.rbegin()->first);
+	ImGui::Dummy(ImVec2((longest + 2), GetTotalLines() * mCharAdvance.y));
 
 	if (mScrollToCursor)
 	{
@@ -1237,62 +2624,66 @@ void TextEditor::Render(const char* aTitle, const ImVec2& aSize, bool aBorder)
 
 void TextEditor::SetText(const std::string & aText)
 {
-	mLines.clear();
-	mLines.emplace_back(Line());
-	for (auto chr : aText)
+	StopColorizer();
+	StopFind();
+	if (aText.find('\r') == std::string::npos)
+		mDocument.SetText(aText.data(), aText.size());
+	else
 	{
-		if (chr == '\r')
-		{
-			// ignore the carriage return character
-		}
-		else if (chr == '\n')
-			mLines.emplace_back(Line());
-		else
-		{
-			mLines.back().emplace_back(Glyph(chr, PaletteIndex::Default));
-		}
+		// ignore the carriage return characters
+		std::string text;
+		text.reserve(aText.size());
+		for (auto chr : aText)
+			if (chr != '\r')
+				text.push_back(chr);
+		mDocument.SetText(text.data(), text.size());
 	}
-
-	mTextChanged = true;
-	mScrollToTop = true;
-
-	mUndoBuffer.clear();
-	mUndoIndex = 0;
-
-	Colorize();
+	ResetLines();
 }
 
-void TextEditor::SetTextLines(const std::vector<std::string> & aLines)
+// Opens the file mapped in memory, it is never written and should not be truncated while open
+bool TextEditor::OpenFile(const std::string & aPath)
 {
-	mLines.clear();
-
-	if (aLines.empty())
-	{
-		mLines.emplace_back(Line());
-	}
-	else
-	{
-		mLines.resize(aLines.size());
-
-		for (size_t i = 0; i < aLines.size(); ++i)
-		{
-			const std::string & aLine = aLines[i];
+	StopColorizer();
+	StopFind();
+	if (!mDocument.Open(aPath.c_str()))
+		return false;
+	ResetLines();
+	return true;
+}
 
-			mLines[i].reserve(aLine.size());
-			for (size_t j = 0; j < aLine.size(); ++j)
-				mLines[i].emplace_back(Glyph(aLine[j], PaletteIndex::Default));
-		}
-	}
+void TextEditor::ResetLines()
+{
+	mLineInfos.resize(mDocument.GetLineCount());
+	InvalidateLineWidths();
+	for (auto& cache : mLineCache)
+		cache.mLine = -1;
 
 	mTextChanged = true;
 	mScrollToTop = true;
 
 	mUndoBuffer.clear();
 	mUndoIndex = 0;
+	mUndoMemory = 0;
 
 	Colorize();
 }
 
+void TextEditor::SetTextLines(const std::vector<std::string> & aLines)
+{
+	std::string text;
+	for (size_t i = 0; i < aLines.size(); ++i)
+	{
+		if (i > 0)
+			text.push_back('\n');
+		text += aLines[i];
+	}
+	StopColorizer();
+	StopFind();
+	mDocument.SetText(text.data(), text.size());
+	ResetLines();
+}
+
 void TextEditor::EnterCharacter(ImWchar aChar, bool aShift)
 {
 	assert(!mReadOnly);
@@ -1316,44 +2707,41 @@ void TextEditor::EnterCharacter(ImWchar aChar, bool aShift)
 			//			end.mColumn = end.mLine < mLines.size() ? mLines[end.mLine].size() : 0;
 			if (end.mColumn == 0 && end.mLine > 0)
 				--end.mLine;
-			if (end.mLine >= (int)mLines.size())
-				end.mLine = mLines.empty() ? 0 : (int)mLines.size() - 1;
+			if (end.mLine >= GetTotalLines())
+				end.mLine = GetTotalLines() - 1;
 			end.mColumn = GetLineMaxColumn(end.mLine);
 
 			//if (end.mColumn >= GetLineMaxColumn(end.mLine))
 			//	end.mColumn = GetLineMaxColumn(end.mLine) - 1;
 
-			u.mRemovedStart = start;
-			u.mRemovedEnd = end;
-			u.mRemoved = GetText(start, end);
+			RecordRemovedText(u, start, end);
 
 			bool modified = false;
 
 			for (int i = start.mLine; i <= end.mLine; i++)
 			{
-				auto& line = mLines[i];
+				Coordinates lineStart(i, 0);
 				if (aShift)
 				{
-					if (!line.empty())
+					int size;
+					auto line = GetLineText(i, &size);
+					int count = 0;
+					if (size > 0 && line[0] == '\t')
+						count = 1;
+					else
 					{
-						if (line.front().mChar == '\t')
-						{
-							line.erase(line.begin());
-							modified = true;
-						}
-						else
-						{
-							for (int j = 0; j < mTabSize && !line.empty() && line.front().mChar == ' '; j++)
-							{
-								line.erase(line.begin());
-								modified = true;
-							}
-						}
+						while (count < mTabSize && count < size && line[count] == ' ')
+							++count;
+					}
+					if (count > 0)
+					{
+						DeleteRange(lineStart, Coordinates(i, GetCharacterColumn(i, count)));
+						modified = true;
 					}
 				}
 				else
 				{
-					line.insert(line.begin(), Glyph('\t', TextEditor::PaletteIndex::Background));
+					InsertTextAt(lineStart, "\t");
 					modified = true;
 				}
 			}
@@ -1366,17 +2754,15 @@ void TextEditor::EnterCharacter(ImWchar aChar, bool aShift)
 				{
 					end = Coordinates(end.mLine, GetLineMaxColumn(end.mLine));
 					rangeEnd = end;
-					u.mAdded = GetText(start, end);
 				}
 				else
 				{
 					end = Coordinates(originalEnd.mLine, 0);
 					rangeEnd = Coordinates(end.mLine - 1, GetLineMaxColumn(end.mLine - 1));
-					u.mAdded = GetText(start, rangeEnd);
 				}
 
-				u.mAddedStart = start;
-				u.mAddedEnd = rangeEnd;
+				const size_t offset = GetOffset(start);
+				RecordAddedText(u, offset, GetOffset(rangeEnd) - offset);
 				u.mAfter = mState;
 
 				mState.mSelectionStart = start;
@@ -1384,6 +2770,7 @@ void TextEditor::EnterCharacter(ImWchar aChar, bool aShift)
 				AddUndo(u);
 
 				mTextChanged = true;
+				Colorize(start.mLine, end.mLine - start.mLine + 1);
 
 				EnsureCursorVisible();
 			}
@@ -1392,34 +2779,30 @@ void TextEditor::EnterCharacter(ImWchar aChar, bool aShift)
 		} // c == '\t'
 		else
 		{
-			u.mRemoved = GetSelectedText();
-			u.mRemovedStart = mState.mSelectionStart;
-			u.mRemovedEnd = mState.mSelectionEnd;
+			RecordRemovedText(u, mState.mSelectionStart, mState.mSelectionEnd);
 			DeleteSelection();
 		}
 	} // HasSelection
 
 	auto coord = GetActualCursorCoordinates();
-	u.mAddedStart = coord;
-
-	assert(!mLines.empty());
+	const size_t offset = GetOffset(coord);
+	u.mCoalesce = u.mEdits.empty();
 
 	if (aChar == '\n')
 	{
-		InsertLine(coord.mLine + 1);
-		auto& line = mLines[coord.mLine];
-		auto& newLine = mLines[coord.mLine + 1];
-
+		std::string text(1, '\n');
 		if (mLanguageDefinition.mAutoIndentation)
-			for (size_t it = 0; it < line.size() && isascii(line[it].mChar) && isblank(line[it].mChar); ++it)
-				newLine.push_back(line[it]);
+		{
+			int size;
+			auto line = GetLineText(coord.mLine, &size);
+			for (int it = 0; it < size && isascii(line[it]) && isblank(line[it]); ++it)
+				text.push_back(line[it]);
+		}
 
-		const size_t whitespaceSize = newLine.size();
-		auto cindex = GetCharacterIndex(coord);
-		newLine.insert(newLine.end(), line.begin() + cindex, line.end());
-		line.erase(line.begin() + cindex, line.begin() + line.size());
-		SetCursorPosition(Coordinates(coord.mLine + 1, GetCharacterColumn(coord.mLine + 1, (int)whitespaceSize)));
-		u.mAdded = (char)aChar;
+		auto where = coord;
+		InsertTextAt(where, text.c_str());
+		SetCursorPosition(where);
+		RecordAddedText(u, offset, text.size());
 	}
 	else
 	{
@@ -1428,28 +2811,24 @@ void TextEditor::EnterCharacter(ImWchar aChar, bool aShift)
 		if (e > 0)
 		{
 			buf[e] = '\0';
-			auto& line = mLines[coord.mLine];
+			int size;
+			auto line = GetLineText(coord.mLine, &size);
 			auto cindex = GetCharacterIndex(coord);
 
-			if (mOverwrite && cindex < (int)line.size())
+			if (mOverwrite && cindex < size)
 			{
-				auto d = UTF8CharLength(line[cindex].mChar);
+				auto d = ImMin(UTF8CharLength(line[cindex]), size - cindex);
 
-				u.mRemovedStart = mState.mCursorPosition;
-				u.mRemovedEnd = Coordinates(coord.mLine, GetCharacterColumn(coord.mLine, cindex + d));
-
-				while (d-- > 0 && cindex < (int)line.size())
-				{
-					u.mRemoved += line[cindex].mChar;
-					line.erase(line.begin() + cindex);
-				}
+				const Coordinates removedEnd(coord.mLine, GetCharacterColumn(coord.mLine, cindex + d));
+				RecordRemovedText(u, coord, removedEnd);
+				DeleteRange(coord, removedEnd);
 			}
 
-			for (auto p = buf; *p != '\0'; p++, ++cindex)
-				line.insert(line.begin() + cindex, Glyph(*p, PaletteIndex::Default));
-			u.mAdded = buf;
+			auto where = coord;
+			InsertTextAt(where, buf);
+			RecordAddedText(u, offset, e);
 
-			SetCursorPosition(Coordinates(coord.mLine, GetCharacterColumn(coord.mLine, cindex)));
+			SetCursorPosition(where);
 		}
 		else
 			return;
@@ -1457,7 +2836,6 @@ void TextEditor::EnterCharacter(ImWchar aChar, bool aShift)
 
 	mTextChanged = true;
 
-	u.mAddedEnd = GetActualCursorCoordinates();
 	u.mAfter = mState;
 
 	AddUndo(u);
@@ -1481,6 +2859,14 @@ void TextEditor::SetColorizerEnable(bool aValue)
 	mColorizerEnabled = aValue;
 }
 
+void TextEditor::SetColorizerThreaded(bool aValue)
+{
+	if (mColorizerThreaded == aValue)
+		return;
+	StopColorizer();
+	mColorizerThreaded = aValue;
+}
+
 void TextEditor::SetCursorPosition(const Coordinates & aPosition)
 {
 	if (mState.mCursorPosition != aPosition)
@@ -1529,7 +2915,6 @@ void TextEditor::SetSelection(const Coordinates & aStart, const Coordinates & aE
 	case TextEditor::SelectionMode::Line:
 	{
 		const auto lineNo = mState.mSelectionEnd.mLine;
-		const auto lineSize = (size_t)lineNo < mLines.size() ? mLines[lineNo].size() : 0;
 		mState.mSelectionStart = Coordinates(mState.mSelectionStart.mLine, 0);
 		mState.mSelectionEnd = Coordinates(lineNo, GetLineMaxColumn(lineNo));
 		break;
@@ -1546,6 +2931,7 @@ void TextEditor::SetSelection(const Coordinates & aStart, const Coordinates & aE
 void TextEditor::SetTabSize(int aValue)
 {
 	mTabSize = ImMax(0, ImMin(32, aValue));
+	InvalidateLineWidths();
 }
 
 void TextEditor::InsertText(const std::string & aValue)
@@ -1613,7 +2999,7 @@ void TextEditor::MoveDown(int aAmount, bool aSelect)
 {
 	assert(mState.mCursorPosition.mColumn >= 0);
 	auto oldPos = mState.mCursorPosition;
-	mState.mCursorPosition.mLine = ImMax(0, ImMin((int)mLines.size() - 1, mState.mCursorPosition.mLine + aAmount));
+	mState.mCursorPosition.mLine = ImMax(0, ImMin(GetTotalLines() - 1, mState.mCursorPosition.mLine + aAmount));
 
 	if (mState.mCursorPosition != oldPos)
 	{
@@ -1644,9 +3030,6 @@ static bool IsUTFSequence(char c)
 
 void TextEditor::MoveLeft(int aAmount, bool aSelect, bool aWordMode)
 {
-	if (mLines.empty())
-		return;
-
 	auto oldPos = mState.mCursorPosition;
 	mState.mCursorPosition = GetActualCursorCoordinates();
 	auto line = mState.mCursorPosition.mLine;
@@ -1659,10 +3042,7 @@ void TextEditor::MoveLeft(int aAmount, bool aSelect, bool aWordMode)
 			if (line > 0)
 			{
 				--line;
-				if ((int)mLines.size() > line)
-					cindex = (int)mLines[line].size();
-				else
-					cindex = 0;
+				GetLineText(line, &cindex);
 			}
 		}
 		else
@@ -1670,11 +3050,10 @@ void TextEditor::MoveLeft(int aAmount, bool aSelect, bool aWordMode)
 			--cindex;
 			if (cindex > 0)
 			{
-				if ((int)mLines.size() > line)
-				{
-					while (cindex > 0 && IsUTFSequence(mLines[line][cindex].mChar))
-						--cindex;
-				}
+				int size;
+				auto text = GetLineText(line, &size);
+				while (cindex > 0 && cindex < size && IsUTFSequence(text[cindex]))
+					--cindex;
 			}
 		}
 
@@ -1712,20 +3091,21 @@ void TextEditor::MoveRight(int aAmount, bool aSelect, bool aWordMode)
 {
 	auto oldPos = mState.mCursorPosition;
 
-	if (mLines.empty() || oldPos.mLine >= mLines.size())
+	if (oldPos.mLine >= GetTotalLines())
 		return;
 
 	auto cindex = GetCharacterIndex(mState.mCursorPosition);
 	while (aAmount-- > 0)
 	{
 		auto lindex = mState.mCursorPosition.mLine;
-		auto& line = mLines[lindex];
+		int size;
+		auto line = GetLineText(lindex, &size);
 
-		if (cindex >= line.size())
+		if (cindex >= size)
 		{
-			if (mState.mCursorPosition.mLine < mLines.size() - 1)
+			if (mState.mCursorPosition.mLine < GetTotalLines() - 1)
 			{
-				mState.mCursorPosition.mLine = ImMax(0, ImMin((int)mLines.size() - 1, mState.mCursorPosition.mLine + 1));
+				mState.mCursorPosition.mLine = ImMax(0, ImMin(GetTotalLines() - 1, mState.mCursorPosition.mLine + 1));
 				mState.mCursorPosition.mColumn = 0;
 			}
 			else
@@ -1733,7 +3113,7 @@ void TextEditor::MoveRight(int aAmount, bool aSelect, bool aWordMode)
 		}
 		else
 		{
-			cindex += UTF8CharLength(line[cindex].mChar);
+			cindex += UTF8CharLength(line[cindex]);
 			mState.mCursorPosition = Coordinates(lindex, GetCharacterColumn(lindex, cindex));
 			if (aWordMode)
 				mState.mCursorPosition = FindNextWord(mState.mCursorPosition);
@@ -1780,7 +3160,7 @@ void TextEditor::MoveTop(bool aSelect)
 void TextEditor::TextEditor::MoveBottom(bool aSelect)
 {
 	auto oldPos = GetCursorPosition();
-	auto newPos = Coordinates((int)mLines.size() - 1, 0);
+	auto newPos = Coordinates(GetTotalLines() - 1, 0);
 	SetCursorPosition(newPos);
 	if (aSelect)
 	{
@@ -1846,50 +3226,38 @@ void TextEditor::Delete()
 {
 	assert(!mReadOnly);
 
-	if (mLines.empty())
-		return;
-
 	UndoRecord u;
 	u.mBefore = mState;
 
 	if (HasSelection())
 	{
-		u.mRemoved = GetSelectedText();
-		u.mRemovedStart = mState.mSelectionStart;
-		u.mRemovedEnd = mState.mSelectionEnd;
-
+		RecordRemovedText(u, mState.mSelectionStart, mState.mSelectionEnd);
 		DeleteSelection();
 	}
 	else
 	{
 		auto pos = GetActualCursorCoordinates();
 		SetCursorPosition(pos);
-		auto& line = mLines[pos.mLine];
 
+		auto end = pos;
 		if (pos.mColumn == GetLineMaxColumn(pos.mLine))
 		{
-			if (pos.mLine == (int)mLines.size() - 1)
+			if (pos.mLine == GetTotalLines() - 1)
 				return;
 
-			u.mRemoved = '\n';
-			u.mRemovedStart = u.mRemovedEnd = GetActualCursorCoordinates();
-			Advance(u.mRemovedEnd);
-
-			auto& nextLine = mLines[pos.mLine + 1];
-			line.insert(line.end(), nextLine.begin(), nextLine.end());
-			RemoveLine(pos.mLine + 1);
+			Advance(end);
 		}
 		else
 		{
+			int size;
+			auto line = GetLineText(pos.mLine, &size);
 			auto cindex = GetCharacterIndex(pos);
-			u.mRemovedStart = u.mRemovedEnd = GetActualCursorCoordinates();
-			u.mRemovedEnd.mColumn++;
-			u.mRemoved = GetText(u.mRemovedStart, u.mRemovedEnd);
-
-			auto d = UTF8CharLength(line[cindex].mChar);
-			while (d-- > 0 && cindex < (int)line.size())
-				line.erase(line.begin() + cindex);
+			auto d = ImMin(UTF8CharLength(line[cindex]), size - cindex);
+			end.mColumn = GetCharacterColumn(pos.mLine, cindex + d);
 		}
+		RecordRemovedText(u, pos, end);
+		u.mCoalesce = true;
+		DeleteRange(pos, end);
 
 		mTextChanged = true;
 
@@ -1904,18 +3272,12 @@ void TextEditor::Backspace()
 {
 	assert(!mReadOnly);
 
-	if (mLines.empty())
-		return;
-
 	UndoRecord u;
 	u.mBefore = mState;
 
 	if (HasSelection())
 	{
-		u.mRemoved = GetSelectedText();
-		u.mRemovedStart = mState.mSelectionStart;
-		u.mRemovedEnd = mState.mSelectionEnd;
-
+		RecordRemovedText(u, mState.mSelectionStart, mState.mSelectionEnd);
 		DeleteSelection();
 	}
 	else
@@ -1923,54 +3285,30 @@ void TextEditor::Backspace()
 		auto pos = GetActualCursorCoordinates();
 		SetCursorPosition(pos);
 
+		Coordinates start, end;
 		if (mState.mCursorPosition.mColumn == 0)
 		{
 			if (mState.mCursorPosition.mLine == 0)
 				return;
 
-			u.mRemoved = '\n';
-			u.mRemovedStart = u.mRemovedEnd = Coordinates(pos.mLine - 1, GetLineMaxColumn(pos.mLine - 1));
-			Advance(u.mRemovedEnd);
-
-			auto& line = mLines[mState.mCursorPosition.mLine];
-			auto& prevLine = mLines[mState.mCursorPosition.mLine - 1];
-			auto prevSize = GetLineMaxColumn(mState.mCursorPosition.mLine - 1);
-			prevLine.insert(prevLine.end(), line.begin(), line.end());
-
-			ErrorMarkers etmp;
-			for (auto& i : mErrorMarkers)
-				etmp.insert(ErrorMarkers::value_type(i.first - 1 == mState.mCursorPosition.mLine ? i.first - 1 : i.first, i.second));
-			mErrorMarkers = std::move(etmp);
-
-			RemoveLine(mState.mCursorPosition.mLine);
-			--mState.mCursorPosition.mLine;
-			mState.mCursorPosition.mColumn = prevSize;
+			start = end = Coordinates(pos.mLine - 1, GetLineMaxColumn(pos.mLine - 1));
+			Advance(end);
 		}
 		else
 		{
-			auto& line = mLines[mState.mCursorPosition.mLine];
+			int size;
+			auto line = GetLineText(pos.mLine, &size);
 			auto cindex = GetCharacterIndex(pos) - 1;
-			auto cend = cindex + 1;
-			while (cindex > 0 && IsUTFSequence(line[cindex].mChar))
+			while (cindex > 0 && IsUTFSequence(line[cindex]))
 				--cindex;
 
-			//if (cindex > 0 && UTF8CharLength(line[cindex].mChar) > 1)
-			//	--cindex;
-
-			u.mRemovedStart = u.mRemovedEnd = GetActualCursorCoordinates();
-			--u.mRemovedStart.mColumn;
-
-			if (line[cindex].mChar == '\t')
-				mState.mCursorPosition.mColumn -= mTabSize;
-			else
-				--mState.mCursorPosition.mColumn;
-
-			while (cindex < line.size() && cend-- > cindex)
-			{
-				u.mRemoved += line[cindex].mChar;
-				line.erase(line.begin() + cindex);
-			}
+			start = Coordinates(pos.mLine, GetCharacterColumn(pos.mLine, cindex));
+			end = pos;
 		}
+		RecordRemovedText(u, start, end);
+		u.mCoalesce = true;
+		DeleteRange(start, end);
+		mState.mCursorPosition = start;
 
 		mTextChanged = true;
 
@@ -1990,7 +3328,7 @@ void TextEditor::SelectWordUnderCursor()
 
 void TextEditor::SelectAll()
 {
-	SetSelection(Coordinates(0, 0), Coordinates((int)mLines.size(), 0));
+	SetSelection(Coordinates(0, 0), Coordinates(GetTotalLines(), 0));
 }
 
 bool TextEditor::HasSelection() const
@@ -2006,14 +3344,10 @@ void TextEditor::Copy()
 	}
 	else
 	{
-		if (!mLines.empty())
-		{
-			std::string str;
-			auto& line = mLines[GetActualCursorCoordinates().mLine];
-			for (auto& g : line)
-				str.push_back(g.mChar);
-			ImGui::SetClipboardText(str.c_str());
-		}
+		int size;
+		auto line = GetLineText(GetActualCursorCoordinates().mLine, &size);
+		std::string str(line, size);
+		ImGui::SetClipboardText(str.c_str());
 	}
 }
 
@@ -2029,9 +3363,7 @@ void TextEditor::Cut()
 		{
 			UndoRecord u;
 			u.mBefore = mState;
-			u.mRemoved = GetSelectedText();
-			u.mRemovedStart = mState.mSelectionStart;
-			u.mRemovedEnd = mState.mSelectionEnd;
+			RecordRemovedText(u, mState.mSelectionStart, mState.mSelectionEnd);
 
 			Copy();
 			DeleteSelection();
@@ -2055,43 +3387,634 @@ void TextEditor::Paste()
 
 		if (HasSelection())
 		{
-			u.mRemoved = GetSelectedText();
-			u.mRemovedStart = mState.mSelectionStart;
-			u.mRemovedEnd = mState.mSelectionEnd;
+			RecordRemovedText(u, mState.mSelectionStart, mState.mSelectionEnd);
 			DeleteSelection();
 		}
 
-		u.mAdded = clipText;
-		u.mAddedStart = GetActualCursorCoordinates();
-
+		const size_t offset = GetOffset(GetActualCursorCoordinates());
+		const size_t size = mDocument.GetSize();
 		InsertText(clipText);
 
-		u.mAddedEnd = GetActualCursorCoordinates();
+		RecordAddedText(u, offset, mDocument.GetSize() - size);
 		u.mAfter = mState;
 		AddUndo(u);
 	}
 }
 
-bool TextEditor::CanUndo() const
+bool TextEditor::CanUndo() const
+{
+	return !mReadOnly && mUndoIndex > 0;
+}
+
+bool TextEditor::CanRedo() const
+{
+	return !mReadOnly && mUndoIndex < (int)mUndoBuffer.size();
+}
+
+void TextEditor::Undo(int aSteps)
+{
+	while (CanUndo() && aSteps-- > 0)
+		mUndoBuffer[--mUndoIndex].Undo(this);
+}
+
+void TextEditor::Redo(int aSteps)
+{
+	while (CanRedo() && aSteps-- > 0)
+		mUndoBuffer[mUndoIndex++].Redo(this);
+}
+
+// Size of the text searched at once by a thread, the chunks end at the start of a line
+static const size_t kFindChunkSize = 4 << 20;
+
+static inline char FoldCase(char c)
+{
+	return c >= 'A' && c <= 'Z' ? (char)(c + ('a' - 'A')) : c;
+}
+
+static inline bool IsWordByte(char c)
+{
+	return isalnum((unsigned char)c) || c == '_' || (unsigned char)c >= 0x80;
+}
+
+static bool EqualLiteral(const char* aText, const char* aQuery, size_t aSize, bool aCaseSensitive)
+{
+	if (aCaseSensitive)
+		return memcmp(aText, aQuery, aSize) == 0;
+	for (size_t i = 0; i < aSize; ++i)
+		if (FoldCase(aText[i]) != aQuery[i])
+			return false;
+	return true;
+}
+
+#ifdef TEXTEDITOR_SSE2
+static inline int CountTrailingZeros(unsigned int aValue)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, aValue);
+	return (int)index;
+#else
+	return __builtin_ctz(aValue);
+#endif
+}
+#endif
+
+// First occurrence of aQuery in [aBegin, aEnd) starting before aLast, the query is in lower case when the case doesn't
+// matter. With SSE2, 16 positions are tested at once against the first and the last byte of the query before comparing
+// the whole query; the case is folded by setting bit 5, which keeps the letters equal to their lower case.
+static const char* FindLiteral(const char* aBegin, const char* aLast, const char* aEnd, const std::string& aQuery, bool aCaseSensitive)
+{
+	const size_t size = aQuery.size();
+	const char* query = aQuery.data();
+	if ((size_t)(aEnd - aBegin) < size)
+		return nullptr;
+	const char* last = ImMin(aLast, aEnd - (size - 1));
+	const char* p = aBegin;
+#ifdef TEXTEDITOR_SSE2
+	const char fold = aCaseSensitive ? 0 : 0x20;
+	const __m128i folds = _mm_set1_epi8(fold);
+	const __m128i first = _mm_set1_epi8((char)(query[0] | fold));
+	const __m128i lastByte = _mm_set1_epi8((char)(query[size - 1] | fold));
+	for (; last - p >= 16; p += 16)
+	{
+		const __m128i a = _mm_or_si128(_mm_loadu_si128((const __m128i*)p), folds);
+		const __m128i b = _mm_or_si128(_mm_loadu_si128((const __m128i*)(p + size - 1)), folds);
+		unsigned int bits = (unsigned int)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, lastByte)));
+		while (bits != 0)
+		{
+			const char* candidate = p + CountTrailingZeros(bits);
+			if (EqualLiteral(candidate, query, size, aCaseSensitive))
+				return candidate;
+			bits &= bits - 1;
+		}
+	}
+#else
+	if (aCaseSensitive)
+	{
+		while (p < last && (p = (const char*)memchr(p, query[0], last - p)) != nullptr)
+		{
+			if (memcmp(p, query, size) == 0)
+				return p;
+			++p;
+		}
+		return nullptr;
+	}
+#endif
+	for (; p < last; ++p)
+		if (EqualLiteral(p, query, size, aCaseSensitive))
+			return p;
+	return nullptr;
+}
+
+bool TextEditor::Find(const std::string& aQuery, const FindOptions& aOptions)
+{
+	StopFind();
+
+	const std::string query(aQuery);
+	mFindQuery = query;
+	mFindOptions = aOptions;
+	mFindVersion = mDocument.GetVersion();
+	mFindChunks.clear();
+	mFindChunksDone = 0;
+	mFindNextChunk = 0;
+	mFindText.mPieces.clear();
+	mFindPieceStarts.clear();
+	mFindScanner.Clear();
+	if (query.empty())
+		return true;
+
+	if (aOptions.mRegex)
+	{
+		// std::regex checks the expression and expands the groups of the replacements, the search runs on the DFA
+		// of the colorizer when the expression compiles to one
+		try
+		{
+			auto flags = std::regex_constants::ECMAScript;
+			if (!aOptions.mCaseSensitive)
+				flags |= std::regex_constants::icase;
+			mFindRegex = std::regex(query, flags);
+		}
+		catch (const std::regex_error&)
+		{
+			mFindQuery.clear();
+			return false;
+		}
+		LanguageDefinition::TokenRegexStrings rules(1, std::make_pair(query, PaletteIndex::Default));
+		mFindScanner.Compile(rules, !aOptions.mCaseSensitive);
+	}
+	else if (!aOptions.mCaseSensitive)
+	{
+		for (auto& c : mFindQuery)
+			c = FoldCase(c);
+	}
+
+	mDocument.GetSnapshot(0, mFindText);
+	size_t size = 0;
+	for (auto& piece : mFindText.mPieces)
+	{
+		mFindPieceStarts.push_back(size);
+		size += piece.second;
+	}
+	mFindPieceStarts.push_back(size);
+
+	for (size_t start = 0; start < size;)
+	{
+		FindChunk chunk;
+		chunk.mStart = start;
+		chunk.mEnd = start + kFindChunkSize >= size ? size : mDocument.GetLineStart(mDocument.GetLineAt(start + kFindChunkSize) + 1);
+		chunk.mDone = false;
+		mFindChunks.push_back(std::move(chunk));
+		start = mFindChunks.back().mEnd;
+	}
+
+	if (mFindChunks.size() == 1)
+	{
+		// small texts are searched right away
+		std::string scratch;
+		SearchChunk(mFindChunks[0], mFindChunks[0].mMatches, scratch, mFindId.load());
+		mFindChunks[0].mDone = true;
+		mFindChunksDone = 1;
+	}
+	else
+	{
+		// the id is taken here, a thread starting after the search was stopped must not see the next one
+		const uint64_t id = mFindId.load();
+		const int threads = ImMin(mFindThreads, (int)mFindChunks.size());
+		for (int i = 0; i < threads; ++i)
+			mFinders.push_back(std::thread(&TextEditor::FindThread, this, id));
+	}
+	return true;
+}
+
+void TextEditor::StopFind()
+{
+	if (mFinders.empty())
+		return;
+	++mFindId;
+	for (auto& finder : mFinders)
+		finder.join();
+	mFinders.clear();
+
+	// an interrupted search starts again on the next frame
+	if (mFindChunksDone < (int)mFindChunks.size())
+		mFindVersion = 0;
+}
+
+void TextEditor::UpdateFind()
+{
+	if (!mFindQuery.empty() && mFindVersion != mDocument.GetVersion())
+	{
+		Find(mFindQuery, mFindOptions);
+	}
+	else if (!mFinders.empty() && !IsFinding())
+	{
+		for (auto& finder : mFinders)
+			finder.join();
+		mFinders.clear();
+	}
+}
+
+void TextEditor::FindThread(uint64_t aId)
+{
+	std::vector<FindMatch> matches;
+	std::string scratch;
+	for (;;)
+	{
+		const int index = mFindNextChunk++;
+		if (index >= (int)mFindChunks.size())
+			break;
+		matches.clear();
+		if (!SearchChunk(mFindChunks[index], matches, scratch, aId))
+			break;
+
+		std::lock_guard<std::mutex> lock(mFindMutex);
+		mFindChunks[index].mMatches.swap(matches);
+		mFindChunks[index].mDone = true;
+		++mFindChunksDone;
+		for (int i = index; i < (int)mFindChunks.size() && mFindChunks[i].mDone; ++i)
+			TrimFindChunk(i);
+	}
+}
+
+// Drops the matches of a chunk starting before the end of the last match of the chunks before it. Literal matches
+// holding a line break can run into the next chunk, which finds its own matches from its start; two matches sharing
+// bytes would be replaced twice. Nothing is dropped until the chunks before are done.
+void TextEditor::TrimFindChunk(int aIndex)
+{
+	size_t end = 0;
+	for (int i = aIndex - 1; i >= 0 && end == 0; --i)
+	{
+		if (!mFindChunks[i].mDone)
+			return;
+		if (!mFindChunks[i].mMatches.empty())
+			end = mFindChunks[i].mMatches.back().mOffset + mFindChunks[i].mMatches.back().mLength;
+	}
+	auto& matches = mFindChunks[aIndex].mMatches;
+	auto first = matches.begin();
+	while (first != matches.end() && first->mOffset < end)
+		++first;
+	matches.erase(matches.begin(), first);
+}
+
+// Appends the matches starting in a chunk, returns false when the search was stopped
+bool TextEditor::SearchChunk(const FindChunk& aChunk, std::vector<FindMatch>& aMatches, std::string& aScratch, uint64_t aId) const
+{
+	const size_t querySize = mFindQuery.size();
+	const bool literal = !mFindOptions.mRegex;
+	const bool wholeWord = mFindOptions.mWholeWord;
+
+	// literal matches may end in the next chunk, the byte after them tells a whole word
+	const size_t start = aChunk.mStart;
+	const size_t end = literal ? ImMin(mFindPieceStarts.back(), aChunk.mEnd + querySize) : aChunk.mEnd;
+
+	// the text is read in place when it lies in one piece
+	int piece = (int)(std::upper_bound(mFindPieceStarts.begin(), mFindPieceStarts.end(), start) - mFindPieceStarts.begin()) - 1;
+	const char* text;
+	if (end <= mFindPieceStarts[piece + 1])
+	{
+		text = mFindText.mPieces[piece].first + (start - mFindPieceStarts[piece]);
+	}
+	else
+	{
+		aScratch.clear();
+		for (size_t from = start; from < end; ++piece)
+		{
+			const size_t to = ImMin(end, mFindPieceStarts[piece + 1]);
+			aScratch.append(mFindText.mPieces[piece].first + (from - mFindPieceStarts[piece]), to - from);
+			from = to;
+		}
+		text = aScratch.data();
+	}
+
+	const char* begin = text;
+	const char* last = text + (aChunk.mEnd - start);
+	const char* stop = text + (end - start);
+	auto isWholeWord = [&](const char* aMatch, const char* aMatchEnd)
+	{
+		return (aMatch == begin || !IsWordByte(aMatch[-1])) && (aMatchEnd == stop || !IsWordByte(*aMatchEnd));
+	};
+
+	if (literal)
+	{
+		const bool caseSensitive = mFindOptions.mCaseSensitive;
+		for (const char* p = begin;;)
+		{
+			const char* match = FindLiteral(p, last, stop, mFindQuery, caseSensitive);
+			if (match == nullptr)
+				break;
+			if (wholeWord && !isWholeWord(match, match + querySize))
+			{
+				p = match + 1;
+				continue;
+			}
+			aMatches.push_back({ start + (size_t)(match - begin), querySize });
+			p = match + querySize;
+			if ((aMatches.size() & 4095) == 0 && mFindId.load(std::memory_order_relaxed) != aId)
+				return false;
+		}
+		return true;
+	}
+
+	// regular expressions match within a line
+	for (const char* line = begin; line < stop;)
+	{
+		const char* lineEnd = (const char*)memchr(line, '\n', stop - line);
+		if (lineEnd == nullptr)
+			lineEnd = stop;
+
+		if (!mFindScanner.IsEmpty())
+		{
+			for (const char* p = line; p < lineEnd;)
+			{
+				const char* matchEnd = nullptr;
+				if (!mFindScanner.CanStart((uint8_t)*p) || mFindScanner.Match(p, lineEnd, matchEnd) < 0 || matchEnd == p ||
+					(wholeWord && !isWholeWord(p, matchEnd)))
+				{
+					++p;
+					continue;
+				}
+				aMatches.push_back({ start + (size_t)(p - begin), (size_t)(matchEnd - p) });
+				p = matchEnd;
+			}
+		}
+		else
+		{
+			for (std::cregex_iterator it(line, lineEnd, mFindRegex), itEnd; it != itEnd; ++it)
+			{
+				const char* p = line + it->position();
+				const char* matchEnd = p + it->length();
+				if (matchEnd != p && (!wholeWord || isWholeWord(p, matchEnd)))
+					aMatches.push_back({ start + (size_t)(p - begin), (size_t)(matchEnd - p) });
+			}
+		}
+
+		line = lineEnd + 1;
+		if (mFindId.load(std::memory_order_relaxed) != aId)
+			return false;
+	}
+	return true;
+}
+
+bool TextEditor::IsFinding() const
+{
+	std::lock_guard<std::mutex> lock(mFindMutex);
+	return !mFinders.empty() && mFindChunksDone < (int)mFindChunks.size();
+}
+
+int TextEditor::GetFindMatchCount() const
+{
+	std::lock_guard<std::mutex> lock(mFindMutex);
+	size_t count = 0;
+	for (auto& chunk : mFindChunks)
+		if (chunk.mDone)
+			count += chunk.mMatches.size();
+	return (int)count;
+}
+
+// Match by index among the matches found so far, in the order of the text
+const TextEditor::FindMatch* TextEditor::GetFoundMatch(int aIndex) const
+{
+	if (aIndex < 0)
+		return nullptr;
+	std::lock_guard<std::mutex> lock(mFindMutex);
+	size_t index = (size_t)aIndex;
+	for (auto& chunk : mFindChunks)
+	{
+		if (!chunk.mDone)
+			continue;
+		if (index < chunk.mMatches.size())
+			return &chunk.mMatches[index];
+		index -= chunk.mMatches.size();
+	}
+	return nullptr;
+}
+
+bool TextEditor::GetFindMatch(int aIndex, Coordinates& aStart, Coordinates& aEnd) const
+{
+	auto match = GetFoundMatch(aIndex);
+	if (match == nullptr)
+		return false;
+	aStart = GetCoordinates(match->mOffset);
+	aEnd = GetCoordinates(match->mOffset + match->mLength);
+	return true;
+}
+
+// Appends the matches found so far that overlap the text from aStart to aEnd
+void TextEditor::GetFoundMatches(size_t aStart, size_t aEnd, std::vector<FindMatch>& aMatches) const
+{
+	auto byOffset = [](const FindMatch& aMatch, size_t aOffset) { return aMatch.mOffset < aOffset; };
+
+	std::lock_guard<std::mutex> lock(mFindMutex);
+	for (auto& chunk : mFindChunks)
+	{
+		if (chunk.mStart >= aEnd)
+			break;
+		if (!chunk.mDone || chunk.mMatches.empty() || chunk.mEnd + mFindQuery.size() <= aStart)
+			continue;
+		auto match = std::lower_bound(chunk.mMatches.begin(), chunk.mMatches.end(), aStart, byOffset);
+		if (match != chunk.mMatches.begin() && (match - 1)->mOffset + (match - 1)->mLength > aStart)
+			--match;
+		for (; match != chunk.mMatches.end() && match->mOffset < aEnd; ++match)
+			aMatches.push_back(*match);
+	}
+}
+
+// First match found from aFrom on, or last one before it, wrapping around the text
+bool TextEditor::GetNextFoundMatch(size_t aFrom, bool aBackward, FindMatch& aMatch) const
+{
+	auto byOffset = [](const FindMatch& aMatch, size_t aOffset) { return aMatch.mOffset < aOffset; };
+	bool found = false;
+
+	std::lock_guard<std::mutex> lock(mFindMutex);
+	if (!aBackward)
+	{
+		for (auto& chunk : mFindChunks)
+		{
+			if (!chunk.mDone || chunk.mMatches.empty())
+				continue;
+			if (!found)
+			{
+				aMatch = chunk.mMatches.front();
+				found = true;
+			}
+			if (chunk.mMatches.back().mOffset >= aFrom)
+			{
+				aMatch = *std::lower_bound(chunk.mMatches.begin(), chunk.mMatches.end(), aFrom, byOffset);
+				break;
+			}
+		}
+	}
+	else
+	{
+		for (auto chunk = mFindChunks.rbegin(); chunk != mFindChunks.rend(); ++chunk)
+		{
+			if (!chunk->mDone || chunk->mMatches.empty())
+				continue;
+			if (!found)
+			{
+				aMatch = chunk->mMatches.back();
+				found = true;
+			}
+			if (chunk->mMatches.front().mOffset < aFrom)
+			{
+				aMatch = *(std::lower_bound(chunk->mMatches.begin(), chunk->mMatches.end(), aFrom, byOffset) - 1);
+				break;
+			}
+		}
+	}
+	return found;
+}
+
+bool TextEditor::FindNext(bool aBackward)
+{
+	UpdateFind();
+
+	FindMatch match;
+	if (!GetNextFoundMatch(GetOffset(aBackward ? mState.mSelectionStart : mState.mSelectionEnd), aBackward, match))
+		return false;
+
+	const auto start = GetCoordinates(match.mOffset);
+	const auto end = GetCoordinates(match.mOffset + match.mLength);
+	SetSelection(start, end);
+	SetCursorPosition(end);
+	return true;
+}
+
+std::string TextEditor::GetReplacement(const FindMatch& aMatch, const std::string& aReplacement, const std::regex* aRegex) const
 {
-	return !mReadOnly && mUndoIndex > 0;
+	if (aRegex == nullptr)
+		return aReplacement;
+
+	std::string text;
+	std::smatch groups;
+	mDocument.GetText(aMatch.mOffset, aMatch.mOffset + aMatch.mLength, text);
+	if (!std::regex_match(text, groups, *aRegex))
+		return aReplacement;
+	return groups.format(aReplacement);
 }
 
-bool TextEditor::CanRedo() const
+bool TextEditor::Replace(const std::string& aReplacement)
 {
-	return !mReadOnly && mUndoIndex < (int)mUndoBuffer.size();
-}
+	UpdateFind();
+	if (mReadOnly || mFindQuery.empty())
+		return false;
 
-void TextEditor::Undo(int aSteps)
-{
-	while (CanUndo() && aSteps-- > 0)
-		mUndoBuffer[--mUndoIndex].Undo(this);
+	// the selection is replaced when it is a match, else the next match is selected
+	const size_t start = GetOffset(mState.mSelectionStart);
+	const size_t end = GetOffset(mState.mSelectionEnd);
+	std::vector<FindMatch> matches;
+	GetFoundMatches(start, end, matches);
+	auto match = std::find_if(matches.begin(), matches.end(),
+		[&](const FindMatch& aMatch) { return aMatch.mOffset == start && aMatch.mOffset + aMatch.mLength == end; });
+	if (match == matches.end())
+		return FindNext();
+
+	const auto text = GetReplacement(*match, aReplacement, mFindOptions.mRegex ? &mFindRegex : nullptr);
+
+	// the match to select next is taken before the search starts again, it moves with the text after the replacement
+	FindMatch next;
+	const bool hasNext = GetNextFoundMatch(end, false, next) && next.mOffset != start;
+
+	UndoRecord u;
+	u.mBefore = mState;
+	auto where = mState.mSelectionStart;
+	RecordRemovedText(u, mState.mSelectionStart, mState.mSelectionEnd);
+	DeleteRange(mState.mSelectionStart, mState.mSelectionEnd);
+	const size_t size = mDocument.GetSize();
+	const int firstLine = where.mLine;
+	InsertTextAt(where, text.c_str());
+	const size_t added = mDocument.GetSize() - size;
+	RecordAddedText(u, start, added);
+
+	if (hasNext)
+	{
+		if (next.mOffset >= end)
+			next.mOffset = next.mOffset + added - (end - start);
+		const auto nextStart = GetCoordinates(next.mOffset);
+		const auto nextEnd = GetCoordinates(next.mOffset + next.mLength);
+		SetSelection(nextStart, nextEnd);
+		SetCursorPosition(nextEnd);
+	}
+	else
+	{
+		SetSelection(where, where);
+		SetCursorPosition(where);
+	}
+	u.mAfter = mState;
+	AddUndo(u);
+	Colorize(firstLine - 1, where.mLine - firstLine + 2);
+
+	Find(mFindQuery, mFindOptions);
+	return true;
 }
 
-void TextEditor::Redo(int aSteps)
+int TextEditor::ReplaceAll(const std::string& aReplacement)
 {
-	while (CanRedo() && aSteps-- > 0)
-		mUndoBuffer[mUndoIndex++].Redo(this);
+	if (mReadOnly || mFindQuery.empty())
+		return 0;
+
+	// waits for the matches of the whole text
+	UpdateFind();
+	for (auto& finder : mFinders)
+		finder.join();
+	mFinders.clear();
+
+	const std::regex* regex = mFindOptions.mRegex ? &mFindRegex : nullptr;
+	UndoRecord u;
+	u.mBefore = mState;
+	std::vector<Document::Piece> pieces;	// of the first literal replacement, shared by the others
+	int count = 0;
+	size_t first = 0, lastEnd = 0;
+	long long delta = 0;
+
+	// from the last match to the first so that the offsets of the matches left stay valid
+	for (auto chunk = mFindChunks.rbegin(); chunk != mFindChunks.rend(); ++chunk)
+	{
+		for (auto match = chunk->mMatches.rbegin(); match != chunk->mMatches.rend(); ++match)
+		{
+			const std::string text = regex != nullptr ? GetReplacement(*match, aReplacement, regex) : std::string();
+			auto where = GetCoordinates(match->mOffset);
+			const auto end = GetCoordinates(match->mOffset + match->mLength);
+			RecordRemovedText(u, where, end);
+			DeleteRange(where, end);
+
+			const size_t size = mDocument.GetSize();
+			if (regex != nullptr)
+			{
+				InsertTextAt(where, text.c_str());
+			}
+			else if (pieces.empty())
+			{
+				InsertTextAt(where, aReplacement.c_str());
+				mDocument.GetPieces(match->mOffset, mDocument.GetSize() - size + match->mOffset, pieces);
+			}
+			else
+			{
+				InsertPiecesAt(where, pieces);
+			}
+			const size_t added = mDocument.GetSize() - size;
+			RecordAddedText(u, match->mOffset, added);
+
+			if (count++ == 0)
+				lastEnd = match->mOffset + match->mLength;
+			first = match->mOffset;
+			delta += (long long)added - (long long)match->mLength;
+		}
+	}
+	if (count == 0)
+		return 0;
+
+	const int firstLine = mDocument.GetLineAt(first);
+	const int lastLine = mDocument.GetLineAt((size_t)((long long)lastEnd + delta));
+	const auto where = GetCoordinates(first);
+	SetSelection(where, where);
+	SetCursorPosition(where);
+	u.mAfter = mState;
+	AddUndo(u);
+	Colorize(firstLine - 1, lastLine - firstLine + 2);
+
+	Find(mFindQuery, mFindOptions);
+	return count;
 }
 
 const TextEditor::Palette & TextEditor::GetDarkPalette()
@@ -2118,6 +4041,7 @@ const TextEditor::Palette & TextEditor::GetDarkPalette()
 			0x40000000, // Current line fill
 			0x40808080, // Current line fill (inactive)
 			0x40a0a0a0, // Current line edge
+			0x6000a0e0, // Find match
 		} };
 	return p;
 }
@@ -2146,6 +4070,7 @@ const TextEditor::Palette & TextEditor::GetLightPalette()
 			0x40000000, // Current line fill
 			0x40808080, // Current line fill (inactive)
 			0x40000000, // Current line edge
+			0x6000c0ff, // Find match
 		} };
 	return p;
 }
@@ -2174,6 +4099,7 @@ const TextEditor::Palette & TextEditor::GetRetroBluePalette()
 			0x40000000, // Current line fill
 			0x40808080, // Current line fill (inactive)
 			0x40000000, // Current line edge
+			0x8000ffff, // Find match
 		} };
 	return p;
 }
@@ -2181,27 +4107,22 @@ const TextEditor::Palette & TextEditor::GetRetroBluePalette()
 
 std::string TextEditor::GetText() const
 {
-	auto lastLine = (int)mLines.size() - 1;
-	auto lastLineLength = GetLineMaxColumn(lastLine);
-	return GetText(Coordinates(), Coordinates(lastLine, lastLineLength));
+	std::string result;
+	mDocument.GetText(0, mDocument.GetSize(), result);
+	return result;
 }
 
 std::vector<std::string> TextEditor::GetTextLines() const
 {
 	std::vector<std::string> result;
 
-	result.reserve(mLines.size());
+	result.reserve(GetTotalLines());
 
-	for (auto & line : mLines)
+	for (int i = 0; i < GetTotalLines(); ++i)
 	{
-		std::string text;
-
-		text.resize(line.size());
-
-		for (size_t i = 0; i < line.size(); ++i)
-			text[i] = line[i].mChar;
-
-		result.emplace_back(std::move(text));
+		int size;
+		auto line = GetLineText(i, &size);
+		result.emplace_back(line, size);
 	}
 
 	return result;
@@ -2226,291 +4147,533 @@ void TextEditor::ProcessInputs()
 
 void TextEditor::Colorize(int aFromLine, int aLines)
 {
-	int toLine = aLines == -1 ? (int)mLines.size() : ImMin((int)mLines.size(), aFromLine + aLines);
-	mColorRangeMin = ImMin(mColorRangeMin, aFromLine);
-	mColorRangeMax = ImMax(mColorRangeMax, toLine);
-	mColorRangeMin = ImMax(0, mColorRangeMin);
-	mColorRangeMax = ImMax(mColorRangeMin, mColorRangeMax);
-	mCheckComments = true;
+	int toLine = aLines == -1 ? GetTotalLines() : ImMin(GetTotalLines(), aFromLine + aLines);
+	// the state at the start of the next line to colorize may be out of date, a new job can't stop before it
+	if (mColorizeStart < GetTotalLines())
+		toLine = ImMax(toLine, mColorizeStart + 1);
+	mColorizeStart = ImMax(0, ImMin(mColorizeStart, aFromLine));
+	mColorizeEnd = ImMax(mColorizeEnd, toLine);
+	mColorizeRestart = true;
 }
 
-void TextEditor::ColorizeRange(int aFromLine, int aToLine)
+// Whether the text of a line at aIndex starts with aString
+static bool MatchesAt(const char* aLine, int aSize, int aIndex, const std::string& aString)
 {
-	if (mLines.empty() || aFromLine >= aToLine)
-		return;
+	return aIndex >= 0 && aIndex + (int)aString.size() <= aSize && memcmp(aLine + aIndex, aString.data(), aString.size()) == 0;
+}
 
-	std::string buffer;
-	std::cmatch results;
-	std::string id;
+// Colors of the bytes from the palette indices of aTokens and the flags of aFlags
+static void MergeSpans(const TextEditor::ColorLine& aTokens, const TextEditor::ColorLine& aFlags, TextEditor::ColorLine& aColors)
+{
+	aColors.clear();
+	TextEditor::ColorSpan token, flags;
+	size_t t = 0, f = 0;
+	while (t < aTokens.size() || f < aFlags.size())
+	{
+		const int start = ImMin(t < aTokens.size() ? aTokens[t].mStart : INT_MAX, f < aFlags.size() ? aFlags[f].mStart : INT_MAX);
+		if (t < aTokens.size() && aTokens[t].mStart == start)
+			token = aTokens[t++];
+		if (f < aFlags.size() && aFlags[f].mStart == start)
+			flags = aFlags[f++];
+		AddSpan(aColors, TextEditor::ColorSpan(start, (TextEditor::PaletteIndex)token.mColorIndex, flags.mFlags));
+	}
+}
 
-	int endLine = ImMax(0, ImMin((int)mLines.size(), aToLine));
-	for (int i = aFromLine; i < endLine; ++i)
+// Colors of a line starting in aState (comments, strings and preprocessor lines, then the tokens), returns the
+// state at the start of the next line. Only reads the language definition, it runs on the colorizer thread.
+uint8_t TextEditor::ColorizeLine(const char* aLine, int aSize, uint8_t aState, ColorLine& aColors, ColorLine& aTokens, ColorLine& aFlags) const
+{
+	auto& startStr = mLanguageDefinition.mCommentStart;
+	auto& singleStartStr = mLanguageDefinition.mSingleLineComment;
+	auto& endStr = mLanguageDefinition.mCommentEnd;
+
+	auto commentStartIndex = (aState & LineState_MultiLineComment) ? -1 : INT_MAX;
+	auto withinString = (aState & LineState_String) != 0;
+	auto withinSingleLineComment = (aState & LineState_SingleLineComment) != 0;
+	auto withinPreproc = (aState & LineState_Preprocessor) != 0;
+	auto firstChar = (aState & LineState_AfterText) == 0;	// there is no other non-whitespace characters in the line before
+	auto concatenate = false;		// '\' on the very end of the line
+
+	aFlags.clear();
+	for (auto currentIndex = 0; currentIndex < aSize; )
 	{
-		auto& line = mLines[i];
+		auto c = aLine[currentIndex];
+		auto next = currentIndex + UTF8CharLength(c);
 
-		if (line.empty())
-			continue;
+		if (c != mLanguageDefinition.mPreprocChar && !isspace(c))
+			firstChar = false;
+
+		if (currentIndex == aSize - 1 && c == '\\')
+			concatenate = true;
 
-		buffer.resize(line.size());
-		for (size_t j = 0; j < line.size(); ++j)
+		bool inComment = commentStartIndex <= currentIndex;
+
+		if (withinString)
 		{
-			auto& col = line[j];
-			buffer[j] = col.mChar;
-			col.mColorIndex = PaletteIndex::Default;
+			if (c == '\"')
+			{
+				// the escaped characters get the flags of the current one
+				if (currentIndex + 1 < aSize && aLine[currentIndex + 1] == '\"')
+					next = currentIndex + 2;
+				else
+					withinString = false;
+			}
+			else if (c == '\\')
+				next = currentIndex + 2;
 		}
+		else
+		{
+			if (firstChar && c == mLanguageDefinition.mPreprocChar)
+				withinPreproc = true;
+
+			if (c == '\"')
+				withinString = true;
+			else
+			{
+				if (!withinSingleLineComment && MatchesAt(aLine, aSize, currentIndex, startStr))
+					commentStartIndex = ImMin(commentStartIndex, currentIndex);
+				else if (singleStartStr.size() > 0 && MatchesAt(aLine, aSize, currentIndex, singleStartStr))
+					withinSingleLineComment = true;
 
-		const char * bufferBegin = &buffer.front();
-		const char * bufferEnd = bufferBegin + buffer.size();
+				inComment = commentStartIndex <= currentIndex;
 
-		auto last = bufferEnd;
+				if (MatchesAt(aLine, aSize, currentIndex + 1 - (int)endStr.size(), endStr))
+					commentStartIndex = INT_MAX;
+			}
+		}
 
-		for (auto first = bufferBegin; first != last; )
-		{
-			const char * token_begin = nullptr;
-			const char * token_end = nullptr;
-			PaletteIndex token_color = PaletteIndex::Default;
+		uint8_t flags = 0;
+		if (inComment)
+			flags |= GlyphFlags_MultiLineComment;
+		if (withinSingleLineComment)
+			flags |= GlyphFlags_Comment;
+		if (withinPreproc)
+			flags |= GlyphFlags_Preprocessor;
+		AddSpan(aFlags, ColorSpan(currentIndex, PaletteIndex::Default, flags));
 
-			bool hasTokenizeResult = false;
+		currentIndex = ImMin(next, aSize);
+	}
+
+	uint8_t nextState = 0;
+	if (commentStartIndex != INT_MAX)
+		nextState |= LineState_MultiLineComment;
+	if (withinString)
+		nextState |= LineState_String;
+	if (concatenate)
+	{
+		if (withinSingleLineComment)
+			nextState |= LineState_SingleLineComment;
+		if (withinPreproc)
+			nextState |= LineState_Preprocessor;
+		if (!firstChar)
+			nextState |= LineState_AfterText;
+	}
+
+	std::cmatch results;
+	aTokens.clear();
+	const char * bufferBegin = aLine;
+	const char * bufferEnd = bufferBegin + aSize;
+	auto last = bufferEnd;
+
+	for (auto first = bufferBegin; first != last; )
+	{
+		const char * token_begin = nullptr;
+		const char * token_end = nullptr;
+		PaletteIndex token_color = PaletteIndex::Default;
 
-			if (mLanguageDefinition.mTokenize != nullptr)
+		bool hasTokenizeResult = false;
+
+		if (mLanguageDefinition.mTokenize != nullptr)
+		{
+			if (mLanguageDefinition.mTokenize(first, last, token_begin, token_end, token_color))
+				hasTokenizeResult = true;
+		}
+
+		if (hasTokenizeResult == false && !mTokenScanner.IsEmpty())
+		{
+			const int rule = mTokenScanner.Match(first, last, token_end);
+			if (rule >= 0)
 			{
-				if (mLanguageDefinition.mTokenize(first, last, token_begin, token_end, token_color))
-					hasTokenizeResult = true;
+				hasTokenizeResult = true;
+				token_begin = first;
+				token_color = mLanguageDefinition.mTokenRegexStrings[rule].second;
 			}
-
-			if (hasTokenizeResult == false)
+		}
+		else if (hasTokenizeResult == false)
+		{
+			for (auto& p : mRegexList)
 			{
-				// todo : remove
-				//printf("using regex for %.*s\n", first + 10 < last ? 10 : int(last - first), first);
-
-				for (auto& p : mRegexList)
+				if (std::regex_search(first, last, results, p.first, std::regex_constants::match_continuous))
 				{
-					if (std::regex_search(first, last, results, p.first, std::regex_constants::match_continuous))
-					{
-						hasTokenizeResult = true;
+					hasTokenizeResult = true;
 
-						auto& v = *results.begin();
-						token_begin = v.first;
-						token_end = v.second;
-						token_color = p.second;
-						break;
-					}
+					auto& v = *results.begin();
+					token_begin = v.first;
+					token_end = v.second;
+					token_color = p.second;
+					break;
 				}
 			}
+		}
 
-			if (hasTokenizeResult == false)
-			{
-				first++;
-			}
-			else
+		if (hasTokenizeResult == false)
+		{
+			first++;
+		}
+		else
+		{
+			if (token_color == PaletteIndex::Identifier)
 			{
-				const size_t token_length = token_end - token_begin;
+				// todo : allmost all language definitions use lower case to specify keywords, so shouldn't this use ::tolower ?
+				const int kinds = mKeywordTable.Find(token_begin, (int)(token_end - token_begin));
 
-				if (token_color == PaletteIndex::Identifier)
+				if (!(GetSpanAt(aFlags, (int)(first - bufferBegin)).mFlags & GlyphFlags_Preprocessor))
 				{
-					id.assign(token_begin, token_end);
-
-					// todo : allmost all language definitions use lower case to specify keywords, so shouldn't this use ::tolower ?
-					if (!mLanguageDefinition.mCaseSensitive)
-						std::transform(id.begin(), id.end(), id.begin(), ::toupper);
-
-					if (!line[first - bufferBegin].mPreprocessor)
-					{
-						if (mLanguageDefinition.mKeywords.count(id) != 0)
-							token_color = PaletteIndex::Keyword;
-						else if (mLanguageDefinition.mIdentifiers.count(id) != 0)
-							token_color = PaletteIndex::KnownIdentifier;
-						else if (mLanguageDefinition.mPreprocIdentifiers.count(id) != 0)
-							token_color = PaletteIndex::PreprocIdentifier;
-					}
-					else
-					{
-						if (mLanguageDefinition.mPreprocIdentifiers.count(id) != 0)
-							token_color = PaletteIndex::PreprocIdentifier;
-					}
+					if (kinds & KeywordTable::Kind_Keyword)
+						token_color = PaletteIndex::Keyword;
+					else if (kinds & KeywordTable::Kind_Identifier)
+						token_color = PaletteIndex::KnownIdentifier;
+					else if (kinds & KeywordTable::Kind_PreprocIdentifier)
+						token_color = PaletteIndex::PreprocIdentifier;
+				}
+				else
+				{
+					if (kinds & KeywordTable::Kind_PreprocIdentifier)
+						token_color = PaletteIndex::PreprocIdentifier;
 				}
+			}
 
-				for (size_t j = 0; j < token_length; ++j)
-					line[(token_begin - bufferBegin) + j].mColorIndex = token_color;
+			// the bytes after the token keep the default color unless another token starts there
+			AddSpan(aTokens, ColorSpan((int)(token_begin - bufferBegin), token_color));
+			AddSpan(aTokens, ColorSpan((int)(token_end - bufferBegin)));
 
-				first = token_end;
-			}
+			first = token_end;
 		}
 	}
+
+	MergeSpans(aTokens, aFlags, aColors);
+	return nextState;
 }
 
-void TextEditor::ColorizeInternal()
+// Colorizes the lines of a job until the end of the text, until a newer job replaces it, for aBudget milliseconds
+// (no limit when 0) or aMaxLines, and publishes the colors by blocks of lines. Returns true when the job is over.
+bool TextEditor::RunColorizeJob(ColorizeJob& aJob, float aBudget, int aMaxLines)
 {
-	if (mLines.empty() || !mColorizerEnabled)
-		return;
-
-	if (mCheckComments)
+	const size_t kBlockLines = 1024;
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds((int64_t)(aBudget * 1000.0f));
+	auto& pieces = aJob.mText.mPieces;
+	ColorLine tokens, flags;
+	std::string scratch;
+	ColorizeBlock block;
+	block.mId = aJob.mId;
+	block.mVersion = aJob.mText.mVersion;
+	block.mFirstLine = aJob.mLine;
+	block.mNextState = 0;
+	block.mLast = false;
+
+	for (int lines = 1; ; ++lines)
 	{
-		auto endLine = mLines.size();
-		auto endIndex = 0;
-		auto commentStartLine = endLine;
-		auto commentStartIndex = endIndex;
-		auto withinString = false;
-		auto withinSingleLineComment = false;
-		auto withinPreproc = false;
-		auto firstChar = true;			// there is no other non-whitespace characters in the line before
-		auto concatenate = false;		// '\' on the very end of the line
-		auto currentLine = 0;
-		auto currentIndex = 0;
-		while (currentLine < endLine || currentIndex < endIndex)
-		{
-			auto& line = mLines[currentLine];
+		if (mColorizeJobId.load(std::memory_order_relaxed) != aJob.mId)
+			return true;
 
-			if (currentIndex == 0 && !concatenate)
+		// the next line, in place when it lies in one piece
+		const char* line = nullptr;
+		size_t size = 0;
+		bool inScratch = false, last = false;
+		scratch.clear();
+		for (;;)
+		{
+			if (aJob.mPiece == pieces.size())
 			{
-				withinSingleLineComment = false;
-				withinPreproc = false;
-				firstChar = true;
+				last = true;
+				break;
 			}
-
-			concatenate = false;
-
-			if (!line.empty())
+			auto& piece = pieces[aJob.mPiece];
+			const char* begin = piece.first + aJob.mOffset;
+			const char* lineEnd = (const char*)memchr(begin, '\n', piece.second - aJob.mOffset);
+			const size_t length = lineEnd != nullptr ? lineEnd - begin : piece.second - aJob.mOffset;
+			if (lineEnd != nullptr && !inScratch)
 			{
-				auto& g = line[currentIndex];
-				auto c = g.mChar;
-
-				if (c != mLanguageDefinition.mPreprocChar && !isspace(c))
-					firstChar = false;
-
-				if (currentIndex == (int)line.size() - 1 && line[line.size() - 1].mChar == '\\')
-					concatenate = true;
+				line = begin;
+				size = length;
+			}
+			else
+			{
+				scratch.append(begin, length);
+				inScratch = true;
+			}
+			aJob.mOffset += length + (lineEnd != nullptr ? 1 : 0);
+			if (aJob.mOffset == piece.second)
+			{
+				++aJob.mPiece;
+				aJob.mOffset = 0;
+			}
+			if (lineEnd != nullptr)
+				break;
+		}
+		if (inScratch)
+		{
+			line = scratch.data();
+			size = scratch.size();
+		}
+		if (size > 0 && line[size - 1] == '\r')
+			--size;
 
-				bool inComment = (commentStartLine < currentLine || (commentStartLine == currentLine && commentStartIndex <= currentIndex));
+		LineInfo info;
+		info.mState = aJob.mState;
+		aJob.mState = ColorizeLine(line, (int)size, aJob.mState, info.mColors, tokens, flags);
+		block.mLines.push_back(std::move(info));
+		++aJob.mLine;
 
-				if (withinString)
-				{
-					line[currentIndex].mMultiLineComment = inComment;
+		const bool late = lines == aMaxLines || (aBudget > 0.0f && (aJob.mLine & 63) == 0 && std::chrono::steady_clock::now() > deadline);
+		if (last || late || block.mLines.size() == kBlockLines)
+		{
+			block.mNextState = aJob.mState;
+			block.mLast = last;
+			{
+				std::lock_guard<std::mutex> lock(mColorizerMutex);
+				if (mColorizeJobId.load() != aJob.mId)
+					return true;
+				mColorizeBlocks.push_back(std::move(block));
+			}
+			if (last)
+				return true;
+			if (late)
+				return false;
+			block.mLines.clear();
+			block.mFirstLine = aJob.mLine;
+		}
+	}
+}
 
-					if (c == '\"')
-					{
-						if (currentIndex + 1 < (int)line.size() && line[currentIndex + 1].mChar == '\"')
-						{
-							currentIndex += 1;
-							if (currentIndex < (int)line.size())
-								line[currentIndex].mMultiLineComment = inComment;
-						}
-						else
-							withinString = false;
-					}
-					else if (c == '\\')
-					{
-						currentIndex += 1;
-						if (currentIndex < (int)line.size())
-							line[currentIndex].mMultiLineComment = inComment;
-					}
-				}
-				else
-				{
-					if (firstChar && c == mLanguageDefinition.mPreprocChar)
-						withinPreproc = true;
+void TextEditor::ColorizerThread()
+{
+	ColorizeJob job;
+	std::unique_lock<std::mutex> lock(mColorizerMutex);
+	for (;;)
+	{
+		mColorizerCondition.wait(lock, [this] { return mColorizerStop || mColorizeJobPending; });
+		if (mColorizerStop)
+			break;
+		std::swap(job, mColorizeJob);
+		mColorizeJobPending = false;
+		lock.unlock();
+		RunColorizeJob(job, 0.0f, INT_MAX);
+		lock.lock();
+	}
+}
 
-					if (c == '\"')
-					{
-						withinString = true;
-						line[currentIndex].mMultiLineComment = inComment;
-					}
-					else
-					{
-						auto pred = [](const char& a, const Glyph& b) { return a == b.mChar; };
-						auto from = line.begin() + currentIndex;
-						auto& startStr = mLanguageDefinition.mCommentStart;
-						auto& singleStartStr = mLanguageDefinition.mSingleLineComment;
+// Waits for the colorizer thread to leave, before the document or the language definition it reads change
+void TextEditor::StopColorizer()
+{
+	{
+		std::lock_guard<std::mutex> lock(mColorizerMutex);
+		mColorizerStop = true;
+		++mColorizeJobId;
+		mColorizeJobPending = false;
+		mColorizeBlocks.clear();
+	}
+	mColorizerCondition.notify_one();
+	if (mColorizer.joinable())
+		mColorizer.join();
+	mColorizerStop = false;
+	mColorizeJob = ColorizeJob();
+	mColorizeRestart = true;
+}
 
-						if (!withinSingleLineComment && currentIndex + startStr.size() <= line.size() &&
-							equals(startStr.begin(), startStr.end(), from, from + startStr.size(), pred))
-						{
-							commentStartLine = currentLine;
-							commentStartIndex = currentIndex;
-						}
-						else if (singleStartStr.size() > 0 &&
-							currentIndex + singleStartStr.size() <= line.size() &&
-							equals(singleStartStr.begin(), singleStartStr.end(), from, from + singleStartStr.size(), pred))
-						{
-							withinSingleLineComment = true;
-						}
+void TextEditor::ColorizeInternal()
+{
+	if (!mColorizerEnabled)
+		return;
 
-						inComment = inComment = (commentStartLine < currentLine || (commentStartLine == currentLine && commentStartIndex <= currentIndex));
+	ApplyColorizeBlocks();
 
-						line[currentIndex].mMultiLineComment = inComment;
-						line[currentIndex].mComment = withinSingleLineComment;
+	// a new job from the first line to colorize replaces the current one after an edit
+	const auto version = mDocument.GetVersion();
+	if (mColorizeStart < GetTotalLines() && (mColorizeRestart || mColorizeVersion != version))
+	{
+		{
+			std::lock_guard<std::mutex> lock(mColorizerMutex);
+			mColorizeEnd = ImMax(mColorizeEnd, mColorizeStart + 1);
+			mColorizeJob = ColorizeJob();
+			mColorizeJob.mId = ++mColorizeJobId;
+			mColorizeJob.mLine = mColorizeStart;
+			mColorizeJob.mState = mLineInfos[mColorizeStart].mState;
+			mDocument.GetSnapshot(mDocument.GetLineStart(mColorizeStart), mColorizeJob.mText);
+			mColorizeJobPending = false;
+			mColorizeBlocks.clear();
+			mColorizeRestart = false;
+			mColorizeVersion = version;
+		}
 
-						auto& endStr = mLanguageDefinition.mCommentEnd;
-						if (currentIndex + 1 >= (int)endStr.size() &&
-							equals(endStr.begin(), endStr.end(), from + 1 - endStr.size(), from + 1, pred))
-						{
-							commentStartIndex = endIndex;
-							commentStartLine = endLine;
-						}
-					}
-				}
-				line[currentIndex].mPreprocessor = withinPreproc;
-				currentIndex += UTF8CharLength(c);
-				if (currentIndex >= (int)line.size())
-				{
-					currentIndex = 0;
-					++currentLine;
-				}
+		// the lines of an edit usually get the same state as before after a few lines, so the job runs here by
+		// steps of more and more lines until it stops or the budget is spent
+		const auto start = std::chrono::steady_clock::now();
+		bool over = false;
+		for (int lines = 16; !over; lines *= 2)
+		{
+			const float elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+			if (elapsed >= mColorizerBudget)
+				break;
+			over = RunColorizeJob(mColorizeJob, mColorizerBudget - elapsed, lines);
+			ApplyColorizeBlocks();
+			over = over || mColorizeJob.mId != mColorizeJobId.load();
+		}
+		if (!over)
+		{
+			{
+				std::lock_guard<std::mutex> lock(mColorizerMutex);
+				mColorizeJobPending = true;
 			}
-			else
+			if (mColorizerThreaded)
 			{
-				currentIndex = 0;
-				++currentLine;
+				if (!mColorizer.joinable())
+					mColorizer = std::thread(&TextEditor::ColorizerThread, this);
+				mColorizerCondition.notify_one();
 			}
 		}
-		mCheckComments = false;
 	}
-
-	if (mColorRangeMin < mColorRangeMax)
+	else if (!mColorizerThreaded && mColorizeJobPending)
 	{
-		const int increment = (mLanguageDefinition.mTokenize == nullptr) ? 10 : 10000;
-		const int to = ImMin(mColorRangeMin + increment, mColorRangeMax);
-		ColorizeRange(mColorRangeMin, to);
-		mColorRangeMin = to;
+		if (RunColorizeJob(mColorizeJob, mColorizerBudget, INT_MAX))
+			mColorizeJobPending = false;
+		ApplyColorizeBlocks();
+	}
+}
 
-		if (mColorRangeMax == mColorRangeMin)
+// Applies the blocks of the current job if the document didn't change since it started, the lines keep their
+// previous colors until then
+void TextEditor::ApplyColorizeBlocks()
+{
+	std::vector<ColorizeBlock> blocks;
+	{
+		std::lock_guard<std::mutex> lock(mColorizerMutex);
+		blocks.swap(mColorizeBlocks);
+	}
+	for (auto& block : blocks)
+	{
+		if (block.mId != mColorizeJobId.load() || block.mVersion != mDocument.GetVersion() || block.mFirstLine != mColorizeStart)
+			continue;
+		for (size_t i = 0; i < block.mLines.size(); ++i)
+		{
+			const int line = block.mFirstLine + (int)i;
+			auto& info = mLineInfos[line];
+			if (line >= mColorizeEnd && (i == 0 ? mColorizeOldState : info.mState) == block.mLines[i].mState)
+			{
+				// the lines from here were colorized from the same state, the job can stop
+				++mColorizeJobId;
+				mColorizeStart = INT_MAX;
+				break;
+			}
+			info.mColors = std::move(block.mLines[i].mColors);
+			info.mState = block.mLines[i].mState;
+			mColorizeStart = line + 1;
+		}
+		// a new job would start from the next line in the state the block ends with
+		if (mColorizeStart < GetTotalLines())
 		{
-			mColorRangeMin = INT_MAX;// std::numeric_limits<int>::max();
-			mColorRangeMax = 0;
+			mColorizeOldState = mLineInfos[mColorizeStart].mState;
+			mLineInfos[mColorizeStart].mState = block.mNextState;
+		}
+		else
+		{
+			mColorizeStart = INT_MAX;
+			mColorizeEnd = 0;
 		}
-		return;
 	}
 }
 
 float TextEditor::TextDistanceToLineStart(const Coordinates& aFrom) const
 {
-	auto& line = mLines[aFrom.mLine];
+	int size;
+	auto line = GetLineText(aFrom.mLine, &size);
 	float distance = 0.0f;
 	float spaceSize = ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, -1.0f, " ", nullptr, nullptr).x;
-	int colIndex = GetCharacterIndex(aFrom);
-	for (size_t it = 0u; it < line.size() && it < colIndex; )
+	int colIndex = ImMin(GetCharacterIndex(aFrom), size);
+	for (int it = 0; it < colIndex; )
 	{
-		if (line[it].mChar == '\t')
+		if (line[it] == '\t')
 		{
 			distance = (1.0f + std::floor((1.0f + distance) / (float(mTabSize) * spaceSize))) * (float(mTabSize) * spaceSize);
 			++it;
 		}
 		else
 		{
-			auto d = UTF8CharLength(line[it].mChar);
-			char tempCString[7];
-			int i = 0;
-			for (; i < 6 && d-- > 0 && it < (int)line.size(); i++, it++)
-				tempCString[i] = line[it].mChar;
-
-			tempCString[i] = '\0';
-			distance += ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, -1.0f, tempCString, nullptr, nullptr).x;
+			auto d = ImMin(UTF8CharLength(line[it]), size - it);
+			distance += GetGlyphWidth(line + it, d);
+			it += d;
 		}
 	}
 
 	return distance;
 }
 
+// Advance of one UTF-8 glyph in the current font, as CalcTextSizeA adds them up
+float TextEditor::GetGlyphWidth(const char* aGlyph, int aLength) const
+{
+	unsigned int c = (unsigned char)*aGlyph;
+	if (c >= 0x80)
+		ImTextCharFromUtf8(&c, aGlyph, aGlyph + aLength);
+	else if (c == '\r')
+		return 0.0f;
+	ImFont* font = ImGui::GetFont();
+	return font->GetCharAdvance((ImWchar)c) * (ImGui::GetFontSize() / font->FontSize);
+}
+
+// Width of a line in pixels, it is measured with its columns once after each change of the line, the font or the tab
+// size and then kept in mLineWidths for the size of the content
+float TextEditor::GetLineWidth(int aLine)
+{
+	auto& info = mLineInfos[aLine];
+	if (info.mMetrics == mLineMetrics)
+		return info.mWidth;
+
+	int size;
+	auto line = GetLineText(aLine, &size);
+	const float tabWidth = float(mTabSize) * GetGlyphWidth(" ", 1);
+	float width = 0.0f;
+	int columns = 0;
+	for (int i = 0; i < size;)
+	{
+		if (line[i] == '\t')
+		{
+			width = (1.0f + std::floor((1.0f + width) / tabWidth)) * tabWidth;
+			columns = (columns / mTabSize) * mTabSize + mTabSize;
+			++i;
+		}
+		else
+		{
+			const int length = ImMin(UTF8CharLength(line[i]), size - i);
+			width += GetGlyphWidth(line + i, length);
+			++columns;
+			i += length;
+		}
+	}
+
+	info.mWidth = width;
+	info.mColumns = columns;
+	info.mMetrics = mLineMetrics;
+	++mLineWidths[width];
+	return width;
+}
+
+void TextEditor::InvalidateLineWidth(int aLine)
+{
+	auto& info = mLineInfos[aLine];
+	if (info.mMetrics != mLineMetrics)
+		return;
+	auto it = mLineWidths.find(info.mWidth);
+	if (--it->second == 0)
+		mLineWidths.erase(it);
+	info.mMetrics = 0;
+}
+
+void TextEditor::InvalidateLineWidths()
+{
+	++mLineMetrics;
+	mLineWidths.clear();
+}
+
 void TextEditor::EnsureCursorVisible()
 {
 	if (!mWithinRender)
@@ -2550,67 +4713,59 @@ int TextEditor::GetPageSize() const
 	return (int)floor(height / mCharAdvance.y);
 }
 
-TextEditor::UndoRecord::UndoRecord(
-	const std::string& aAdded,
-	const TextEditor::Coordinates aAddedStart,
-	const TextEditor::Coordinates aAddedEnd,
-	const std::string& aRemoved,
-	const TextEditor::Coordinates aRemovedStart,
-	const TextEditor::Coordinates aRemovedEnd,
-	TextEditor::EditorState& aBefore,
-	TextEditor::EditorState& aAfter)
-	: mAdded(aAdded)
-	, mAddedStart(aAddedStart)
-	, mAddedEnd(aAddedEnd)
-	, mRemoved(aRemoved)
-	, mRemovedStart(aRemovedStart)
-	, mRemovedEnd(aRemovedEnd)
-	, mBefore(aBefore)
-	, mAfter(aAfter)
-{
-	assert(mAddedStart <= mAddedEnd);
-	assert(mRemovedStart <= mRemovedEnd);
-}
-
 void TextEditor::UndoRecord::Undo(TextEditor * aEditor)
 {
-	if (!mAdded.empty())
+	for (auto it = mEdits.rbegin(); it != mEdits.rend(); ++it)
 	{
-		aEditor->DeleteRange(mAddedStart, mAddedEnd);
-		aEditor->Colorize(mAddedStart.mLine - 1, mAddedEnd.mLine - mAddedStart.mLine + 2);
-	}
+		auto start = aEditor->GetCoordinates(it->mOffset);
+		if (it->mAddedSize != 0)
+		{
+			const auto end = aEditor->GetCoordinates(it->mOffset + it->mAddedSize);
+			aEditor->DeleteRange(start, end);
+			aEditor->Colorize(start.mLine - 1, end.mLine - start.mLine + 2);
+		}
 
-	if (!mRemoved.empty())
-	{
-		auto start = mRemovedStart;
-		aEditor->InsertTextAt(start, mRemoved.c_str());
-		aEditor->Colorize(mRemovedStart.mLine - 1, mRemovedEnd.mLine - mRemovedStart.mLine + 2);
+		if (it->mRemovedSize != 0)
+		{
+			const int lines = aEditor->InsertPiecesAt(start, it->mRemoved);
+			aEditor->Colorize(start.mLine - lines - 1, lines + 2);
+		}
 	}
 
 	aEditor->mState = mBefore;
 	aEditor->EnsureCursorVisible();
-
 }
 
 void TextEditor::UndoRecord::Redo(TextEditor * aEditor)
 {
-	if (!mRemoved.empty())
+	for (auto& edit : mEdits)
 	{
-		aEditor->DeleteRange(mRemovedStart, mRemovedEnd);
-		aEditor->Colorize(mRemovedStart.mLine - 1, mRemovedEnd.mLine - mRemovedStart.mLine + 1);
-	}
+		auto start = aEditor->GetCoordinates(edit.mOffset);
+		if (edit.mRemovedSize != 0)
+		{
+			aEditor->DeleteRange(start, aEditor->GetCoordinates(edit.mOffset + edit.mRemovedSize));
+			aEditor->Colorize(start.mLine - 1, 2);
+		}
 
-	if (!mAdded.empty())
-	{
-		auto start = mAddedStart;
-		aEditor->InsertTextAt(start, mAdded.c_str());
-		aEditor->Colorize(mAddedStart.mLine - 1, mAddedEnd.mLine - mAddedStart.mLine + 1);
+		if (edit.mAddedSize != 0)
+		{
+			const int lines = aEditor->InsertPiecesAt(start, edit.mAdded);
+			aEditor->Colorize(start.mLine - lines - 1, lines + 2);
+		}
 	}
 
 	aEditor->mState = mAfter;
 	aEditor->EnsureCursorVisible();
 }
 
+size_t TextEditor::UndoRecord::GetMemoryUsage() const
+{
+	size_t size = sizeof(UndoRecord) + mEdits.capacity() * sizeof(UndoEdit);
+	for (auto& edit : mEdits)
+		size += (edit.mAdded.capacity() + edit.mRemoved.capacity()) * sizeof(Document::Piece);
+	return size;
+}
+
 static bool TokenizeCStyleString(const char * in_begin, const char * in_end, const char *& out_begin, const char *& out_end)
 {
 	const char * p = in_begin;
@@ -3117,7 +5272,7 @@ const TextEditor::LanguageDefinition& TextEditor::LanguageDefinition::HLSL()
 		}
 
 		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("[ \\t]*#[ \\t]*[a-zA-Z_]+", PaletteIndex::Preprocessor));
-		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("L?\\\"(\\\\.|[^\\\"])*\\\"", PaletteIndex::String));
+		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("L?\\\"(\\\\.|[^\\\"\\\\])*\\\"", PaletteIndex::String));
 		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("\\'\\\\?[^\\']\\'", PaletteIndex::CharLiteral));
 		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("[+-]?([0-9]+([.][0-9]*)?|[.][0-9]+)([eE][+-]?[0-9]+)?[fF]?", PaletteIndex::Number));
 		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("[+-]?[0-9]+[Uu]?[lL]?[lL]?", PaletteIndex::Number));
@@ -3166,7 +5321,7 @@ const TextEditor::LanguageDefinition& TextEditor::LanguageDefinition::GLSL()
 		}
 
 		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("[ \\t]*#[ \\t]*[a-zA-Z_]+", PaletteIndex::Preprocessor));
-		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("L?\\\"(\\\\.|[^\\\"])*\\\"", PaletteIndex::String));
+		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("L?\\\"(\\\\.|[^\\\"\\\\])*\\\"", PaletteIndex::String));
 		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("\\'\\\\?[^\\']\\'", PaletteIndex::CharLiteral));
 		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("[+-]?([0-9]+([.][0-9]*)?|[.][0-9]+)([eE][+-]?[0-9]+)?[fF]?", PaletteIndex::Number));
 		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("[+-]?[0-9]+[Uu]?[lL]?[lL]?", PaletteIndex::Number));
@@ -3296,7 +5451,7 @@ const TextEditor::LanguageDefinition& TextEditor::LanguageDefinition::SQL()
 			langDef.mIdentifiers.insert(std::make_pair(std::string(k), id));
 		}
 
-		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("L?\\\"(\\\\.|[^\\\"])*\\\"", PaletteIndex::String));
+		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("L?\\\"(\\\\.|[^\\\"\\\\])*\\\"", PaletteIndex::String));
 		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("\\\'[^\\\']*\\\'", PaletteIndex::String));
 		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("[+-]?([0-9]+([.][0-9]*)?|[.][0-9]+)([eE][+-]?[0-9]+)?[fF]?", PaletteIndex::Number));
 		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("[+-]?[0-9]+[Uu]?[lL]?[lL]?", PaletteIndex::Number));
@@ -3346,7 +5501,7 @@ const TextEditor::LanguageDefinition& TextEditor::LanguageDefinition::AngelScrip
 			langDef.mIdentifiers.insert(std::make_pair(std::string(k), id));
 		}
 
-		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("L?\\\"(\\\\.|[^\\\"])*\\\"", PaletteIndex::String));
+		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("L?\\\"(\\\\.|[^\\\"\\\\])*\\\"", PaletteIndex::String));
 		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("\\'\\\\?[^\\']\\'", PaletteIndex::String));
 		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("[+-]?([0-9]+([.][0-9]*)?|[.][0-9]+)([eE][+-]?[0-9]+)?[fF]?", PaletteIndex::Number));
 		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("[+-]?[0-9]+[Uu]?[lL]?[lL]?", PaletteIndex::Number));
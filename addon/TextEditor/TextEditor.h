@@ -2,12 +2,18 @@
 
 #include <string>
 #include <vector>
+#include <deque>
+#include <algorithm>
 #include <array>
 #include <memory>
 #include <unordered_set>
 #include <unordered_map>
 #include <map>
 #include <regex>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 #include "imgui.h"
 
 class IMGUI_API TextEditor
@@ -36,6 +42,7 @@ public:
 		CurrentLineFill,
 		CurrentLineFillInactive,
 		CurrentLineEdge,
+		FindMatch,
 		Max
 	};
 
@@ -46,6 +53,18 @@ public:
 		Line
 	};
 
+	// Options of a search: the query is a regular expression, its letter case matters, it matches whole words only.
+	// Matches of regular expressions don't span lines.
+	struct FindOptions
+	{
+		bool mRegex;
+		bool mCaseSensitive;
+		bool mWholeWord;
+
+		FindOptions(bool aRegex = false, bool aCaseSensitive = true, bool aWholeWord = false)
+			: mRegex(aRegex), mCaseSensitive(aCaseSensitive), mWholeWord(aWholeWord) {}
+	};
+
 	struct Breakpoint
 	{
 		int mLine;
@@ -133,6 +152,30 @@ public:
 	typedef std::array<ImU32, (unsigned)PaletteIndex::Max> Palette;
 	typedef uint8_t Char;
 
+	enum GlyphFlags
+	{
+		GlyphFlags_Comment = 1 << 0,
+		GlyphFlags_MultiLineComment = 1 << 1,
+		GlyphFlags_Preprocessor = 1 << 2
+	};
+
+	// Colors of a line are stored as runs of bytes sharing the same palette index and flags,
+	// a span lasts until the start of the next one or the end of the line.
+	struct ColorSpan
+	{
+		int mStart;
+		uint8_t mColorIndex;	// PaletteIndex
+		uint8_t mFlags;			// GlyphFlags
+
+		ColorSpan(int aStart = 0, PaletteIndex aColorIndex = PaletteIndex::Default, uint8_t aFlags = 0)
+			: mStart(aStart), mColorIndex((uint8_t)aColorIndex), mFlags(aFlags) {}
+		bool SameColor(const ColorSpan& o) const { return mColorIndex == o.mColorIndex && mFlags == o.mFlags; }
+	};
+
+	typedef std::vector<ColorSpan> ColorLine;
+
+	// A byte and its color as lines were stored before the piece table, kept for code built against these types.
+	// The editor doesn't use them anymore.
 	struct Glyph
 	{
 		Char mChar;
@@ -148,6 +191,114 @@ public:
 	typedef std::vector<Glyph> Line;
 	typedef std::vector<Line> Lines;
 
+	// Text of the editor as a piece table: the original text (a copy, or a read only mapping of a file) is never
+	// modified, inserted text is appended to add buffers, and the document is the sequence of pieces of these buffers.
+	// Pieces live in a balanced tree indexed by byte offset and line break count, so finding a line, inserting and
+	// erasing cost O(log pieces) whatever the size of the document. Bytes never move once stored.
+	// Lines end with '\n', a '\r' before it is kept in the text but not reported as part of the line.
+	class IMGUI_API Document
+	{
+	public:
+		// Text from an offset to the end as pieces of the buffers. Bytes never move once stored, so the pieces
+		// stay valid while the document is edited, until it is cleared, set or opened again.
+		struct Snapshot
+		{
+			std::vector<std::pair<const char*, size_t>> mPieces;
+			uint64_t mVersion;
+
+			Snapshot() : mVersion(0) {}
+		};
+
+		// Bytes of a buffer, text erased from the document stays in its buffer and can be inserted again
+		struct Piece
+		{
+			int mBuffer;
+			size_t mStart, mLength;
+		};
+
+		Document();
+		~Document();
+
+		void SetText(const char* aText, size_t aSize);
+		bool Open(const char* aPath);
+		void Clear();
+
+		size_t GetSize() const { return mNodes[mRoot].mTotalLength; }
+		int GetLineCount() const { return (int)mNodes[mRoot].mTotalBreaks + 1; }
+		size_t GetLineStart(int aLine) const;
+		size_t GetLineEnd(int aLine) const;
+		int GetLineAt(size_t aOffset) const;
+		char GetChar(size_t aOffset) const;
+		// Bytes of a line without its line break, points into the buffers when the line is stored in one piece
+		// or into aScratch otherwise
+		const char* GetLine(int aLine, int* aSize, std::string& aScratch) const;
+		void GetText(size_t aStart, size_t aEnd, std::string& aOut) const;
+		void GetSnapshot(size_t aFrom, Snapshot& aOut) const;
+		// Appends the pieces of the text from aStart to aEnd to aOut, they stay valid until the document is
+		// cleared, set or opened again
+		void GetPieces(size_t aStart, size_t aEnd, std::vector<Piece>& aOut) const;
+		const char* GetPieceText(const Piece& aPiece) const { return mBuffers[aPiece.mBuffer].mData + aPiece.mStart; }
+		size_t CountLineBreaks(const Piece& aPiece, size_t* aLastBreak) const;
+
+		void Insert(size_t aOffset, const char* aText, size_t aSize);
+		void InsertPieces(size_t aOffset, const Piece* aPieces, size_t aCount);
+		void Erase(size_t aStart, size_t aEnd);
+
+		int GetPieceCount() const { return (int)(mNodes.size() - mFreeNodes.size()) - 1; }
+		size_t GetMemoryUsage() const;
+		bool IsMapped() const { return mMapped; }
+		uint64_t GetVersion() const { return mVersion; }
+
+	private:
+		struct Buffer
+		{
+			char* mData;
+			size_t mSize;
+			size_t mCapacity;
+			std::vector<size_t> mLineBreaks;	// offsets of the '\n' of the buffer
+
+			Buffer() : mData(nullptr), mSize(0), mCapacity(0) {}
+		};
+
+		struct Node
+		{
+			int mLeft, mRight;
+			unsigned int mPriority;
+			int mBuffer;
+			size_t mStart, mLength;				// bytes of the buffer
+			size_t mFirstBreak, mBreaks;		// line breaks of the buffer inside the piece
+			size_t mTotalLength, mTotalBreaks;	// of the subtree
+
+			Node() : mLeft(0), mRight(0), mPriority(0), mBuffer(0), mStart(0), mLength(0), mFirstBreak(0), mBreaks(0), mTotalLength(0), mTotalBreaks(0) {}
+		};
+
+		Document(const Document&);
+		Document& operator=(const Document&);
+
+		int NewNode(int aBuffer, size_t aStart, size_t aLength);
+		void FreeNodes(int aNode);
+		void SetPiece(int aNode, size_t aStart, size_t aLength);
+		void Update(int aNode);
+		void Split(int aNode, size_t aOffset, int& aLeft, int& aRight);
+		int Merge(int aLeft, int aRight);
+		bool ExtendLast(int aNode, int aBuffer, size_t aStart, size_t aLength);
+		int FindPiece(size_t aOffset, size_t* aPieceStart) const;
+		void CollectText(int aNode, size_t aBase, size_t aStart, size_t aEnd, std::string& aOut) const;
+		void CollectPieces(int aNode, size_t aBase, size_t aStart, Snapshot& aOut) const;
+		void CollectPieces(int aNode, size_t aBase, size_t aStart, size_t aEnd, std::vector<Piece>& aOut) const;
+		void Append(const char* aText, size_t aSize, int* aBuffer, size_t* aStart);
+		void IndexBuffer(Buffer& aBuffer, size_t aFrom);
+
+		std::vector<Buffer> mBuffers;		// [0] holds the original text, then the add buffers
+		std::vector<Node> mNodes;			// [0] is the empty tree
+		std::vector<int> mFreeNodes;
+		int mRoot;
+		unsigned int mSeed;
+		bool mMapped;
+		size_t mMappedSize;
+		uint64_t mVersion;
+	};
+
 	struct IMGUI_API LanguageDefinition
 	{
 		typedef std::pair<std::string, PaletteIndex> TokenRegexString;
@@ -196,7 +347,9 @@ public:
 
 	void Render(const char* aTitle, const ImVec2& aSize = ImVec2(), bool aBorder = false);
 	void SetText(const std::string& aText);
+	bool OpenFile(const std::string& aPath);
 	std::string GetText() const;
+	const Document& GetDocument() const { return mDocument; }
 
 	void SetTextLines(const std::vector<std::string>& aLines);
 	std::vector<std::string> GetTextLines() const;
@@ -204,7 +357,7 @@ public:
 	std::string GetSelectedText() const;
 	std::string GetCurrentLineText()const;
 
-	int GetTotalLines() const { return (int)mLines.size(); }
+	int GetTotalLines() const { return mDocument.GetLineCount(); }
 	bool IsOverwrite() const { return mOverwrite; }
 
 	void SetReadOnly(bool aValue);
@@ -215,6 +368,12 @@ public:
 
 	bool IsColorizerEnabled() const { return mColorizerEnabled; }
 	void SetColorizerEnable(bool aValue);
+	// Lines are colorized by a thread of the editor, or during the frames when it's disabled
+	void SetColorizerThreaded(bool aValue);
+	bool IsColorizerThreaded() const { return mColorizerThreaded; }
+	// Time spent colorizing in a frame after an edit, longer jobs go on in the thread or in the next frames
+	void SetColorizerBudget(float aMilliseconds) { mColorizerBudget = aMilliseconds; }
+	bool IsColorizing() const { return mColorizeStart < GetTotalLines(); }
 
 	Coordinates GetCursorPosition() const { return GetActualCursorCoordinates(); }
 	void SetCursorPosition(const Coordinates& aPosition);
@@ -265,6 +424,28 @@ public:
 	bool CanRedo() const;
 	void Undo(int aSteps = 1);
 	void Redo(int aSteps = 1);
+	// Searches the text for a query, the matches are highlighted and searched again when the text changes. Large texts
+	// are searched by chunks on threads and the matches come in while the search runs, an empty query stops it.
+	// Returns false when the regular expression is not valid.
+	bool Find(const std::string& aQuery, const FindOptions& aOptions = FindOptions());
+	void ClearFind() { Find(std::string()); }
+	bool IsFinding() const;
+	int GetFindMatchCount() const;
+	bool GetFindMatch(int aIndex, Coordinates& aStart, Coordinates& aEnd) const;
+	// Selects the first match found after the selection, or before it, wrapping around the text
+	bool FindNext(bool aBackward = false);
+	// Replaces the selected match and selects the next one, the replacement of a regular expression may refer to
+	// its groups as $1, $2...
+	bool Replace(const std::string& aReplacement);
+	// Replaces every match once the search is over in one undo step, returns the number of replacements
+	int ReplaceAll(const std::string& aReplacement);
+	void SetFindThreads(int aThreads) { mFindThreads = std::max(1, aThreads); }
+
+	// Heap memory of the undo history, the oldest steps are dropped to keep it under the budget
+	void SetUndoBudget(size_t aBytes);
+	size_t GetUndoBudget() const { return mUndoBudget; }
+	size_t GetUndoMemoryUsage() const { return mUndoMemory; }
+	int GetUndoCount() const { return (int)mUndoBuffer.size(); }
 
 	static const Palette& GetDarkPalette();
 	static const Palette& GetLightPalette();
@@ -273,53 +454,284 @@ public:
 private:
 	typedef std::vector<std::pair<std::regex, PaletteIndex>> RegexList;
 
+	// Array stored in blocks of about kBlockSize items, inserting or erasing items moves the items of one block
+	// and the start indices of the blocks after it. Looking up an item searches the block starts, or reuses the
+	// block of the previous lookup when iterating.
+	template <typename T>
+	class BlockVector
+	{
+	public:
+		BlockVector() : mSize(0), mLast(0) { clear(); }
+
+		int size() const { return mSize; }
+		T& operator[](int aIndex) { const int b = Find(aIndex); return mBlocks[b][aIndex - mStarts[b]]; }
+		const T& operator[](int aIndex) const { const int b = Find(aIndex); return mBlocks[b][aIndex - mStarts[b]]; }
+
+		void clear()
+		{
+			mBlocks.assign(1, std::vector<T>());
+			mStarts.assign(1, 0);
+			mSize = mLast = 0;
+		}
+
+		void resize(int aSize)
+		{
+			clear();
+			insert(0, aSize);
+		}
+
+		void insert(int aIndex, int aCount)
+		{
+			if (aCount <= 0)
+				return;
+			const int b = aIndex == mSize ? (int)mBlocks.size() - 1 : Find(aIndex);
+			auto& block = mBlocks[b];
+			block.insert(block.begin() + (aIndex - mStarts[b]), aCount, T());
+			mSize += aCount;
+			if ((int)block.size() > 2 * kBlockSize)
+			{
+				// split in blocks of kBlockSize items
+				std::vector<std::vector<T>> blocks;
+				for (int i = 0; i < (int)block.size(); i += kBlockSize)
+					blocks.emplace_back(std::make_move_iterator(block.begin() + i), std::make_move_iterator(block.begin() + std::min(i + kBlockSize, (int)block.size())));
+				mBlocks.erase(mBlocks.begin() + b);
+				mBlocks.insert(mBlocks.begin() + b, std::make_move_iterator(blocks.begin()), std::make_move_iterator(blocks.end()));
+				mStarts.resize(mBlocks.size());
+			}
+			UpdateStarts(b + 1);
+		}
+
+		void erase(int aIndex, int aCount)
+		{
+			if (aCount <= 0)
+				return;
+			int b = Find(aIndex);
+			const int first = b;
+			mSize -= aCount;
+			while (aCount > 0)
+			{
+				auto& block = mBlocks[b];
+				const int offset = aIndex - mStarts[b];
+				const int count = std::min(aCount, (int)block.size() - offset);
+				block.erase(block.begin() + offset, block.begin() + offset + count);
+				aCount -= count;
+				aIndex = mStarts[b] + offset + count;	// the starts are updated at the end
+				if (block.empty() && mBlocks.size() > 1)
+				{
+					mBlocks.erase(mBlocks.begin() + b);
+					mStarts.erase(mStarts.begin() + b);
+				}
+				else
+					++b;
+			}
+			UpdateStarts(std::min(first, (int)mBlocks.size() - 1));
+		}
+
+	private:
+		enum { kBlockSize = 1024 };
+
+		int Find(int aIndex) const
+		{
+			if (aIndex >= mStarts[mLast] && aIndex < mStarts[mLast] + (int)mBlocks[mLast].size())
+				return mLast;
+			if (mLast + 1 < (int)mBlocks.size() && aIndex >= mStarts[mLast + 1] && aIndex < mStarts[mLast + 1] + (int)mBlocks[mLast + 1].size())
+				return ++mLast;
+			mLast = (int)(std::upper_bound(mStarts.begin(), mStarts.end(), aIndex) - mStarts.begin()) - 1;
+			mLast = std::max(0, std::min(mLast, (int)mBlocks.size() - 1));
+			return mLast;
+		}
+
+		// Recomputes the starts from aBlock on
+		void UpdateStarts(int aBlock)
+		{
+			mStarts[0] = 0;
+			for (int i = std::max(aBlock, 1); i < (int)mBlocks.size(); ++i)
+				mStarts[i] = mStarts[i - 1] + (int)mBlocks[i - 1].size();
+			mLast = 0;
+		}
+
+		std::vector<std::vector<T>> mBlocks;
+		std::vector<int> mStarts;
+		int mSize;
+		mutable int mLast;
+	};
+
+	// Lexer state at the start of a line, 0 at the start of the text
+	enum LineState
+	{
+		LineState_MultiLineComment = 1 << 0,
+		LineState_String = 1 << 1,
+		LineState_SingleLineComment = 1 << 2,	// continued by a backslash at the end of the previous line
+		LineState_Preprocessor = 1 << 3,
+		LineState_AfterText = 1 << 4			// a preprocessor char no longer starts a directive
+	};
+
+	struct LineInfo
+	{
+		ColorLine mColors;
+		float mWidth;		// in pixels, valid with mColumns while mMetrics is the one of the editor
+		int mColumns;
+		uint32_t mMetrics;
+		uint8_t mState;		// LineState
+
+		LineInfo() : mWidth(0.0f), mColumns(0), mMetrics(0), mState(0) {}
+	};
+
+	typedef BlockVector<LineInfo> LineInfos;
+
+	// Lines to colorize from a snapshot of the document, the job goes on until the end of the text unless a newer
+	// one replaces it or the editor finds a line starting in the same state as before
+	struct ColorizeJob
+	{
+		uint64_t mId;
+		Document::Snapshot mText;	// from the start of mLine
+		size_t mPiece, mOffset;		// position of mLine in the pieces
+		int mLine;
+		uint8_t mState;				// LineState at the start of mLine
+
+		ColorizeJob() : mId(0), mPiece(0), mOffset(0), mLine(0), mState(0) {}
+	};
+
+	// Colors of consecutive lines published by a job, applied if the document is still at the version of the job
+	struct ColorizeBlock
+	{
+		uint64_t mId;
+		uint64_t mVersion;
+		int mFirstLine;
+		std::vector<LineInfo> mLines;	// mState is the state at the start of a line
+		uint8_t mNextState;				// state at the start of the line after the block
+		bool mLast;						// the job reached the end of the text
+	};
+
+	// Token rules of a language definition compiled to one DFA over classes of bytes. A match runs from a position
+	// and reports the longest token, the first rule of the list wins between tokens of the same length. Rules may
+	// use literals, escapes, classes, '.', groups, alternations and the ?, *, +, {n,m} quantifiers, Compile fails
+	// on anything else (anchors, back references, lazy quantifiers) and the rules are left to std::regex.
+	class TokenScanner
+	{
+	public:
+		TokenScanner() : mClassCount(0) {}
+
+		bool Compile(const LanguageDefinition::TokenRegexStrings& aRules, bool aIgnoreCase = false);
+		void Clear();
+		bool IsEmpty() const { return mAccept.empty(); }
+		bool CanStart(uint8_t aByte) const { return mNext[mClasses[aByte]] >= 0; }
+		int Match(const char* aBegin, const char* aEnd, const char*& aTokenEnd) const;
+
+	private:
+		uint8_t mClasses[256];		// class of each byte, bytes of a class go through the same transitions
+		int mClassCount;
+		std::vector<int> mNext;		// next state by state * mClassCount + class, -1 when no token goes further
+		std::vector<int> mAccept;	// rule of the token ending in a state, -1 when none
+	};
+
+	// Perfect hash of the keywords and identifiers of a language definition, a name is found with two hashes and
+	// one comparison. Names are uppercased before the lookup when the language isn't case sensitive.
+	class KeywordTable
+	{
+	public:
+		enum
+		{
+			Kind_Keyword = 1 << 0,
+			Kind_Identifier = 1 << 1,
+			Kind_PreprocIdentifier = 1 << 2
+		};
+
+		void Build(const LanguageDefinition& aLanguage);
+		int Find(const char* aName, int aSize) const;	// Kind flags of a name, 0 when unknown
+
+	private:
+		struct Slot
+		{
+			uint32_t mOffset;
+			uint16_t mSize;
+			uint8_t mKinds;
+		};
+
+		bool mCaseSensitive;
+		std::vector<uint32_t> mSeeds;	// seed of the slot hash by bucket
+		std::vector<Slot> mSlots;
+		std::string mNames;
+	};
+
 	struct EditorState
 	{
 		Coordinates mSelectionStart;
 		Coordinates mSelectionEnd;
 		Coordinates mCursorPosition;
+
+		bool operator ==(const EditorState& o) const
+		{
+			return mSelectionStart == o.mSelectionStart && mSelectionEnd == o.mSelectionEnd && mCursorPosition == o.mCursorPosition;
+		}
 	};
 
-	class UndoRecord
+	// Text added and removed at an offset of the document, kept as pieces of the document buffers so an edit
+	// copies no text whatever its size
+	struct UndoEdit
 	{
-	public:
-		UndoRecord() {}
-		~UndoRecord() {}
+		size_t mOffset;
+		size_t mAddedSize;
+		size_t mRemovedSize;
+		std::vector<Document::Piece> mAdded;
+		std::vector<Document::Piece> mRemoved;
 
-		UndoRecord(
-			const std::string& aAdded,
-			const TextEditor::Coordinates aAddedStart,
-			const TextEditor::Coordinates aAddedEnd,
-
-			const std::string& aRemoved,
-			const TextEditor::Coordinates aRemovedStart,
-			const TextEditor::Coordinates aRemovedEnd,
+		UndoEdit() : mOffset(0), mAddedSize(0), mRemovedSize(0) {}
+	};
 
-			TextEditor::EditorState& aBefore,
-			TextEditor::EditorState& aAfter);
+	class UndoRecord
+	{
+	public:
+		UndoRecord() : mCoalesce(false) {}
 
 		void Undo(TextEditor* aEditor);
 		void Redo(TextEditor* aEditor);
+		size_t GetMemoryUsage() const;
 
-		std::string mAdded;
-		Coordinates mAddedStart;
-		Coordinates mAddedEnd;
-
-		std::string mRemoved;
-		Coordinates mRemovedStart;
-		Coordinates mRemovedEnd;
-
+		std::vector<UndoEdit> mEdits;		// in the order they were made
 		EditorState mBefore;
 		EditorState mAfter;
+		bool mCoalesce;						// a typed or deleted character, merged with the record before it when it follows it
+	};
+
+	typedef std::deque<UndoRecord> UndoBuffer;
+
+	struct FindMatch
+	{
+		size_t mOffset;
+		size_t mLength;
 	};
 
-	typedef std::vector<UndoRecord> UndoBuffer;
+	// Text searched by one thread, from the start of a line to the start of another, with the matches starting in it
+	struct FindChunk
+	{
+		size_t mStart, mEnd;
+		std::vector<FindMatch> mMatches;
+		bool mDone;
+	};
 
 	void ProcessInputs();
 	void Colorize(int aFromLine = 0, int aCount = -1);
-	void ColorizeRange(int aFromLine = 0, int aToLine = 0);
 	void ColorizeInternal();
+	uint8_t ColorizeLine(const char* aLine, int aSize, uint8_t aState, ColorLine& aColors, ColorLine& aTokens, ColorLine& aFlags) const;
+	bool RunColorizeJob(ColorizeJob& aJob, float aBudget, int aMaxLines);
+	void ApplyColorizeBlocks();
+	void ColorizerThread();
+	void StopColorizer();
+	void StopFind();
+	void UpdateFind();
+	void FindThread(uint64_t aId);
+	void TrimFindChunk(int aIndex);
+	bool SearchChunk(const FindChunk& aChunk, std::vector<FindMatch>& aMatches, std::string& aScratch, uint64_t aId) const;
+	const FindMatch* GetFoundMatch(int aIndex) const;
+	void GetFoundMatches(size_t aStart, size_t aEnd, std::vector<FindMatch>& aMatches) const;
+	bool GetNextFoundMatch(size_t aFrom, bool aBackward, FindMatch& aMatch) const;
+	std::string GetReplacement(const FindMatch& aMatch, const std::string& aReplacement, const std::regex* aRegex) const;
 	float TextDistanceToLineStart(const Coordinates& aFrom) const;
+	float GetGlyphWidth(const char* aGlyph, int aLength) const;
+	float GetLineWidth(int aLine);
+	void InvalidateLineWidth(int aLine);
+	void InvalidateLineWidths();
 	void EnsureCursorVisible();
 	int GetPageSize() const;
 	std::string GetText(const Coordinates& aStart, const Coordinates& aEnd) const;
@@ -328,35 +740,61 @@ private:
 	void Advance(Coordinates& aCoordinates) const;
 	void DeleteRange(const Coordinates& aStart, const Coordinates& aEnd);
 	int InsertTextAt(Coordinates& aWhere, const char* aValue);
+	int InsertPiecesAt(Coordinates& aWhere, const std::vector<Document::Piece>& aPieces);
+	void InsertLineColors(int aLine, int aIndex, int aSize, int aLines, int aLastLineSize);
+	void RecordRemovedText(UndoRecord& aRecord, const Coordinates& aStart, const Coordinates& aEnd) const;
+	void RecordAddedText(UndoRecord& aRecord, size_t aOffset, size_t aSize) const;
 	void AddUndo(UndoRecord& aValue);
+	bool CoalesceUndo(UndoRecord& aRecord, const UndoRecord& aNext) const;
+	void EvictUndo();
 	Coordinates ScreenPosToCoordinates(const ImVec2& aPosition, bool aInsertionMode = false) const;
 	Coordinates FindWordStart(const Coordinates& aFrom) const;
 	Coordinates FindWordEnd(const Coordinates& aFrom) const;
 	Coordinates FindNextWord(const Coordinates& aFrom) const;
+	const char* GetLineText(int aLine, int* aSize) const;
+	size_t GetOffset(const Coordinates& aCoordinates) const;
+	Coordinates GetCoordinates(size_t aOffset) const;
 	int GetCharacterIndex(const Coordinates& aCoordinates) const;
 	int GetCharacterColumn(int aLine, int aIndex) const;
 	int GetLineCharacterCount(int aLine) const;
 	int GetLineMaxColumn(int aLine) const;
 	bool IsOnWordBoundary(const Coordinates& aAt) const;
-	void RemoveLine(int aStart, int aEnd);
-	void RemoveLine(int aIndex);
-	Line& InsertLine(int aIndex);
+	void InsertLines(int aIndex, int aCount);
+	void RemoveLines(int aStart, int aEnd);
+	void ResetLines();
 	void EnterCharacter(ImWchar aChar, bool aShift);
 	void Backspace();
 	void DeleteSelection();
 	std::string GetWordUnderCursor() const;
 	std::string GetWordAt(const Coordinates& aCoords) const;
-	ImU32 GetGlyphColor(const Glyph& aGlyph) const;
+	ImU32 GetGlyphColor(const ColorSpan& aSpan) const;
 
 	void HandleKeyboardInputs();
 	void HandleMouseInputs();
 	void Render();
 
+	struct LineCache
+	{
+		int mLine;
+		uint64_t mVersion;
+		int mSize;
+		std::string mText;
+	};
+
 	float mLineSpacing;
-	Lines mLines;
+	Document mDocument;
+	LineInfos mLineInfos;
+	mutable LineCache mLineCache[4];	// lines stored in several pieces
+	mutable int mLineCacheNext;
+	uint32_t mLineMetrics;				// changes with the font and the tab size, the lines are measured again
+	ImFont* mMetricsFont;
+	float mMetricsFontSize;
+	std::map<float, int> mLineWidths;	// number of measured lines by width, the last one is the widest
 	EditorState mState;
 	UndoBuffer mUndoBuffer;
 	int mUndoIndex;
+	size_t mUndoMemory;
+	size_t mUndoBudget;
 
 	int mTabSize;
 	bool mOverwrite;
@@ -369,7 +807,6 @@ private:
 	float mTextStart;                   // position (in pixels) where a code line starts relative to the left of the TextEditor.
 	int  mLeftMargin;
 	bool mCursorPositionChanged;
-	int mColorRangeMin, mColorRangeMax;
 	SelectionMode mSelectionMode;
 	bool mHandleKeyboardInputs;
 	bool mHandleMouseInputs;
@@ -380,9 +817,40 @@ private:
 	Palette mPaletteBase;
 	Palette mPalette;
 	LanguageDefinition mLanguageDefinition;
-	RegexList mRegexList;
-
-	bool mCheckComments;
+	RegexList mRegexList;		// used when the token rules don't compile to mTokenScanner
+	TokenScanner mTokenScanner;
+	KeywordTable mKeywordTable;
+
+	int mColorizeStart, mColorizeEnd;	// lines to colorize, then until a line starts in the same state as before
+	bool mColorizeRestart;					// the lines to colorize changed since the current job started
+	uint64_t mColorizeVersion;				// of the document when the current job started
+	uint8_t mColorizeOldState;				// state of mColorizeStart before the job set it
+	float mColorizerBudget;
+	bool mColorizerThreaded;
+	std::thread mColorizer;
+	std::mutex mColorizerMutex;				// guards the job and the blocks passed to the colorizer thread
+	std::condition_variable mColorizerCondition;
+	ColorizeJob mColorizeJob;
+	bool mColorizeJobPending;
+	bool mColorizerStop;
+	std::atomic<uint64_t> mColorizeJobId;	// of the current job, older jobs stop at their next line
+	std::vector<ColorizeBlock> mColorizeBlocks;
+
+	std::string mFindQuery;				// literals are in lower case when the case doesn't matter
+	FindOptions mFindOptions;
+	uint64_t mFindVersion;				// of the document searched
+	int mFindThreads;
+	TokenScanner mFindScanner;
+	std::regex mFindRegex;				// expands the groups of the replacements, searches when mFindScanner can't
+	Document::Snapshot mFindText;
+	std::vector<size_t> mFindPieceStarts;
+	std::vector<FindChunk> mFindChunks;
+	std::vector<std::thread> mFinders;
+	std::atomic<uint64_t> mFindId;
+	std::atomic<int> mFindNextChunk;
+	int mFindChunksDone;
+	mutable std::mutex mFindMutex;
+	std::vector<FindMatch> mVisibleMatches;
 	Breakpoints mBreakpoints;
 	ErrorMarkers mErrorMarkers;
 	ImVec2 mCharAdvance;
@@ -130,6 +130,7 @@ You can read releases logs https://github.com/epezent/implot/releases for more d
 #include "implot_internal.h"
 
 #include <stdlib.h>
+#include <mutex> // add by Dicky for image rendering
 
 // Support for pre-1.82 versions. Users on 1.82+ can use 0 (default) flags to mean "all corners" but in order to support older versions we are more explicit.
 #if (IMGUI_VERSION_NUM < 18102) && !defined(ImDrawFlags_RoundCornersAll)
@@ -155,7 +156,7 @@ You can read releases logs https://github.com/epezent/implot/releases for more d
 
 // Global plot context
 #ifndef GImPlot
-ImPlotContext* GImPlot = nullptr;
+IMGUI_CONTEXT_STORAGE ImPlotContext* GImPlot = nullptr; // modify by Dicky
 #endif
 
 //-----------------------------------------------------------------------------
@@ -1311,6 +1312,79 @@ void Locator_Time(ImPlotTicker& ticker, const ImPlotRange& range, float pixels,
     }
 }
 
+// add by Dicky for tick cache
+//-----------------------------------------------------------------------------
+// Tick Cache
+//-----------------------------------------------------------------------------
+
+void LocateTicks(ImPlotTicker& ticker, ImPlotLocator locator, const ImPlotRange& range, float pixels, bool vertical, ImPlotFormatter formatter, void* formatter_data) {
+    ImPlotContext& gp = *GImPlot;
+    // custom ticks are already in the ticker and change how the default ones are pruned
+    if (ticker.TickCount() > 0) {
+        locator(ticker, range, pixels, vertical, formatter, formatter_data);
+        return;
+    }
+    ImPlotTickCacheKey key;
+    memset(&key, 0, sizeof(key));
+    key.Locator       = locator;
+    key.Formatter     = formatter;
+    key.FormatterData = formatter_data;
+    key.FormatHash    = (formatter == Formatter_Default && formatter_data != nullptr) ? ImHashStr((const char*)formatter_data) : 0;
+    key.RangeMin      = range.Min;
+    key.RangeMax      = range.Max;
+    key.Pixels        = pixels;
+    key.Vertical      = vertical;
+    key.TimeStyle     = (gp.Style.UseLocalTime ? 1 : 0) | (gp.Style.UseISO8601 ? 2 : 0) | (gp.Style.Use24HourClock ? 4 : 0);
+    key.Font          = ImGui::GetFont();
+    key.FontSize      = ImGui::GetFontSize();
+    const ImGuiID id  = ImHashData(&key, sizeof(key));
+    // the late size of tags only grows the ticker's max size, it's not part of what the locator generates
+    const ImVec2 late_size = ticker.MaxSize;
+    ImPlotTickCacheEntry* entry = gp.TickCache.GetByKey(id);
+    if (entry == nullptr || memcmp(&entry->Key, &key, sizeof(key)) != 0) {
+        if (entry == nullptr) {
+            if (gp.TickCache.GetAliveCount() >= IMPLOT_TICK_CACHE_SIZE) {
+                ImPlotTickCacheEntry* lru = nullptr;
+                for (int n = 0; n < gp.TickCache.GetMapSize(); ++n) {
+                    ImPlotTickCacheEntry* e = gp.TickCache.TryGetMapData(n);
+                    if (e != nullptr && (lru == nullptr || e->LastUse < lru->LastUse))
+                        lru = e;
+                }
+                gp.TickCache.Remove(lru->ID, lru);
+                // removed keys stay in the pool map, drop them before they outnumber the live ones
+                ImVector<ImGuiStorage::ImGuiStoragePair>& pairs = gp.TickCache.Map.Data;
+                if (pairs.Size > IMPLOT_TICK_CACHE_SIZE * 4) {
+                    int live = 0;
+                    for (int n = 0; n < pairs.Size; ++n)
+                        if (pairs[n].val_i != -1)
+                            pairs[live++] = pairs[n];
+                    pairs.resize(live);
+                }
+            }
+            entry = gp.TickCache.GetOrAddByKey(id);
+            entry->ID = id;
+        }
+        ticker.MaxSize = ImVec2(0,0);
+        locator(ticker, range, pixels, vertical, formatter, formatter_data);
+        entry->Key = key;
+        entry->Ticks = ticker.Ticks;
+        entry->TextBuffer.Buf = ticker.TextBuffer.Buf;
+        entry->MaxSize = ticker.MaxSize;
+    }
+    else {
+        ticker.Ticks = entry->Ticks;
+        ticker.TextBuffer.Buf = entry->TextBuffer.Buf;
+    }
+    entry->LastUse = ++gp.TickCacheClock;
+    ticker.MaxSize = ImMax(late_size, entry->MaxSize);
+}
+
+void BustTickCache() {
+    ImPlotContext& gp = *GImPlot;
+    gp.TickCache.Clear();
+}
+// add by Dicky end
+
 //-----------------------------------------------------------------------------
 // Context Menu
 //-----------------------------------------------------------------------------
@@ -2571,7 +2645,7 @@ void SetupFinish() {
     for (int i = 0; i < IMPLOT_NUM_Y_AXES; i++) {
         ImPlotAxis& axis = plot.YAxis(i);
         if (axis.WillRender() && axis.ShowDefaultTicks && plot_height > 0) {
-            axis.Locator(axis.Ticker, axis.Range, plot_height, true, axis.Formatter, axis.FormatterData);
+            LocateTicks(axis.Ticker, axis.Locator, axis.Range, plot_height, true, axis.Formatter, axis.FormatterData); // modify by Dicky
         }
     }
 
@@ -2584,7 +2658,7 @@ void SetupFinish() {
     for (int i = 0; i < IMPLOT_NUM_X_AXES; i++) {
         ImPlotAxis& axis = plot.XAxis(i);
         if (axis.WillRender() && axis.ShowDefaultTicks && plot_width > 0) {
-            axis.Locator(axis.Ticker, axis.Range, plot_width, false, axis.Formatter, axis.FormatterData);
+            LocateTicks(axis.Ticker, axis.Locator, axis.Range, plot_width, false, axis.Formatter, axis.FormatterData); // modify by Dicky
         }
     }
 
@@ -2636,7 +2710,7 @@ void SetupFinish() {
 
     // fit from FitNextPlotAxes or auto fit
     for (int i = 0; i < ImAxis_COUNT; ++i) {
-        if (gp.NextPlotData.Fit[i] || plot.Axes[i].IsAutoFitting()) {
+        if (gp.NextPlotData.Fit[i] || plot.Axes[i].IsAutoFitting() || gp.ImagePass == 1) { // modify by Dicky
             plot.FitThisFrame = true;
             plot.Axes[i].FitThisFrame = true;
         }
@@ -3792,6 +3866,34 @@ void HideNextItem(bool hidden, ImPlotCond cond) {
     gp.NextItemData.HiddenCond = cond;
 }
 
+// add by Dicky for fit cache
+ImGuiID GetFitKey(const ImPlotAxis& x_axis, const ImPlotAxis& y_axis) {
+    double state[8];
+    memset(state, 0, sizeof(state));
+    state[0] = x_axis.ConstraintRange.Min;
+    state[1] = x_axis.ConstraintRange.Max;
+    state[2] = y_axis.ConstraintRange.Min;
+    state[3] = y_axis.ConstraintRange.Max;
+    // with RangeFit the points fitted on one axis depend on the range of the other
+    if (ImHasFlag(x_axis.Flags, ImPlotAxisFlags_RangeFit)) {
+        state[4] = y_axis.Range.Min;
+        state[5] = y_axis.Range.Max;
+    }
+    if (ImHasFlag(y_axis.Flags, ImPlotAxisFlags_RangeFit)) {
+        state[6] = x_axis.Range.Min;
+        state[7] = x_axis.Range.Max;
+    }
+    const ImGuiID seed = (ImHasFlag(x_axis.Flags, ImPlotAxisFlags_RangeFit) ? 1 : 0) | (ImHasFlag(y_axis.Flags, ImPlotAxisFlags_RangeFit) ? 2 : 0);
+    return ImHashData(state, sizeof(state), seed);
+}
+
+void SetNextFitVersion(ImU64 version) {
+    ImPlotContext& gp = *GImPlot;
+    gp.NextItemData.HasFitVersion = true;
+    gp.NextItemData.FitVersion    = version;
+}
+// add by Dicky end
+
 //-----------------------------------------------------------------------------
 // [SECTION] Plot Tools
 //-----------------------------------------------------------------------------
@@ -4643,7 +4745,7 @@ void ColormapScale(const char* label, double scale_min, double scale_max, const
 
     ImPlotRange range(ImMin(scale_min,scale_max), ImMax(scale_min,scale_max));
     gp.CTicker.Reset();
-    Locator_Default(gp.CTicker, range, frame_size.y, true, Formatter_Default, (void*)format);
+    LocateTicks(gp.CTicker, Locator_Default, range, frame_size.y, true, Formatter_Default, (void*)format); // modify by Dicky
 
     const bool rend_label = label_size.x > 0;
     const float txt_off   = gp.Style.LabelPadding.x;
@@ -5859,6 +5961,77 @@ void StyleColorsLight(ImPlotStyle* dst) {
     colors[ImPlotCol_Crosshairs]    = ImVec4(0.00f, 0.00f, 0.00f, 0.50f);
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] Image Rendering (add by Dicky)
+//-----------------------------------------------------------------------------
+
+// The default font is decompressed through globals of stb, contexts building their own atlas take turns
+static std::mutex GImageFontMutex;
+
+ImPlotContext* CreateImageContext(ImFontAtlas* shared_font_atlas) {
+    ImGuiContext* imgui_ctx = ImGui::CreateContext(shared_font_atlas);
+    ImGui::SetCurrentContext(imgui_ctx);
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.LogFilename = nullptr;
+    // the rasterizer handles vertex offsets, large plots need them with 16-bit indices
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    if (shared_font_atlas == nullptr) {
+        std::lock_guard<std::mutex> lock(GImageFontMutex);
+        unsigned char* pixels = nullptr;
+        int width = 0, height = 0;
+        io.Fonts->AddFontDefault();
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    }
+    ImPlotContext* ctx = CreateContext();
+    ctx->ImageContext = imgui_ctx;
+    SetCurrentContext(ctx);
+    return ctx;
+}
+
+void DestroyImageContext(ImPlotContext* ctx) {
+    IM_ASSERT(ctx != nullptr && ctx->ImageContext != nullptr && "Not an image context!");
+    ImGuiContext* imgui_ctx = ctx->ImageContext;
+    DestroyContext(ctx);
+    ImGui::DestroyContext(imgui_ctx);
+}
+
+bool BeginImage(int width, int height) {
+    IM_ASSERT_USER_ERROR(GImPlot != nullptr && GImPlot->ImageContext != nullptr && GImPlot->ImageContext == ImGui::GetCurrentContext(), "No image context is current, call CreateImageContext() first!");
+    ImPlotContext& gp = *GImPlot;
+    if (gp.ImagePass == 2) {
+        gp.ImagePass = 0;
+        return false;
+    }
+    gp.ImagePass++;
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2((float)width, (float)height);
+    io.DeltaTime = 1.0f / 60.0f;
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(io.DisplaySize);
+    ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0, 0));
+    ImGui::PushStyleVar(ImGuiStyleVar_WindowBorderSize, 0.0f);
+    // the window background is the color the image is cleared with
+    ImGui::Begin("##Image", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoBackground | ImGuiWindowFlags_NoSavedSettings);
+    ImGui::PopStyleVar(2);
+    return true;
+}
+
+void EndImage(ImGui::ImMat& mat) {
+    ImPlotContext& gp = *GImPlot;
+    IM_ASSERT_USER_ERROR(gp.ImagePass != 0, "Mismatched BeginImage()/EndImage()!");
+    ImGui::End();
+    if (gp.ImagePass == 1) {
+        ImGui::EndFrame();
+        return;
+    }
+    ImGui::Render();
+    ImVec4 clear = ImGui::GetStyleColorVec4(ImGuiCol_WindowBg);
+    clear.w = 1.0f;
+    ImGui::ImDrawDataToMat(ImGui::GetDrawData(), mat, ImGui::ColorConvertFloat4ToU32(clear));
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] Obsolete Functions/Types
 //-----------------------------------------------------------------------------
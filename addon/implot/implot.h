@@ -41,11 +41,14 @@
 // [SECTION] Colormaps
 // [SECTION] Input Mapping
 // [SECTION] Miscellaneous
+// [SECTION] Image Rendering (add by Dicky)
 // [SECTION] Demo
 // [SECTION] Obsolete API
 
 #pragma once
 #include "imgui.h"
+#include <atomic> // add by Dicky for ring buffer
+namespace ImGui { class ImMat; } // add by Dicky for image rendering
 
 //-----------------------------------------------------------------------------
 // [SECTION] Macros and Defines
@@ -97,6 +100,7 @@ typedef int ImPlotStemsFlags;         // -> ImPlotStemsFlags_
 typedef int ImPlotInfLinesFlags;      // -> ImPlotInfLinesFlags_
 typedef int ImPlotPieChartFlags;      // -> ImPlotPieChartFlags_
 typedef int ImPlotHeatmapFlags;       // -> ImPlotHeatmapFlags_
+typedef int ImPlotSurfaceFlags;       // -> ImPlotSurfaceFlags_ // add by Dicky
 typedef int ImPlotHistogramFlags;     // -> ImPlotHistogramFlags_
 typedef int ImPlotDigitalFlags;       // -> ImPlotDigitalFlags_
 typedef int ImPlotImageFlags;         // -> ImPlotImageFlags_
@@ -233,12 +237,17 @@ enum ImPlotLineFlags_ {
     ImPlotLineFlags_SkipNaN     = 1 << 12, // NaNs values will be skipped instead of rendered as missing data
     ImPlotLineFlags_NoClip      = 1 << 13, // markers (if displayed) on the edge of a plot will not be clipped
     ImPlotLineFlags_Shaded      = 1 << 14, // a filled region between the line and horizontal origin will be rendered; use PlotShaded for more advanced cases
+    ImPlotLineFlags_NoDecimate  = 1 << 15, // add by Dicky, large series with ascending x won't be reduced to the first/last/min/max point of each pixel column before rendering (line only, see ImPlotLineFlags_DecimateMarkers)
+    ImPlotLineFlags_SortedX     = 1 << 16, // add by Dicky, xs are sorted in ascending order, allows large PlotLine(xs,ys) and PlotLineG series to be decimated (PlotLine(values) with xscale > 0 always is)
+    ImPlotLineFlags_LTTB        = 1 << 17, // add by Dicky, decimate with Largest-Triangle-Three-Buckets (2 points per pixel column, not pixel exact) instead of per column min/max
+    ImPlotLineFlags_DecimateMarkers = 1 << 18, // add by Dicky, markers (if displayed) of large series are decimated like ImPlotScatterFlags_Decimate
 };
 
 // Flags for PlotScatter
 enum ImPlotScatterFlags_ {
     ImPlotScatterFlags_None   = 0,       // default
     ImPlotScatterFlags_NoClip = 1 << 10, // markers on the edge of a plot will not be clipped
+    ImPlotScatterFlags_Decimate = 1 << 11, // add by Dicky, large series skip markers whose center lands on a pixel already covered by the same series (opaque markers only, skipped markers may differ by sub-pixel edges)
 };
 
 // Flags for PlotStairs
@@ -295,8 +304,20 @@ enum ImPlotPieChartFlags_ {
 enum ImPlotHeatmapFlags_ {
     ImPlotHeatmapFlags_None     = 0,       // default
     ImPlotHeatmapFlags_ColMajor = 1 << 10, // data will be read in column major order
+    ImPlotHeatmapFlags_Texture  = 1 << 11, // add by Dicky, colorize the heatmap into a cached texture instead of one quad per cell, only changed rows are uploaded again (needs a renderer backend, tiny heatmaps, label formats and non linear axes still use quads)
 };
 
+// add by Dicky for surface plots
+// Flags for PlotSurface
+enum ImPlotSurfaceFlags_ {
+    ImPlotSurfaceFlags_None     = 0,       // default
+    ImPlotSurfaceFlags_ColMajor = 1 << 10, // data will be read in column major order
+    ImPlotSurfaceFlags_Mesh     = 1 << 11, // draw the edges of the grid cells over the surface with the line color (set the fill alpha to 0 for a wireframe)
+    ImPlotSurfaceFlags_NoCull   = 1 << 12, // draw the triangles facing away from the viewer too (e.g. the underside of the surface)
+    ImPlotSurfaceFlags_NoLOD    = 1 << 13, // draw every grid cell, even when several cells share a pixel
+};
+// add by Dicky end
+
 // Flags for PlotHistogram and PlotHistogram2D
 enum ImPlotHistogramFlags_ {
     ImPlotHistogramFlags_None       = 0,       // default
@@ -577,6 +598,129 @@ struct ImPlotInputMap {
     IMPLOT_API ImPlotInputMap();
 };
 
+// add by Dicky for min/max pyramid
+#define IMPLOT_PYRAMID_BLOCK_SHIFT  4   // level 0 nodes of ImPlotPyramid cover 2^4 samples, smaller ranges are scanned
+#define IMPLOT_PYRAMID_LEVELS       27  // level k nodes cover 2^(4+k) samples
+
+// Min and max y (and their sample index) of a block of samples, NaNs are ignored and indices are -1 for a block of NaNs.
+struct ImPlotPyramidNode {
+    double  Min, Max;
+    int     IdxMin, IdxMax;
+};
+
+// Multi-resolution min/max cache of a series with ascending x. Build it once, or Append samples as they arrive,
+// and plot it with PlotLine/PlotShaded/PlotDigital: a frame then reads O(pixels * log N) entries instead of
+// every visible sample, whatever the zoom level. Samples are copied as doubles, the pyramid adds ~3 bytes per sample.
+struct IMPLOT_API ImPlotPyramid {
+    ImVector<double>            Xs;                             // sample x, empty when x is uniform (XStart + idx * XScale)
+    ImVector<double>            Ys;                             // sample y
+    double                      XScale;
+    double                      XStart;
+    ImVector<int>               NaNs;                           // indices of NaN samples, ascending
+    ImVector<ImPlotPyramidNode> Levels[IMPLOT_PYRAMID_LEVELS];  // complete blocks of each level, level k node n covers samples [n,n+1) << (4+k)
+
+    ImPlotPyramid() { XScale = 1; XStart = 0; }
+    void    Clear();
+    int     Size() const                { return Ys.Size; }
+    double  GetX(int idx) const         { return Xs.Size ? Xs.Data[idx] : XStart + XScale * idx; }
+    // build from (or append to) a series with uniform x, xscale must be positive
+    template <typename T> void Build(const T* values, int count, double xscale=1, double xstart=0, int offset=0, int stride=sizeof(T));
+    template <typename T> void Append(const T* values, int count, int offset=0, int stride=sizeof(T));
+    // build from (or append to) a series with explicit x, xs must be ascending (across appends too)
+    template <typename T> void Build(const T* xs, const T* ys, int count, int offset=0, int stride=sizeof(T));
+    template <typename T> void Append(const T* xs, const T* ys, int count, int offset=0, int stride=sizeof(T));
+    // true if any sample in [idx0,idx1) is NaN
+    bool    HasNaN(int idx0, int idx1) const;
+    // indices of the min and max y in [idx0,idx1) ignoring NaNs (-1 if none), reads O(log N) nodes and at most two blocks of samples
+    void    QueryMinMax(int idx0, int idx1, int* idx_min, int* idx_max) const;
+    // updates the levels after samples were added past old_size
+    void    UpdateLevels(int old_size);
+};
+// add by Dicky end
+
+// add by Dicky for lock-free ring buffer
+// Lock-free ring buffer of (x,y) samples for streaming series. Acquisition threads Push samples while the plot thread
+// plots the buffer with PlotLine/PlotScatter/PlotShaded, without a mutex and without copying. Each frame the plot takes
+// a snapshot of the last History published samples, which producers never overwrite: samples that don't fit in the
+// rest of the buffer are dropped and counted instead. There must be a single producer thread unless the buffer is
+// created with multi_producer. Capacity should hold History plus the samples pushed during a frame or two.
+struct IMPLOT_API ImPlotRingBuffer {
+    ImPlotRingBuffer(int capacity, int history = 0, bool multi_producer = false);  // capacity is rounded up to a power of two, history defaults to half of it
+    ~ImPlotRingBuffer();
+
+    // producer side
+    bool    Push(double x, double y);                               // false if the sample was dropped
+    int     Push(const double* xs, const double* ys, int count);    // returns the number of samples pushed, the others are dropped
+    ImU64   GetPushed() const   { return (MultiProducer ? Reserved : Head).load(std::memory_order_relaxed); }
+    ImU64   GetDropped() const  { return Dropped.load(std::memory_order_relaxed); }
+
+    // consumer side, plot thread only. Plot functions take a snapshot once per frame unless one was already taken.
+    int     Snapshot();                                             // snapshots the last History published samples, releases older ones to producers and returns the snapshot size
+    int     Size() const                { return SnapshotCount; }
+    double  GetX(int idx) const         { return Xs[(SnapshotStart + idx) & Mask]; }
+    double  GetY(int idx) const         { return Ys[(SnapshotStart + idx) & Mask]; }
+
+    double*             Xs;
+    double*             Ys;
+    std::atomic<ImU64>* Seqs;           // multi producer only, slot i holds i+1 once sample i is written
+    int                 Capacity;
+    int                 History;
+    ImU64               Mask;
+    bool                MultiProducer;
+    ImU64               SnapshotStart;  // index of the first sample of the snapshot
+    int                 SnapshotCount;
+    int                 SnapshotFrame;
+    // indices only grow, shared ones are kept on their own cache lines
+    char                Pad0[64];
+    std::atomic<ImU64>  Head;           // end of the published samples, written by the producer (or by Snapshot with multiple producers)
+    ImU64               ProducerTail;   // single producer only, last Tail seen by the producer
+    char                Pad1[64];
+    std::atomic<ImU64>  Reserved;       // multi producer only, end of the samples reserved by producers
+    char                Pad2[64];
+    std::atomic<ImU64>  Tail;           // start of the samples held by the consumer, written by Snapshot
+    char                Pad3[64];
+    std::atomic<ImU64>  Dropped;
+};
+// add by Dicky end
+
+// add by Dicky for columnar data
+// A chunk of an ImPlotColumn, e.g. one record batch of an Arrow chunked array.
+template <typename T>
+struct ImPlotColumnChunk {
+    const T*        Data;           // first value of the chunk
+    const ImU8*     Validity;       // optional validity bitmap of the chunk, see ImPlotColumn
+    int             ValidityOffset; // bit of the first value in Validity
+    int             Count;
+
+    ImPlotColumnChunk(const T* data = nullptr, int count = 0, const ImU8* validity = nullptr, int validity_offset = 0) { Data = data; Validity = validity; ValidityOffset = validity_offset; Count = count; }
+};
+
+// A column of #T values read in place from user memory: a plain or strided array (a field of an array of structs),
+// optionally with an Arrow style validity bitmap (bit i, LSB first, is set when value i is valid) and optionally split
+// in chunks sharing the stride. Null values plot as NaN, so they break lines unless ImPlotLineFlags_SkipNaN is passed.
+// Plot functions taking columns plot min(Count) points and read values through getters the compiler inlines, columns
+// without validity or chunks are read exactly like the arrays of the pointer overloads.
+template <typename T>
+struct ImPlotColumn {
+    const T*                    Data;           // first value, unused with chunks
+    int                         Count;          // number of values, the sum of the chunk counts with chunks
+    int                         Stride;         // bytes between two values
+    const ImU8*                 Validity;       // optional validity bitmap, unused with chunks
+    int                         ValidityOffset; // bit of the first value in Validity
+    const ImPlotColumnChunk<T>* Chunks;         // optional chunks, the column is their concatenation
+    int                         ChunkCount;
+
+    ImPlotColumn(const T* data, int count, int stride = sizeof(T), const ImU8* validity = nullptr, int validity_offset = 0) {
+        Data = data; Count = count; Stride = stride; Validity = validity; ValidityOffset = validity_offset; Chunks = nullptr; ChunkCount = 0;
+    }
+    ImPlotColumn(const ImPlotColumnChunk<T>* chunks, int chunk_count, int stride = sizeof(T)) {
+        Data = nullptr; Count = 0; Stride = stride; Validity = nullptr; ValidityOffset = 0; Chunks = chunks; ChunkCount = chunk_count;
+        for (int i = 0; i < chunk_count; ++i)
+            Count += chunks[i].Count;
+    }
+};
+// add by Dicky end
+
 //-----------------------------------------------------------------------------
 // [SECTION] Callbacks
 //-----------------------------------------------------------------------------
@@ -737,6 +881,7 @@ IMPLOT_API void SetupAxisLinks(ImAxis axis, double* link_min, double* link_max);
 // Sets the format of numeric axis labels via formater specifier (default="%g"). Formated values will be double (i.e. use %f).
 IMPLOT_API void SetupAxisFormat(ImAxis axis, const char* fmt);
 // Sets the format of numeric axis labels via formatter callback. Given #value, write a label into #buff. Optionally pass user data.
+// Labels are cached for the formatter and data pointer, call BustTickCache if the formatter output changes otherwise. // add by Dicky
 IMPLOT_API void SetupAxisFormat(ImAxis axis, ImPlotFormatter formatter, void* data=nullptr);
 // Sets an axis' ticks and optionally the labels. To keep the default ticks, set #keep_default=true.
 IMPLOT_API void SetupAxisTicks(ImAxis axis, const double* values, int n_ticks, const char* const labels[]=nullptr, bool keep_default=false);
@@ -856,11 +1001,16 @@ IMPLOT_API void SetNextAxesToFit();
 IMPLOT_TMP void PlotLine(const char* label_id, const T* values, int count, double xscale=1, double xstart=0, ImPlotLineFlags flags=0, int offset=0, int stride=sizeof(T));
 IMPLOT_TMP void PlotLine(const char* label_id, const T* xs, const T* ys, int count, ImPlotLineFlags flags=0, int offset=0, int stride=sizeof(T));
 IMPLOT_API void PlotLineG(const char* label_id, ImPlotGetter getter, void* data, int count, ImPlotLineFlags flags=0);
+IMPLOT_API void PlotLine(const char* label_id, const ImPlotPyramid& pyramid, ImPlotLineFlags flags=0); // add by Dicky
+IMPLOT_API void PlotLine(const char* label_id, ImPlotRingBuffer& buffer, ImPlotLineFlags flags=0); // add by Dicky, pass ImPlotLineFlags_SortedX to decimate when x is ascending
+IMPLOT_TMP void PlotLine(const char* label_id, const ImPlotColumn<T>& xs, const ImPlotColumn<T>& ys, ImPlotLineFlags flags=0); // add by Dicky
 
 // Plots a standard 2D scatter plot. Default marker is ImPlotMarker_Circle.
 IMPLOT_TMP void PlotScatter(const char* label_id, const T* values, int count, double xscale=1, double xstart=0, ImPlotScatterFlags flags=0, int offset=0, int stride=sizeof(T));
 IMPLOT_TMP void PlotScatter(const char* label_id, const T* xs, const T* ys, int count, ImPlotScatterFlags flags=0, int offset=0, int stride=sizeof(T));
 IMPLOT_API void PlotScatterG(const char* label_id, ImPlotGetter getter, void* data, int count, ImPlotScatterFlags flags=0);
+IMPLOT_API void PlotScatter(const char* label_id, ImPlotRingBuffer& buffer, ImPlotScatterFlags flags=0); // add by Dicky
+IMPLOT_TMP void PlotScatter(const char* label_id, const ImPlotColumn<T>& xs, const ImPlotColumn<T>& ys, ImPlotScatterFlags flags=0); // add by Dicky
 
 // Plots a a stairstep graph. The y value is continued constantly to the right from every x position, i.e. the interval [x[i], x[i+1]) has the value y[i]
 IMPLOT_TMP void PlotStairs(const char* label_id, const T* values, int count, double xscale=1, double xstart=0, ImPlotStairsFlags flags=0, int offset=0, int stride=sizeof(T));
@@ -872,11 +1022,16 @@ IMPLOT_TMP void PlotShaded(const char* label_id, const T* values, int count, dou
 IMPLOT_TMP void PlotShaded(const char* label_id, const T* xs, const T* ys, int count, double yref=0, ImPlotShadedFlags flags=0, int offset=0, int stride=sizeof(T));
 IMPLOT_TMP void PlotShaded(const char* label_id, const T* xs, const T* ys1, const T* ys2, int count, ImPlotShadedFlags flags=0, int offset=0, int stride=sizeof(T));
 IMPLOT_API void PlotShadedG(const char* label_id, ImPlotGetter getter1, void* data1, ImPlotGetter getter2, void* data2, int count, ImPlotShadedFlags flags=0);
+IMPLOT_API void PlotShaded(const char* label_id, const ImPlotPyramid& pyramid, double yref=0, ImPlotShadedFlags flags=0); // add by Dicky
+IMPLOT_API void PlotShaded(const char* label_id, ImPlotRingBuffer& buffer, double yref=0, ImPlotShadedFlags flags=0); // add by Dicky
+IMPLOT_TMP void PlotShaded(const char* label_id, const ImPlotColumn<T>& xs, const ImPlotColumn<T>& ys, double yref=0, ImPlotShadedFlags flags=0); // add by Dicky
+IMPLOT_TMP void PlotShaded(const char* label_id, const ImPlotColumn<T>& xs, const ImPlotColumn<T>& ys1, const ImPlotColumn<T>& ys2, ImPlotShadedFlags flags=0); // add by Dicky
 
 // Plots a bar graph. Vertical by default. #bar_size and #shift are in plot units.
 IMPLOT_TMP void PlotBars(const char* label_id, const T* values, int count, double bar_size=0.67, double shift=0, ImPlotBarsFlags flags=0, int offset=0, int stride=sizeof(T));
 IMPLOT_TMP void PlotBars(const char* label_id, const T* xs, const T* ys, int count, double bar_size, ImPlotBarsFlags flags=0, int offset=0, int stride=sizeof(T));
 IMPLOT_API void PlotBarsG(const char* label_id, ImPlotGetter getter, void* data, int count, double bar_size, ImPlotBarsFlags flags=0);
+IMPLOT_TMP void PlotBars(const char* label_id, const ImPlotColumn<T>& xs, const ImPlotColumn<T>& ys, double bar_size, ImPlotBarsFlags flags=0); // add by Dicky
 
 // Plots a group of bars. #values is a row-major matrix with #item_count rows and #group_count cols. #label_ids should have #item_count elements.
 IMPLOT_TMP void PlotBarGroups(const char* const label_ids[], const T* values, int item_count, int group_count, double group_size=0.67, double shift=0, ImPlotBarGroupsFlags flags=0);
@@ -899,6 +1054,17 @@ IMPLOT_TMP void PlotPieChart(const char* const label_ids[], const T* values, int
 // Plots a 2D heatmap chart. Values are expected to be in row-major order by default. Leave #scale_min and scale_max both at 0 for automatic color scaling, or set them to a predefined range. #label_fmt can be set to nullptr for no labels.
 IMPLOT_TMP void PlotHeatmap(const char* label_id, const T* values, int rows, int cols, double scale_min=0, double scale_max=0, const char* label_fmt="%.1f", const ImPlotPoint& bounds_min=ImPlotPoint(0,0), const ImPlotPoint& bounds_max=ImPlotPoint(1,1), ImPlotHeatmapFlags flags=0);
 
+// add by Dicky, plots a 2D scalar field as a shaded surface seen through the view set with SetNextSurfaceView(). #values are
+// samples at the nodes of a #rows x #cols grid spanning #bounds_min/bounds_max, first row at the top like PlotHeatmap, colored
+// with the current colormap between #scale_min and #scale_max (0 and 0 for the min/max of the values). The surface is projected
+// orthographically into plot coordinates around the center of the bounds, use ImPlotFlags_Equal to keep its proportions.
+// Cells are drawn from the farthest corner, culled to the plot area and reduced to a few pixels each on screen.
+IMPLOT_TMP void PlotSurface(const char* label_id, const T* values, int rows, int cols, double scale_min=0, double scale_max=0, const ImPlotPoint& bounds_min=ImPlotPoint(0,0), const ImPlotPoint& bounds_max=ImPlotPoint(1,1), ImPlotSurfaceFlags flags=0);
+// add by Dicky, view of the next PlotSurface: #yaw turns the grid around the vertical axis, #pitch is the elevation of the viewer
+// (0 looks from the side, IM_PI/2 from above), both in radians. The values span #height times the larger side of the bounds.
+// Surfaces plotted without it use yaw 0.5, pitch 0.6 and height 0.5.
+IMPLOT_API void SetNextSurfaceView(double yaw, double pitch, double height=0.5);
+
 // Plots a horizontal histogram. #bins can be a positive integer or an ImPlotBin_ method. If #range is left unspecified, the min/max of #values will be used as the range.
 // Otherwise, outlier values outside of the range are not binned. The largest bin count or density is returned.
 IMPLOT_TMP double PlotHistogram(const char* label_id, const T* values, int count, int bins=ImPlotBin_Sturges, double bar_scale=1.0, ImPlotRange range=ImPlotRange(), ImPlotHistogramFlags flags=0);
@@ -906,10 +1072,14 @@ IMPLOT_TMP double PlotHistogram(const char* label_id, const T* values, int count
 // Plots two dimensional, bivariate histogram as a heatmap. #x_bins and #y_bins can be a positive integer or an ImPlotBin. If #range is left unspecified, the min/max of
 // #xs an #ys will be used as the ranges. Otherwise, outlier values outside of range are not binned. The largest bin count or density is returned.
 IMPLOT_TMP double PlotHistogram2D(const char* label_id, const T* xs, const T* ys, int count, int x_bins=ImPlotBin_Sturges, int y_bins=ImPlotBin_Sturges, ImPlotRect range=ImPlotRect(), ImPlotHistogramFlags flags=0);
+// add by Dicky, the next PlotHistogram or PlotHistogram2D reuses the bins it computed last time while its data pointers, count, bins, range, flags and #version
+// stay the same. Change #version whenever the values change, unchanged data then skips binning.
+IMPLOT_API void SetNextHistogramVersion(ImU64 version);
 
 // Plots digital data. Digital plots do not respond to y drag or zoom, and are always referenced to the bottom of the plot.
 IMPLOT_TMP void PlotDigital(const char* label_id, const T* xs, const T* ys, int count, ImPlotDigitalFlags flags=0, int offset=0, int stride=sizeof(T));
 IMPLOT_API void PlotDigitalG(const char* label_id, ImPlotGetter getter, void* data, int count, ImPlotDigitalFlags flags=0);
+IMPLOT_API void PlotDigital(const char* label_id, const ImPlotPyramid& pyramid, ImPlotDigitalFlags flags=0); // add by Dicky
 
 // Plots an axis-aligned image. #bounds_min/bounds_max are in plot coordinates (y-up) and #uv0/uv1 are in texture coordinates (y-down).
 IMPLOT_API void PlotImage(const char* label_id, ImTextureID user_texture_id, const ImPlotPoint& bounds_min, const ImPlotPoint& bounds_max, const ImVec2& uv0=ImVec2(0,0), const ImVec2& uv1=ImVec2(1,1), const ImVec4& tint_col=ImVec4(1,1,1,1), ImPlotImageFlags flags=0);
@@ -997,6 +1167,9 @@ IMPLOT_API void CancelPlotSelection();
 // Hides or shows the next plot item (i.e. as if it were toggled from the legend).
 // Use ImPlotCond_Always if you need to forcefully set this every frame.
 IMPLOT_API void HideNextItem(bool hidden = true, ImPlotCond cond = ImPlotCond_Once);
+// add by Dicky, while the next item is auto-fitted it reuses the extents it fitted last time with the same #version
+// (and axis constraints) instead of visiting all its points. Change #version whenever its data changes.
+IMPLOT_API void SetNextFitVersion(ImU64 version);
 
 // Use the following around calls to Begin/EndPlot to align l/r/t/b padding.
 // Consider using Begin/EndSubplots first. They are more feature rich and
@@ -1197,6 +1370,12 @@ IMPLOT_API bool ColormapButton(const char* label, const ImVec2& size = ImVec2(0,
 // need this function, but it is available for applications that require runtime colormap swaps (e.g. Heatmaps demo).
 IMPLOT_API void BustColorCache(const char* plot_title_id = nullptr);
 
+// add by Dicky for tick cache
+// Axis ticks and their formatted, measured labels are cached by axis range, size, formatter and font, and shared
+// between plots. Call this if a formatter callback writes different labels for the same user data (e.g. units changed).
+IMPLOT_API void BustTickCache();
+// add by Dicky end
+
 //-----------------------------------------------------------------------------
 // [SECTION] Input Mapping
 //-----------------------------------------------------------------------------
@@ -1238,6 +1417,40 @@ IMPLOT_API void ShowUserGuide();
 // Shows ImPlot metrics/debug information window.
 IMPLOT_API void ShowMetricsWindow(bool* p_popen = nullptr);
 
+//-----------------------------------------------------------------------------
+// [SECTION] Image Rendering (add by Dicky)
+//-----------------------------------------------------------------------------
+
+// Renders plots to images on the CPU, without a window, backend or GPU (e.g. report charts in batch jobs). An image
+// context is an ImGui and an ImPlot context, made current on the thread creating it. Each image takes two passes of
+// the same plotting code, the first one fits the axes of every plot to its data and the second one draws them:
+//
+// ImPlotContext* ctx = ImPlot::CreateImageContext();
+// ImGui::ImMat mat;
+// while (ImPlot::BeginImage(800, 600)) {
+//     if (ImPlot::BeginPlot("Report", ImVec2(-1,-1))) {
+//         ImPlot::PlotLine(...);
+//         ImPlot::EndPlot();
+//     }
+//     ImPlot::EndImage(mat);
+// }
+// ImGui::ImMatToFile(mat, "report.png");
+// ImPlot::DestroyImageContext(ctx);
+//
+// Axes with limits set up with ImPlotCond_Always aren't fitted. With IMGUI_THREAD_LOCAL_CONTEXT (cmake option) several
+// threads can render images at once, each one with its own image context.
+
+// Creates an image context and makes it current. A #shared_font_atlas must already be built (GetTexDataAsRGBA32),
+// without one the context builds its own atlas with the default font.
+IMPLOT_API ImPlotContext* CreateImageContext(ImFontAtlas* shared_font_atlas = nullptr);
+// Destroys an image context and its ImGui context.
+IMPLOT_API void DestroyImageContext(ImPlotContext* ctx);
+// Starts a pass of an image of #width x #height pixels, showing a window filling it. Returns false once the image is
+// done, otherwise EndImage() MUST be called.
+IMPLOT_API bool BeginImage(int width, int height);
+// Ends a pass of an image, the last one rasterizes it into a 4 channel 8 bit (RGBA) #mat.
+IMPLOT_API void EndImage(ImGui::ImMat& mat);
+
 //-----------------------------------------------------------------------------
 // [SECTION] Demo
 //-----------------------------------------------------------------------------
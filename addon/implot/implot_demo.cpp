@@ -668,6 +668,8 @@ void Demo_Heatmaps() {
     static ImPlotHeatmapFlags hm_flags = 0;
 
     ImGui::CheckboxFlags("Column Major", (unsigned int*)&hm_flags, ImPlotHeatmapFlags_ColMajor);
+    ImGui::SameLine(); // add by Dicky
+    ImGui::CheckboxFlags("Texture", (unsigned int*)&hm_flags, ImPlotHeatmapFlags_Texture); // add by Dicky
 
     static ImPlotAxisFlags axes_flags = ImPlotAxisFlags_Lock | ImPlotAxisFlags_NoGridLines | ImPlotAxisFlags_NoTickMarks;
 
@@ -694,14 +696,55 @@ void Demo_Heatmaps() {
     if (ImPlot::BeginPlot("##Heatmap2",ImVec2(225,225))) {
         ImPlot::SetupAxes(nullptr, nullptr, ImPlotAxisFlags_NoDecorations, ImPlotAxisFlags_NoDecorations);
         ImPlot::SetupAxesLimits(-1,1,-1,1);
-        ImPlot::PlotHeatmap("heat1",values2,size,size,0,1,nullptr);
-        ImPlot::PlotHeatmap("heat2",values2,size,size,0,1,nullptr, ImPlotPoint(-1,-1), ImPlotPoint(0,0));
+        ImPlot::PlotHeatmap("heat1",values2,size,size,0,1,nullptr,ImPlotPoint(0,0),ImPlotPoint(1,1),hm_flags); // modify by Dicky
+        ImPlot::PlotHeatmap("heat2",values2,size,size,0,1,nullptr, ImPlotPoint(-1,-1), ImPlotPoint(0,0),hm_flags); // modify by Dicky
         ImPlot::EndPlot();
     }
     ImPlot::PopColormap();
 
 }
 
+// add by Dicky for surface plots
+void Demo_Surfaces() {
+    const int size = 256;
+    static float values[size*size];
+    static bool init = true;
+    if (init) {
+        for (int r = 0; r < size; ++r) {
+            for (int c = 0; c < size; ++c) {
+                const float x = (c / (float)(size - 1) - 0.5f) * 12, y = (r / (float)(size - 1) - 0.5f) * 12;
+                const float d = sqrtf(x*x + y*y) + 1e-3f;
+                values[r*size+c] = sinf(d) / d;
+            }
+        }
+        init = false;
+    }
+    static float yaw = 0.5f, pitch = 0.6f, height = 0.5f;
+    static ImPlotSurfaceFlags flags = 0;
+    ImGui::SetNextItemWidth(225);
+    ImGui::SliderAngle("Yaw", &yaw, -180, 180);
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(225);
+    ImGui::SliderAngle("Pitch", &pitch, 0, 90);
+    ImGui::SetNextItemWidth(225);
+    ImGui::SliderFloat("Height", &height, 0, 1);
+    ImGui::SameLine();
+    ImGui::CheckboxFlags("Mesh", (unsigned int*)&flags, ImPlotSurfaceFlags_Mesh);
+    ImGui::SameLine();
+    ImGui::CheckboxFlags("No Cull", (unsigned int*)&flags, ImPlotSurfaceFlags_NoCull);
+    ImGui::SameLine();
+    ImGui::CheckboxFlags("No LOD", (unsigned int*)&flags, ImPlotSurfaceFlags_NoLOD);
+    ImPlot::PushColormap(ImPlotColormap_Viridis);
+    if (ImPlot::BeginPlot("##Surface",ImVec2(-1,0),ImPlotFlags_Equal)) {
+        ImPlot::SetupAxes(nullptr, nullptr, ImPlotAxisFlags_NoDecorations, ImPlotAxisFlags_NoDecorations);
+        ImPlot::SetNextSurfaceView(yaw, pitch, height);
+        ImPlot::PlotSurface("sombrero",values,size,size,0,0,ImPlotPoint(-1,-1),ImPlotPoint(1,1),flags);
+        ImPlot::EndPlot();
+    }
+    ImPlot::PopColormap();
+}
+// add by Dicky end
+
 //-----------------------------------------------------------------------------
 
 void Demo_Histogram() {
@@ -911,6 +954,19 @@ void Demo_RealtimePlots() {
         ImPlot::PlotLine("Mouse Y", &rdata2.Data[0].x, &rdata2.Data[0].y, rdata2.Data.size(), 0, 0, 2 * sizeof(float));
         ImPlot::EndPlot();
     }
+    // add by Dicky for lock-free ring buffer
+    // producers may Push from other threads while the plot reads the buffer, here the mouse is sampled every frame
+    static ImPlotRingBuffer ring(4096, 2000);
+    ring.Push(t, mouse.y * 0.0005f);
+    if (ImPlot::BeginPlot("##RingBuffer", ImVec2(-1,150))) {
+        ImPlot::SetupAxes(nullptr, nullptr, flags, flags);
+        ImPlot::SetupAxisLimits(ImAxis_X1,t - history, t, ImGuiCond_Always);
+        ImPlot::SetupAxisLimits(ImAxis_Y1,0,1);
+        ImPlot::PlotLine("Mouse Y", ring, ImPlotLineFlags_SortedX);
+        ImPlot::EndPlot();
+    }
+    ImGui::Text("Ring buffer: %d samples plotted, %llu pushed, %llu dropped", ring.Size(), (unsigned long long)ring.GetPushed(), (unsigned long long)ring.GetDropped());
+    // add by Dicky end
 }
 
 //-----------------------------------------------------------------------------
@@ -2237,6 +2293,7 @@ void ShowDemoWindow(bool* p_open) {
             DemoHeader("Infinite Lines", Demo_InfiniteLines);
             DemoHeader("Pie Charts", Demo_PieCharts);
             DemoHeader("Heatmaps", Demo_Heatmaps);
+            DemoHeader("Surfaces", Demo_Surfaces); // add by Dicky
             DemoHeader("Histogram", Demo_Histogram);
             DemoHeader("Histogram 2D", Demo_Histogram2D);
             DemoHeader("Digital Plots", Demo_DigitalPlots);
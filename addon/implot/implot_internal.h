@@ -33,6 +33,7 @@
 
 #include <time.h>
 #include "imgui_internal.h"
+#include "imgui_texture.h" // add by Dicky for heatmap textures
 
 #ifndef IMPLOT_VERSION
 #error Must include implot.h before implot_internal.h
@@ -91,7 +92,7 @@ struct ImPlotTicker;
 //-----------------------------------------------------------------------------
 
 #ifndef GImPlot
-extern IMPLOT_API ImPlotContext* GImPlot; // Current implicit context pointer
+extern IMPLOT_API IMGUI_CONTEXT_STORAGE ImPlotContext* GImPlot; // Current implicit context pointer // modify by Dicky
 #endif
 
 //-----------------------------------------------------------------------------
@@ -620,6 +621,35 @@ struct ImPlotTicker {
     }
 };
 
+// add by Dicky for tick cache
+#define IMPLOT_TICK_CACHE_SIZE 256 // ticks of this many axis states are kept, the least recently used are replaced
+
+// Everything the ticks generated by a locator depend on. Zeroed before it's filled so it can be hashed and compared as bytes.
+struct ImPlotTickCacheKey {
+    ImPlotLocator   Locator;
+    ImPlotFormatter Formatter;
+    void*           FormatterData;
+    ImGuiID         FormatHash;     // hash of the format string given to Formatter_Default
+    double          RangeMin;
+    double          RangeMax;
+    float           Pixels;
+    int             Vertical;
+    int             TimeStyle;      // UseLocalTime, UseISO8601 and Use24HourClock bits
+    ImFont*         Font;
+    float           FontSize;
+};
+
+// Ticks and labels a locator generated for a key
+struct ImPlotTickCacheEntry {
+    ImGuiID              ID;
+    ImPlotTickCacheKey   Key;
+    ImVector<ImPlotTick> Ticks;
+    ImGuiTextBuffer      TextBuffer;
+    ImVec2               MaxSize;
+    int                  LastUse;
+};
+// add by Dicky end
+
 // Axis state information that must persist after EndPlot
 struct ImPlotAxis
 {
@@ -946,6 +976,10 @@ struct ImPlotItem
     bool         Show;
     bool         LegendHovered;
     bool         SeenThisFrame;
+    bool         HasFitCache;   // add by Dicky, FitX/FitY hold the extents last fitted for FitVersion and FitKey
+    ImU64        FitVersion;    // add by Dicky
+    ImGuiID      FitKey;        // add by Dicky, hash of the axis state fitting depends on
+    ImPlotRange  FitX, FitY;    // add by Dicky
 
     ImPlotItem() {
         ID            = 0;
@@ -954,6 +988,9 @@ struct ImPlotItem
         Show          = true;
         SeenThisFrame = false;
         LegendHovered = false;
+        HasFitCache   = false; // add by Dicky
+        FitVersion    = 0;     // add by Dicky
+        FitKey        = 0;     // add by Dicky
     }
 
     ~ImPlotItem() { ID = 0; }
@@ -1190,6 +1227,14 @@ struct ImPlotNextItemData {
     bool            HasHidden;
     bool            Hidden;
     ImPlotCond      HiddenCond;
+    bool            HasHistogramVersion; // add by Dicky
+    ImU64           HistogramVersion;    // add by Dicky
+    bool            HasFitVersion;       // add by Dicky
+    ImU64           FitVersion;          // add by Dicky
+    bool            HasSurfaceView;      // add by Dicky
+    double          SurfaceYaw;          // add by Dicky
+    double          SurfacePitch;        // add by Dicky
+    double          SurfaceHeight;       // add by Dicky
     ImPlotNextItemData() { Reset(); }
     void Reset() {
         for (int i = 0; i < 5; ++i)
@@ -1197,9 +1242,74 @@ struct ImPlotNextItemData {
         LineWeight    = MarkerSize = MarkerWeight = FillAlpha = ErrorBarSize = ErrorBarWeight = DigitalBitHeight = DigitalBitGap = IMPLOT_AUTO;
         Marker        = IMPLOT_AUTO;
         HasHidden     = Hidden = false;
+        HasHistogramVersion = false; // add by Dicky
+        HasFitVersion = false; // add by Dicky
+        HasSurfaceView = false; // add by Dicky
     }
 };
 
+// add by Dicky for heatmap textures
+// Colorized pixels and texture of a heatmap plotted with ImPlotHeatmapFlags_Texture. Every texture row holds one
+// contiguous line of values (a row, or a column when column major) and the rows are used as a ring starting at
+// Head, so when the data scrolls by some lines only the lines scrolling in are colorized and uploaded again.
+struct ImPlotHeatmapTexture {
+    ImGuiID         ID;
+    ImTextureID     Texture;
+    ImGui::ImMat    Pixels;        // LineSize x Lines RGBA, in texture row order
+    ImVector<ImU64> LineHashes;    // hash of the values colorized into each texture row
+    ImVector<ImU64> NewHashes;     // hash of each line of the values being updated
+    ImVector<int>   DirtyLines;    // texture rows colorized but not uploaded yet
+    int             Lines;
+    int             LineSize;
+    int             Head;          // texture row holding the first line of values
+    ImU64           ColormapHash;
+    double          ScaleMin, ScaleMax;
+    int             LastFrame;
+
+    ImPlotHeatmapTexture() { ID = 0; Texture = 0; Lines = LineSize = Head = 0; ColormapHash = 0; ScaleMin = ScaleMax = 0; LastFrame = -1; }
+    ~ImPlotHeatmapTexture() { if (Texture) ImGui::ImDestroyTexture(Texture); }
+};
+
+// Bins last computed by PlotHistogram or PlotHistogram2D for an item given a version with SetNextHistogramVersion(),
+// along with the arguments they were computed for.
+struct ImPlotHistogramCache {
+    ImGuiID              ID;
+    const void*          Xs;
+    const void*          Ys;
+    int                  Count;
+    ImU64                Version;
+    int                  XBinsArg, YBinsArg;
+    ImPlotRect           RangeArg;
+    ImPlotHistogramFlags Flags;
+    int                  XBins, YBins;   // resolved bin counts
+    ImPlotRect           Range;          // resolved range
+    double               Width, Height;  // bin size
+    double               MaxCount;
+    ImVector<double>     Centers;        // bin centers (PlotHistogram only)
+    ImVector<double>     Counts;
+    int                  LastFrame;
+
+    ImPlotHistogramCache() { ID = 0; Xs = Ys = nullptr; Count = 0; Version = 0; XBinsArg = YBinsArg = XBins = YBins = 0; Flags = 0; Width = Height = MaxCount = 0; LastFrame = -1; }
+};
+// add by Dicky end
+
+// add by Dicky for surface plots
+// A grid node of a surface seen through its view: X right and Y up in plot units from the center of the surface,
+// Z away from the viewer. Nodes holding NaN are not Valid, the cells around them are left out.
+struct ImPlotSurfaceNode {
+    ImVec2  Pixel;
+    float   X, Y, Z;
+    ImU32   Col;
+    bool    Valid;
+};
+
+// Triangles of a run of surface tiles, generated by one thread
+struct ImPlotSurfaceBuffer {
+    ImVector<ImPlotSurfaceNode> Nodes;  // nodes of the tile being generated
+    ImVector<ImDrawVert>        Vtx;    // three vertices per triangle, in drawing order
+};
+// add by Dicky end
+
 // Holds state information that must persist between calls to BeginPlot()/EndPlot()
 struct ImPlotContext {
     // Plot States
@@ -1231,6 +1341,7 @@ struct ImPlotContext {
     // Temp data for general use
     ImVector<double>   TempDouble1, TempDouble2;
     ImVector<int>      TempInt1;
+    ImBitVector        TempBits;        // add by Dicky, pixel occupancy of the plot area used to decimate markers
 
     // Misc
     int                DigitalPlotItemCnt;
@@ -1246,6 +1357,14 @@ struct ImPlotContext {
     ImPool<ImPlotAlignmentData> AlignmentData;
     ImPlotAlignmentData*        CurrentAlignmentH;
     ImPlotAlignmentData*        CurrentAlignmentV;
+
+    ImPool<ImPlotHeatmapTexture> HeatmapTextures; // add by Dicky, textures of heatmaps plotted with ImPlotHeatmapFlags_Texture, keyed by item ID
+    ImPool<ImPlotHistogramCache> HistogramCaches; // add by Dicky, bins of histograms given a version, keyed by item ID
+    ImPool<ImPlotTickCacheEntry> TickCache;       // add by Dicky, ticks generated by locators, keyed by the hash of their ImPlotTickCacheKey
+    int                          TickCacheClock;  // add by Dicky, lookups so far, orders entries by last use
+    ImGuiContext*                ImageContext;    // add by Dicky, ImGui context owned by an image context, see CreateImageContext()
+    int                          ImagePass;       // add by Dicky, pass of the image being rendered: 1 fits the plots, 2 draws them
+    ImPlotSurfaceBuffer          SurfaceBuffers[OMP_THREADS]; // add by Dicky, triangles of the surface being plotted, one buffer per thread
 };
 
 //-----------------------------------------------------------------------------
@@ -1311,21 +1430,61 @@ IMPLOT_API void ShowSubplotsContextMenu(ImPlotSubplot& subplot);
 // Begins a new item. Returns false if the item should not be plotted. Pushes PlotClipRect.
 IMPLOT_API bool BeginItem(const char* label_id, ImPlotItemFlags flags=0, ImPlotCol recolor_from=IMPLOT_AUTO);
 
+// Ends an item (call only if BeginItem returns true). Pops PlotClipRect.
+IMPLOT_API void EndItem();
+
+// add by Dicky for fit cache
+// Hash of the axis state the points an item fits depend on (constraints, and ranges used by RangeFit).
+IMPLOT_API ImGuiID GetFitKey(const ImPlotAxis& x_axis, const ImPlotAxis& y_axis);
+
+// Fits the current item with #fitter, or extends the axes with the extents it fitted last time when
+// its version and the axis state are unchanged.
+template <typename _Fitter>
+void FitItemVersioned(const _Fitter& fitter, ImPlotAxis& x_axis, ImPlotAxis& y_axis) {
+    ImPlotItem& item = *GImPlot->CurrentItem;
+    const ImU64 version = GImPlot->NextItemData.FitVersion;
+    const ImGuiID key = GetFitKey(x_axis, y_axis);
+    if (!item.HasFitCache || item.FitVersion != version || item.FitKey != key) {
+        // fit the item alone, then merge it into the extents of the items before it
+        const ImPlotRange x_ext = x_axis.FitExtents, y_ext = y_axis.FitExtents;
+        x_axis.FitExtents = ImPlotRange(HUGE_VAL, -HUGE_VAL);
+        y_axis.FitExtents = ImPlotRange(HUGE_VAL, -HUGE_VAL);
+        fitter.Fit(x_axis, y_axis);
+        item.FitX = x_axis.FitExtents;
+        item.FitY = y_axis.FitExtents;
+        item.FitVersion = version;
+        item.FitKey = key;
+        item.HasFitCache = true;
+        x_axis.FitExtents = x_ext;
+        y_axis.FitExtents = y_ext;
+    }
+    x_axis.FitExtents = ImPlotRange(ImMin(x_axis.FitExtents.Min, item.FitX.Min), ImMax(x_axis.FitExtents.Max, item.FitX.Max));
+    y_axis.FitExtents = ImPlotRange(ImMin(y_axis.FitExtents.Min, item.FitY.Min), ImMax(y_axis.FitExtents.Max, item.FitY.Max));
+}
+// add by Dicky end
+
 // Same as above but with fitting functionality.
 template <typename _Fitter>
 bool BeginItemEx(const char* label_id, const _Fitter& fitter, ImPlotItemFlags flags=0, ImPlotCol recolor_from=IMPLOT_AUTO) {
     if (BeginItem(label_id, flags, recolor_from)) {
         ImPlotPlot& plot = *GetCurrentPlot();
-        if (plot.FitThisFrame && !ImHasFlag(flags, ImPlotItemFlags_NoFit))
-            fitter.Fit(plot.Axes[plot.CurrentX], plot.Axes[plot.CurrentY]);
+        if (plot.FitThisFrame && !ImHasFlag(flags, ImPlotItemFlags_NoFit)) {
+            if (GImPlot->NextItemData.HasFitVersion) // add by Dicky for fit cache
+                FitItemVersioned(fitter, plot.Axes[plot.CurrentX], plot.Axes[plot.CurrentY]); // add by Dicky
+            else
+                fitter.Fit(plot.Axes[plot.CurrentX], plot.Axes[plot.CurrentY]);
+        }
+        // add by Dicky for image rendering, the fit pass of an image doesn't need the item drawn
+        if (GImPlot->ImagePass == 1) {
+            EndItem();
+            return false;
+        }
+        // add by Dicky end
         return true;
     }
     return false;
 }
 
-// Ends an item (call only if BeginItem returns true). Pops PlotClipRect.
-IMPLOT_API void EndItem();
-
 // Register or get an existing item from the current plot.
 IMPLOT_API ImPlotItem* RegisterOrGetItem(const char* label_id, ImPlotItemFlags flags, bool* just_created = nullptr);
 // Get a plot item from the current plot.
@@ -1334,6 +1493,15 @@ IMPLOT_API ImPlotItem* GetItem(const char* label_id);
 IMPLOT_API ImPlotItem* GetCurrentItem();
 // Busts the cache for every item for every plot in the current context.
 IMPLOT_API void BustItemCache();
+// add by Dicky for tick cache
+// Fills a ticker with the ticks of #locator, copied from the tick cache when it already ran with the same inputs.
+IMPLOT_API void LocateTicks(ImPlotTicker& ticker, ImPlotLocator locator, const ImPlotRange& range, float pixels, bool vertical, ImPlotFormatter formatter, void* formatter_data);
+// add by Dicky end
+// add by Dicky for heatmap textures
+// Colorizes the lines of a heatmap whose values, scale or colormap changed since the last update of #cache into its pixels
+// and queues them in DirtyLines for upload. Returns the number of lines colorized.
+IMPLOT_TMP int UpdateHeatmapPixels(ImPlotHeatmapTexture& cache, const T* values, int rows, int cols, double scale_min, double scale_max, bool col_maj);
+// add by Dicky end
 
 //-----------------------------------------------------------------------------
 // [SECTION] Axis Utils
@@ -551,6 +551,114 @@ struct IndexerConst {
     const double Ref;
 };
 
+// add by Dicky for columnar data
+static IMPLOT_INLINE bool IsValidBit(const ImU8* validity, int bit) {
+    return validity == nullptr || ((validity[bit >> 3] >> (bit & 7)) & 1) != 0;
+}
+
+// Values of a strided column with an optional validity bitmap, nulls read as NaN
+template <typename T>
+struct IndexerColumn {
+    IndexerColumn(const ImPlotColumn<T>& column, int count) :
+        Data((const unsigned char*)column.Data),
+        Validity(column.Validity),
+        ValidityOffset(column.ValidityOffset),
+        Stride(column.Stride),
+        Count(count)
+    { }
+    template <typename I> IMPLOT_INLINE double operator()(I idx) const {
+        if (!IsValidBit(Validity, ValidityOffset + (int)idx))
+            return NAN;
+        return (double)*(const T*)(const void*)(Data + (size_t)idx * Stride);
+    }
+    const unsigned char* const Data;
+    const ImU8* const Validity;
+    const int ValidityOffset;
+    const int Stride;
+    const int Count;
+};
+
+// Chunk list of a column, a column without chunks is a single chunk. Starts holds the index of the first value
+// of each chunk followed by the column size.
+template <typename T>
+struct ColumnChunks {
+    ColumnChunks(const ImPlotColumn<T>& column) {
+        if (column.Chunks != nullptr)
+            Chunks.resize(column.ChunkCount);
+        else
+            Chunks.push_back(ImPlotColumnChunk<T>(column.Data, column.Count, column.Validity, column.ValidityOffset));
+        Starts.resize(Chunks.Size + 1);
+        Starts[0] = 0;
+        for (int i = 0; i < Chunks.Size; ++i) {
+            if (column.Chunks != nullptr)
+                Chunks[i] = column.Chunks[i];
+            Starts[i + 1] = Starts[i] + Chunks[i].Count;
+        }
+    }
+    ImVector<ImPlotColumnChunk<T>> Chunks;
+    ImVector<int> Starts;
+};
+
+// Values of a chunked column. Renderers and fitters mostly read consecutive values, so the chunk of the last value
+// read is checked first and the others are found by a binary search over the chunk starts. That chunk is state of
+// each copy of the indexer, parallel fitting reads from one copy per thread.
+template <typename T>
+struct IndexerColumnChunks {
+    IndexerColumnChunks(const ColumnChunks<T>& chunks, int stride, int count) :
+        Chunks(chunks.Chunks.Data),
+        Starts(chunks.Starts.Data),
+        ChunkCount(chunks.Chunks.Size),
+        Stride(stride),
+        Count(count),
+        Current(0)
+    { }
+    int FindChunk(int idx) const {
+        int lo = 0, hi = ChunkCount - 1;
+        while (lo < hi) {
+            const int mid = (lo + hi + 1) >> 1;
+            if (Starts[mid] <= idx)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+        return lo;
+    }
+    template <typename I> IMPLOT_INLINE double operator()(I idx) const {
+        const int i = (int)idx;
+        if (i < Starts[Current] || i >= Starts[Current + 1])
+            Current = FindChunk(i);
+        const ImPlotColumnChunk<T>& chunk = Chunks[Current];
+        const int local = i - Starts[Current];
+        if (!IsValidBit(chunk.Validity, chunk.ValidityOffset + local))
+            return NAN;
+        return (double)*(const T*)(const void*)((const unsigned char*)chunk.Data + (size_t)local * Stride);
+    }
+    const ImPlotColumnChunk<T>* const Chunks;
+    const int* const Starts;
+    const int ChunkCount;
+    const int Stride;
+    const int Count;
+    mutable int Current;
+};
+
+// How the values of a set of columns are read, the cheapest indexer that reads all of them
+enum ColumnAccess_ {
+    ColumnAccess_Array,     // IndexerIdx, the same as the pointer overloads
+    ColumnAccess_Nullable,  // IndexerColumn
+    ColumnAccess_Chunked    // IndexerColumnChunks
+};
+
+template <typename T>
+static int GetColumnAccess(const ImPlotColumn<T>& column) {
+    return column.Chunks != nullptr ? ColumnAccess_Chunked : column.Validity != nullptr ? ColumnAccess_Nullable : ColumnAccess_Array;
+}
+
+template <typename T>
+static int GetColumnAccess(const ImPlotColumn<T>& column1, const ImPlotColumn<T>& column2, const ImPlotColumn<T>& column3) {
+    return ImMax(GetColumnAccess(column1), ImMax(GetColumnAccess(column2), GetColumnAccess(column3)));
+}
+// add by Dicky end
+
 //-----------------------------------------------------------------------------
 // [SECTION] Getters
 //-----------------------------------------------------------------------------
@@ -648,15 +756,232 @@ struct GetterError {
 // [SECTION] Fitters
 //-----------------------------------------------------------------------------
 
+// add by Dicky for parallel fitting
+// Auto-fitting visits every point of every item again after plotting them. Contiguous arrays are reduced
+// with min/max lanes the compiler vectorizes, and only checked point by point when they hold values the
+// axes reject; other getters are scanned in chunks on several threads. Items given a version with
+// SetNextFitVersion() reuse the extents of their last fit while it doesn't change.
+
+// Arrays with at least this many values are reduced on several threads
+#define IMPLOT_MINMAX_PARALLEL_COUNT (256 * 1024)
+// Getters with at least this many points are fitted on several threads
+#define IMPLOT_FIT_PARALLEL_COUNT (256 * 1024)
+
+// Same result as ImMinMaxArray starting from #init: NaNs after the first value are skipped
+template <typename T>
+static void MinMaxLanes(const T* values, int count, T init, T* min_out, T* max_out) {
+    T mins[8], maxs[8];
+    for (int l = 0; l < 8; ++l)
+        mins[l] = maxs[l] = init;
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        for (int l = 0; l < 8; ++l) {
+            const T v = values[i + l];
+            mins[l] = v < mins[l] ? v : mins[l];
+            maxs[l] = v > maxs[l] ? v : maxs[l];
+        }
+    }
+    for (; i < count; ++i) {
+        mins[0] = values[i] < mins[0] ? values[i] : mins[0];
+        maxs[0] = values[i] > maxs[0] ? values[i] : maxs[0];
+    }
+    for (int l = 1; l < 8; ++l) {
+        mins[0] = mins[l] < mins[0] ? mins[l] : mins[0];
+        maxs[0] = maxs[l] > maxs[0] ? maxs[l] : maxs[0];
+    }
+    *min_out = mins[0];
+    *max_out = maxs[0];
+}
+
+template <typename T>
+static void ParallelMinMax(const T* values, int count, T* min_out, T* max_out) {
+    if (count < IMPLOT_MINMAX_PARALLEL_COUNT) {
+        MinMaxLanes(values, count, values[0], min_out, max_out);
+        return;
+    }
+    T mins[OMP_THREADS], maxs[OMP_THREADS];
+    const int chunk = (count + OMP_THREADS - 1) / OMP_THREADS;
+    #pragma omp parallel for num_threads(OMP_THREADS)
+    for (int c = 0; c < OMP_THREADS; ++c) {
+        const int i0 = c * chunk;
+        MinMaxLanes(values + i0, ImClamp(count - i0, 0, chunk), values[0], &mins[c], &maxs[c]);
+    }
+    T unused;
+    MinMaxLanes(mins, OMP_THREADS, values[0], min_out, &unused);
+    MinMaxLanes(maxs, OMP_THREADS, values[0], &unused, max_out);
+}
+
+// Min and max of the finite values, starting from a finite first value
+template <typename T>
+static void FiniteMinMax(const T* values, int count, T* min_out, T* max_out) {
+    T lo = values[0], hi = values[0];
+    for (int i = 1; i < count; ++i) {
+        if (ImNanOrInf((double)values[i]))
+            continue;
+        lo = values[i] < lo ? values[i] : lo;
+        hi = values[i] > hi ? values[i] : hi;
+    }
+    *min_out = lo;
+    *max_out = hi;
+}
+
+// Tells whether a getter can be called from several threads at once, user callbacks may not be reentrant
+template <typename _Getter>
+struct GetterIsThreadSafe { enum { Value = 1 }; };
+
+template <>
+struct GetterIsThreadSafe<GetterFuncPtr> { enum { Value = 0 }; };
+
+template <typename _Getter>
+struct GetterIsThreadSafe<GetterOverrideX<_Getter>> { enum { Value = GetterIsThreadSafe<_Getter>::Value }; };
+
+template <typename _Getter>
+struct GetterIsThreadSafe<GetterOverrideY<_Getter>> { enum { Value = GetterIsThreadSafe<_Getter>::Value }; };
+
+template <typename _Getter>
+struct GetterIsThreadSafe<GetterLoop<_Getter>> { enum { Value = GetterIsThreadSafe<_Getter>::Value }; };
+
+// The checks ImPlotAxis::ExtendFitWith makes on a point, copied out of the axes
+struct FitFilter {
+    FitFilter(const ImPlotAxis& x_axis, const ImPlotAxis& y_axis) :
+        XConstraint(x_axis.ConstraintRange),
+        YConstraint(y_axis.ConstraintRange),
+        XRange(x_axis.Range),
+        YRange(y_axis.Range),
+        XRangeFit(ImHasFlag(x_axis.Flags, ImPlotAxisFlags_RangeFit)),
+        YRangeFit(ImHasFlag(y_axis.Flags, ImPlotAxisFlags_RangeFit))
+    { }
+    const ImPlotRange XConstraint;
+    const ImPlotRange YConstraint;
+    const ImPlotRange XRange;
+    const ImPlotRange YRange;
+    const bool XRangeFit;
+    const bool YRangeFit;
+};
+
+// Extents of the points that passed a FitFilter, empty while Min > Max
+struct FitExtents {
+    FitExtents() : X(HUGE_VAL, -HUGE_VAL), Y(HUGE_VAL, -HUGE_VAL) { }
+    IMPLOT_INLINE void Add(const FitFilter& f, double x, double y) {
+        if ((!f.XRangeFit || f.YRange.Contains(y)) && !ImNanOrInf(x) && x >= f.XConstraint.Min && x <= f.XConstraint.Max) {
+            X.Min = x < X.Min ? x : X.Min;
+            X.Max = x > X.Max ? x : X.Max;
+        }
+        if ((!f.YRangeFit || f.XRange.Contains(x)) && !ImNanOrInf(y) && y >= f.YConstraint.Min && y <= f.YConstraint.Max) {
+            Y.Min = y < Y.Min ? y : Y.Min;
+            Y.Max = y > Y.Max ? y : Y.Max;
+        }
+    }
+    void Merge(const FitExtents& e) {
+        X.Min = ImMin(X.Min, e.X.Min); X.Max = ImMax(X.Max, e.X.Max);
+        Y.Min = ImMin(Y.Min, e.Y.Min); Y.Max = ImMax(Y.Max, e.Y.Max);
+    }
+    void Apply(ImPlotAxis& x_axis, ImPlotAxis& y_axis) const {
+        if (X.Min <= X.Max) { x_axis.ExtendFit(X.Min); x_axis.ExtendFit(X.Max); }
+        if (Y.Min <= Y.Max) { y_axis.ExtendFit(Y.Min); y_axis.ExtendFit(Y.Max); }
+    }
+    ImPlotRange X, Y;
+};
+
+// Extents of the values of an indexer shifted by #shift, when they can be found without checking values one by one.
+// Fails unless every value is finite and inside #constraint (NaNs are skipped like ExtendFit does).
+template <typename _Indexer>
+static bool IndexerExtents(const _Indexer&, int, double, const ImPlotRange&, ImPlotRange*) {
+    return false;
+}
+
+static bool CheckedExtents(double lo, double hi, const ImPlotRange& constraint, ImPlotRange* ext) {
+    if (ImNanOrInf(lo) || ImNanOrInf(hi) || lo < constraint.Min || hi > constraint.Max)
+        return false;
+    ext->Min = lo;
+    ext->Max = hi;
+    return true;
+}
+
+template <typename T>
+static bool IndexerExtents(const IndexerIdx<T>& indexer, int count, double shift, const ImPlotRange& constraint, ImPlotRange* ext) {
+    // with a unit stride the offset only rotates the array, which doesn't change its extents
+    if (indexer.Stride != (int)sizeof(T) || indexer.Count != count)
+        return false;
+    int first = 0;
+    while (first < count && ImNan((double)indexer.Data[first]))
+        ++first;
+    if (first == count) {
+        *ext = ImPlotRange(HUGE_VAL, -HUGE_VAL);
+        return true;
+    }
+    T lo, hi;
+    ParallelMinMax(indexer.Data + first, count - first, &lo, &hi);
+    return CheckedExtents((double)lo + shift, (double)hi + shift, constraint, ext);
+}
+
+static bool IndexerExtents(const IndexerLin& indexer, int count, double shift, const ImPlotRange& constraint, ImPlotRange* ext) {
+    const double v0 = indexer(0) + shift;
+    const double v1 = indexer(count - 1) + shift;
+    return CheckedExtents(ImMin(v0, v1), ImMax(v0, v1), constraint, ext);
+}
+
+static bool IndexerExtents(const IndexerConst& indexer, int, double shift, const ImPlotRange& constraint, ImPlotRange* ext) {
+    const double v = indexer(0) + shift;
+    return CheckedExtents(v, v, constraint, ext);
+}
+
+template <typename _Getter>
+static bool GetterExtents(const _Getter&, int, const FitFilter&, double, double, FitExtents*) {
+    return false;
+}
+
+template <typename _IndexerX, typename _IndexerY>
+static bool GetterExtents(const GetterXY<_IndexerX,_IndexerY>& getter, int count, const FitFilter& filter, double dx, double dy, FitExtents* ext) {
+    // with RangeFit the points of one axis are filtered by the other one
+    if (filter.XRangeFit || filter.YRangeFit)
+        return false;
+    return IndexerExtents(getter.IndxerX, count, dx, filter.XConstraint, &ext->X) && IndexerExtents(getter.IndxerY, count, dy, filter.YConstraint, &ext->Y);
+}
+
+// Getter is taken by value so the loop doesn't reload it after every extents update
+template <typename _Getter>
+static FitExtents FitChunk(const _Getter getter, const FitFilter filter, int i0, int i1, double dx, double dy) {
+    FitExtents ext;
+    for (int i = i0; i < i1; ++i) {
+        const ImPlotPoint p = getter(i);
+        ext.Add(filter, p.x + dx, p.y + dy);
+    }
+    return ext;
+}
+
+// Extends the fit of the axes with the first #count points of a getter shifted by (dx,dy), the same
+// as calling ExtendFitWith for each of them. The default shift of -0.0 leaves every value unchanged.
+template <typename _Getter>
+static void FitPoints(const _Getter& getter, int count, ImPlotAxis& x_axis, ImPlotAxis& y_axis, double dx = -0.0, double dy = -0.0) {
+    if (count <= 0)
+        return;
+    const FitFilter filter(x_axis, y_axis);
+    FitExtents ext;
+    if (!GetterExtents(getter, count, filter, dx, dy, &ext)) {
+        ext = FitExtents();
+        if (count >= IMPLOT_FIT_PARALLEL_COUNT && GetterIsThreadSafe<_Getter>::Value) {
+            FitExtents parts[OMP_THREADS];
+            const int chunk = (count + OMP_THREADS - 1) / OMP_THREADS;
+            #pragma omp parallel for num_threads(OMP_THREADS)
+            for (int c = 0; c < OMP_THREADS; ++c)
+                parts[c] = FitChunk(getter, filter, ImMin(c * chunk, count), ImMin((c + 1) * chunk, count), dx, dy);
+            for (int c = 0; c < OMP_THREADS; ++c)
+                ext.Merge(parts[c]);
+        }
+        else {
+            ext = FitChunk(getter, filter, 0, count, dx, dy);
+        }
+    }
+    ext.Apply(x_axis, y_axis);
+}
+// add by Dicky end
+
 template <typename _Getter1>
 struct Fitter1 {
     Fitter1(const _Getter1& getter) : Getter(getter) { }
     void Fit(ImPlotAxis& x_axis, ImPlotAxis& y_axis) const {
-        for (int i = 0; i < Getter.Count; ++i) {
-            ImPlotPoint p = Getter(i);
-            x_axis.ExtendFitWith(y_axis, p.x, p.y);
-            y_axis.ExtendFitWith(x_axis, p.y, p.x);
-        }
+        FitPoints(Getter, Getter.Count, x_axis, y_axis); // modify by Dicky
     }
     const _Getter1& Getter;
 };
@@ -689,16 +1014,10 @@ template <typename _Getter1, typename _Getter2>
 struct Fitter2 {
     Fitter2(const _Getter1& getter1, const _Getter2& getter2) : Getter1(getter1), Getter2(getter2) { }
     void Fit(ImPlotAxis& x_axis, ImPlotAxis& y_axis) const {
-        for (int i = 0; i < Getter1.Count; ++i) {
-            ImPlotPoint p = Getter1(i);
-            x_axis.ExtendFitWith(y_axis, p.x, p.y);
-            y_axis.ExtendFitWith(x_axis, p.y, p.x);
-        }
-        for (int i = 0; i < Getter2.Count; ++i) {
-            ImPlotPoint p = Getter2(i);
-            x_axis.ExtendFitWith(y_axis, p.x, p.y);
-            y_axis.ExtendFitWith(x_axis, p.y, p.x);
-        }
+        // modify by Dicky for parallel fitting
+        FitPoints(Getter1, Getter1.Count, x_axis, y_axis);
+        FitPoints(Getter2, Getter2.Count, x_axis, y_axis);
+        // modify by Dicky end
     }
     const _Getter1& Getter1;
     const _Getter2& Getter2;
@@ -713,14 +1032,10 @@ struct FitterBarV {
     { }
     void Fit(ImPlotAxis& x_axis, ImPlotAxis& y_axis) const {
         int count = ImMin(Getter1.Count, Getter2.Count);
-        for (int i = 0; i < count; ++i) {
-            ImPlotPoint p1 = Getter1(i); p1.x -= HalfWidth;
-            ImPlotPoint p2 = Getter2(i); p2.x += HalfWidth;
-            x_axis.ExtendFitWith(y_axis, p1.x, p1.y);
-            y_axis.ExtendFitWith(x_axis, p1.y, p1.x);
-            x_axis.ExtendFitWith(y_axis, p2.x, p2.y);
-            y_axis.ExtendFitWith(x_axis, p2.y, p2.x);
-        }
+        // modify by Dicky for parallel fitting
+        FitPoints(Getter1, count, x_axis, y_axis, -HalfWidth);
+        FitPoints(Getter2, count, x_axis, y_axis, HalfWidth);
+        // modify by Dicky end
     }
     const _Getter1& Getter1;
     const _Getter2& Getter2;
@@ -736,14 +1051,10 @@ struct FitterBarH {
     { }
     void Fit(ImPlotAxis& x_axis, ImPlotAxis& y_axis) const {
         int count = ImMin(Getter1.Count, Getter2.Count);
-        for (int i = 0; i < count; ++i) {
-            ImPlotPoint p1 = Getter1(i); p1.y -= HalfHeight;
-            ImPlotPoint p2 = Getter2(i); p2.y += HalfHeight;
-            x_axis.ExtendFitWith(y_axis, p1.x, p1.y);
-            y_axis.ExtendFitWith(x_axis, p1.y, p1.x);
-            x_axis.ExtendFitWith(y_axis, p2.x, p2.y);
-            y_axis.ExtendFitWith(x_axis, p2.y, p2.x);
-        }
+        // modify by Dicky for parallel fitting
+        FitPoints(Getter1, count, x_axis, y_axis, -0.0, -HalfHeight);
+        FitPoints(Getter2, count, x_axis, y_axis, -0.0, HalfHeight);
+        // modify by Dicky end
     }
     const _Getter1& Getter1;
     const _Getter2& Getter2;
@@ -1410,6 +1721,457 @@ void RenderPrimitives2(const _Getter1& getter1, const _Getter2& getter2, Args...
     RenderPrimitivesEx(_Renderer<_Getter1,_Getter2>(getter1,getter2,args...), draw_list, cull_rect);
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] Decimation (add by Dicky)
+//-----------------------------------------------------------------------------
+
+// A series with millions of points collapses onto a few thousand pixel columns, yet the
+// renderers above transform and cull every point. For series with ascending x we find the
+// visible index range with a binary search and keep only the first, last, min and max point
+// of each pixel column (M4), which rasterizes to the same line. LTTB can be requested instead
+// for fewer vertices at the cost of pixel exactness. Markers are decimated by skipping those
+// whose center lands on a pixel already covered by an earlier marker of the same series.
+
+// Series are only decimated when they have more points than this per pixel column of the plot
+#define IMPLOT_DECIMATE_MIN_POINTS_PER_PIXEL 4
+
+// Tells whether a getter's x is known to be ascending without looking at the data
+template <typename _Getter>
+struct GetterIsSortedX {
+    static bool Check(const _Getter&) { return false; }
+};
+
+template <typename _IndexerY>
+struct GetterIsSortedX<GetterXY<IndexerLin,_IndexerY>> {
+    static bool Check(const GetterXY<IndexerLin,_IndexerY>& getter) { return getter.IndxerX.M > 0; }
+};
+
+// Returns the first index in [lo,hi) whose x is not less than x, or hi (getter x must be ascending)
+template <typename _Getter>
+int LowerBoundX(const _Getter& getter, double x, int lo, int hi) {
+    while (lo < hi) {
+        const int mid = lo + (hi - lo) / 2;
+        if (getter(mid).x < x) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+// Returns the first index in [lo,hi) whose x is greater than x, or hi (getter x must be ascending)
+template <typename _Getter>
+int UpperBoundX(const _Getter& getter, double x, int lo, int hi) {
+    while (lo < hi) {
+        const int mid = lo + (hi - lo) / 2;
+        if (getter(mid).x <= x) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+static IMPLOT_INLINE void PushDecimatedPoint(ImVector<double>& xs, ImVector<double>& ys, const ImPlotPoint& p) {
+    xs.push_back(p.x);
+    ys.push_back(p.y);
+}
+
+// First, last, min and max point of the samples falling in one pixel column
+struct DecimatorM4Column {
+    ImPlotPoint First, Last, Min, Max;
+    int IdxFirst, IdxLast, IdxMin, IdxMax;
+    IMPLOT_INLINE void Begin(const ImPlotPoint& p, int idx) {
+        First = Last = Min = Max = p;
+        IdxFirst = IdxLast = IdxMin = IdxMax = idx;
+    }
+    IMPLOT_INLINE void Add(const ImPlotPoint& p, int idx) {
+        Last = p; IdxLast = idx;
+        if (p.y < Min.y) { Min = p; IdxMin = idx; }
+        if (p.y > Max.y) { Max = p; IdxMax = idx; }
+    }
+    // emits the kept points in their original order
+    void Flush(ImVector<double>& xs, ImVector<double>& ys) const {
+        const bool min_first = IdxMin < IdxMax;
+        const int idx_a = min_first ? IdxMin : IdxMax;
+        const int idx_b = min_first ? IdxMax : IdxMin;
+        PushDecimatedPoint(xs, ys, First);
+        if (idx_a != IdxFirst && idx_a != IdxLast)
+            PushDecimatedPoint(xs, ys, min_first ? Min : Max);
+        if (idx_b != IdxFirst && idx_b != IdxLast)
+            PushDecimatedPoint(xs, ys, min_first ? Max : Min);
+        if (IdxLast != IdxFirst)
+            PushDecimatedPoint(xs, ys, Last);
+    }
+};
+
+// Per point M4 over [i0,i1], used for ranges holding NaNs which must be kept to break the line
+template <typename _Getter>
+void DecimateM4Points(const _Getter& getter, int i0, int i1, const Transformer1& tx, float px_min, float px_max, bool skip_nan, ImVector<double>& xs, ImVector<double>& ys) {
+    DecimatorM4Column col;
+    int column = 0;
+    bool open = false;
+    for (int i = i0; i <= i1; ++i) {
+        const ImPlotPoint p = getter(i);
+        if (ImNan(p.x) || ImNan(p.y)) {
+            if (skip_nan)
+                continue;
+            if (open)
+                col.Flush(xs, ys);
+            open = false;
+            PushDecimatedPoint(xs, ys, p);
+            continue;
+        }
+        const int c = (int)ImFloor(ImClamp(tx(p.x), px_min, px_max));
+        if (open && c == column) {
+            col.Add(p, i);
+            continue;
+        }
+        if (open)
+            col.Flush(xs, ys);
+        col.Begin(p, i);
+        column = c;
+        open = true;
+    }
+    if (open)
+        col.Flush(xs, ys);
+}
+
+// Min/max y of the samples [a,b) of a column found by scanning them, fails if one of them is NaN
+template <typename _Getter>
+struct ColumnMinMaxScan {
+    ColumnMinMaxScan(const _Getter& getter) : Getter(getter) { }
+    IMPLOT_INLINE bool operator()(int a, int b, int* idx_min, int* idx_max) const {
+        double y_min = Getter(a).y, y_max = y_min;
+        bool nan = ImNan(y_min);
+        *idx_min = *idx_max = a;
+        for (int i = a + 1; i < b; ++i) {
+            const double y = Getter(i).y;
+            nan |= ImNan(y);
+            if (y < y_min) { y_min = y; *idx_min = i; }
+            if (y > y_max) { y_max = y; *idx_max = i; }
+        }
+        return !nan;
+    }
+    const _Getter& Getter;
+};
+
+// End of the pixel column starting at point a (at pixel px) found with a binary search on the
+// column's edge, points beyond the plot area share a column so the segments leaving it are kept
+template <typename _Getter>
+int DecimateColumnEnd(const _Getter& getter, int a, int i1, const ImPlotAxis& x_axis, float px, float px_min, float px_max) {
+    const bool ascending_px = x_axis.ScaleToPixel > 0;
+    if (px > px_min && px < px_max) {
+        const float edge = ascending_px ? ImFloor(px) + 1.0f : ImFloor(px);
+        return LowerBoundX(getter, x_axis.PixelsToPlot(edge), a + 1, i1 + 1);
+    }
+    if ((px <= px_min) == ascending_px)
+        return LowerBoundX(getter, x_axis.PixelsToPlot(ascending_px ? px_min + 1.0f : px_max - 1.0f), a + 1, i1 + 1);
+    return i1 + 1;
+}
+
+// M4 over [i0,i1]: the points of each pixel column are found with a binary search on the
+// column's edge, so only the min/max of the column's y has to be found
+template <typename _Getter, typename _MinMax>
+void DecimateM4(const _Getter& getter, const _MinMax& minmax, int i0, int i1, const ImPlotAxis& x_axis, const Transformer1& tx, float px_min, float px_max, bool skip_nan, ImVector<double>& xs, ImVector<double>& ys) {
+    DecimatorM4Column col;
+    int a = i0;
+    while (a <= i1) {
+        const float px = ImClamp(tx(getter(a).x), px_min, px_max);
+        if (ImNan(px)) {
+            DecimateM4Points(getter, a, a, tx, px_min, px_max, skip_nan, xs, ys);
+            a++;
+            continue;
+        }
+        const int b = DecimateColumnEnd(getter, a, i1, x_axis, px, px_min, px_max);
+        int idx_min, idx_max;
+        if (!minmax(a, b, &idx_min, &idx_max)) {
+            DecimateM4Points(getter, a, b - 1, tx, px_min, px_max, skip_nan, xs, ys);
+        }
+        else {
+            col.First = getter(a);    col.IdxFirst = a;
+            col.Last  = getter(b - 1); col.IdxLast  = b - 1;
+            col.Min   = getter(idx_min); col.IdxMin = idx_min;
+            col.Max   = getter(idx_max); col.IdxMax = idx_max;
+            col.Flush(xs, ys);
+        }
+        a = b;
+    }
+}
+
+template <typename _Getter>
+void DecimateLTTB(const _Getter& getter, int i0, int i1, int threshold, ImVector<double>& xs, ImVector<double>& ys) {
+    const int n = i1 - i0 + 1;
+    if (threshold < 3 || threshold >= n) {
+        for (int i = i0; i <= i1; ++i)
+            PushDecimatedPoint(xs, ys, getter(i));
+        return;
+    }
+    const double every = (double)(n - 2) / (threshold - 2);
+    ImPlotPoint a = getter(i0);
+    PushDecimatedPoint(xs, ys, a);
+    for (int b = 0; b < threshold - 2; ++b) {
+        // average point of the next bucket, NaNs are ignored
+        const int avg_start = i0 + (int)((b + 1) * every) + 1;
+        const int avg_end   = ImMin(i0 + (int)((b + 2) * every) + 1, i1 + 1);
+        ImPlotPoint avg(0, 0);
+        int avg_count = 0;
+        for (int i = avg_start; i < avg_end; ++i) {
+            const ImPlotPoint p = getter(i);
+            if (ImNan(p.x) || ImNan(p.y))
+                continue;
+            avg.x += p.x;
+            avg.y += p.y;
+            avg_count++;
+        }
+        if (avg_count > 0) {
+            avg.x /= avg_count;
+            avg.y /= avg_count;
+        }
+        else {
+            avg = getter(i1);
+        }
+        // point of the current bucket forming the largest triangle with the previous pick and the average
+        const int start = i0 + (int)(b * every) + 1;
+        const int end   = i0 + (int)((b + 1) * every) + 1;
+        ImPlotPoint pick = getter(start);
+        double max_area = -1;
+        for (int i = start; i < end; ++i) {
+            const ImPlotPoint p = getter(i);
+            const double area = ImAbs((a.x - avg.x) * (p.y - a.y) - (a.x - p.x) * (avg.y - a.y));
+            if (area > max_area) {
+                max_area = area;
+                pick = p;
+            }
+        }
+        PushDecimatedPoint(xs, ys, pick);
+        a = pick;
+    }
+    PushDecimatedPoint(xs, ys, getter(i1));
+}
+
+// Decimates a large line series with ascending x to the pixel resolution of the current plot,
+// returns false when the series should be rendered as is
+template <typename _Getter, typename _MinMax>
+bool DecimateLineEx(const _Getter& getter, const _MinMax& minmax, ImPlotLineFlags flags, ImVector<double>& xs, ImVector<double>& ys) {
+    if (flags & (ImPlotLineFlags_NoDecimate | ImPlotLineFlags_Segments | ImPlotLineFlags_Loop))
+        return false;
+    ImPlotPlot& plot = *GetCurrentPlot();
+    const ImRect& rect = plot.PlotRect;
+    const int columns = (int)rect.GetWidth() + 1;
+    if (getter.Count <= IMPLOT_DECIMATE_MIN_POINTS_PER_PIXEL * columns)
+        return false;
+    // visible range plus one point on each side, so lines leaving the plot area are kept
+    const ImPlotRange& range = plot.Axes[plot.CurrentX].Range;
+    const int i0 = ImMax(LowerBoundX(getter, range.Min, 0, getter.Count) - 1, 0);
+    const int i1 = ImMin(UpperBoundX(getter, range.Max, 0, getter.Count), getter.Count - 1);
+    xs.resize(0);
+    ys.resize(0);
+    if (i1 <= i0)
+        return true;
+    if (ImHasFlag(flags, ImPlotLineFlags_LTTB)) {
+        xs.reserve(2 * columns);
+        ys.reserve(2 * columns);
+        DecimateLTTB(getter, i0, i1, 2 * columns, xs, ys);
+    }
+    else {
+        xs.reserve(4 * columns + 4);
+        ys.reserve(4 * columns + 4);
+        const Transformer1 tx = Transformer2(plot).Tx;
+        DecimateM4(getter, minmax, i0, i1, plot.Axes[plot.CurrentX], tx, rect.Min.x - 1, rect.Max.x + 1, ImHasFlag(flags, ImPlotLineFlags_SkipNaN), xs, ys);
+    }
+    return true;
+}
+
+template <typename _Getter>
+bool DecimateLine(const _Getter& getter, ImPlotLineFlags flags, ImVector<double>& xs, ImVector<double>& ys) {
+    if (!ImHasFlag(flags, ImPlotLineFlags_SortedX) && !GetterIsSortedX<_Getter>::Check(getter))
+        return false;
+    return DecimateLineEx(getter, ColumnMinMaxScan<_Getter>(getter), flags, xs, ys);
+}
+
+// Markers drawn over an earlier one of the same series only hide it when they are opaque,
+// translucent ones blend into a different color and can't be skipped.
+static IMPLOT_INLINE bool MarkersOpaque(bool rend_fill, ImU32 col_fill, bool rend_line, ImU32 col_line) {
+    return (!rend_fill || (col_fill & IM_COL32_A_MASK) == IM_COL32_A_MASK) && (!rend_line || (col_line & IM_COL32_A_MASK) == IM_COL32_A_MASK);
+}
+
+// Keeps only the first marker landing on each pixel of the plot area, markers outside of it
+// are culled by the renderers anyway. Returns false when the series should be rendered as is.
+template <typename _Getter>
+bool DecimateMarkers(const _Getter& getter, ImVector<double>& xs, ImVector<double>& ys) {
+    ImPlotContext& gp = *GImPlot;
+    const ImRect& rect = GetCurrentPlot()->PlotRect;
+    const int w = (int)rect.GetWidth() + 1;
+    const int h = (int)rect.GetHeight() + 1;
+    if (getter.Count <= IMPLOT_DECIMATE_MIN_POINTS_PER_PIXEL * w)
+        return false;
+    gp.TempBits.Create(w * h);
+    Transformer2 transformer;
+    xs.resize(0);
+    ys.resize(0);
+    for (int i = 0; i < getter.Count; ++i) {
+        const ImPlotPoint p = getter(i);
+        const ImVec2 pix = transformer(p);
+        // same test as the marker renderers, also rejects NaNs
+        if (!(pix.x >= rect.Min.x && pix.y >= rect.Min.y && pix.x <= rect.Max.x && pix.y <= rect.Max.y))
+            continue;
+        const int bit = (int)(pix.y - rect.Min.y) * w + (int)(pix.x - rect.Min.x);
+        if (gp.TempBits.TestBit(bit))
+            continue;
+        gp.TempBits.SetBit(bit);
+        PushDecimatedPoint(xs, ys, p);
+    }
+    return true;
+}
+
+// Getter over the decimated points left in gp.TempDouble1/2
+typedef GetterXY<IndexerIdx<double>,IndexerIdx<double>> GetterDecimated;
+
+static IMPLOT_INLINE GetterDecimated GetDecimatedGetter() {
+    ImPlotContext& gp = *GImPlot;
+    return GetterDecimated(IndexerIdx<double>(gp.TempDouble1.Data, gp.TempDouble1.Size), IndexerIdx<double>(gp.TempDouble2.Data, gp.TempDouble2.Size), gp.TempDouble1.Size);
+}
+
+// add by Dicky for min/max pyramid
+// Samples of an ImPlotPyramid
+struct GetterPyramid {
+    GetterPyramid(const ImPlotPyramid& pyramid) : Pyramid(pyramid), Count(pyramid.Size()) { }
+    template <typename I> IMPLOT_INLINE ImPlotPoint operator()(I idx) const {
+        return ImPlotPoint(Pyramid.GetX((int)idx), Pyramid.Ys.Data[idx]);
+    }
+    const ImPlotPyramid& Pyramid;
+    const int Count;
+};
+
+// Min/max y of the samples [a,b) of a column read from the pyramid, fails if one of them is NaN
+struct ColumnMinMaxPyramid {
+    ColumnMinMaxPyramid(const ImPlotPyramid& pyramid) : Pyramid(pyramid) { }
+    IMPLOT_INLINE bool operator()(int a, int b, int* idx_min, int* idx_max) const {
+        if (Pyramid.HasNaN(a, b))
+            return false;
+        Pyramid.QueryMinMax(a, b, idx_min, idx_max);
+        return true;
+    }
+    const ImPlotPyramid& Pyramid;
+};
+
+static bool DecimateLine(const GetterPyramid& getter, ImPlotLineFlags flags, ImVector<double>& xs, ImVector<double>& ys) {
+    return DecimateLineEx(getter, ColumnMinMaxPyramid(getter.Pyramid), flags, xs, ys);
+}
+
+// Digital plots hold each sample's state until the next one, so M4's min/max would stretch a
+// short pulse up to the column's last point. Each pixel column instead keeps its first and last
+// sample and, for each extreme differing from the first state, the extreme followed by the
+// sample ending it, all in time order. Columns holding NaNs keep all their samples.
+static void DecimateDigitalColumn(const GetterPyramid& getter, int a, int b, ImVector<double>& xs, ImVector<double>& ys) {
+    if (getter.Pyramid.HasNaN(a, b)) {
+        for (int i = a; i < b; ++i)
+            PushDecimatedPoint(xs, ys, getter(i));
+        return;
+    }
+    int idx[6], n = 0;
+    idx[n++] = a;
+    int idx_min, idx_max;
+    getter.Pyramid.QueryMinMax(a, b, &idx_min, &idx_max);
+    const double y_first = getter.Pyramid.Ys.Data[a];
+    const int idx_a = ImMin(idx_min, idx_max), idx_b = ImMax(idx_min, idx_max);
+    if (getter.Pyramid.Ys.Data[idx_a] != y_first) {
+        idx[n++] = idx_a;
+        idx[n++] = idx_a + 1;
+    }
+    if (idx_b != idx_a && getter.Pyramid.Ys.Data[idx_b] != y_first) {
+        idx[n++] = idx_b;
+        idx[n++] = idx_b + 1;
+    }
+    idx[n++] = b - 1;
+    for (int k = 0, prev = -1; k < n; ++k) {
+        if (idx[k] <= prev || idx[k] >= b)
+            continue;
+        PushDecimatedPoint(xs, ys, getter(idx[k]));
+        prev = idx[k];
+    }
+}
+
+// Decimates a digital pyramid to the pixel resolution of the current plot, returns false when
+// the series should be rendered as is
+static bool DecimateDigital(const GetterPyramid& getter, ImVector<double>& xs, ImVector<double>& ys) {
+    ImPlotPlot& plot = *GetCurrentPlot();
+    const ImRect& rect = plot.PlotRect;
+    const int columns = (int)rect.GetWidth() + 1;
+    if (getter.Count <= IMPLOT_DECIMATE_MIN_POINTS_PER_PIXEL * columns)
+        return false;
+    // visible range plus one point on each side, the state left of the plot area holds into it
+    const ImPlotRange& range = plot.Axes[plot.CurrentX].Range;
+    const int i0 = ImMax(LowerBoundX(getter, range.Min, 0, getter.Count) - 1, 0);
+    const int i1 = ImMin(UpperBoundX(getter, range.Max, 0, getter.Count), getter.Count - 1);
+    xs.resize(0);
+    ys.resize(0);
+    if (i1 <= i0)
+        return true;
+    xs.reserve(6 * columns + 6);
+    ys.reserve(6 * columns + 6);
+    const ImPlotAxis& x_axis = plot.Axes[plot.CurrentX];
+    const Transformer1 tx = Transformer2(plot).Tx;
+    const float px_min = rect.Min.x - 1, px_max = rect.Max.x + 1;
+    int a = i0;
+    while (a <= i1) {
+        const float px = ImClamp(tx(getter(a).x), px_min, px_max);
+        const int b = ImNan(px) ? a + 1 : DecimateColumnEnd(getter, a, i1, x_axis, px, px_min, px_max);
+        DecimateDigitalColumn(getter, a, b, xs, ys);
+        a = b;
+    }
+    return true;
+}
+
+// Fits the extents of a pyramid (and optionally a reference y) without visiting its samples
+struct FitterPyramid {
+    FitterPyramid(const ImPlotPyramid& pyramid, double y_ref = NAN) : Pyramid(pyramid), YRef(y_ref) { }
+    void Fit(ImPlotAxis& x_axis, ImPlotAxis& y_axis) const {
+        const int count = Pyramid.Size();
+        if (count == 0)
+            return;
+        GetterPyramid getter(Pyramid);
+        int idx[4] = { 0, count - 1, -1, -1 };
+        Pyramid.QueryMinMax(0, count, &idx[2], &idx[3]);
+        for (int i = 0; i < 4; ++i) {
+            if (idx[i] < 0)
+                continue;
+            ImPlotPoint p = getter(idx[i]);
+            x_axis.ExtendFitWith(y_axis, p.x, p.y);
+            y_axis.ExtendFitWith(x_axis, p.y, p.x);
+        }
+        if (!ImNan(YRef))
+            y_axis.ExtendFitWith(x_axis, YRef, getter(0).x);
+    }
+    const ImPlotPyramid& Pyramid;
+    const double YRef;
+};
+// add by Dicky end
+
+// add by Dicky for lock-free ring buffer
+// Samples of the snapshot of an ImPlotRingBuffer, wrapping around the end of its storage
+struct GetterRingBuffer {
+    GetterRingBuffer(const ImPlotRingBuffer& buffer) :
+        Xs(buffer.Xs),
+        Ys(buffer.Ys),
+        Start(buffer.SnapshotStart),
+        Mask(buffer.Mask),
+        Count(buffer.SnapshotCount)
+    { }
+    template <typename I> IMPLOT_INLINE ImPlotPoint operator()(I idx) const {
+        const ImU64 i = (Start + (ImU64)idx) & Mask;
+        return ImPlotPoint(Xs[i], Ys[i]);
+    }
+    const double* const Xs;
+    const double* const Ys;
+    const ImU64 Start;
+    const ImU64 Mask;
+    const int Count;
+};
+
+// Takes the frame's snapshot of a ring buffer unless one was already taken this frame
+static GetterRingBuffer GetRingBufferSnapshot(ImPlotRingBuffer& buffer) {
+    if (buffer.SnapshotFrame != ImGui::GetFrameCount())
+        buffer.Snapshot();
+    return GetterRingBuffer(buffer);
+}
+// add by Dicky end
+
 //-----------------------------------------------------------------------------
 // [SECTION] Markers
 //-----------------------------------------------------------------------------
@@ -1567,37 +2329,50 @@ void RenderMarkers(const _Getter& getter, ImPlotMarker marker, float size, bool
 //-----------------------------------------------------------------------------
 
 template <typename _Getter>
-void PlotLineEx(const char* label_id, const _Getter& getter, ImPlotLineFlags flags) {
-    if (BeginItemEx(label_id, Fitter1<_Getter>(getter), flags, ImPlotCol_Line)) {
+void RenderLineEx(const _Getter& getter, ImPlotLineFlags flags, const ImPlotNextItemData& s) {
+    if (getter.Count <= 1)
+        return;
+    if (ImHasFlag(flags, ImPlotLineFlags_Shaded) && s.RenderFill) {
+        const ImU32 col_fill = ImGui::GetColorU32(s.Colors[ImPlotCol_Fill]);
+        GetterOverrideY<_Getter> getter2(getter, 0);
+        RenderPrimitives2<RendererShaded>(getter,getter2,col_fill);
+    }
+    if (s.RenderLine) {
+        const ImU32 col_line = ImGui::GetColorU32(s.Colors[ImPlotCol_Line]);
+        if (ImHasFlag(flags,ImPlotLineFlags_Segments)) {
+            RenderPrimitives1<RendererLineSegments1>(getter,col_line,s.LineWeight);
+        }
+        else if (ImHasFlag(flags, ImPlotLineFlags_Loop)) {
+            if (ImHasFlag(flags, ImPlotLineFlags_SkipNaN))
+                RenderPrimitives1<RendererLineStripSkip>(GetterLoop<_Getter>(getter),col_line,s.LineWeight);
+            else
+                RenderPrimitives1<RendererLineStrip>(GetterLoop<_Getter>(getter),col_line,s.LineWeight);
+        }
+        else {
+            if (ImHasFlag(flags, ImPlotLineFlags_SkipNaN))
+                RenderPrimitives1<RendererLineStripSkip>(getter,col_line,s.LineWeight);
+            else
+                RenderPrimitives1<RendererLineStrip>(getter,col_line,s.LineWeight);
+        }
+    }
+}
+
+template <typename _Getter, typename _Fitter>
+void PlotLineEx(const char* label_id, const _Getter& getter, const _Fitter& fitter, ImPlotLineFlags flags) {
+    if (BeginItemEx(label_id, fitter, flags, ImPlotCol_Line)) {
         if (getter.Count <= 0) {
             EndItem();
             return;
         }
+        ImPlotContext& gp = *GImPlot;
         const ImPlotNextItemData& s = GetItemData();
-        if (getter.Count > 1) {
-            if (ImHasFlag(flags, ImPlotLineFlags_Shaded) && s.RenderFill) {
-                const ImU32 col_fill = ImGui::GetColorU32(s.Colors[ImPlotCol_Fill]);
-                GetterOverrideY<_Getter> getter2(getter, 0);
-                RenderPrimitives2<RendererShaded>(getter,getter2,col_fill);
-            }
-            if (s.RenderLine) {
-                const ImU32 col_line = ImGui::GetColorU32(s.Colors[ImPlotCol_Line]);
-                if (ImHasFlag(flags,ImPlotLineFlags_Segments)) {
-                    RenderPrimitives1<RendererLineSegments1>(getter,col_line,s.LineWeight);
-                }
-                else if (ImHasFlag(flags, ImPlotLineFlags_Loop)) {
-                    if (ImHasFlag(flags, ImPlotLineFlags_SkipNaN))
-                        RenderPrimitives1<RendererLineStripSkip>(GetterLoop<_Getter>(getter),col_line,s.LineWeight);
-                    else
-                        RenderPrimitives1<RendererLineStrip>(GetterLoop<_Getter>(getter),col_line,s.LineWeight);
-                }
-                else {
-                    if (ImHasFlag(flags, ImPlotLineFlags_SkipNaN))
-                        RenderPrimitives1<RendererLineStripSkip>(getter,col_line,s.LineWeight);
-                    else
-                        RenderPrimitives1<RendererLineStrip>(getter,col_line,s.LineWeight);
-                }
-            }
+        if (getter.Count > 1 && (s.RenderLine || (ImHasFlag(flags, ImPlotLineFlags_Shaded) && s.RenderFill))) {
+            // add by Dicky for decimation
+            if (DecimateLine(getter, flags, gp.TempDouble1, gp.TempDouble2))
+                RenderLineEx(GetDecimatedGetter(), flags, s);
+            else
+                RenderLineEx(getter, flags, s);
+            // add by Dicky end
         }
         // render markers
         if (s.Marker != ImPlotMarker_None) {
@@ -1607,12 +2382,22 @@ void PlotLineEx(const char* label_id, const _Getter& getter, ImPlotLineFlags fla
             }
             const ImU32 col_line = ImGui::GetColorU32(s.Colors[ImPlotCol_MarkerOutline]);
             const ImU32 col_fill = ImGui::GetColorU32(s.Colors[ImPlotCol_MarkerFill]);
-            RenderMarkers<_Getter>(getter, s.Marker, s.MarkerSize, s.RenderMarkerFill, col_fill, s.RenderMarkerLine, col_line, s.MarkerWeight);
+            // add by Dicky for decimation
+            if (ImHasFlag(flags, ImPlotLineFlags_DecimateMarkers) && MarkersOpaque(s.RenderMarkerFill, col_fill, s.RenderMarkerLine, col_line) && DecimateMarkers(getter, gp.TempDouble1, gp.TempDouble2))
+                RenderMarkers<GetterDecimated>(GetDecimatedGetter(), s.Marker, s.MarkerSize, s.RenderMarkerFill, col_fill, s.RenderMarkerLine, col_line, s.MarkerWeight);
+            else
+                RenderMarkers<_Getter>(getter, s.Marker, s.MarkerSize, s.RenderMarkerFill, col_fill, s.RenderMarkerLine, col_line, s.MarkerWeight);
+            // add by Dicky end
         }
         EndItem();
     }
 }
 
+template <typename _Getter>
+void PlotLineEx(const char* label_id, const _Getter& getter, ImPlotLineFlags flags) {
+    PlotLineEx(label_id, getter, Fitter1<_Getter>(getter), flags);
+}
+
 template <typename T>
 void PlotLine(const char* label_id, const T* values, int count, double xscale, double x0, ImPlotLineFlags flags, int offset, int stride) {
     GetterXY<IndexerLin,IndexerIdx<T>> getter(IndexerLin(xscale,x0),IndexerIdx<T>(values,count,offset,stride),count);
@@ -1637,6 +2422,49 @@ void PlotLineG(const char* label_id, ImPlotGetter getter_func, void* data, int c
     PlotLineEx(label_id, getter, flags);
 }
 
+// add by Dicky for min/max pyramid
+void PlotLine(const char* label_id, const ImPlotPyramid& pyramid, ImPlotLineFlags flags) {
+    GetterPyramid getter(pyramid);
+    PlotLineEx(label_id, getter, FitterPyramid(pyramid), flags);
+}
+// add by Dicky end
+
+// add by Dicky for lock-free ring buffer
+void PlotLine(const char* label_id, ImPlotRingBuffer& buffer, ImPlotLineFlags flags) {
+    GetterRingBuffer getter = GetRingBufferSnapshot(buffer);
+    PlotLineEx(label_id, getter, flags);
+}
+// add by Dicky end
+
+// add by Dicky for columnar data
+template <typename T>
+void PlotLine(const char* label_id, const ImPlotColumn<T>& xs, const ImPlotColumn<T>& ys, ImPlotLineFlags flags) {
+    const int count = ImMin(xs.Count, ys.Count);
+    switch (GetColumnAccess(xs, ys, ys)) {
+        case ColumnAccess_Array: {
+            GetterXY<IndexerIdx<T>,IndexerIdx<T>> getter(IndexerIdx<T>(xs.Data,count,0,xs.Stride),IndexerIdx<T>(ys.Data,count,0,ys.Stride),count);
+            PlotLineEx(label_id, getter, flags);
+            break;
+        }
+        case ColumnAccess_Nullable: {
+            GetterXY<IndexerColumn<T>,IndexerColumn<T>> getter(IndexerColumn<T>(xs,count),IndexerColumn<T>(ys,count),count);
+            PlotLineEx(label_id, getter, flags);
+            break;
+        }
+        default: {
+            ColumnChunks<T> chunks_x(xs), chunks_y(ys);
+            GetterXY<IndexerColumnChunks<T>,IndexerColumnChunks<T>> getter(IndexerColumnChunks<T>(chunks_x,xs.Stride,count),IndexerColumnChunks<T>(chunks_y,ys.Stride,count),count);
+            PlotLineEx(label_id, getter, flags);
+            break;
+        }
+    }
+}
+
+#define INSTANTIATE_MACRO(T) template IMPLOT_API void PlotLine<T>(const char* label_id, const ImPlotColumn<T>& xs, const ImPlotColumn<T>& ys, ImPlotLineFlags flags);
+CALL_INSTANTIATE_FOR_NUMERIC_TYPES()
+#undef INSTANTIATE_MACRO
+// add by Dicky end
+
 //-----------------------------------------------------------------------------
 // [SECTION] PlotScatter
 //-----------------------------------------------------------------------------
@@ -1657,7 +2485,13 @@ void PlotScatterEx(const char* label_id, const Getter& getter, ImPlotScatterFlag
             }
             const ImU32 col_line = ImGui::GetColorU32(s.Colors[ImPlotCol_MarkerOutline]);
             const ImU32 col_fill = ImGui::GetColorU32(s.Colors[ImPlotCol_MarkerFill]);
-            RenderMarkers<Getter>(getter, marker, s.MarkerSize, s.RenderMarkerFill, col_fill, s.RenderMarkerLine, col_line, s.MarkerWeight);
+            // add by Dicky for decimation
+            ImPlotContext& gp = *GImPlot;
+            if (ImHasFlag(flags, ImPlotScatterFlags_Decimate) && MarkersOpaque(s.RenderMarkerFill, col_fill, s.RenderMarkerLine, col_line) && DecimateMarkers(getter, gp.TempDouble1, gp.TempDouble2))
+                RenderMarkers<GetterDecimated>(GetDecimatedGetter(), marker, s.MarkerSize, s.RenderMarkerFill, col_fill, s.RenderMarkerLine, col_line, s.MarkerWeight);
+            else
+                RenderMarkers<Getter>(getter, marker, s.MarkerSize, s.RenderMarkerFill, col_fill, s.RenderMarkerLine, col_line, s.MarkerWeight);
+            // add by Dicky end
         }
         EndItem();
     }
@@ -1687,6 +2521,42 @@ void PlotScatterG(const char* label_id, ImPlotGetter getter_func, void* data, in
     return PlotScatterEx(label_id, getter, flags);
 }
 
+// add by Dicky for lock-free ring buffer
+void PlotScatter(const char* label_id, ImPlotRingBuffer& buffer, ImPlotScatterFlags flags) {
+    GetterRingBuffer getter = GetRingBufferSnapshot(buffer);
+    PlotScatterEx(label_id, getter, flags);
+}
+// add by Dicky end
+
+// add by Dicky for columnar data
+template <typename T>
+void PlotScatter(const char* label_id, const ImPlotColumn<T>& xs, const ImPlotColumn<T>& ys, ImPlotScatterFlags flags) {
+    const int count = ImMin(xs.Count, ys.Count);
+    switch (GetColumnAccess(xs, ys, ys)) {
+        case ColumnAccess_Array: {
+            GetterXY<IndexerIdx<T>,IndexerIdx<T>> getter(IndexerIdx<T>(xs.Data,count,0,xs.Stride),IndexerIdx<T>(ys.Data,count,0,ys.Stride),count);
+            PlotScatterEx(label_id, getter, flags);
+            break;
+        }
+        case ColumnAccess_Nullable: {
+            GetterXY<IndexerColumn<T>,IndexerColumn<T>> getter(IndexerColumn<T>(xs,count),IndexerColumn<T>(ys,count),count);
+            PlotScatterEx(label_id, getter, flags);
+            break;
+        }
+        default: {
+            ColumnChunks<T> chunks_x(xs), chunks_y(ys);
+            GetterXY<IndexerColumnChunks<T>,IndexerColumnChunks<T>> getter(IndexerColumnChunks<T>(chunks_x,xs.Stride,count),IndexerColumnChunks<T>(chunks_y,ys.Stride,count),count);
+            PlotScatterEx(label_id, getter, flags);
+            break;
+        }
+    }
+}
+
+#define INSTANTIATE_MACRO(T) template IMPLOT_API void PlotScatter<T>(const char* label_id, const ImPlotColumn<T>& xs, const ImPlotColumn<T>& ys, ImPlotScatterFlags flags);
+CALL_INSTANTIATE_FOR_NUMERIC_TYPES()
+#undef INSTANTIATE_MACRO
+// add by Dicky end
+
 //-----------------------------------------------------------------------------
 // [SECTION] PlotStairs
 //-----------------------------------------------------------------------------
@@ -1815,6 +2685,107 @@ void PlotShadedG(const char* label_id, ImPlotGetter getter_func1, void* data1, I
     PlotShadedEx(label_id, getter1, getter2, flags);
 }
 
+// add by Dicky for min/max pyramid
+void PlotShaded(const char* label_id, const ImPlotPyramid& pyramid, double y_ref, ImPlotShadedFlags flags) {
+    if (y_ref == -HUGE_VAL)
+        y_ref = GetPlotLimits(IMPLOT_AUTO,IMPLOT_AUTO).Y.Min;
+    if (y_ref == HUGE_VAL)
+        y_ref = GetPlotLimits(IMPLOT_AUTO,IMPLOT_AUTO).Y.Max;
+    if (BeginItemEx(label_id, FitterPyramid(pyramid, y_ref), flags, ImPlotCol_Fill)) {
+        ImPlotContext& gp = *GImPlot;
+        const ImPlotNextItemData& s = GetItemData();
+        if (pyramid.Size() > 1 && s.RenderFill) {
+            const ImU32 col = ImGui::GetColorU32(s.Colors[ImPlotCol_Fill]);
+            GetterPyramid getter(pyramid);
+            if (DecimateLine(getter, ImPlotLineFlags_None, gp.TempDouble1, gp.TempDouble2)) {
+                GetterDecimated getter1 = GetDecimatedGetter();
+                if (getter1.Count > 1)
+                    RenderPrimitives2<RendererShaded>(getter1,GetterOverrideY<GetterDecimated>(getter1,y_ref),col);
+            }
+            else {
+                RenderPrimitives2<RendererShaded>(getter,GetterOverrideY<GetterPyramid>(getter,y_ref),col);
+            }
+        }
+        EndItem();
+    }
+}
+// add by Dicky end
+
+// add by Dicky for lock-free ring buffer
+void PlotShaded(const char* label_id, ImPlotRingBuffer& buffer, double y_ref, ImPlotShadedFlags flags) {
+    if (y_ref == -HUGE_VAL)
+        y_ref = GetPlotLimits(IMPLOT_AUTO,IMPLOT_AUTO).Y.Min;
+    if (y_ref == HUGE_VAL)
+        y_ref = GetPlotLimits(IMPLOT_AUTO,IMPLOT_AUTO).Y.Max;
+    GetterRingBuffer getter = GetRingBufferSnapshot(buffer);
+    PlotShadedEx(label_id, getter, GetterOverrideY<GetterRingBuffer>(getter, y_ref), flags);
+}
+// add by Dicky end
+
+// add by Dicky for columnar data
+template <typename T>
+void PlotShaded(const char* label_id, const ImPlotColumn<T>& xs, const ImPlotColumn<T>& ys, double y_ref, ImPlotShadedFlags flags) {
+    if (y_ref == -HUGE_VAL)
+        y_ref = GetPlotLimits(IMPLOT_AUTO,IMPLOT_AUTO).Y.Min;
+    if (y_ref == HUGE_VAL)
+        y_ref = GetPlotLimits(IMPLOT_AUTO,IMPLOT_AUTO).Y.Max;
+    const int count = ImMin(xs.Count, ys.Count);
+    switch (GetColumnAccess(xs, ys, ys)) {
+        case ColumnAccess_Array: {
+            GetterXY<IndexerIdx<T>,IndexerIdx<T>> getter1(IndexerIdx<T>(xs.Data,count,0,xs.Stride),IndexerIdx<T>(ys.Data,count,0,ys.Stride),count);
+            GetterXY<IndexerIdx<T>,IndexerConst>  getter2(IndexerIdx<T>(xs.Data,count,0,xs.Stride),IndexerConst(y_ref),count);
+            PlotShadedEx(label_id, getter1, getter2, flags);
+            break;
+        }
+        case ColumnAccess_Nullable: {
+            GetterXY<IndexerColumn<T>,IndexerColumn<T>> getter1(IndexerColumn<T>(xs,count),IndexerColumn<T>(ys,count),count);
+            GetterXY<IndexerColumn<T>,IndexerConst>     getter2(IndexerColumn<T>(xs,count),IndexerConst(y_ref),count);
+            PlotShadedEx(label_id, getter1, getter2, flags);
+            break;
+        }
+        default: {
+            ColumnChunks<T> chunks_x(xs), chunks_y(ys);
+            GetterXY<IndexerColumnChunks<T>,IndexerColumnChunks<T>> getter1(IndexerColumnChunks<T>(chunks_x,xs.Stride,count),IndexerColumnChunks<T>(chunks_y,ys.Stride,count),count);
+            GetterXY<IndexerColumnChunks<T>,IndexerConst>           getter2(IndexerColumnChunks<T>(chunks_x,xs.Stride,count),IndexerConst(y_ref),count);
+            PlotShadedEx(label_id, getter1, getter2, flags);
+            break;
+        }
+    }
+}
+
+template <typename T>
+void PlotShaded(const char* label_id, const ImPlotColumn<T>& xs, const ImPlotColumn<T>& ys1, const ImPlotColumn<T>& ys2, ImPlotShadedFlags flags) {
+    const int count = ImMin(xs.Count, ImMin(ys1.Count, ys2.Count));
+    switch (GetColumnAccess(xs, ys1, ys2)) {
+        case ColumnAccess_Array: {
+            GetterXY<IndexerIdx<T>,IndexerIdx<T>> getter1(IndexerIdx<T>(xs.Data,count,0,xs.Stride),IndexerIdx<T>(ys1.Data,count,0,ys1.Stride),count);
+            GetterXY<IndexerIdx<T>,IndexerIdx<T>> getter2(IndexerIdx<T>(xs.Data,count,0,xs.Stride),IndexerIdx<T>(ys2.Data,count,0,ys2.Stride),count);
+            PlotShadedEx(label_id, getter1, getter2, flags);
+            break;
+        }
+        case ColumnAccess_Nullable: {
+            GetterXY<IndexerColumn<T>,IndexerColumn<T>> getter1(IndexerColumn<T>(xs,count),IndexerColumn<T>(ys1,count),count);
+            GetterXY<IndexerColumn<T>,IndexerColumn<T>> getter2(IndexerColumn<T>(xs,count),IndexerColumn<T>(ys2,count),count);
+            PlotShadedEx(label_id, getter1, getter2, flags);
+            break;
+        }
+        default: {
+            ColumnChunks<T> chunks_x(xs), chunks_y1(ys1), chunks_y2(ys2);
+            GetterXY<IndexerColumnChunks<T>,IndexerColumnChunks<T>> getter1(IndexerColumnChunks<T>(chunks_x,xs.Stride,count),IndexerColumnChunks<T>(chunks_y1,ys1.Stride,count),count);
+            GetterXY<IndexerColumnChunks<T>,IndexerColumnChunks<T>> getter2(IndexerColumnChunks<T>(chunks_x,xs.Stride,count),IndexerColumnChunks<T>(chunks_y2,ys2.Stride,count),count);
+            PlotShadedEx(label_id, getter1, getter2, flags);
+            break;
+        }
+    }
+}
+
+#define INSTANTIATE_MACRO(T) \
+    template IMPLOT_API void PlotShaded<T>(const char* label_id, const ImPlotColumn<T>& xs, const ImPlotColumn<T>& ys, double y_ref, ImPlotShadedFlags flags); \
+    template IMPLOT_API void PlotShaded<T>(const char* label_id, const ImPlotColumn<T>& xs, const ImPlotColumn<T>& ys1, const ImPlotColumn<T>& ys2, ImPlotShadedFlags flags);
+CALL_INSTANTIATE_FOR_NUMERIC_TYPES()
+#undef INSTANTIATE_MACRO
+// add by Dicky end
+
 //-----------------------------------------------------------------------------
 // [SECTION] PlotBars
 //-----------------------------------------------------------------------------
@@ -1914,6 +2885,43 @@ void PlotBarsG(const char* label_id, ImPlotGetter getter_func, void* data, int c
     }
 }
 
+// add by Dicky for columnar data
+template <typename _IndexerX, typename _IndexerY>
+static void PlotBarsColumns(const char* label_id, const _IndexerX& indexer_x, const _IndexerY& indexer_y, int count, double bar_size, ImPlotBarsFlags flags) {
+    GetterXY<_IndexerX,_IndexerY> getter1(indexer_x,indexer_y,count);
+    if (ImHasFlag(flags, ImPlotBarsFlags_Horizontal)) {
+        GetterXY<IndexerConst,_IndexerY> getter2(IndexerConst(0),indexer_y,count);
+        PlotBarsHEx(label_id, getter1, getter2, bar_size, flags);
+    }
+    else {
+        GetterXY<_IndexerX,IndexerConst> getter2(indexer_x,IndexerConst(0),count);
+        PlotBarsVEx(label_id, getter1, getter2, bar_size, flags);
+    }
+}
+
+template <typename T>
+void PlotBars(const char* label_id, const ImPlotColumn<T>& xs, const ImPlotColumn<T>& ys, double bar_size, ImPlotBarsFlags flags) {
+    const int count = ImMin(xs.Count, ys.Count);
+    switch (GetColumnAccess(xs, ys, ys)) {
+        case ColumnAccess_Array:
+            PlotBarsColumns(label_id, IndexerIdx<T>(xs.Data,count,0,xs.Stride), IndexerIdx<T>(ys.Data,count,0,ys.Stride), count, bar_size, flags);
+            break;
+        case ColumnAccess_Nullable:
+            PlotBarsColumns(label_id, IndexerColumn<T>(xs,count), IndexerColumn<T>(ys,count), count, bar_size, flags);
+            break;
+        default: {
+            ColumnChunks<T> chunks_x(xs), chunks_y(ys);
+            PlotBarsColumns(label_id, IndexerColumnChunks<T>(chunks_x,xs.Stride,count), IndexerColumnChunks<T>(chunks_y,ys.Stride,count), count, bar_size, flags);
+            break;
+        }
+    }
+}
+
+#define INSTANTIATE_MACRO(T) template IMPLOT_API void PlotBars<T>(const char* label_id, const ImPlotColumn<T>& xs, const ImPlotColumn<T>& ys, double bar_size, ImPlotBarsFlags flags);
+CALL_INSTANTIATE_FOR_NUMERIC_TYPES()
+#undef INSTANTIATE_MACRO
+// add by Dicky end
+
 //-----------------------------------------------------------------------------
 // [SECTION] PlotBarGroups
 //-----------------------------------------------------------------------------
@@ -2480,6 +3488,253 @@ void RenderHeatmap(ImDrawList& draw_list, const T* values, int rows, int cols, d
     }
 }
 
+// add by Dicky for heatmap textures
+// Drawing a quad per cell costs 4 vertices and 6 indices per cell every frame. Large heatmaps can instead
+// be colorized into a texture that only needs uploading again for the lines whose values changed.
+
+// Heatmaps with fewer cells than this are cheaper to draw as quads
+#define IMPLOT_HEATMAP_TEXTURE_MIN_CELLS 1024
+// Lines are hashed and colorized on several threads when the heatmap has at least this many cells
+#define IMPLOT_HEATMAP_PARALLEL_CELLS (64 * 1024)
+// Textures of heatmaps not plotted for this many frames are released
+#define IMPLOT_HEATMAP_TEXTURE_KEEP_FRAMES 120
+
+// Hashes 32 bytes at a time in four independent lanes so the multiplies overlap
+static ImU64 HashHeatmapLine(const void* data, size_t size) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    ImU64 lanes[4] = { 0xcbf29ce484222325ULL ^ size, 0x84222325cbf29ce4ULL, 0x9E3779B97F4A7C15ULL, 0x7F4A7C159E3779B9ULL };
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        ImU64 w[4];
+        memcpy(w, bytes + i, 32);
+        for (int l = 0; l < 4; ++l) {
+            lanes[l] = (lanes[l] ^ w[l]) * 0x9E3779B97F4A7C15ULL;
+            lanes[l] ^= lanes[l] >> 29;
+        }
+    }
+    ImU64 h = lanes[0];
+    for (int l = 1; l < 4; ++l)
+        h = (h ^ lanes[l]) * 0x100000001B3ULL;
+    for (; i + 8 <= size; i += 8) {
+        ImU64 w;
+        memcpy(&w, bytes + i, 8);
+        h = (h ^ w) * 0x9E3779B97F4A7C15ULL;
+        h ^= h >> 29;
+    }
+    for (; i < size; ++i)
+        h = (h ^ bytes[i]) * 0x100000001B3ULL;
+    return h;
+}
+
+// Same mapping as ImPlotColormapData::LerpTable, NaN values take the first color
+template <typename T>
+static void ColorizeHeatmapLine(const T* values, ImU32* pixels, int count, double scale_min, double scale_max, const ImU32* table, int table_size, bool qual) {
+    if (qual) {
+        for (int i = 0; i < count; ++i) {
+            float t = (float)ImRemap01((double)values[i], scale_min, scale_max);
+            t = t > 0.0f ? (t < 1.0f ? t : 1.0f) : 0.0f;
+            pixels[i] = table[ImMin((int)(table_size * t), table_size - 1)];
+        }
+    }
+    else {
+        for (int i = 0; i < count; ++i) {
+            float t = (float)ImRemap01((double)values[i], scale_min, scale_max);
+            t = t > 0.0f ? (t < 1.0f ? t : 1.0f) : 0.0f;
+            pixels[i] = table[(int)((table_size - 1) * t + 0.5f)];
+        }
+    }
+}
+
+// Counts the lines that would need colorizing if the first line of values was held by texture row #head
+static int CountHeatmapDirtyLines(const ImPlotHeatmapTexture& cache, int head) {
+    int dirty = 0;
+    for (int r = 0; r < cache.Lines; ++r) {
+        const int p = head + r < cache.Lines ? head + r : head + r - cache.Lines;
+        dirty += cache.LineHashes[p] != cache.NewHashes[r];
+    }
+    return dirty;
+}
+
+template <typename T>
+int UpdateHeatmapPixels(ImPlotHeatmapTexture& cache, const T* values, int rows, int cols, double scale_min, double scale_max, bool col_maj) {
+    ImPlotContext& gp = *GImPlot;
+    const int lines     = col_maj ? cols : rows;
+    const int line_size = col_maj ? rows : cols;
+    const ImPlotColormap cmap = gp.Style.Colormap;
+    const ImU32* table  = gp.ColormapData.GetTable(cmap);
+    const int table_size = gp.ColormapData.GetTableSize(cmap);
+    const bool qual     = gp.ColormapData.IsQual(cmap);
+    const bool parallel = (ImS64)lines * line_size >= IMPLOT_HEATMAP_PARALLEL_CELLS;
+
+    bool all = false;
+    if (cache.Lines != lines || cache.LineSize != line_size) {
+        if (cache.Texture) {
+            ImGui::ImDestroyTexture(cache.Texture);
+            cache.Texture = 0;
+        }
+        cache.Pixels.create(line_size, lines, 4, 1u, 4);
+        cache.LineHashes.resize(lines);
+        cache.Lines    = lines;
+        cache.LineSize = line_size;
+        cache.Head     = 0;
+        all = true;
+    }
+    // a new scale or colormap changes the color of every cell
+    const ImU64 colormap_hash = HashHeatmapLine(table, sizeof(ImU32) * table_size) ^ (ImU64)qual;
+    if (cache.ColormapHash != colormap_hash || cache.ScaleMin != scale_min || cache.ScaleMax != scale_max) {
+        cache.ColormapHash = colormap_hash;
+        cache.ScaleMin     = scale_min;
+        cache.ScaleMax     = scale_max;
+        all = true;
+    }
+
+    cache.NewHashes.resize(lines);
+    ImU64* hashes = cache.NewHashes.Data;
+    #pragma omp parallel for num_threads(OMP_THREADS) if (parallel)
+    for (int r = 0; r < lines; ++r)
+        hashes[r] = HashHeatmapLine(values + (size_t)r * line_size, sizeof(T) * line_size);
+
+    // keep the texture rows of lines that only moved: values scrolled towards the first line move the head
+    // forward to the old row of the new first line, values scrolled towards the last line move it backward
+    int head = cache.Head;
+    if (!all) {
+        int best = CountHeatmapDirtyLines(cache, head);
+        for (int k = 1; k < lines && best > 0; ++k) {
+            const int p = (cache.Head + k) % lines;
+            if (cache.LineHashes[p] == hashes[0]) {
+                const int dirty = CountHeatmapDirtyLines(cache, p);
+                if (dirty < best) { best = dirty; head = p; }
+                break;
+            }
+        }
+        for (int k = 1; k < lines && best > 0; ++k) {
+            if (hashes[k] == cache.LineHashes[cache.Head]) {
+                const int p = (cache.Head - k + lines) % lines;
+                const int dirty = CountHeatmapDirtyLines(cache, p);
+                if (dirty < best) { best = dirty; head = p; }
+                break;
+            }
+        }
+    }
+    cache.Head = head;
+
+    const int first_dirty = cache.DirtyLines.Size;
+    for (int r = 0; r < lines; ++r) {
+        const int p = head + r < lines ? head + r : head + r - lines;
+        if (all || cache.LineHashes[p] != hashes[r]) {
+            cache.LineHashes[p] = hashes[r];
+            cache.DirtyLines.push_back(p);
+        }
+    }
+
+    const int* dirty_lines = cache.DirtyLines.Data + first_dirty;
+    const int count = cache.DirtyLines.Size - first_dirty;
+    ImU32* pixels = (ImU32*)cache.Pixels.data;
+    #pragma omp parallel for num_threads(OMP_THREADS) if (parallel && count > 1)
+    for (int i = 0; i < count; ++i) {
+        const int p = dirty_lines[i];
+        const int r = p >= head ? p - head : p - head + lines;
+        ColorizeHeatmapLine(values + (size_t)r * line_size, pixels + (size_t)p * line_size, line_size, scale_min, scale_max, table, table_size, qual);
+    }
+    return count;
+}
+#define INSTANTIATE_MACRO(T) template IMPLOT_API int UpdateHeatmapPixels<T>(ImPlotHeatmapTexture& cache, const T* values, int rows, int cols, double scale_min, double scale_max, bool col_maj);
+CALL_INSTANTIATE_FOR_NUMERIC_TYPES()
+#undef INSTANTIATE_MACRO
+
+// Uploads the queued rows, as whole texture updates when most of the rows changed
+static void UploadHeatmapTexture(ImPlotHeatmapTexture& cache) {
+    if (cache.DirtyLines.empty())
+        return;
+#if IMGUI_RENDERING_DX11 || IMGUI_RENDERING_DX9
+    const bool partial = false; // ImCopyToTexture doesn't update textures of these backends
+#else
+    const bool partial = cache.Texture != 0 && cache.DirtyLines.Size * 2 < cache.Lines;
+#endif
+    if (!partial) {
+        ImGui::ImGenerateOrUpdateTexture(cache.Texture, cache.LineSize, cache.Lines, 4, (const unsigned char*)&cache.Pixels, false, false, false, true, true, true);
+    }
+    else {
+        // dirty rows are ascending except where they wrap around the ring, upload them in contiguous runs
+        const int row_bytes = cache.LineSize * 4;
+        for (int i = 0; i < cache.DirtyLines.Size; ) {
+            const int first = cache.DirtyLines[i];
+            int n = 1;
+            while (i + n < cache.DirtyLines.Size && cache.DirtyLines[i + n] == first + n)
+                ++n;
+            ImGui::ImMat run(cache.LineSize, n, 4, (unsigned char*)cache.Pixels.data + (size_t)first * row_bytes, 1u, 4);
+            ImGui::ImCopyToTexture(cache.Texture, (unsigned char*)&run, cache.LineSize, n, 4, 0, first, true);
+            i += n;
+        }
+    }
+    cache.DirtyLines.resize(0);
+}
+
+// Plot position of a point #along a line (0 to 1) of values at the start of #line
+static inline ImPlotPoint HeatmapTexturePoint(double along, double line, int lines, const ImPlotPoint& bounds_min, const ImPlotPoint& bounds_max, double yref, double ydir, bool col_maj) {
+    const double width  = bounds_max.x - bounds_min.x;
+    const double height = bounds_max.y - bounds_min.y;
+    if (col_maj)
+        return ImPlotPoint(bounds_min.x + width * line / lines, yref + ydir * height * along);
+    return ImPlotPoint(bounds_min.x + width * along, yref + ydir * height * line / lines);
+}
+
+// Draws the heatmap from its cached texture. Returns false when it should be drawn with quads instead.
+template <typename T>
+bool RenderHeatmapTexture(ImDrawList& draw_list, const T* values, int rows, int cols, double scale_min, double scale_max, const ImPlotPoint& bounds_min, const ImPlotPoint& bounds_max, bool reverse_y, bool col_maj) {
+    ImPlotContext& gp = *GImPlot;
+    ImPlotPlot& plot = *gp.CurrentPlot;
+    if ((ImS64)rows * cols < IMPLOT_HEATMAP_TEXTURE_MIN_CELLS)
+        return false;
+    // the texture is stretched linearly between the bounds
+    if (plot.Axes[plot.CurrentX].TransformForward != nullptr || plot.Axes[plot.CurrentY].TransformForward != nullptr)
+        return false;
+    if (scale_min == 0 && scale_max == 0) {
+        T temp_min, temp_max;
+        ImMinMaxArray(values,rows*cols,&temp_min,&temp_max);
+        scale_min = (double)temp_min;
+        scale_max = (double)temp_max;
+    }
+    if (scale_min == scale_max)
+        return false;
+
+    const int frame = ImGui::GetFrameCount();
+    for (int n = 0; n < gp.HeatmapTextures.GetMapSize(); ++n) {
+        ImPlotHeatmapTexture* stale = gp.HeatmapTextures.TryGetMapData(n);
+        if (stale != nullptr && stale->LastFrame < frame - IMPLOT_HEATMAP_TEXTURE_KEEP_FRAMES)
+            gp.HeatmapTextures.Remove(stale->ID, stale);
+    }
+    const ImGuiID id = gp.CurrentItem->ID;
+    ImPlotHeatmapTexture& cache = *gp.HeatmapTextures.GetOrAddByKey(id);
+    cache.ID = id;
+    cache.LastFrame = frame;
+    UpdateHeatmapPixels(cache, values, rows, cols, scale_min, scale_max, col_maj);
+    UploadHeatmapTexture(cache);
+    if (!cache.Texture)
+        return false;
+
+    // lines before the head are at the end of the ring, draw the two parts of the ring separately
+    Transformer2 transformer;
+    const double yref = reverse_y ? bounds_max.y : bounds_min.y;
+    const double ydir = reverse_y ? -1 : 1;
+    const int lines = cache.Lines;
+    const int parts[2][2] = { { 0, lines - cache.Head }, { lines - cache.Head, lines } };
+    for (int i = 0; i < 2; ++i) {
+        const int l0 = parts[i][0], l1 = parts[i][1];
+        if (l0 == l1)
+            continue;
+        const float v0 = (float)((cache.Head + l0) % lines) / lines;
+        const float v1 = v0 + (float)(l1 - l0) / lines;
+        ImVec2 p1 = transformer(HeatmapTexturePoint(0, l0, lines, bounds_min, bounds_max, yref, ydir, col_maj));
+        ImVec2 p2 = transformer(HeatmapTexturePoint(1, l0, lines, bounds_min, bounds_max, yref, ydir, col_maj));
+        ImVec2 p3 = transformer(HeatmapTexturePoint(1, l1, lines, bounds_min, bounds_max, yref, ydir, col_maj));
+        ImVec2 p4 = transformer(HeatmapTexturePoint(0, l1, lines, bounds_min, bounds_max, yref, ydir, col_maj));
+        draw_list.AddImageQuad(cache.Texture, p1, p2, p3, p4, ImVec2(0, v0), ImVec2(1, v0), ImVec2(1, v1), ImVec2(0, v1));
+    }
+    return true;
+}
+// add by Dicky end
+
 template <typename T>
 void PlotHeatmap(const char* label_id, const T* values, int rows, int cols, double scale_min, double scale_max, const char* fmt, const ImPlotPoint& bounds_min, const ImPlotPoint& bounds_max, ImPlotHeatmapFlags flags) {
     if (BeginItemEx(label_id, FitterRect(bounds_min, bounds_max))) {
@@ -2489,7 +3744,8 @@ void PlotHeatmap(const char* label_id, const T* values, int rows, int cols, doub
         }
         ImDrawList& draw_list = *GetPlotDrawList();
         const bool col_maj = ImHasFlag(flags, ImPlotHeatmapFlags_ColMajor);
-        RenderHeatmap(draw_list, values, rows, cols, scale_min, scale_max, fmt, bounds_min, bounds_max, true, col_maj);
+        if (!ImHasFlag(flags, ImPlotHeatmapFlags_Texture) || fmt != nullptr || !RenderHeatmapTexture(draw_list, values, rows, cols, scale_min, scale_max, bounds_min, bounds_max, true, col_maj)) // add by Dicky
+            RenderHeatmap(draw_list, values, rows, cols, scale_min, scale_max, fmt, bounds_min, bounds_max, true, col_maj);
         EndItem();
     }
 }
@@ -2497,6 +3753,540 @@ void PlotHeatmap(const char* label_id, const T* values, int rows, int cols, doub
 CALL_INSTANTIATE_FOR_NUMERIC_TYPES()
 #undef INSTANTIATE_MACRO
 
+//-----------------------------------------------------------------------------
+// [SECTION] PlotSurface (add by Dicky)
+//-----------------------------------------------------------------------------
+
+// Surfaces are projected orthographically, so a view ray crosses the grid along a straight line on the ground and the
+// cells it meets get nearer in both row and column order. Drawing rows and columns from the farthest corner is then an
+// exact back to front order for the painter's algorithm, and triangles need no sorting. The grid is walked in square
+// tiles: tiles whose box misses the plot area are skipped, the others are split in runs whose triangles are generated
+// on several threads and appended to the draw list in order. Unless ImPlotSurfaceFlags_NoLOD is passed, rows and
+// columns are subsampled so cells keep a few pixels on screen whatever the size of the grid.
+
+// Cells of the level of detail are at least this many pixels wide on screen
+#define IMPLOT_SURFACE_LOD_PIXELS 4
+// Tiles culled against the plot area and handed to threads are this many cells wide
+#define IMPLOT_SURFACE_TILE 32
+// Surfaces with at least this many visible cells are generated on several threads
+#define IMPLOT_SURFACE_PARALLEL_CELLS (16 * 1024)
+// View of surfaces plotted without SetNextSurfaceView()
+#define IMPLOT_SURFACE_YAW    0.5
+#define IMPLOT_SURFACE_PITCH  0.6
+#define IMPLOT_SURFACE_HEIGHT 0.5
+
+void SetNextSurfaceView(double yaw, double pitch, double height) {
+    ImPlotContext& gp = *GImPlot;
+    gp.NextItemData.HasSurfaceView = true;
+    gp.NextItemData.SurfaceYaw     = yaw;
+    gp.NextItemData.SurfacePitch   = pitch;
+    gp.NextItemData.SurfaceHeight  = height;
+}
+
+// Turns the grid by Yaw around the vertical axis through the center of the bounds, then tilts it towards the viewer by Pitch
+struct SurfaceView {
+    SurfaceView(const ImPlotPoint& bounds_min, const ImPlotPoint& bounds_max, double yaw, double pitch, double height) :
+        Cx((bounds_min.x + bounds_max.x) * 0.5),
+        Cy((bounds_min.y + bounds_max.y) * 0.5),
+        Height(height * ImMax(ImAbs(bounds_max.x - bounds_min.x), ImAbs(bounds_max.y - bounds_min.y))),
+        CosYaw(cos(yaw)),
+        SinYaw(sin(yaw)),
+        CosPitch(cos(pitch)),
+        SinPitch(sin(pitch))
+    { }
+    // view coordinates of the point (x,y) at normalized height t, see ImPlotSurfaceNode
+    IMPLOT_INLINE void Project(double x, double y, double t, double* vx, double* vy, double* vz) const {
+        const double ux = x - Cx, uy = y - Cy, uz = (t - 0.5) * Height;
+        const double depth = ux * SinYaw + uy * CosYaw;
+        *vx = ux * CosYaw - uy * SinYaw;
+        *vy = depth * SinPitch + uz * CosPitch;
+        *vz = depth * CosPitch - uz * SinPitch;
+    }
+    IMPLOT_INLINE ImPlotPoint ToPlot(double x, double y, double t) const {
+        double vx, vy, vz;
+        Project(x, y, t, &vx, &vy, &vz);
+        return ImPlotPoint(Cx + vx, Cy + vy);
+    }
+    double Cx, Cy, Height;
+    double CosYaw, SinYaw, CosPitch, SinPitch;
+};
+
+// Fits the projection of the box holding the surface
+struct FitterSurface {
+    FitterSurface(const SurfaceView& view, const ImPlotPoint& bounds_min, const ImPlotPoint& bounds_max) : View(view), BoundsMin(bounds_min), BoundsMax(bounds_max) { }
+    void Fit(ImPlotAxis& x_axis, ImPlotAxis& y_axis) const {
+        for (int i = 0; i < 8; ++i) {
+            const ImPlotPoint p = View.ToPlot((i & 1) ? BoundsMax.x : BoundsMin.x, (i & 2) ? BoundsMax.y : BoundsMin.y, (i & 4) ? 1.0 : 0.0);
+            x_axis.ExtendFitWith(y_axis, p.x, p.y);
+            y_axis.ExtendFitWith(x_axis, p.y, p.x);
+        }
+    }
+    const SurfaceView View;
+    const ImPlotPoint BoundsMin;
+    const ImPlotPoint BoundsMax;
+};
+
+// Level of detail grid of a surface and how to draw it. Node (r,c) is the sample (SampleRow(r),SampleCol(c)) of the
+// values, whose plot position before the view is (X0 + sc * DX, Y0 + sr * DY).
+struct SurfaceGrid {
+    int             Rows, Cols;
+    bool            ColMajor;
+    int             StepR, StepC;
+    int             NodesR, NodesC;
+    double          X0, DX, Y0, DY;
+    double          ScaleMin, ScaleMax;
+    SurfaceView     View;
+    Transformer2    Transformer;
+    bool            FarR, FarC;     // whether higher rows/columns are farther from the viewer
+    float           Flip;           // -1 when the bounds mirror the grid, front faces then turn clockwise
+    bool            Cull, Fill, Mesh;
+    const ImU32*    Table;
+    int             TableSize;
+    bool            Qual;
+    float           Alpha;
+    ImU32           LineCol;
+    float           HalfWeight;
+    ImVec2          Uv;
+
+    SurfaceGrid(const SurfaceView& view) : View(view) { }
+    IMPLOT_INLINE int SampleRow(int r) const { return ImMin(r * StepR, Rows - 1); }
+    IMPLOT_INLINE int SampleCol(int c) const { return ImMin(c * StepC, Cols - 1); }
+    template <typename T> IMPLOT_INLINE double Value(const T* values, int sr, int sc) const {
+        return (double)(ColMajor ? values[(size_t)sc * Rows + sr] : values[(size_t)sr * Cols + sc]);
+    }
+    // same mapping as ImPlotColormapData::LerpTable
+    IMPLOT_INLINE ImU32 Color(float t) const {
+        const ImU32 col = Qual ? Table[ImMin((int)(TableSize * t), TableSize - 1)] : Table[(int)((TableSize - 1) * t + 0.5f)];
+        if (Alpha >= 1.0f)
+            return col;
+        const ImU32 a = (ImU32)(((col >> IM_COL32_A_SHIFT) & 0xFF) * Alpha);
+        return (col & ~IM_COL32_A_MASK) | (a << IM_COL32_A_SHIFT);
+    }
+};
+
+// Scales the color channels by shade/256
+static IMPLOT_INLINE ImU32 ShadeSurfaceColor(ImU32 col, ImU32 shade) {
+    const ImU32 rb = (((col & 0x00FF00FF) * shade) >> 8) & 0x00FF00FF;
+    const ImU32 g  = (((col & 0x0000FF00) * shade) >> 8) & 0x0000FF00;
+    return rb | g | (col & IM_COL32_A_MASK);
+}
+
+// Appends a triangle given counterclockwise on the ground, shaded by how much it faces the viewer
+static IMPLOT_INLINE ImDrawVert* EmitSurfaceTriangle(const SurfaceGrid& grid, ImDrawVert* out, const ImPlotSurfaceNode& a, const ImPlotSurfaceNode& b, const ImPlotSurfaceNode& c) {
+    if (!(a.Valid && b.Valid && c.Valid))
+        return out;
+    const float e1x = b.X - a.X, e1y = b.Y - a.Y, e1z = b.Z - a.Z;
+    const float e2x = c.X - a.X, e2y = c.Y - a.Y, e2z = c.Z - a.Z;
+    // the normal's component towards the viewer is the signed area on screen
+    const float nz = (e1x * e2y - e1y * e2x) * grid.Flip;
+    if (grid.Cull && nz <= 0)
+        return out;
+    const float nx = e1y * e2z - e1z * e2y;
+    const float ny = e1z * e2x - e1x * e2z;
+    const float len2 = nx * nx + ny * ny + nz * nz;
+    const float facing = len2 > 0 ? ImMin(ImAbs(nz) * ImInvSqrt(len2), 1.0f) : 1.0f;
+    const ImU32 shade = (ImU32)(256.0f * (0.35f + 0.65f * facing));
+    out[0].pos = a.Pixel; out[0].uv = grid.Uv; out[0].col = ShadeSurfaceColor(a.Col, shade);
+    out[1].pos = b.Pixel; out[1].uv = grid.Uv; out[1].col = ShadeSurfaceColor(b.Col, shade);
+    out[2].pos = c.Pixel; out[2].uv = grid.Uv; out[2].col = ShadeSurfaceColor(c.Col, shade);
+    return out + 3;
+}
+
+// Appends an edge of the mesh as two triangles
+static IMPLOT_INLINE ImDrawVert* EmitSurfaceEdge(const SurfaceGrid& grid, ImDrawVert* out, const ImPlotSurfaceNode& a, const ImPlotSurfaceNode& b) {
+    if (!(a.Valid && b.Valid))
+        return out;
+    float dx = b.Pixel.x - a.Pixel.x;
+    float dy = b.Pixel.y - a.Pixel.y;
+    IMPLOT_NORMALIZE2F_OVER_ZERO(dx, dy);
+    dx *= grid.HalfWeight;
+    dy *= grid.HalfWeight;
+    const ImVec2 p[4] = { ImVec2(a.Pixel.x + dy, a.Pixel.y - dx), ImVec2(b.Pixel.x + dy, b.Pixel.y - dx), ImVec2(b.Pixel.x - dy, b.Pixel.y + dx), ImVec2(a.Pixel.x - dy, a.Pixel.y + dx) };
+    static const int quad[6] = { 0, 1, 2, 0, 2, 3 };
+    for (int i = 0; i < 6; ++i) {
+        out[i].pos = p[quad[i]];
+        out[i].uv  = grid.Uv;
+        out[i].col = grid.LineCol;
+    }
+    return out + 6;
+}
+
+// Appends the triangles of a cell, the one holding the cell's farthest corner first
+static IMPLOT_INLINE ImDrawVert* EmitSurfaceCell(const SurfaceGrid& grid, ImDrawVert* out, const ImPlotSurfaceNode& n00, const ImPlotSurfaceNode& n01, const ImPlotSurfaceNode& n10, const ImPlotSurfaceNode& n11) {
+    if (grid.Fill) {
+        if (grid.FarR == grid.FarC) {
+            // farthest corner n00 or n11, split along n01-n10
+            if (grid.FarR) {
+                out = EmitSurfaceTriangle(grid, out, n01, n10, n11);
+                out = EmitSurfaceTriangle(grid, out, n00, n10, n01);
+            }
+            else {
+                out = EmitSurfaceTriangle(grid, out, n00, n10, n01);
+                out = EmitSurfaceTriangle(grid, out, n01, n10, n11);
+            }
+        }
+        else {
+            // farthest corner n01 or n10, split along n00-n11
+            if (grid.FarC) {
+                out = EmitSurfaceTriangle(grid, out, n00, n11, n01);
+                out = EmitSurfaceTriangle(grid, out, n00, n10, n11);
+            }
+            else {
+                out = EmitSurfaceTriangle(grid, out, n00, n10, n11);
+                out = EmitSurfaceTriangle(grid, out, n00, n11, n01);
+            }
+        }
+    }
+    if (grid.Mesh) {
+        out = EmitSurfaceEdge(grid, out, n00, n01);
+        out = EmitSurfaceEdge(grid, out, n01, n11);
+        out = EmitSurfaceEdge(grid, out, n11, n10);
+        out = EmitSurfaceEdge(grid, out, n10, n00);
+    }
+    return out;
+}
+
+// Vertices a cell can take at most
+static inline int SurfaceCellVertices(const SurfaceGrid& grid) {
+    return (grid.Fill ? 6 : 0) + (grid.Mesh ? 24 : 0);
+}
+
+// Projects the nodes of a tile and appends its cells from the farthest one. buf must have room for them.
+template <typename T>
+static void GenerateSurfaceTile(const SurfaceGrid& grid, const T* values, int tile_r, int tile_c, ImPlotSurfaceBuffer& buf) {
+    const int r0 = tile_r * IMPLOT_SURFACE_TILE, r1 = ImMin(r0 + IMPLOT_SURFACE_TILE, grid.NodesR - 1);
+    const int c0 = tile_c * IMPLOT_SURFACE_TILE, c1 = ImMin(c0 + IMPLOT_SURFACE_TILE, grid.NodesC - 1);
+    const int nr = r1 - r0 + 1, nc = c1 - c0 + 1;
+    ImPlotSurfaceNode* nodes = buf.Nodes.Data;
+    for (int r = 0; r < nr; ++r) {
+        const int sr = grid.SampleRow(r0 + r);
+        const double y = grid.Y0 + sr * grid.DY;
+        for (int c = 0; c < nc; ++c) {
+            const int sc = grid.SampleCol(c0 + c);
+            const double v = grid.Value(values, sr, sc);
+            ImPlotSurfaceNode& node = nodes[r * nc + c];
+            node.Valid = !ImNanOrInf(v);
+            if (!node.Valid)
+                continue;
+            // a constant field has no range to map, it is drawn flat at mid height
+            const float t = grid.ScaleMin == grid.ScaleMax ? 0.5f : ImClamp((float)ImRemap01(v, grid.ScaleMin, grid.ScaleMax), 0.0f, 1.0f);
+            double vx, vy, vz;
+            grid.View.Project(grid.X0 + sc * grid.DX, y, t, &vx, &vy, &vz);
+            node.Pixel = grid.Transformer(ImPlotPoint(grid.View.Cx + vx, grid.View.Cy + vy));
+            node.X     = (float)vx;
+            node.Y     = (float)vy;
+            node.Z     = (float)vz;
+            node.Col   = grid.Color(t);
+        }
+    }
+    ImDrawVert* out = buf.Vtx.Data + buf.Vtx.Size;
+    for (int i = 0; i < nr - 1; ++i) {
+        const int r = grid.FarR ? nr - 2 - i : i;
+        const ImPlotSurfaceNode* row0 = nodes + r * nc;
+        const ImPlotSurfaceNode* row1 = row0 + nc;
+        for (int j = 0; j < nc - 1; ++j) {
+            const int c = grid.FarC ? nc - 2 - j : j;
+            out = EmitSurfaceCell(grid, out, row0[c], row0[c + 1], row1[c], row1[c + 1]);
+        }
+    }
+    buf.Vtx.Size = (int)(out - buf.Vtx.Data);
+}
+
+// Appends triangles of three consecutive vertices, in draw commands of at most MaxIdx vertices
+static void SubmitSurfaceTriangles(ImDrawList& draw_list, const ImDrawVert* vtx, int count) {
+    while (count > 0) {
+        unsigned int room = (MaxIdx<ImDrawIdx>::Value - draw_list._VtxCurrentIdx) / 3 * 3;
+        if (room < 192)
+            room = MaxIdx<ImDrawIdx>::Value / 3 * 3;
+        const int n = (int)ImMin((unsigned int)count, room);
+        draw_list.PrimReserve(n, n);
+        memcpy(draw_list._VtxWritePtr, vtx, n * sizeof(ImDrawVert));
+        const unsigned int idx = draw_list._VtxCurrentIdx;
+        for (int i = 0; i < n; ++i)
+            draw_list._IdxWritePtr[i] = (ImDrawIdx)(idx + i);
+        draw_list._VtxWritePtr   += n;
+        draw_list._IdxWritePtr   += n;
+        draw_list._VtxCurrentIdx += n;
+        vtx   += n;
+        count -= n;
+    }
+}
+
+template <typename T>
+static void RenderSurface(ImDrawList& draw_list, const T* values, int rows, int cols, double scale_min, double scale_max, const ImPlotPoint& bounds_min, const ImPlotPoint& bounds_max, const SurfaceView& view, ImPlotSurfaceFlags flags) {
+    ImPlotContext& gp = *GImPlot;
+    ImPlotPlot& plot = *gp.CurrentPlot;
+    const ImPlotNextItemData& s = GetItemData();
+    SurfaceGrid grid(view);
+    grid.Rows       = rows;
+    grid.Cols       = cols;
+    grid.ColMajor   = ImHasFlag(flags, ImPlotSurfaceFlags_ColMajor);
+    grid.X0         = bounds_min.x;
+    grid.DX         = (bounds_max.x - bounds_min.x) / (cols - 1);
+    grid.Y0         = bounds_max.y;
+    grid.DY         = (bounds_min.y - bounds_max.y) / (rows - 1);
+    grid.ScaleMin   = scale_min;
+    grid.ScaleMax   = scale_max;
+    grid.Flip       = (grid.DX > 0) == (grid.DY < 0) ? 1.0f : -1.0f;
+    grid.Cull       = !ImHasFlag(flags, ImPlotSurfaceFlags_NoCull);
+    grid.Fill       = s.RenderFill;
+    grid.Mesh       = ImHasFlag(flags, ImPlotSurfaceFlags_Mesh) && s.RenderLine;
+    grid.Table      = gp.ColormapData.GetTable(gp.Style.Colormap);
+    grid.TableSize  = gp.ColormapData.GetTableSize(gp.Style.Colormap);
+    grid.Qual       = gp.ColormapData.IsQual(gp.Style.Colormap);
+    grid.Alpha      = s.FillAlpha;
+    grid.LineCol    = ImGui::GetColorU32(s.Colors[ImPlotCol_Line]);
+    grid.HalfWeight = ImMax(1.0f, s.LineWeight) * 0.5f;
+    grid.Uv         = draw_list._Data->TexUvWhitePixel;
+
+    // level of detail from the length of the grid on screen, heights add to it when seen from the side
+    const Transformer2& transformer = grid.Transformer;
+    const ImVec2 p00 = transformer(view.ToPlot(bounds_min.x, bounds_max.y, 0.5));
+    const ImVec2 p0c = transformer(view.ToPlot(bounds_max.x, bounds_max.y, 0.5));
+    const ImVec2 pr0 = transformer(view.ToPlot(bounds_min.x, bounds_min.y, 0.5));
+    const float height_px = ImSqrt(ImLengthSqr(transformer(view.ToPlot(view.Cx, view.Cy, 1.0)) - transformer(view.ToPlot(view.Cx, view.Cy, 0.0))));
+    const float length_c = ImSqrt(ImLengthSqr(p0c - p00)) + height_px;
+    const float length_r = ImSqrt(ImLengthSqr(pr0 - p00)) + height_px;
+    const bool lod = !ImHasFlag(flags, ImPlotSurfaceFlags_NoLOD);
+    grid.StepC  = lod ? ImMax(1, (int)ImCeil(IMPLOT_SURFACE_LOD_PIXELS * (cols - 1) / ImMax(length_c, 1.0f))) : 1;
+    grid.StepR  = lod ? ImMax(1, (int)ImCeil(IMPLOT_SURFACE_LOD_PIXELS * (rows - 1) / ImMax(length_r, 1.0f))) : 1;
+    grid.NodesC = (cols - 1 + grid.StepC - 1) / grid.StepC + 1;
+    grid.NodesR = (rows - 1 + grid.StepR - 1) / grid.StepR + 1;
+
+    // depth grows along the ground by these per sample
+    grid.FarC = grid.DX * view.SinYaw * view.CosPitch > 0;
+    grid.FarR = grid.DY * view.CosYaw * view.CosPitch > 0;
+
+    // visible tiles from the farthest one
+    const int tiles_r = (grid.NodesR - 2) / IMPLOT_SURFACE_TILE + 1;
+    const int tiles_c = (grid.NodesC - 2) / IMPLOT_SURFACE_TILE + 1;
+    const ImPlotRange& x_range = plot.Axes[plot.CurrentX].Range;
+    const ImPlotRange& y_range = plot.Axes[plot.CurrentY].Range;
+    ImVector<int>& tiles = gp.TempInt1;
+    tiles.resize(0);
+    ImS64 cells = 0;
+    for (int i = 0; i < tiles_r; ++i) {
+        const int tr = grid.FarR ? tiles_r - 1 - i : i;
+        const int r0 = tr * IMPLOT_SURFACE_TILE, r1 = ImMin(r0 + IMPLOT_SURFACE_TILE, grid.NodesR - 1);
+        const double y0 = grid.Y0 + grid.SampleRow(r0) * grid.DY, y1 = grid.Y0 + grid.SampleRow(r1) * grid.DY;
+        for (int j = 0; j < tiles_c; ++j) {
+            const int tc = grid.FarC ? tiles_c - 1 - j : j;
+            const int c0 = tc * IMPLOT_SURFACE_TILE, c1 = ImMin(c0 + IMPLOT_SURFACE_TILE, grid.NodesC - 1);
+            const double x0 = grid.X0 + grid.SampleCol(c0) * grid.DX, x1 = grid.X0 + grid.SampleCol(c1) * grid.DX;
+            ImPlotRect box(HUGE_VAL, -HUGE_VAL, HUGE_VAL, -HUGE_VAL);
+            for (int k = 0; k < 8; ++k) {
+                const ImPlotPoint p = view.ToPlot((k & 1) ? x1 : x0, (k & 2) ? y1 : y0, (k & 4) ? 1.0 : 0.0);
+                box.X.Min = ImMin(box.X.Min, p.x); box.X.Max = ImMax(box.X.Max, p.x);
+                box.Y.Min = ImMin(box.Y.Min, p.y); box.Y.Max = ImMax(box.Y.Max, p.y);
+            }
+            if (box.X.Max < x_range.Min || box.X.Min > x_range.Max || box.Y.Max < y_range.Min || box.Y.Min > y_range.Max)
+                continue;
+            tiles.push_back(tr * tiles_c + tc);
+            cells += (ImS64)(r1 - r0) * (c1 - c0);
+        }
+    }
+    if (tiles.empty())
+        return;
+
+    // runs of tiles in drawing order, buffers are sized up front so threads don't allocate
+    const int runs = cells >= IMPLOT_SURFACE_PARALLEL_CELLS ? ImMin(OMP_THREADS, tiles.Size) : 1;
+    const int tile_vertices = IMPLOT_SURFACE_TILE * IMPLOT_SURFACE_TILE * SurfaceCellVertices(grid);
+    ImPlotSurfaceBuffer* buffers = gp.SurfaceBuffers;
+    for (int k = 0; k < runs; ++k) {
+        const int count = (k + 1) * tiles.Size / runs - k * tiles.Size / runs;
+        buffers[k].Nodes.resize((IMPLOT_SURFACE_TILE + 1) * (IMPLOT_SURFACE_TILE + 1));
+        buffers[k].Vtx.resize(0);
+        buffers[k].Vtx.reserve(count * tile_vertices);
+    }
+    const int* tile_list = tiles.Data;
+    const int tile_count = tiles.Size;
+    #pragma omp parallel for num_threads(OMP_THREADS) if (runs > 1)
+    for (int k = 0; k < runs; ++k) {
+        for (int i = k * tile_count / runs; i < (k + 1) * tile_count / runs; ++i)
+            GenerateSurfaceTile(grid, values, tile_list[i] / tiles_c, tile_list[i] % tiles_c, buffers[k]);
+    }
+    for (int k = 0; k < runs; ++k)
+        SubmitSurfaceTriangles(draw_list, buffers[k].Vtx.Data, buffers[k].Vtx.Size);
+}
+
+template <typename T>
+void PlotSurface(const char* label_id, const T* values, int rows, int cols, double scale_min, double scale_max, const ImPlotPoint& bounds_min, const ImPlotPoint& bounds_max, ImPlotSurfaceFlags flags) {
+    const ImPlotNextItemData& n = GImPlot->NextItemData;
+    const SurfaceView view(bounds_min, bounds_max,
+                           n.HasSurfaceView ? n.SurfaceYaw    : IMPLOT_SURFACE_YAW,
+                           n.HasSurfaceView ? n.SurfacePitch  : IMPLOT_SURFACE_PITCH,
+                           n.HasSurfaceView ? n.SurfaceHeight : IMPLOT_SURFACE_HEIGHT);
+    if (BeginItemEx(label_id, FitterSurface(view, bounds_min, bounds_max), flags, ImPlotCol_Line)) {
+        if (rows < 2 || cols < 2) {
+            EndItem();
+            return;
+        }
+        if (scale_min == 0 && scale_max == 0) {
+            const int count = rows * cols;
+            int first = 0;
+            while (first < count && ImNanOrInf((double)values[first]))
+                ++first;
+            if (first < count) {
+                T temp_min, temp_max;
+                ParallelMinMax(values + first, count - first, &temp_min, &temp_max);
+                // infinite samples are not drawn, the range is taken again without them
+                if (ImNanOrInf((double)temp_min) || ImNanOrInf((double)temp_max))
+                    FiniteMinMax(values + first, count - first, &temp_min, &temp_max);
+                scale_min = (double)temp_min;
+                scale_max = (double)temp_max;
+            }
+        }
+        RenderSurface(*GetPlotDrawList(), values, rows, cols, scale_min, scale_max, bounds_min, bounds_max, view, flags);
+        EndItem();
+    }
+}
+#define INSTANTIATE_MACRO(T) template IMPLOT_API void PlotSurface<T>(const char* label_id, const T* values, int rows, int cols, double scale_min, double scale_max, const ImPlotPoint& bounds_min, const ImPlotPoint& bounds_max, ImPlotSurfaceFlags flags);
+CALL_INSTANTIATE_FOR_NUMERIC_TYPES()
+#undef INSTANTIATE_MACRO
+
+//-----------------------------------------------------------------------------
+// [SECTION] Histogram Binning (add by Dicky)
+//-----------------------------------------------------------------------------
+
+// Binning millions of samples every frame dominates the cost of a histogram. Min/max are found with
+// ParallelMinMax and samples are counted into integer partial histograms on several threads, then
+// merged. Callers can also give a version with SetNextHistogramVersion() so unchanged data reuses its bins.
+
+// Arrays with at least this many samples are split across threads
+#define IMPLOT_HISTOGRAM_PARALLEL_COUNT (256 * 1024)
+// Bins of histograms not plotted for this many frames are released
+#define IMPLOT_HISTOGRAM_CACHE_KEEP_FRAMES 120
+
+// Finds the bin of a value inside the range. The division is kept: binning is bound by loads and counter updates
+// and a multiply by the reciprocal measured no faster, while moving values on bin edges of quantized data.
+struct HistogramBinner {
+    HistogramBinner(double min, double width, int bins) : Min(min), Width(width), Bins(bins) { }
+    IMPLOT_INLINE int operator()(double v) const {
+        return ImClamp((int)((v - Min) / Width), 0, Bins - 1);
+    }
+    const double Min, Width;
+    const int Bins;
+};
+
+// Partial histograms take OMP_THREADS times the bins, only split the samples when they outnumber them
+static inline int HistogramChunks(int count, int bins) {
+    return count >= IMPLOT_HISTOGRAM_PARALLEL_COUNT && (ImS64)bins * OMP_THREADS <= count ? OMP_THREADS : 1;
+}
+
+// Counts values[i0,i1) inside #range into #hist and returns how many are below it. The binners are taken
+// by value so the counter stores can't alias them.
+template <typename T>
+static int BinHistogramChunk(const T* values, int i0, int i1, ImPlotRange range, HistogramBinner binner, int* hist) {
+    int below = 0;
+    for (int i = i0; i < i1; ++i) {
+        const double val = (double)values[i];
+        if (range.Contains(val))
+            hist[binner(val)]++;
+        else if (val < range.Min)
+            below++;
+    }
+    return below;
+}
+
+template <typename T>
+static void BinHistogramChunk2D(const T* xs, const T* ys, int i0, int i1, ImPlotRect range, HistogramBinner x_binner, HistogramBinner y_binner, int* hist) {
+    const int x_bins = x_binner.Bins;
+    for (int i = i0; i < i1; ++i) {
+        const double x = (double)xs[i];
+        const double y = (double)ys[i];
+        if (range.Contains(x, y))
+            hist[y_binner(y) * x_bins + x_binner(x)]++;
+    }
+}
+
+// Counts the values inside #range into #counts, returns the values below the range in #below_out
+template <typename T>
+static void BinHistogram(const T* values, int count, const ImPlotRange& range, int bins, double width, ImVector<double>& counts, int* below_out) {
+    ImPlotContext& gp = *GImPlot;
+    const HistogramBinner binner(range.Min, width, bins);
+    const int chunks = HistogramChunks(count, bins);
+    const int chunk = (count + chunks - 1) / chunks;
+    ImVector<int>& partial = gp.TempInt1;
+    partial.resize(chunks * bins);
+    memset(partial.Data, 0, sizeof(int) * partial.Size);
+    int below[OMP_THREADS] = {};
+    #pragma omp parallel for num_threads(OMP_THREADS) if (chunks > 1)
+    for (int c = 0; c < chunks; ++c)
+        below[c] = BinHistogramChunk(values, c * chunk, ImMin(count, (c + 1) * chunk), range, binner, partial.Data + c * bins);
+    *below_out = 0;
+    for (int c = 0; c < chunks; ++c)
+        *below_out += below[c];
+    for (int b = 0; b < bins; ++b) {
+        int n = 0;
+        for (int c = 0; c < chunks; ++c)
+            n += partial[c * bins + b];
+        counts[b] = n;
+    }
+}
+
+// Counts the points inside #range into #counts, rows of #x_bins
+template <typename T>
+static void BinHistogram2D(const T* xs, const T* ys, int count, const ImPlotRect& range, int x_bins, int y_bins, double width, double height, ImVector<double>& counts) {
+    ImPlotContext& gp = *GImPlot;
+    const HistogramBinner x_binner(range.X.Min, width, x_bins);
+    const HistogramBinner y_binner(range.Y.Min, height, y_bins);
+    const int bins = x_bins * y_bins;
+    const int chunks = HistogramChunks(count, bins);
+    const int chunk = (count + chunks - 1) / chunks;
+    ImVector<int>& partial = gp.TempInt1;
+    partial.resize(chunks * bins);
+    memset(partial.Data, 0, sizeof(int) * partial.Size);
+    #pragma omp parallel for num_threads(OMP_THREADS) if (chunks > 1)
+    for (int c = 0; c < chunks; ++c)
+        BinHistogramChunk2D(xs, ys, c * chunk, ImMin(count, (c + 1) * chunk), range, x_binner, y_binner, partial.Data + c * bins);
+    for (int b = 0; b < bins; ++b) {
+        int n = 0;
+        for (int c = 0; c < chunks; ++c)
+            n += partial[c * bins + b];
+        counts[b] = n;
+    }
+}
+
+void SetNextHistogramVersion(ImU64 version) {
+    ImPlotContext& gp = *GImPlot;
+    gp.NextItemData.HasHistogramVersion = true;
+    gp.NextItemData.HistogramVersion    = version;
+}
+
+// Returns the bins cache of the item when the caller gave a version for it, #hit tells whether it holds
+// the bins of these arguments. Otherwise it now expects them.
+static ImPlotHistogramCache* GetHistogramCache(const char* label_id, const void* xs, const void* ys, int count, int x_bins, int y_bins, const ImPlotRect& range, ImPlotHistogramFlags flags, bool* hit) {
+    ImPlotContext& gp = *GImPlot;
+    *hit = false;
+    if (!gp.NextItemData.HasHistogramVersion)
+        return nullptr;
+    gp.NextItemData.HasHistogramVersion = false;
+    const ImU64 version = gp.NextItemData.HistogramVersion;
+    const int frame = ImGui::GetFrameCount();
+    for (int n = 0; n < gp.HistogramCaches.GetMapSize(); ++n) {
+        ImPlotHistogramCache* stale = gp.HistogramCaches.TryGetMapData(n);
+        if (stale != nullptr && stale->LastFrame < frame - IMPLOT_HISTOGRAM_CACHE_KEEP_FRAMES)
+            gp.HistogramCaches.Remove(stale->ID, stale);
+    }
+    const ImGuiID id = gp.CurrentItems->GetItemID(label_id);
+    ImPlotHistogramCache& cache = *gp.HistogramCaches.GetOrAddByKey(id);
+    *hit = cache.LastFrame >= 0 && cache.Version == version && cache.Xs == xs && cache.Ys == ys && cache.Count == count &&
+           cache.XBinsArg == x_bins && cache.YBinsArg == y_bins && cache.Flags == flags &&
+           cache.RangeArg.X.Min == range.X.Min && cache.RangeArg.X.Max == range.X.Max &&
+           cache.RangeArg.Y.Min == range.Y.Min && cache.RangeArg.Y.Max == range.Y.Max;
+    cache.ID       = id;
+    cache.Xs       = xs;
+    cache.Ys       = ys;
+    cache.Count    = count;
+    cache.Version  = version;
+    cache.XBinsArg = x_bins;
+    cache.YBinsArg = y_bins;
+    cache.RangeArg = range;
+    cache.Flags    = flags;
+    cache.LastFrame = frame;
+    return &cache;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] PlotHistogram
 //-----------------------------------------------------------------------------
@@ -2511,68 +4301,76 @@ double PlotHistogram(const char* label_id, const T* values, int count, int bins,
     if (count <= 0 || bins == 0)
         return 0;
 
-    if (range.Min == 0 && range.Max == 0) {
-        T Min, Max;
-        ImMinMaxArray(values, count, &Min, &Max);
-        range.Min = (double)Min;
-        range.Max = (double)Max;
+    ImPlotContext& gp = *GImPlot;
+    // add by Dicky for histogram caching
+    bool cached;
+    ImPlotHistogramCache* cache = GetHistogramCache(label_id, values, nullptr, count, bins, 0, ImPlotRect(range.Min, range.Max, 0, 0), flags, &cached);
+    ImVector<double>& bin_centers = cache ? cache->Centers : gp.TempDouble1;
+    ImVector<double>& bin_counts  = cache ? cache->Counts  : gp.TempDouble2;
+    double width, max_count;
+    if (cached) {
+        bins      = cache->XBins;
+        width     = cache->Width;
+        max_count = cache->MaxCount;
     }
+    else {
+        if (range.Min == 0 && range.Max == 0) {
+            T Min, Max;
+            ParallelMinMax(values, count, &Min, &Max); // modify by Dicky
+            range.Min = (double)Min;
+            range.Max = (double)Max;
+        }
 
-    double width;
-    if (bins < 0)
-        CalculateBins(values, count, bins, range, bins, width);
-    else
-        width = range.Size() / bins;
+        if (bins < 0)
+            CalculateBins(values, count, bins, range, bins, width);
+        else
+            width = range.Size() / bins;
 
-    ImPlotContext& gp = *GImPlot;
-    ImVector<double>& bin_centers = gp.TempDouble1;
-    ImVector<double>& bin_counts  = gp.TempDouble2;
-    bin_centers.resize(bins);
-    bin_counts.resize(bins);
-    int below = 0;
+        bin_centers.resize(bins);
+        bin_counts.resize(bins);
+        int below = 0;
 
-    for (int b = 0; b < bins; ++b) {
-        bin_centers[b] = range.Min + b * width + width * 0.5;
-        bin_counts[b] = 0;
-    }
-    int counted = 0;
-    double max_count = 0;
-    for (int i = 0; i < count; ++i) {
-        double val = (double)values[i];
-        if (range.Contains(val)) {
-            const int b = ImClamp((int)((val - range.Min) / width), 0, bins - 1);
-            bin_counts[b] += 1.0;
+        for (int b = 0; b < bins; ++b)
+            bin_centers[b] = range.Min + b * width + width * 0.5;
+        BinHistogram(values, count, range, bins, width, bin_counts, &below); // modify by Dicky
+        int counted = 0;
+        max_count = 0;
+        for (int b = 0; b < bins; ++b) {
+            counted += (int)bin_counts[b];
             if (bin_counts[b] > max_count)
                 max_count = bin_counts[b];
-            counted++;
         }
-        else if (val < range.Min) {
-            below++;
+        if (cumulative && density) {
+            if (outliers)
+                bin_counts[0] += below;
+            for (int b = 1; b < bins; ++b)
+                bin_counts[b] += bin_counts[b-1];
+            double scale = 1.0 / (outliers ? count : counted);
+            for (int b = 0; b < bins; ++b)
+                bin_counts[b] *= scale;
+            max_count = bin_counts[bins-1];
+        }
+        else if (cumulative) {
+            if (outliers)
+                bin_counts[0] += below;
+            for (int b = 1; b < bins; ++b)
+                bin_counts[b] += bin_counts[b-1];
+            max_count = bin_counts[bins-1];
+        }
+        else if (density) {
+            double scale = 1.0 / ((outliers ? count : counted) * width);
+            for (int b = 0; b < bins; ++b)
+                bin_counts[b] *= scale;
+            max_count *= scale;
+        }
+
+        if (cache) {
+            cache->XBins    = bins;
+            cache->Width    = width;
+            cache->MaxCount = max_count;
         }
     }
-    if (cumulative && density) {
-        if (outliers)
-            bin_counts[0] += below;
-        for (int b = 1; b < bins; ++b)
-            bin_counts[b] += bin_counts[b-1];
-        double scale = 1.0 / (outliers ? count : counted);
-        for (int b = 0; b < bins; ++b)
-            bin_counts[b] *= scale;
-        max_count = bin_counts[bins-1];
-    }
-    else if (cumulative) {
-        if (outliers)
-            bin_counts[0] += below;
-        for (int b = 1; b < bins; ++b)
-            bin_counts[b] += bin_counts[b-1];
-        max_count = bin_counts[bins-1];
-    }
-    else if (density) {
-        double scale = 1.0 / ((outliers ? count : counted) * width);
-        for (int b = 0; b < bins; ++b)
-            bin_counts[b] *= scale;
-        max_count *= scale;
-    }
+    // add by Dicky end
     if (ImHasFlag(flags, ImPlotHistogramFlags_Horizontal))
         PlotBars(label_id, &bin_counts.Data[0], &bin_centers.Data[0], bins, bar_scale*width, ImPlotBarsFlags_Horizontal);
     else
@@ -2598,57 +4396,69 @@ double PlotHistogram2D(const char* label_id, const T* xs, const T* ys, int count
     if (count <= 0 || x_bins == 0 || y_bins == 0)
         return 0;
 
-    if (range.X.Min == 0 && range.X.Max == 0) {
-        T Min, Max;
-        ImMinMaxArray(xs, count, &Min, &Max);
-        range.X.Min = (double)Min;
-        range.X.Max = (double)Max;
-    }
-    if (range.Y.Min == 0 && range.Y.Max == 0) {
-        T Min, Max;
-        ImMinMaxArray(ys, count, &Min, &Max);
-        range.Y.Min = (double)Min;
-        range.Y.Max = (double)Max;
+    ImPlotContext& gp = *GImPlot;
+    // add by Dicky for histogram caching
+    bool cached;
+    ImPlotHistogramCache* cache = GetHistogramCache(label_id, xs, ys, count, x_bins, y_bins, range, flags, &cached);
+    ImVector<double>& bin_counts = cache ? cache->Counts : gp.TempDouble1;
+    double max_count;
+    if (cached) {
+        x_bins    = cache->XBins;
+        y_bins    = cache->YBins;
+        range     = cache->Range;
+        max_count = cache->MaxCount;
     }
+    else {
+        if (range.X.Min == 0 && range.X.Max == 0) {
+            T Min, Max;
+            ParallelMinMax(xs, count, &Min, &Max); // modify by Dicky
+            range.X.Min = (double)Min;
+            range.X.Max = (double)Max;
+        }
+        if (range.Y.Min == 0 && range.Y.Max == 0) {
+            T Min, Max;
+            ParallelMinMax(ys, count, &Min, &Max); // modify by Dicky
+            range.Y.Min = (double)Min;
+            range.Y.Max = (double)Max;
+        }
 
-    double width, height;
-    if (x_bins < 0)
-        CalculateBins(xs, count, x_bins, range.X, x_bins, width);
-    else
-        width = range.X.Size() / x_bins;
-    if (y_bins < 0)
-        CalculateBins(ys, count, y_bins, range.Y, y_bins, height);
-    else
-        height = range.Y.Size() / y_bins;
-
-    const int bins = x_bins * y_bins;
+        double width, height;
+        if (x_bins < 0)
+            CalculateBins(xs, count, x_bins, range.X, x_bins, width);
+        else
+            width = range.X.Size() / x_bins;
+        if (y_bins < 0)
+            CalculateBins(ys, count, y_bins, range.Y, y_bins, height);
+        else
+            height = range.Y.Size() / y_bins;
 
-    ImPlotContext& gp = *GImPlot;
-    ImVector<double>& bin_counts = gp.TempDouble1;
-    bin_counts.resize(bins);
+        const int bins = x_bins * y_bins;
 
-    for (int b = 0; b < bins; ++b)
-        bin_counts[b] = 0;
+        bin_counts.resize(bins);
+        BinHistogram2D(xs, ys, count, range, x_bins, y_bins, width, height, bin_counts); // modify by Dicky
 
-    int counted = 0;
-    double max_count = 0;
-    for (int i = 0; i < count; ++i) {
-        if (range.Contains((double)xs[i], (double)ys[i])) {
-            const int xb = ImClamp( (int)((double)(xs[i] - range.X.Min) / width)  , 0, x_bins - 1);
-            const int yb = ImClamp( (int)((double)(ys[i] - range.Y.Min) / height) , 0, y_bins - 1);
-            const int b  = yb * x_bins + xb;
-            bin_counts[b] += 1.0;
+        int counted = 0;
+        max_count = 0;
+        for (int b = 0; b < bins; ++b) {
+            counted += (int)bin_counts[b];
             if (bin_counts[b] > max_count)
                 max_count = bin_counts[b];
-            counted++;
+        }
+        if (density) {
+            double scale = 1.0 / ((outliers ? count : counted) * width * height);
+            for (int b = 0; b < bins; ++b)
+                bin_counts[b] *= scale;
+            max_count *= scale;
+        }
+
+        if (cache) {
+            cache->XBins    = x_bins;
+            cache->YBins    = y_bins;
+            cache->Range    = range;
+            cache->MaxCount = max_count;
         }
     }
-    if (density) {
-        double scale = 1.0 / ((outliers ? count : counted) * width * height);
-        for (int b = 0; b < bins; ++b)
-            bin_counts[b] *= scale;
-        max_count *= scale;
-    }
+    // add by Dicky end
 
     if (BeginItemEx(label_id, FitterRect(range))) {
         if (y_bins <= 0 || x_bins <= 0) {
@@ -2671,8 +4481,9 @@ CALL_INSTANTIATE_FOR_NUMERIC_TYPES()
 
 // TODO: Make this behave like all the other plot types (.e. not fixed in y axis)
 
+// add by Dicky: decimated columns may end on the right edge of the plot, which its rect excludes
 template <typename Getter>
-void PlotDigitalEx(const char* label_id, Getter getter, ImPlotDigitalFlags flags) {
+void PlotDigitalEx(const char* label_id, Getter getter, ImPlotDigitalFlags flags, bool decimated = false) {
     if (BeginItem(label_id, flags, ImPlotCol_Fill)) {
         ImPlotContext& gp = *GImPlot;
         ImDrawList& draw_list = *GetPlotDrawList();
@@ -2715,6 +4526,8 @@ void PlotDigitalEx(const char* label_id, Getter getter, ImPlotDigitalFlags flags
                 if (pMax.x < x_axis.PixelMin) pMax.x = x_axis.PixelMin;
                 if (pMin.x > x_axis.PixelMax) pMin.x = x_axis.PixelMax - 1; //fix issue related to https://github.com/ocornut/imgui/issues/3976
                 if (pMax.x > x_axis.PixelMax) pMax.x = x_axis.PixelMax - 1; //fix issue related to https://github.com/ocornut/imgui/issues/3976
+                if (decimated && pMin.x == x_axis.PixelMax) pMin.x = x_axis.PixelMax - 1; // add by Dicky
+                if (decimated && pMax.x == x_axis.PixelMax) pMax.x = x_axis.PixelMax - 1; // add by Dicky
                 //plot a rectangle that extends up to x2 with y1 height
                 if ((pMax.x > pMin.x) && (gp.CurrentPlot->PlotRect.Contains(pMin) || gp.CurrentPlot->PlotRect.Contains(pMax))) {
                     // ImVec4 colAlpha = item->Color;
@@ -2746,6 +4559,19 @@ void PlotDigitalG(const char* label_id, ImPlotGetter getter_func, void* data, in
     return PlotDigitalEx(label_id, getter, flags);
 }
 
+// add by Dicky for min/max pyramid
+void PlotDigital(const char* label_id, const ImPlotPyramid& pyramid, ImPlotDigitalFlags flags) {
+    // the plot area is needed to decimate
+    SetupLock();
+    ImPlotContext& gp = *GImPlot;
+    GetterPyramid getter(pyramid);
+    if (DecimateDigital(getter, gp.TempDouble1, gp.TempDouble2))
+        PlotDigitalEx(label_id, GetDecimatedGetter(), flags, true);
+    else
+        PlotDigitalEx(label_id, getter, flags);
+}
+// add by Dicky end
+
 //-----------------------------------------------------------------------------
 // [SECTION] PlotImage
 //-----------------------------------------------------------------------------
@@ -2806,3 +4632,247 @@ void PlotDummy(const char* label_id, ImPlotDummyFlags flags) {
 }
 
 } // namespace ImPlot
+
+//-----------------------------------------------------------------------------
+// [SECTION] ImPlotPyramid (add by Dicky)
+//-----------------------------------------------------------------------------
+
+static ImPlotPyramidNode MergePyramidNodes(const ImPlotPyramidNode& a, const ImPlotPyramidNode& b) {
+    ImPlotPyramidNode node = a;
+    if (b.IdxMin >= 0 && (node.IdxMin < 0 || b.Min < node.Min)) { node.Min = b.Min; node.IdxMin = b.IdxMin; }
+    if (b.IdxMax >= 0 && (node.IdxMax < 0 || b.Max > node.Max)) { node.Max = b.Max; node.IdxMax = b.IdxMax; }
+    return node;
+}
+
+void ImPlotPyramid::Clear() {
+    Xs.clear();
+    Ys.clear();
+    NaNs.clear();
+    for (int l = 0; l < IMPLOT_PYRAMID_LEVELS; ++l)
+        Levels[l].clear();
+}
+
+template <typename T>
+void ImPlotPyramid::Build(const T* values, int count, double xscale, double xstart, int offset, int stride) {
+    Clear();
+    XScale = xscale;
+    XStart = xstart;
+    Append(values, count, offset, stride);
+}
+
+template <typename T>
+void ImPlotPyramid::Append(const T* values, int count, int offset, int stride) {
+    IM_ASSERT(Xs.Size == 0 && XScale > 0 && "ImPlotPyramid built from xs and ys needs xs to append!");
+    const int old_size = Ys.Size;
+    Ys.resize(old_size + count);
+    offset = count ? ImPosMod(offset, count) : 0;
+    for (int i = 0; i < count; ++i)
+        Ys.Data[old_size + i] = (double)ImPlot::IndexData(values, i, count, offset, stride);
+    UpdateLevels(old_size);
+}
+
+template <typename T>
+void ImPlotPyramid::Build(const T* xs, const T* ys, int count, int offset, int stride) {
+    Clear();
+    Append(xs, ys, count, offset, stride);
+}
+
+template <typename T>
+void ImPlotPyramid::Append(const T* xs, const T* ys, int count, int offset, int stride) {
+    IM_ASSERT(Xs.Size == Ys.Size && "ImPlotPyramid built from uniform values can't append xs!");
+    const int old_size = Ys.Size;
+    Xs.resize(old_size + count);
+    Ys.resize(old_size + count);
+    offset = count ? ImPosMod(offset, count) : 0;
+    for (int i = 0; i < count; ++i) {
+        Xs.Data[old_size + i] = (double)ImPlot::IndexData(xs, i, count, offset, stride);
+        Ys.Data[old_size + i] = (double)ImPlot::IndexData(ys, i, count, offset, stride);
+        IM_ASSERT((old_size + i == 0 || Xs.Data[old_size + i] >= Xs.Data[old_size + i - 1]) && "ImPlotPyramid xs must be ascending!");
+    }
+    UpdateLevels(old_size);
+}
+
+#define INSTANTIATE_MACRO(T) \
+    template void ImPlotPyramid::Build<T>(const T* values, int count, double xscale, double xstart, int offset, int stride); \
+    template void ImPlotPyramid::Append<T>(const T* values, int count, int offset, int stride); \
+    template void ImPlotPyramid::Build<T>(const T* xs, const T* ys, int count, int offset, int stride); \
+    template void ImPlotPyramid::Append<T>(const T* xs, const T* ys, int count, int offset, int stride);
+CALL_INSTANTIATE_FOR_NUMERIC_TYPES()
+#undef INSTANTIATE_MACRO
+
+void ImPlotPyramid::UpdateLevels(int old_size) {
+    for (int i = old_size; i < Ys.Size; ++i)
+        if (ImNan(Ys.Data[i]))
+            NaNs.push_back(i);
+    // nodes are only kept for complete blocks, each completed pair of nodes completes one of the level above
+    const int block = 1 << IMPLOT_PYRAMID_BLOCK_SHIFT;
+    for (int n = Levels[0].Size; n < (Ys.Size >> IMPLOT_PYRAMID_BLOCK_SHIFT); ++n) {
+        ImPlotPyramidNode node;
+        node.Min = node.Max = 0;
+        node.IdxMin = node.IdxMax = -1;
+        for (int i = n * block; i < (n + 1) * block; ++i) {
+            const double y = Ys.Data[i];
+            if (ImNan(y))
+                continue;
+            if (node.IdxMin < 0 || y < node.Min) { node.Min = y; node.IdxMin = i; }
+            if (node.IdxMax < 0 || y > node.Max) { node.Max = y; node.IdxMax = i; }
+        }
+        Levels[0].push_back(node);
+        for (int l = 0; l + 1 < IMPLOT_PYRAMID_LEVELS && (Levels[l].Size & 1) == 0; ++l)
+            Levels[l + 1].push_back(MergePyramidNodes(Levels[l][Levels[l].Size - 2], Levels[l][Levels[l].Size - 1]));
+    }
+}
+
+bool ImPlotPyramid::HasNaN(int idx0, int idx1) const {
+    // first NaN index not less than idx0
+    int lo = 0, hi = NaNs.Size;
+    while (lo < hi) {
+        const int mid = lo + (hi - lo) / 2;
+        if (NaNs.Data[mid] < idx0) lo = mid + 1; else hi = mid;
+    }
+    return lo < NaNs.Size && NaNs.Data[lo] < idx1;
+}
+
+void ImPlotPyramid::QueryMinMax(int idx0, int idx1, int* idx_min, int* idx_max) const {
+    ImPlotPyramidNode acc;
+    acc.Min = acc.Max = 0;
+    acc.IdxMin = acc.IdxMax = -1;
+    int i = ImMax(idx0, 0);
+    idx1 = ImMin(idx1, Ys.Size);
+    while (i < idx1) {
+        // largest complete node starting at i and ending before idx1
+        int level = -1;
+        for (int l = 0; l < IMPLOT_PYRAMID_LEVELS; ++l) {
+            const int shift = IMPLOT_PYRAMID_BLOCK_SHIFT + l;
+            if ((i & ((1 << shift) - 1)) != 0 || idx1 - i < (1 << shift) || (i >> shift) >= Levels[l].Size)
+                break;
+            level = l;
+        }
+        if (level >= 0) {
+            acc = MergePyramidNodes(acc, Levels[level][i >> (IMPLOT_PYRAMID_BLOCK_SHIFT + level)]);
+            i += 1 << (IMPLOT_PYRAMID_BLOCK_SHIFT + level);
+            continue;
+        }
+        const double y = Ys.Data[i];
+        if (!ImNan(y)) {
+            if (acc.IdxMin < 0 || y < acc.Min) { acc.Min = y; acc.IdxMin = i; }
+            if (acc.IdxMax < 0 || y > acc.Max) { acc.Max = y; acc.IdxMax = i; }
+        }
+        i++;
+    }
+    *idx_min = acc.IdxMin;
+    *idx_max = acc.IdxMax;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] ImPlotRingBuffer (add by Dicky)
+//-----------------------------------------------------------------------------
+
+// Samples are indexed by 64-bit counters that never wrap, slot of sample i is i & Mask. The consumer owns the
+// samples [Tail,Head) and producers write to [Head,Tail+Capacity), publishing with a release store to Head
+// (single producer) or to the slot sequence (multiple producers, which reserve their slots with a CAS on Reserved).
+
+ImPlotRingBuffer::ImPlotRingBuffer(int capacity, int history, bool multi_producer) {
+    IM_ASSERT(capacity > 0 && capacity <= (1 << 30) && "ImPlotRingBuffer capacity is out of range!");
+    Capacity = 1;
+    while (Capacity < capacity)
+        Capacity <<= 1;
+    History = history > 0 ? history : ImMax(Capacity / 2, 1);
+    IM_ASSERT(History <= Capacity && "ImPlotRingBuffer history can't exceed its capacity!");
+    Mask = (ImU64)Capacity - 1;
+    MultiProducer = multi_producer;
+    Xs = (double*)IM_ALLOC(sizeof(double) * Capacity);
+    Ys = (double*)IM_ALLOC(sizeof(double) * Capacity);
+    Seqs = NULL;
+    if (MultiProducer) {
+        Seqs = (std::atomic<ImU64>*)IM_ALLOC(sizeof(std::atomic<ImU64>) * Capacity);
+        for (int i = 0; i < Capacity; ++i)
+            IM_PLACEMENT_NEW(&Seqs[i]) std::atomic<ImU64>(0);
+    }
+    SnapshotStart = 0;
+    SnapshotCount = 0;
+    SnapshotFrame = -1;
+    Head.store(0);
+    ProducerTail = 0;
+    Reserved.store(0);
+    Tail.store(0);
+    Dropped.store(0);
+}
+
+ImPlotRingBuffer::~ImPlotRingBuffer() {
+    IM_FREE(Xs);
+    IM_FREE(Ys);
+    if (Seqs)
+        IM_FREE(Seqs);
+}
+
+bool ImPlotRingBuffer::Push(double x, double y) {
+    return Push(&x, &y, 1) == 1;
+}
+
+int ImPlotRingBuffer::Push(const double* xs, const double* ys, int count) {
+    if (count <= 0)
+        return 0;
+    ImU64 start;
+    int pushed;
+    if (MultiProducer) {
+        start = Reserved.load(std::memory_order_relaxed);
+        for (;;) {
+            const ImU64 used = start - Tail.load(std::memory_order_acquire);
+            pushed = (int)ImMin((ImU64)count, (ImU64)Capacity - used);
+            if (pushed == 0 || Reserved.compare_exchange_weak(start, start + pushed, std::memory_order_relaxed))
+                break;
+        }
+    }
+    else {
+        // the consumer's Tail is only read again when the last one seen leaves too little room
+        start = Head.load(std::memory_order_relaxed);
+        if ((ImU64)Capacity - (start - ProducerTail) < (ImU64)count)
+            ProducerTail = Tail.load(std::memory_order_acquire);
+        pushed = (int)ImMin((ImU64)count, (ImU64)Capacity - (start - ProducerTail));
+    }
+    if (pushed < count)
+        Dropped.fetch_add((ImU64)(count - pushed), std::memory_order_relaxed);
+    if (pushed == 0)
+        return 0;
+    // copy in at most two parts around the end of the storage
+    const int slot = (int)(start & Mask);
+    const int first = ImMin(pushed, Capacity - slot);
+    memcpy(Xs + slot, xs, sizeof(double) * first);
+    memcpy(Ys + slot, ys, sizeof(double) * first);
+    memcpy(Xs, xs + first, sizeof(double) * (pushed - first));
+    memcpy(Ys, ys + first, sizeof(double) * (pushed - first));
+    if (MultiProducer) {
+        for (int i = 0; i < pushed; ++i)
+            Seqs[(start + i) & Mask].store(start + i + 1, std::memory_order_release);
+    }
+    else {
+        Head.store(start + pushed, std::memory_order_release);
+    }
+    return pushed;
+}
+
+int ImPlotRingBuffer::Snapshot() {
+    ImU64 head;
+    if (MultiProducer) {
+        // samples are published in order, up to the first reserved slot still being written
+        head = Head.load(std::memory_order_relaxed);
+        const ImU64 reserved = Reserved.load(std::memory_order_acquire);
+        while (head < reserved && Seqs[head & Mask].load(std::memory_order_acquire) == head + 1)
+            head++;
+        Head.store(head, std::memory_order_relaxed);
+    }
+    else {
+        head = Head.load(std::memory_order_acquire);
+    }
+    // releasing samples older than the history orders our reads of them before producers overwrite them
+    ImU64 tail = Tail.load(std::memory_order_relaxed);
+    if (head - tail > (ImU64)History) {
+        tail = head - History;
+        Tail.store(tail, std::memory_order_release);
+    }
+    SnapshotStart = tail;
+    SnapshotCount = (int)(head - tail);
+    SnapshotFrame = ImGui::GetCurrentContext() ? ImGui::GetFrameCount() : -1;
+    return SnapshotCount;
+}
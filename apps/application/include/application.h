@@ -40,6 +40,7 @@ typedef struct ApplicationWindowProperty
     bool center     {true};
     bool power_save {false};
     bool low_reflash {true};
+    bool damage_tracking {false};
     float max_fps   {30.f};
     float min_fps   {5.f};
     bool full_screen{false};
@@ -48,6 +48,12 @@ static void DropCallback(GLFWwindow*, int count, const char** paths)
     }
 }
 
+// add by Dicky for damage tracking, window content exposed, resized or lost: the next frame must be fully redrawn and presented
+static bool force_redraw = true;
+static void RefreshCallback(GLFWwindow*) { force_redraw = true; }
+static void FramebufferSizeCallback(GLFWwindow*, int, int) { force_redraw = true; }
+static void IconifyCallback(GLFWwindow*, int) { force_redraw = true; }
+
 void Application_FullScreen(bool on)
 {
     ImGui_ImplGlfw_FullScreen(ImGui::GetMainViewport(), on);
@@ -168,6 +174,7 @@ int main(int argc, char** argv)
     io.FontGlobalScale = 1.0f / property.font_scale;
     if (property.power_save) io.ConfigFlags |= ImGuiConfigFlags_EnablePowerSavingMode;
     if (property.low_reflash) io.ConfigFlags |= ImGuiConfigFlags_EnableLowRefreshMode;
+    if (property.damage_tracking && (property.power_save || property.low_reflash)) io.ConfigFlags |= ImGuiConfigFlags_EnableDamageTracking;
     ImGui::SetCustomFrameRate(property.max_fps, property.min_fps);
     if (property.navigator)
     {
@@ -262,6 +269,9 @@ int main(int argc, char** argv)
     
     glfwMakeContextCurrent(window);
     glfwSetDropCallback(window, DropCallback);
+    glfwSetWindowRefreshCallback(window, RefreshCallback);
+    glfwSetFramebufferSizeCallback(window, FramebufferSizeCallback);
+    glfwSetWindowIconifyCallback(window, IconifyCallback);
     glfwSwapInterval(1); // Enable vsync
 
     // Get/Set frame buffer scale
@@ -327,13 +337,20 @@ int main(int argc, char** argv)
         ImGui::EndFrame();
         // Rendering
         ImGui::Render();
-        glfwMakeContextCurrent(window);
-        int display_w, display_h;
-        glfwGetFramebufferSize(window, &display_w, &display_h);
-        glViewport(0, 0, display_w, display_h);
-        glClearColor(clear_color.x * clear_color.w, clear_color.y * clear_color.w, clear_color.z * clear_color.w, clear_color.w);
-        glClear(GL_COLOR_BUFFER_BIT);
-        ImGui_ImplOpenGL2_RenderDrawData(ImGui::GetDrawData());
+        // add by Dicky for damage tracking, nothing changed since last frame: keep presented image
+        ImDrawData* draw_data = ImGui::GetDrawData();
+        const bool main_damaged = force_redraw || !draw_data->DamageValid || draw_data->DamageRects.Size > 0;
+        force_redraw = false;
+        if (main_damaged)
+        {
+            glfwMakeContextCurrent(window);
+            int display_w, display_h;
+            glfwGetFramebufferSize(window, &display_w, &display_h);
+            glViewport(0, 0, display_w, display_h);
+            glClearColor(clear_color.x * clear_color.w, clear_color.y * clear_color.w, clear_color.z * clear_color.w, clear_color.w);
+            glClear(GL_COLOR_BUFFER_BIT);
+            ImGui_ImplOpenGL2_RenderDrawData(draw_data);
+        }
         // Update and Render additional Platform Windows
         // (Platform functions may change the current OpenGL context, so we save/restore it to make it easier to paste this code elsewhere.
         //  For this specific demo app we could also call glfwMakeContextCurrent(window) directly)
@@ -344,7 +361,8 @@ int main(int argc, char** argv)
             ImGui::RenderPlatformWindowsDefault();
             glfwMakeContextCurrent(backup_current_context);
         }
-        glfwSwapBuffers(window);
+        if (main_damaged)
+            glfwSwapBuffers(window);
     }
 
     if (property.application.Application_Finalize)
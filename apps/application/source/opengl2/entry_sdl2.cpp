@@ -205,6 +205,7 @@ int main(int argc, char** argv)
     io.FontGlobalScale = 1.0f / property.font_scale;
     if (property.power_save) io.ConfigFlags |= ImGuiConfigFlags_EnablePowerSavingMode;
     if (property.low_reflash) io.ConfigFlags |= ImGuiConfigFlags_EnableLowRefreshMode;
+    if (property.damage_tracking && (property.power_save || property.low_reflash)) io.ConfigFlags |= ImGuiConfigFlags_EnableDamageTracking;
     ImGui::SetCustomFrameRate(property.max_fps, property.min_fps);
     if (property.navigator)
     {
@@ -294,6 +295,7 @@ int main(int argc, char** argv)
     bool done = false;
     bool app_done = false;
     bool show = true;
+    bool force_redraw = true;
     while (!app_done)
     {
         ImGui::ImUpdateTextures();
@@ -320,6 +322,12 @@ int main(int argc, char** argv)
             {
                 show = true;
             }
+            if (event.type == SDL_WINDOWEVENT && event.window.windowID == SDL_GetWindowID(window) &&
+                (event.window.event == SDL_WINDOWEVENT_EXPOSED || event.window.event == SDL_WINDOWEVENT_SHOWN || event.window.event == SDL_WINDOWEVENT_RESTORED ||
+                 event.window.event == SDL_WINDOWEVENT_RESIZED || event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED))
+            {
+                force_redraw = true; // add by Dicky for damage tracking, window content exposed, resized or lost
+            }
             if (event.type == SDL_DROPFILE)
             {
                 // file path in event.drop.file
@@ -353,11 +361,18 @@ int main(int argc, char** argv)
 
         // Rendering
         ImGui::Render();
-        SDL_GL_MakeCurrent(window, gl_context);
-        glViewport(0, 0, (int)io.DisplaySize.x, (int)io.DisplaySize.y);
-        glClearColor(clear_color.x * clear_color.w, clear_color.y * clear_color.w, clear_color.z * clear_color.w, clear_color.w);
-        glClear(GL_COLOR_BUFFER_BIT);
-        ImGui_ImplOpenGL2_RenderDrawData(ImGui::GetDrawData());
+        // add by Dicky for damage tracking, nothing changed since last frame: keep presented image
+        ImDrawData* draw_data = ImGui::GetDrawData();
+        const bool main_damaged = force_redraw || !draw_data->DamageValid || draw_data->DamageRects.Size > 0;
+        force_redraw = false;
+        if (main_damaged)
+        {
+            SDL_GL_MakeCurrent(window, gl_context);
+            glViewport(0, 0, (int)io.DisplaySize.x, (int)io.DisplaySize.y);
+            glClearColor(clear_color.x * clear_color.w, clear_color.y * clear_color.w, clear_color.z * clear_color.w, clear_color.w);
+            glClear(GL_COLOR_BUFFER_BIT);
+            ImGui_ImplOpenGL2_RenderDrawData(draw_data);
+        }
         // Update and Render additional Platform Windows
         // (Platform functions may change the current OpenGL context, so we save/restore it to make it easier to paste this code elsewhere.
         //  For this specific demo app we could also call SDL_GL_MakeCurrent(window, gl_context) directly)
@@ -369,7 +384,8 @@ int main(int argc, char** argv)
             ImGui::RenderPlatformWindowsDefault();
             SDL_GL_MakeCurrent(backup_current_window, backup_current_context);
         }
-        SDL_GL_SwapWindow(window);
+        if (main_damaged)
+            SDL_GL_SwapWindow(window);
     }
 
     if (property.application.Application_Finalize)
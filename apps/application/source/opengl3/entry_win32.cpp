@@ -27,6 +27,7 @@
 // Data
 static HDC                      g_HDC = NULL;
 static HGLRC                    g_HGLRC = NULL;
+static bool                     g_ForceRedraw = true; // add by Dicky for damage tracking, window content exposed, resized or lost
 bool CreateGLContext(HWND hWnd)
 {
     // Setup pixelformat descriptor
@@ -81,8 +82,12 @@ LRESULT WINAPI WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
         case WM_SIZE:
             if (wParam != SIZE_MINIMIZED)
             {
+                g_ForceRedraw = true;
             }
             return 0;
+        case WM_PAINT:
+            g_ForceRedraw = true;
+            break;
         case WM_SYSCOMMAND:
             if ((wParam & 0xfff0) == SC_KEYMENU) // Disable ALT application menu
                 return 0;
@@ -188,6 +193,7 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
     io.FontGlobalScale = 1.0f / property.font_scale;
     if (property.power_save) io.ConfigFlags |= ImGuiConfigFlags_EnablePowerSavingMode;
     if (property.low_reflash) io.ConfigFlags |= ImGuiConfigFlags_EnableLowRefreshMode;
+    if (property.damage_tracking && (property.power_save || property.low_reflash)) io.ConfigFlags |= ImGuiConfigFlags_EnableDamageTracking;
     ImGui::SetCustomFrameRate(property.max_fps, property.min_fps);
     if (property.navigator)
     {
@@ -286,8 +292,15 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
 
         // Rendering
         ImGui::Render();
-        ImGui_ImplOpenGL3_ClearScreen(ImVec2(0, 0), io.DisplaySize, clear_color);
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        // add by Dicky for damage tracking, nothing changed since last frame: keep presented image
+        ImDrawData* draw_data = ImGui::GetDrawData();
+        const bool main_damaged = g_ForceRedraw || !draw_data->DamageValid || draw_data->DamageRects.Size > 0;
+        g_ForceRedraw = false;
+        if (main_damaged)
+        {
+            ImGui_ImplOpenGL3_ClearScreen(ImVec2(0, 0), io.DisplaySize, clear_color);
+            ImGui_ImplOpenGL3_RenderDrawData(draw_data);
+        }
 
         // Update and Render additional Platform Windows
         if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
@@ -298,7 +311,8 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
             wglMakeCurrent(g_HDC, backup_context);
         }
 
-        SwapBuffers(g_HDC);
+        if (main_damaged)
+            SwapBuffers(g_HDC);
     }
 
     if (property.application.Application_Finalize)
@@ -1121,11 +1121,12 @@ static void             BeginLayout(ImGuiID id, ImGuiLayoutType type, ImVec2 siz
 static void             EndLayout(ImGuiLayoutType type);
 static void             PushLayout(ImGuiLayout* layout);
 static void             PopLayout(ImGuiLayout* layout);
-static void             BalanceLayoutSprings(ImGuiLayout& layout);
+static void             BalanceLayoutSprings(ImGuiLayout& layout, bool translate_items = true);
 static ImVec2           BalanceLayoutItemAlignment(ImGuiLayout& layout, ImGuiLayoutItem& item);
 static void             BalanceLayoutItemsAlignment(ImGuiLayout& layout);
 static void             BalanceChildLayouts(ImGuiLayout& layout);
 static ImVec2           CalculateLayoutSize(ImGuiLayout& layout, bool collapse_springs);
+static ImGuiID          CalculateLayoutItemsHash(ImGuiLayout& layout);
 static ImGuiLayoutItem* GenerateLayoutItem(ImGuiLayout& layout, ImGuiLayoutItemType type);
 static float            CalculateLayoutItemAlignmentOffset(ImGuiLayout& layout, ImGuiLayoutItem& item);
 static void             TranslateLayoutItem(ImGuiLayoutItem& item, const ImVec2& offset);
@@ -1192,7 +1193,7 @@ static void             UpdateViewportPlatformMonitor(ImGuiViewportP* viewport);
 //   - If you need a finite number of contexts, you may compile and use multiple instances of the ImGui code from a different namespace.
 // - DLL users: read comments above.
 #ifndef GImGui
-ImGuiContext*   GImGui = NULL;
+IMGUI_CONTEXT_STORAGE ImGuiContext*   GImGui = NULL; // modify by Dicky
 #endif
 
 // Memory Allocator functions. Use SetAllocatorFunctions() to change them.
@@ -1379,6 +1380,7 @@ ImGuiIO::ImGuiIO()
     // Add by Dicky
     ConfigFlippedMouseWheelAxisX = false;
     ConfigFlippedMouseWheelAxisY = false;
+    ConfigProfilerEnabled = false;
     // Add by Dicky end
 
     // Platform Functions
@@ -4846,6 +4848,13 @@ void ImGui::NewFrame()
     IM_ASSERT(GImGui != NULL && "No current context. Did you call ImGui::CreateContext() and ImGui::SetCurrentContext() ?");
     ImGuiContext& g = *GImGui;
 
+    // add by Dicky for frame profiler
+#if IMGUI_ENABLE_PROFILER
+    ProfilerNewFrame();
+#endif
+    IMGUI_PROFILER_SCOPE(ImGuiProfilerPhase_NewFrame, NULL, 0);
+    // add by Dicky end
+
     // Remove pending delete hooks before frame start.
     // This deferred removal avoid issues of removal while iterating the hook vector
     for (int n = g.Hooks.Size - 1; n >= 0; n--)
@@ -5238,6 +5247,208 @@ static void InitViewportDrawData(ImGuiViewportP* viewport)
     draw_data->OwnerViewport = viewport;
 }
 
+// add by Dicky for damage tracking
+// Hash 32 bytes at a time over 4 independent lanes (ImHashData() is a bytewise CRC32, too slow to run on every vertex each frame)
+static ImU64 DamageHashData(const void* data, size_t size, ImU64 seed)
+{
+    const ImU64 prime = 0x100000001B3ULL;
+    ImU64 h0 = seed, h1 = seed ^ 0x9E3779B97F4A7C15ULL, h2 = seed ^ 0xC2B2AE3D27D4EB4FULL, h3 = seed ^ 0x165667B19E3779F9ULL;
+    const unsigned char* p = (const unsigned char*)data;
+    size_t n = 0;
+    for (; n + 32 <= size; n += 32)
+    {
+        ImU64 w[4];
+        memcpy(w, p + n, 32);
+        h0 = (h0 ^ w[0]) * prime;
+        h1 = (h1 ^ w[1]) * prime;
+        h2 = (h2 ^ w[2]) * prime;
+        h3 = (h3 ^ w[3]) * prime;
+    }
+    ImU64 r = (h0 ^ (h1 >> 7)) * prime ^ (h2 ^ (h3 >> 13)) ^ (ImU64)size;
+    for (; n < size; n++)
+        r = (r ^ p[n]) * prime;
+    return r ^ (r >> 29);
+}
+
+// Add a rectangle to the damage list, merging overlapping ones
+static void DamageAddRect(ImVector<ImVec4>& rects, ImRect r, const ImRect& display_rect)
+{
+    r.ClipWithFull(display_rect);
+    if (r.Min.x >= r.Max.x || r.Min.y >= r.Max.y)
+        return;
+    r.Min = ImFloor(r.Min);
+    r.Max = ImFloor(r.Max + ImVec2(1.0f, 1.0f)); // Cover partially touched pixels
+    for (int n = 0; n < rects.Size; )
+    {
+        ImRect other(rects[n]);
+        if (other.Overlaps(r))
+        {
+            r.Add(other);
+            rects.erase(rects.Data + n);
+            n = 0; // Grown rectangle may now overlap previous ones
+            continue;
+        }
+        n++;
+    }
+    if (rects.Size >= IMGUI_DAMAGE_RECTS_MAX)
+    {
+        for (const ImVec4& other : rects)
+            r.Add(ImRect(other));
+        rects.resize(0);
+    }
+    rects.push_back(r.ToVec4());
+}
+
+// Compare the output of every ImDrawCmd with the previous frame and fill ImDrawData::DamageRects
+static void UpdateViewportDamage(ImGuiViewportP* viewport)
+{
+    ImGuiContext& g = *GImGui;
+    ImDrawData* draw_data = &viewport->DrawDataP;
+    const ImRect display_rect(draw_data->DisplayPos, draw_data->DisplayPos + draw_data->DisplaySize);
+    bool valid = viewport->DamageLastFrame == g.FrameCount - 1 && viewport->DamageLastDisplayRect.ToVec4() == display_rect.ToVec4() && viewport->DamageLastFramebufferScale == draw_data->FramebufferScale;
+    viewport->DamageLastFrame = g.FrameCount;
+    viewport->DamageLastDisplayRect = display_rect;
+    viewport->DamageLastFramebufferScale = draw_data->FramebufferScale;
+
+    ImVector<ImGuiDamageSignature>& curr = viewport->DamageSignatures;
+    ImVector<ImGuiDamageSignature>& prev = viewport->DamageSignaturesPrev;
+    ImVector<ImGuiDamageDrawList>& curr_lists = viewport->DamageDrawLists;
+    ImVector<ImGuiDamageDrawList>& prev_lists = viewport->DamageDrawListsPrev;
+    curr.swap(prev);
+    curr_lists.swap(prev_lists);
+    curr.resize(0);
+    curr_lists.resize(0);
+    draw_data->DamageRects.resize(0);
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        // Hash the whole draw list first: unchanged ones (idle windows) reuse last frame signatures without scanning their commands
+        ImU64 list_hash = DamageHashData(draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.size_in_bytes(), 0);
+        list_hash = DamageHashData(draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.size_in_bytes(), list_hash);
+        for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+        {
+            const ImU32 offsets[3] = { cmd.VtxOffset, cmd.IdxOffset, cmd.ElemCount };
+            list_hash = DamageHashData(&cmd.ClipRect, sizeof(cmd.ClipRect), list_hash);
+            list_hash = DamageHashData(&cmd.TextureId, sizeof(cmd.TextureId), list_hash);
+            list_hash = DamageHashData(offsets, sizeof(offsets), list_hash);
+            if (cmd.UserCallback != NULL)
+                valid = false; // We can't tell what a callback renders
+        }
+
+        ImGuiDamageDrawList list_entry;
+        list_entry.DrawList = draw_list;
+        list_entry.Hash = list_hash;
+        list_entry.SigOffset = curr.Size;
+        const ImGuiDamageDrawList* prev_list_entry = NULL;
+        for (const ImGuiDamageDrawList& entry : prev_lists)
+            if (entry.DrawList == draw_list && entry.Hash == list_hash)
+            {
+                prev_list_entry = &entry;
+                break;
+            }
+        if (prev_list_entry != NULL)
+        {
+            for (int n = 0; n < prev_list_entry->SigCount; n++)
+            {
+                curr.push_back(prev[prev_list_entry->SigOffset + n]);
+                curr.back().Vtx = NULL; // Bounds are already known
+            }
+        }
+        else
+        {
+            const ImDrawVert* vtx_buffer = draw_list->VtxBuffer.Data;
+            for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+            {
+                if (cmd.UserCallback != NULL || cmd.ElemCount == 0)
+                    continue;
+
+                // Vertices used by a command are contiguous. Commands are made of triangles, scan 3 indices at a time to shorten dependency chains.
+                const ImDrawIdx* idx = draw_list->IdxBuffer.Data + cmd.IdxOffset;
+                ImDrawIdx min0 = idx[0], min1 = idx[0], min2 = idx[0], max0 = idx[0], max1 = idx[0], max2 = idx[0];
+                unsigned int n = 0;
+                for (; n + 3 <= cmd.ElemCount; n += 3)
+                {
+                    min0 = ImMin(min0, idx[n + 0]); max0 = ImMax(max0, idx[n + 0]);
+                    min1 = ImMin(min1, idx[n + 1]); max1 = ImMax(max1, idx[n + 1]);
+                    min2 = ImMin(min2, idx[n + 2]); max2 = ImMax(max2, idx[n + 2]);
+                }
+                for (; n < cmd.ElemCount; n++)
+                {
+                    min0 = ImMin(min0, idx[n]); max0 = ImMax(max0, idx[n]);
+                }
+                const ImDrawIdx vtx_min = ImMin(min0, ImMin(min1, min2));
+                const ImDrawIdx vtx_max = ImMax(max0, ImMax(max1, max2));
+
+                ImGuiDamageSignature sig;
+                sig.Vtx = vtx_buffer + cmd.VtxOffset + vtx_min;
+                sig.VtxCount = (int)(vtx_max - vtx_min) + 1;
+                sig.ClipRect = ImRect(cmd.ClipRect);
+                sig.Hash = DamageHashData(&cmd.ClipRect, sizeof(cmd.ClipRect), cmd.ElemCount);
+                sig.Hash = DamageHashData(&cmd.TextureId, sizeof(cmd.TextureId), sig.Hash);
+                sig.Hash = DamageHashData(sig.Vtx, (size_t)sig.VtxCount * sizeof(ImDrawVert), sig.Hash);
+                curr.push_back(sig);
+            }
+        }
+        list_entry.SigCount = curr.Size - list_entry.SigOffset;
+        curr_lists.push_back(list_entry);
+    }
+
+    // Match the two frames in draw order: a pixel only keeps its value if the commands covering it are the same and drawn in the same order,
+    // so a command that moved relative to others (z-order or focus change between windows with identical content) must be damaged too.
+    // Any order-preserving matching is correct, unmatched commands are damaged: new content drawn, or old content to erase.
+    // Bounds are only computed for new commands, matched ones inherit them from the previous frame.
+    int curr_begin = 0, prev_begin = 0, curr_end = curr.Size, prev_end = prev.Size;
+    while (curr_begin < curr_end && prev_begin < prev_end && curr[curr_begin].Hash == prev[prev_begin].Hash)
+    {
+        curr[curr_begin].Bounds = prev[prev_begin].Bounds;
+        curr[curr_begin++].Vtx = NULL;
+        prev_begin++;
+    }
+    while (curr_begin < curr_end && prev_begin < prev_end && curr[curr_end - 1].Hash == prev[prev_end - 1].Hash)
+    {
+        curr[--curr_end].Bounds = prev[--prev_end].Bounds;
+        curr[curr_end].Vtx = NULL;
+    }
+    int i = curr_begin, j = prev_begin;
+    while (i < curr_end || j < prev_end)
+    {
+        // Within the changed range, pair commands at the same position when both frames have as many left (e.g. an animated widget),
+        // otherwise drop commands from the longer side until they realign.
+        const int curr_left = curr_end - i, prev_left = prev_end - j;
+        const bool take_curr = curr_left > 0 && curr_left >= prev_left;
+        const bool take_prev = prev_left > 0 && prev_left >= curr_left;
+        if (take_curr && take_prev && curr[i].Hash == prev[j].Hash)
+        {
+            curr[i].Bounds = prev[j].Bounds;
+            curr[i++].Vtx = NULL;
+            j++;
+            continue;
+        }
+        if (take_curr)
+        {
+            ImGuiDamageSignature* sig = &curr[i++];
+            if (sig->Vtx != NULL)
+            {
+                ImRect bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+                for (int n = 0; n < sig->VtxCount; n++)
+                    bounds.Add(sig->Vtx[n].pos);
+                bounds.ClipWithFull(sig->ClipRect);
+                sig->Bounds = bounds;
+                sig->Vtx = NULL;
+            }
+            if (valid)
+                DamageAddRect(draw_data->DamageRects, sig->Bounds, display_rect);
+        }
+        if (take_prev)
+        {
+            if (valid)
+                DamageAddRect(draw_data->DamageRects, prev[j].Bounds, display_rect);
+            j++;
+        }
+    }
+    draw_data->DamageValid = valid;
+}
+// add by Dicky end
+
 // Push a clipping rectangle for both ImGui logic (hit-testing etc.) and low-level ImDrawList rendering.
 // - When using this function it is sane to ensure that float are perfectly rounded to integer values,
 //   so that e.g. (int)(max.x-min.x) in user's render produce correct result.
@@ -5391,6 +5602,7 @@ void ImGui::EndFrame()
     if (g.FrameCountEnded == g.FrameCount)
         return;
     IM_ASSERT(g.WithinFrameScope && "Forgot to call ImGui::NewFrame()?");
+    IMGUI_PROFILER_SCOPE(ImGuiProfilerPhase_EndFrame, NULL, 0); // add by Dicky for frame profiler
 
     CallContextHooks(&g, ImGuiContextHookType_EndFramePre);
 
@@ -5505,6 +5717,7 @@ void ImGui::Render()
     if (g.FrameCountRendered == g.FrameCount)
         return;
     g.FrameCountRendered = g.FrameCount;
+    IMGUI_PROFILER_BEGIN(ImGuiProfilerPhase_Render, 0); // add by Dicky for frame profiler
 
     g.IO.MetricsRenderWindows = 0;
     CallContextHooks(&g, ImGuiContextHookType_RenderPre);
@@ -5521,6 +5734,7 @@ void ImGui::Render()
     RenderDimmedBackgrounds();
 
     // Add ImDrawList to render
+    IMGUI_PROFILER_BEGIN(ImGuiProfilerPhase_DrawData, 0); // add by Dicky for frame profiler
     ImGuiWindow* windows_to_render_top_most[2];
     windows_to_render_top_most[0] = (g.NavWindowingTarget && !(g.NavWindowingTarget->Flags & ImGuiWindowFlags_NoBringToFrontOnFocus)) ? g.NavWindowingTarget->RootWindowDockTree : NULL;
     windows_to_render_top_most[1] = (g.NavWindowingTarget ? g.NavWindowingListWindow : NULL);
@@ -5533,6 +5747,7 @@ void ImGui::Render()
     for (int n = 0; n < IM_ARRAYSIZE(windows_to_render_top_most); n++)
         if (windows_to_render_top_most[n] && IsWindowActiveAndVisible(windows_to_render_top_most[n])) // NavWindowingTarget is always temporarily displayed as the top-most window
             AddRootWindowToDrawData(windows_to_render_top_most[n]);
+    IMGUI_PROFILER_END(); // add by Dicky for frame profiler
 
     // Draw software mouse cursor if requested by io.MouseDrawCursor flag
     if (g.IO.MouseDrawCursor && g.MouseCursor != ImGuiMouseCursor_None)
@@ -5542,6 +5757,7 @@ void ImGui::Render()
         RenderMouseCursor(g.IO.MousePos, g.Style.MouseCursorScale, g.MouseCursor, IM_COL32_WHITE, IM_COL32_BLACK, IM_COL32(0, 0, 0, 48));
     // add by Dicky end
     // Setup ImDrawData structures for end-user
+    IMGUI_PROFILER_BEGIN(ImGuiProfilerPhase_DrawData, 0); // add by Dicky for frame profiler
     g.IO.MetricsRenderVertices = g.IO.MetricsRenderIndices = 0;
     for (ImGuiViewportP* viewport : g.Viewports)
     {
@@ -5559,9 +5775,24 @@ void ImGui::Render()
 
         g.IO.MetricsRenderVertices += draw_data->TotalVtxCount;
         g.IO.MetricsRenderIndices += draw_data->TotalIdxCount;
+
+        // add by Dicky for damage tracking
+        if (g.IO.ConfigFlags & ImGuiConfigFlags_EnableDamageTracking)
+            UpdateViewportDamage(viewport);
+        else
+            draw_data->DamageValid = false;
+        // add by Dicky end
     }
+    IMGUI_PROFILER_END(); // add by Dicky for frame profiler
 
     CallContextHooks(&g, ImGuiContextHookType_RenderPost);
+
+    // add by Dicky for frame profiler
+    IMGUI_PROFILER_END();
+#if IMGUI_ENABLE_PROFILER
+    ProfilerEndFrame();
+#endif
+    // add by Dicky end
 }
 
 // Add by Dicky for force reflash screen in power saving mode
@@ -6940,12 +7171,14 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
     IM_ASSERT(name != NULL && name[0] != '\0');     // Window name required
     IM_ASSERT(g.WithinFrameScope);                  // Forgot to call ImGui::NewFrame()
     IM_ASSERT(g.FrameCountEnded != g.FrameCount);   // Called ImGui::Render() or ImGui::EndFrame() and haven't called ImGui::NewFrame() again yet
+    IMGUI_PROFILER_SCOPE(ImGuiProfilerPhase_WindowBegin, NULL, 0); // add by Dicky for frame profiler
 
     // Find or create
     ImGuiWindow* window = FindWindowByName(name);
     const bool window_just_created = (window == NULL);
     if (window_just_created)
         window = CreateNewWindow(name, flags);
+    IMGUI_PROFILER_SET_ID(window->ID); // add by Dicky for frame profiler
 
     // Automatically disable manual moving/resizing when NoInputs is set
     if ((flags & ImGuiWindowFlags_NoInputs) == ImGuiWindowFlags_NoInputs)
@@ -7686,6 +7919,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
             ImGuiLayout* layout = (ImGuiLayout*)window->DC.Layouts.Data[i].val_p;
             layout->Live = false;
         }
+        window->DC.LayoutsOrderIdx = 0;
         // Add By Dicky end
 
         // [DEBUG]
@@ -7801,6 +8035,7 @@ void ImGui::End()
 {
     ImGuiContext& g = *GImGui;
     ImGuiWindow* window = g.CurrentWindow;
+    IMGUI_PROFILER_SCOPE(ImGuiProfilerPhase_WindowEnd, NULL, window ? window->ID : 0); // add by Dicky for frame profiler
 
     // Error checking: verify that user hasn't called End() too many times!
     if (g.CurrentWindowStack.Size <= 1 && g.WithinFrameScopeWithImplicitWindow)
@@ -19680,8 +19915,14 @@ static ImGuiLayout* ImGui::FindLayout(ImGuiID id, ImGuiLayoutType type)
 {
     IM_ASSERT(type == ImGuiLayoutType_Horizontal || type == ImGuiLayoutType_Vertical);
 
+    // Layouts are usually submitted in the same order every frame, try last frame order before searching storage.
     ImGuiWindow* window = GetCurrentWindow();
-    ImGuiLayout* layout = (ImGuiLayout*)window->DC.Layouts.GetVoidPtr(id);
+    ImGuiLayout* layout = NULL;
+    const int order_idx = window->DC.LayoutsOrderIdx;
+    if (order_idx < window->DC.LayoutsOrder.Size && window->DC.LayoutsOrder[order_idx]->Id == id)
+        layout = window->DC.LayoutsOrder[order_idx];
+    else
+        layout = (ImGuiLayout*)window->DC.Layouts.GetVoidPtr(id);
     if (!layout)
         return NULL;
 
@@ -19690,6 +19931,7 @@ static ImGuiLayout* ImGui::FindLayout(ImGuiID id, ImGuiLayoutType type)
         layout->Type = type;
         layout->MinimumSize = ImVec2(0.0f, 0.0f);
         layout->Items.clear();
+        layout->SpringsValid = false;
     }
 
     return layout;
@@ -19712,6 +19954,7 @@ static ImGuiLayout* ImGui::CreateNewLayout(ImGuiID id, ImGuiLayoutType type, ImV
 static void ImGui::BeginLayout(ImGuiID id, ImGuiLayoutType type, ImVec2 size, float align)
 {
     ImGuiWindow* window = GetCurrentWindow();
+    IMGUI_PROFILER_SCOPE(ImGuiProfilerPhase_StackLayout, NULL, id); // add by Dicky for frame profiler
 
     PushID(id);
 
@@ -19720,6 +19963,12 @@ static void ImGui::BeginLayout(ImGuiID id, ImGuiLayoutType type, ImVec2 size, fl
     if (!layout)
         layout = CreateNewLayout(id, type, size);
 
+    if (window->DC.LayoutsOrderIdx < window->DC.LayoutsOrder.Size)
+        window->DC.LayoutsOrder[window->DC.LayoutsOrderIdx] = layout;
+    else
+        window->DC.LayoutsOrder.push_back(layout);
+    window->DC.LayoutsOrderIdx++;
+
     layout->Live = true;
 
     PushLayout(layout);
@@ -19737,6 +19986,21 @@ static void ImGui::BeginLayout(ImGuiID id, ImGuiLayoutType type, ImVec2 size, fl
 
     layout->CurrentSize.x = layout->Size.x > 0.0f ? layout->Size.x : layout->MinimumSize.x;
     layout->CurrentSize.y = layout->Size.y > 0.0f ? layout->Size.y : layout->MinimumSize.y;
+    layout->AlignExtent = (type == ImGuiLayoutType_Horizontal) ? layout->CurrentSize.y : layout->CurrentSize.x;
+
+    // Solve springs against this frame available space before items are submitted, using item sizes measured last frame.
+    // Items are placed (and hit-tested) at their final position in the same frame unless their own sizes change,
+    // in which case EndLayout() still corrects them. A nested layout spans its parent like in EndLayout().
+    const ImVec2 current_size = layout->CurrentSize;
+    if (layout->Parent != NULL)
+    {
+        if (type == ImGuiLayoutType_Horizontal && layout->Size.x <= 0.0f && layout->Parent->CurrentSize.x > 0)
+            layout->CurrentSize.x = layout->Parent->CurrentSize.x;
+        else if (type == ImGuiLayoutType_Vertical && layout->Size.y <= 0.0f && layout->Parent->CurrentSize.y > 0)
+            layout->CurrentSize.y = layout->Parent->CurrentSize.y;
+    }
+    BalanceLayoutSprings(*layout, false);
+    layout->CurrentSize = current_size;
 
     layout->StartPos = window->DC.CursorPos;
     layout->StartCursorMaxPos = window->DC.CursorMaxPos;
@@ -19763,6 +20027,7 @@ static void ImGui::EndLayout(ImGuiLayoutType type)
     IM_ASSERT(window->DC.CurrentLayout->Type == type);
 
     ImGuiLayout* layout = window->DC.CurrentLayout;
+    IMGUI_PROFILER_SCOPE(ImGuiProfilerPhase_StackLayout, NULL, layout->Id); // add by Dicky for frame profiler
 
     EndLayoutItem(*layout);
 
@@ -19784,6 +20049,7 @@ static void ImGui::EndLayout(ImGuiLayoutType type)
         new_size.y = layout->CurrentSize.y;
 
     ImVec2 new_minimum_size = CalculateLayoutSize(*layout, true);
+    layout->ItemsHash = CalculateLayoutItemsHash(*layout);
 
     if (new_minimum_size.x != layout->MinimumSize.x || new_minimum_size.y != layout->MinimumSize.y)
     {
@@ -19886,6 +20152,37 @@ static ImVec2 ImGui::CalculateLayoutSize(ImGuiLayout& layout, bool collapse_spri
     return bounds;
 }
 
+// Mix one value into a layout hash a word at a time (ImHashData() is a bytewise CRC32, too slow to run on every item each frame)
+static inline ImGuiID LayoutHashFloat(ImGuiID hash, float value)
+{
+    ImU32 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    hash = (hash ^ bits) * 0x9E3779B1u;
+    return hash ^ (hash >> 15);
+}
+
+// Spring sizes only depend on what is hashed here and on the free space, see BalanceLayoutSprings().
+static ImGuiID ImGui::CalculateLayoutItemsHash(ImGuiLayout& layout)
+{
+    const bool is_horizontal = (layout.Type == ImGuiLayoutType_Horizontal);
+    ImGuiID hash = (ImGuiID)layout.Type * 0x85EBCA6Bu + (ImGuiID)layout.Items.Size;
+    for (int i = 0; i < layout.Items.Size; i++)
+    {
+        ImGuiLayoutItem& item = layout.Items[i];
+        if (item.Type == ImGuiLayoutItemType_Item)
+        {
+            hash = LayoutHashFloat(hash, is_horizontal ? item.MeasuredBounds.GetWidth() : item.MeasuredBounds.GetHeight());
+        }
+        else
+        {
+            hash = LayoutHashFloat(hash, -1.0f); // Keep item types apart
+            hash = LayoutHashFloat(hash, item.SpringSpacing);
+            hash = LayoutHashFloat(hash, item.SpringWeight);
+        }
+    }
+    return hash;
+}
+
 static void ImGui::PushLayout(ImGuiLayout* layout)
 {
     ImGuiWindow* window = GetCurrentWindow();
@@ -19934,9 +20231,23 @@ static void ImGui::PopLayout(ImGuiLayout* layout)
     }
 }
 
-static void ImGui::BalanceLayoutSprings(ImGuiLayout& layout)
+static void ImGui::BalanceLayoutSprings(ImGuiLayout& layout, bool translate_items)
 {
-    // Accumulate amount of occupied space and springs weights
+    // Determine occupied space and available space depending on layout type
+    const bool  is_horizontal   = (layout.Type == ImGuiLayoutType_Horizontal);
+    const bool  is_auto_sized   = ((is_horizontal ? layout.Size.x : layout.Size.y) <= 0.0f) && (layout.Parent == NULL);
+    const float occupied_space  = is_horizontal ? layout.MinimumSize.x : layout.MinimumSize.y;
+    const float available_space = is_auto_sized ? occupied_space : (is_horizontal ? layout.CurrentSize.x : layout.CurrentSize.y);
+    const float free_space      = ImMax(available_space - occupied_space, 0.0f);
+
+    // Spring sizes only depend on items and free space, keep them if the layout was already balanced against both.
+    if (layout.SpringsValid && layout.SpringsItemsHash == layout.ItemsHash && layout.SpringsFreeSpace == free_space)
+        return;
+    layout.SpringsValid = true;
+    layout.SpringsItemsHash = layout.ItemsHash;
+    layout.SpringsFreeSpace = free_space;
+
+    // Accumulate springs weights
     float total_spring_weight = 0.0f;
 
     int last_spring_item_index = -1;
@@ -19950,13 +20261,6 @@ static void ImGui::BalanceLayoutSprings(ImGuiLayout& layout)
         }
     }
 
-    // Determine occupied space and available space depending on layout type
-    const bool  is_horizontal   = (layout.Type == ImGuiLayoutType_Horizontal);
-    const bool  is_auto_sized   = ((is_horizontal ? layout.Size.x : layout.Size.y) <= 0.0f) && (layout.Parent == NULL);
-    const float occupied_space  = is_horizontal ? layout.MinimumSize.x : layout.MinimumSize.y;
-    const float available_space = is_auto_sized ? occupied_space : (is_horizontal ? layout.CurrentSize.x : layout.CurrentSize.y);
-    const float free_space      = ImMax(available_space - occupied_space, 0.0f);
-
     float span_start     = 0.0f;
     float current_weight = 0.0f;
     for (int i = 0; i < layout.Items.Size; i++)
@@ -19982,7 +20286,7 @@ static void ImGui::BalanceLayoutSprings(ImGuiLayout& layout)
         }
 
         // If spring changed its size, fix positioning of following items to avoid one frame visual bugs.
-        if (last_spring_size != item.SpringSize)
+        if (translate_items && last_spring_size != item.SpringSize)
         {
             float difference = item.SpringSize - last_spring_size;
 
@@ -20052,6 +20356,7 @@ static bool HasAnyNonZeroSpring(ImGuiLayout& layout)
 
 static void ImGui::BalanceChildLayouts(ImGuiLayout& layout)
 {
+    bool items_resized = false;
     for (ImGuiLayout* child = layout.FirstChild; child != NULL; child = child->NextSibling)
     {
         //ImVec2 child_layout_size = child->CurrentSize;
@@ -20081,16 +20386,27 @@ static void ImGui::BalanceChildLayouts(ImGuiLayout& layout)
         {
             // Expand item measured bounds to make alignment correct.
             ImGuiLayoutItem& item = layout.Items[child->ParentItemIndex];
+            const ImVec2 item_max = item.MeasuredBounds.Max;
 
             if (child->Type == ImGuiLayoutType_Horizontal && child->Size.x <= 0.0f)
                 item.MeasuredBounds.Max.x = ImMax(item.MeasuredBounds.Max.x, item.MeasuredBounds.Min.x + layout.CurrentSize.x);
             else if (child->Type == ImGuiLayoutType_Vertical && child->Size.y <= 0.0f)
                 item.MeasuredBounds.Max.y = ImMax(item.MeasuredBounds.Max.y, item.MeasuredBounds.Min.y + layout.CurrentSize.y);
+
+            if (item.MeasuredBounds.Max.x != item_max.x || item.MeasuredBounds.Max.y != item_max.y)
+                items_resized = true;
         }
     }
 
     BalanceLayoutSprings(layout);
-    BalanceLayoutItemsAlignment(layout);
+
+    // Items were already aligned in EndLayoutItem(), only redo it when layout or item sizes changed since then.
+    const float align_extent = (layout.Type == ImGuiLayoutType_Horizontal) ? layout.CurrentSize.y : layout.CurrentSize.x;
+    if (items_resized || layout.AlignExtent != align_extent)
+    {
+        BalanceLayoutItemsAlignment(layout);
+        layout.AlignExtent = align_extent;
+    }
 }
 
 static ImGuiLayoutItem* ImGui::GenerateLayoutItem(ImGuiLayout& layout, ImGuiLayoutItemType type)
@@ -20102,11 +20418,15 @@ static ImGuiLayoutItem* ImGui::GenerateLayoutItem(ImGuiLayout& layout, ImGuiLayo
     {
         ImGuiLayoutItem& item = layout.Items[layout.CurrentItemIndex];
         if (item.Type != type)
+        {
             item = ImGuiLayoutItem(type);
+            layout.SpringsValid = false;
+        }
     }
     else
     {
         layout.Items.push_back(ImGuiLayoutItem(type));
+        layout.SpringsValid = false;
     }
 
     g.CurrentWindow->DC.CurrentLayoutItem = &layout.Items[layout.CurrentItemIndex];
@@ -20462,6 +20782,409 @@ double ImGui::GetEventWaitingTime()
 }
 // Add By Dicky end
 
+// Add By Dicky for frame profiler
+static const char* GProfilerPhaseNames[ImGuiProfilerPhase_COUNT] = { "NewFrame", "EndFrame", "WindowBegin", "WindowEnd", "StackLayout", "TableLayout", "Text", "Render", "DrawData", "User" };
+
+const char* ImGui::ProfilerGetPhaseName(ImGuiProfilerPhase phase)
+{
+    IM_ASSERT(phase >= 0 && phase < ImGuiProfilerPhase_COUNT);
+    return GProfilerPhaseNames[phase];
+}
+
+#if IMGUI_ENABLE_PROFILER
+static inline ImU64 ProfilerGetTicks()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void ImGui::ProfilerNewFrame()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiProfiler& profiler = g.Profiler;
+    if (profiler.FrameActive)
+        ProfilerEndFrame(); // Render() wasn't called last frame
+    if (!g.IO.ConfigProfilerEnabled || profiler.Paused)
+        return;
+
+    profiler.FrameIdx = (profiler.FrameIdx + 1) % IMGUI_PROFILER_HISTORY;
+    ImGuiProfilerFrame& frame = profiler.Frames[profiler.FrameIdx];
+    frame.FrameCount = g.FrameCount + 1;
+    frame.Start = ProfilerGetTicks();
+    frame.End = 0;
+    memset(frame.PhaseTicks, 0, sizeof(frame.PhaseTicks));
+    frame.DroppedEvents = 0;
+    frame.Events.resize(0);
+    if (profiler.TimeOrigin == 0)
+        profiler.TimeOrigin = frame.Start;
+    profiler.Stack.resize(0);
+    profiler.FrameActive = true;
+}
+
+void ImGui::ProfilerEndFrame()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiProfiler& profiler = g.Profiler;
+    if (!profiler.FrameActive)
+        return;
+    while (profiler.Stack.Size > 0) // Close unbalanced user scopes
+        ProfilerEndScope();
+    ImGuiProfilerFrame& frame = profiler.Frames[profiler.FrameIdx];
+    frame.End = ProfilerGetTicks();
+    profiler.FrameActive = false;
+
+    g.IO.MetricsProfilerFrameTime = frame.GetDuration();
+    for (int n = 0; n < ImGuiProfilerPhase_COUNT; n++)
+        g.IO.MetricsProfilerPhaseTime[n] = frame.GetPhaseTime(n);
+}
+
+void ImGui::ProfilerBeginScope(ImGuiProfilerPhase phase, const char* name, ImGuiID id)
+{
+    ImGuiContext* ctx = GImGui;
+    if (ctx == NULL || !ctx->Profiler.FrameActive)
+        return;
+    ImGuiProfiler& profiler = ctx->Profiler;
+    IM_ASSERT(phase >= 0 && phase < ImGuiProfilerPhase_COUNT);
+    profiler.Stack.resize(profiler.Stack.Size + 1);
+    ImGuiProfilerStackEntry& entry = profiler.Stack.back();
+    entry.Name = name;
+    entry.ID = id;
+    entry.WindowID = ctx->CurrentWindow ? ctx->CurrentWindow->ID : 0;
+    entry.Phase = (ImS8)phase;
+    entry.ChildTicks = 0;
+    entry.Start = ProfilerGetTicks();
+}
+
+void ImGui::ProfilerEndScope()
+{
+    ImGuiContext* ctx = GImGui;
+    if (ctx == NULL || ctx->Profiler.Stack.Size == 0)
+        return;
+    const ImU64 now = ProfilerGetTicks();
+    ImGuiProfiler& profiler = ctx->Profiler;
+    ImGuiProfilerFrame& frame = profiler.Frames[profiler.FrameIdx];
+    ImGuiProfilerStackEntry entry = profiler.Stack.back();
+    profiler.Stack.pop_back();
+
+    const ImU64 duration = now - entry.Start;
+    const ImU64 self = duration > entry.ChildTicks ? duration - entry.ChildTicks : 0;
+    if (profiler.Stack.Size > 0)
+        profiler.Stack.back().ChildTicks += duration;
+    frame.PhaseTicks[entry.Phase] += self;
+
+    if (frame.Events.Size >= IMGUI_PROFILER_MAX_EVENTS)
+    {
+        frame.DroppedEvents++;
+        return;
+    }
+    ImGuiProfilerEvent event;
+    event.Start = (ImU32)ImMin(entry.Start - frame.Start, (ImU64)UINT32_MAX);
+    event.Duration = (ImU32)ImMin(duration, (ImU64)UINT32_MAX);
+    event.Self = (ImU32)ImMin(self, (ImU64)UINT32_MAX);
+    event.Phase = entry.Phase;
+    event.Depth = (ImS8)ImMin(profiler.Stack.Size, 127);
+    event.Name = entry.Name;
+    event.ID = entry.ID;
+    event.WindowID = entry.WindowID;
+    frame.Events.push_back(event);
+}
+
+void ImGui::ProfilerSetScopeID(ImGuiID id)
+{
+    ImGuiContext& g = *GImGui;
+    if (g.Profiler.Stack.Size == 0)
+        return;
+    ImGuiProfilerStackEntry& entry = g.Profiler.Stack.back();
+    entry.ID = entry.WindowID = id;
+}
+
+static const char* ProfilerGetEventName(const ImGuiProfilerEvent& event, char* buf, int buf_size)
+{
+    if (event.Name != NULL)
+        return event.Name;
+    if (event.ID != 0)
+        if (ImGuiWindow* window = ImGui::FindWindowByID(event.ID))
+            return window->Name;
+    if (event.ID != 0)
+        ImFormatString(buf, buf_size, "%s 0x%08X", GProfilerPhaseNames[event.Phase], event.ID);
+    else
+        ImFormatString(buf, buf_size, "%s", GProfilerPhaseNames[event.Phase]);
+    return buf;
+}
+
+static void ProfilerAppendJsonString(ImGuiTextBuffer* buf, const char* str)
+{
+    buf->append("\"");
+    for (const char* p = str; *p; p++)
+    {
+        const unsigned char c = (unsigned char)*p;
+        if (c == '"' || c == '\\')
+            buf->appendf("\\%c", c);
+        else if (c < 0x20)
+            buf->appendf("\\u%04x", c);
+        else
+            buf->append(p, p + 1);
+    }
+    buf->append("\"");
+}
+
+bool ImGui::SaveProfilerTrace(const char* filename)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiProfiler& profiler = g.Profiler;
+    ImGuiTextBuffer buf;
+    char name_buf[64];
+    bool first = true;
+    buf.append("{\"traceEvents\":[\n");
+    for (int n = 1; n <= IMGUI_PROFILER_HISTORY; n++) // Oldest to newest
+    {
+        const ImGuiProfilerFrame& frame = profiler.Frames[(profiler.FrameIdx + n) % IMGUI_PROFILER_HISTORY];
+        if (!frame.IsValid())
+            continue;
+        const double frame_ts = (double)(frame.Start - profiler.TimeOrigin) * 1e-3;
+        buf.appendf("%s{\"name\":\"Frame %d\",\"cat\":\"Frame\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":0}", first ? "" : ",\n", frame.FrameCount, frame_ts, (double)(frame.End - frame.Start) * 1e-3);
+        first = false;
+        for (const ImGuiProfilerEvent& event : frame.Events)
+        {
+            buf.append(",\n{\"name\":");
+            ProfilerAppendJsonString(&buf, ProfilerGetEventName(event, name_buf, IM_ARRAYSIZE(name_buf)));
+            buf.appendf(",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":0,\"args\":{\"frame\":%d,\"id\":\"0x%08X\",\"self_us\":%.3f}}",
+                GProfilerPhaseNames[event.Phase], frame_ts + event.Start * 1e-3, event.Duration * 1e-3, frame.FrameCount, event.ID, event.Self * 1e-3);
+        }
+    }
+    buf.append("\n],\"displayTimeUnit\":\"ms\"}\n");
+    if (first)
+        return false;
+
+    ImFileHandle f = ImFileOpen(filename, "wb");
+    if (!f)
+        return false;
+    const bool ret = ImFileWrite(buf.c_str(), sizeof(char), (ImU64)buf.size(), f) == (ImU64)buf.size();
+    ImFileClose(f);
+    return ret;
+}
+
+#ifndef IMGUI_DISABLE_DEBUG_TOOLS
+void ImGui::DebugNodeProfiler()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiProfiler& profiler = g.Profiler;
+    Checkbox("Enabled", &g.IO.ConfigProfilerEnabled);
+    SameLine();
+    Checkbox("Paused", &profiler.Paused);
+    SameLine();
+    static char trace_filename[256] = "imgui_trace.json";
+    if (Button("Export Chrome trace"))
+        SaveProfilerTrace(trace_filename);
+    SameLine();
+    SetNextItemWidth(GetFontSize() * 12.0f);
+    InputText("##TraceFilename", trace_filename, IM_ARRAYSIZE(trace_filename));
+
+    // Frame history, oldest to newest
+    int frame_indices[IMGUI_PROFILER_HISTORY];
+    int frame_count = 0;
+    float frame_max = 0.0f;
+    for (int n = 1; n <= IMGUI_PROFILER_HISTORY; n++)
+    {
+        int idx = (profiler.FrameIdx + n) % IMGUI_PROFILER_HISTORY;
+        if (!profiler.Frames[idx].IsValid())
+            continue;
+        frame_indices[frame_count++] = idx;
+        frame_max = ImMax(frame_max, profiler.Frames[idx].GetDuration());
+    }
+    if (frame_count == 0)
+    {
+        TextDisabled("No frame recorded.");
+        return;
+    }
+    if (profiler.SelectedFrame >= 0 && !profiler.Frames[profiler.SelectedFrame].IsValid())
+        profiler.SelectedFrame = -1;
+    const int selected_idx = profiler.SelectedFrame >= 0 ? profiler.SelectedFrame : frame_indices[frame_count - 1];
+    const ImGuiProfilerFrame& frame = profiler.Frames[selected_idx];
+
+    // Frame time bars, click to select a frame (and pause)
+    ImDrawList* draw_list = GetWindowDrawList();
+    const float graph_height = GetFrameHeight() * 3.0f;
+    const ImVec2 graph_pos = GetCursorScreenPos();
+    const ImVec2 graph_size(ImMax(GetContentRegionAvail().x, 100.0f), graph_height);
+    InvisibleButton("##FrameGraph", graph_size);
+    const float bar_width = graph_size.x / IMGUI_PROFILER_HISTORY;
+    draw_list->AddRectFilled(graph_pos, graph_pos + graph_size, GetColorU32(ImGuiCol_FrameBg));
+    for (int n = 0; n < frame_count; n++)
+    {
+        const ImGuiProfilerFrame& f = profiler.Frames[frame_indices[n]];
+        const float x = graph_pos.x + (IMGUI_PROFILER_HISTORY - frame_count + n) * bar_width;
+        const float h = graph_size.y * f.GetDuration() / frame_max;
+        ImU32 col = frame_indices[n] == selected_idx ? GetColorU32(ImGuiCol_PlotHistogramHovered) : GetColorU32(ImGuiCol_PlotHistogram);
+        draw_list->AddRectFilled(ImVec2(x, graph_pos.y + graph_size.y - h), ImVec2(x + ImMax(bar_width - 1.0f, 1.0f), graph_pos.y + graph_size.y), col);
+    }
+    if (IsItemHovered())
+    {
+        int n = (int)((g.IO.MousePos.x - graph_pos.x) / bar_width) - (IMGUI_PROFILER_HISTORY - frame_count);
+        if (n >= 0 && n < frame_count)
+        {
+            const ImGuiProfilerFrame& f = profiler.Frames[frame_indices[n]];
+            SetTooltip("Frame %d: %.3f ms", f.FrameCount, f.GetDuration());
+            if (IsItemClicked())
+            {
+                profiler.SelectedFrame = frame_indices[n];
+                profiler.Paused = true;
+            }
+        }
+    }
+    if (profiler.SelectedFrame >= 0)
+    {
+        if (SmallButton("Follow last frame"))
+        {
+            profiler.SelectedFrame = -1;
+            profiler.Paused = false;
+        }
+        SameLine();
+    }
+    Text("Frame %d: %.3f ms, %d events", frame.FrameCount, frame.GetDuration(), frame.Events.Size);
+    if (frame.DroppedEvents > 0)
+    {
+        SameLine();
+        TextColored(ImVec4(1.0f, 0.6f, 0.0f, 1.0f), "(%d dropped)", frame.DroppedEvents);
+    }
+
+    static const ImU32 phase_colors[ImGuiProfilerPhase_COUNT] =
+    {
+        IM_COL32(90, 140, 220, 255), IM_COL32(120, 120, 220, 255), IM_COL32(80, 180, 120, 255), IM_COL32(60, 140, 100, 255), IM_COL32(200, 170, 60, 255),
+        IM_COL32(210, 120, 60, 255), IM_COL32(170, 90, 180, 255), IM_COL32(200, 80, 80, 255), IM_COL32(230, 110, 110, 255), IM_COL32(140, 140, 140, 255),
+    };
+
+    // Per phase self time: selected frame, average and maximum over history
+    if (BeginTable("##Phases", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit))
+    {
+        TableSetupColumn("Phase");
+        TableSetupColumn("Frame (ms)");
+        TableSetupColumn("Average (ms)");
+        TableSetupColumn("Max (ms)");
+        TableHeadersRow();
+        for (int phase = 0; phase < ImGuiProfilerPhase_COUNT; phase++)
+        {
+            float sum = 0.0f, max = 0.0f;
+            for (int n = 0; n < frame_count; n++)
+            {
+                float t = profiler.Frames[frame_indices[n]].GetPhaseTime(phase);
+                sum += t;
+                max = ImMax(max, t);
+            }
+            TableNextRow();
+            TableNextColumn();
+            ColorButton("##col", ColorConvertU32ToFloat4(phase_colors[phase]), ImGuiColorEditFlags_NoTooltip, ImVec2(GetFontSize(), GetFontSize()));
+            SameLine();
+            TextUnformatted(GProfilerPhaseNames[phase]);
+            TableNextColumn(); Text("%.3f", frame.GetPhaseTime(phase));
+            TableNextColumn(); Text("%.3f", sum / frame_count);
+            TableNextColumn(); Text("%.3f", max);
+        }
+        EndTable();
+    }
+
+    // Timeline of the selected frame, nested scopes stacked by depth
+    if (TreeNodeEx("Timeline", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        int max_depth = 0;
+        for (const ImGuiProfilerEvent& event : frame.Events)
+            max_depth = ImMax(max_depth, (int)event.Depth);
+        const float row_height = GetTextLineHeight() + 2.0f;
+        const ImVec2 pos = GetCursorScreenPos();
+        const ImVec2 size(ImMax(GetContentRegionAvail().x, 100.0f), row_height * (max_depth + 1));
+        InvisibleButton("##Timeline", size);
+        const bool hovered = IsItemHovered();
+        const float scale = size.x / ImMax((float)(frame.End - frame.Start), 1.0f);
+        draw_list->AddRectFilled(pos, pos + size, GetColorU32(ImGuiCol_FrameBg));
+        draw_list->PushClipRect(pos, pos + size, true);
+        const ImGuiProfilerEvent* hovered_event = NULL;
+        char name_buf[64];
+        for (const ImGuiProfilerEvent& event : frame.Events)
+        {
+            ImVec2 p0(pos.x + event.Start * scale, pos.y + event.Depth * row_height);
+            ImVec2 p1(ImMax(p0.x + event.Duration * scale, p0.x + 1.0f), p0.y + row_height - 1.0f);
+            if (p1.x < g.CurrentWindow->ClipRect.Min.x || p0.x > g.CurrentWindow->ClipRect.Max.x)
+                continue;
+            draw_list->AddRectFilled(p0, p1, phase_colors[event.Phase]);
+            if (p1.x - p0.x > GetFontSize() * 2.0f)
+            {
+                const char* name = ProfilerGetEventName(event, name_buf, IM_ARRAYSIZE(name_buf));
+                const ImVec4 clip_rect(p0.x, p0.y, p1.x - 2.0f, p1.y);
+                draw_list->AddText(NULL, 0.0f, ImVec2(p0.x + 2.0f, p0.y + 1.0f), IM_COL32_WHITE, name, NULL, 0.0f, &clip_rect);
+            }
+            if (hovered && ImRect(p0, p1).Contains(g.IO.MousePos))
+                hovered_event = &event;
+        }
+        draw_list->PopClipRect();
+        if (hovered_event)
+            SetTooltip("%s (%s)\nDuration: %.3f ms\nSelf: %.3f ms\nStart: +%.3f ms", ProfilerGetEventName(*hovered_event, name_buf, IM_ARRAYSIZE(name_buf)), GProfilerPhaseNames[hovered_event->Phase], hovered_event->Duration * 1e-6f, hovered_event->Self * 1e-6f, hovered_event->Start * 1e-6f);
+        TreePop();
+    }
+
+    // Self time of the selected frame aggregated by window
+    if (TreeNode("By window"))
+    {
+        struct WindowTime { ImGuiID ID; ImU64 Ticks; int Count; };
+        ImVector<WindowTime> totals;
+        ImGuiStorage lookup;
+        for (const ImGuiProfilerEvent& event : frame.Events)
+        {
+            int* idx = lookup.GetIntRef(event.WindowID, -1);
+            if (*idx < 0)
+            {
+                *idx = totals.Size;
+                WindowTime t = { event.WindowID, 0, 0 };
+                totals.push_back(t);
+            }
+            totals[*idx].Ticks += event.Self;
+            totals[*idx].Count++;
+        }
+        struct Funcs { static int IMGUI_CDECL CompareByTicks(const void* lhs, const void* rhs) { ImU64 a = ((const WindowTime*)lhs)->Ticks, b = ((const WindowTime*)rhs)->Ticks; return a < b ? 1 : a > b ? -1 : 0; } };
+        ImQsort(totals.Data, (size_t)totals.Size, sizeof(WindowTime), Funcs::CompareByTicks);
+        if (BeginTable("##Windows", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit))
+        {
+            TableSetupColumn("Window");
+            TableSetupColumn("Self (ms)");
+            TableSetupColumn("Scopes");
+            TableHeadersRow();
+            for (const WindowTime& t : totals)
+            {
+                ImGuiWindow* window = t.ID ? FindWindowByID(t.ID) : NULL;
+                TableNextRow();
+                TableNextColumn();
+                if (window)
+                    TextUnformatted(window->Name);
+                else if (t.ID)
+                    Text("0x%08X", t.ID);
+                else
+                    TextDisabled("(no window)");
+                TableNextColumn(); Text("%.3f", t.Ticks * 1e-6f);
+                TableNextColumn(); Text("%d", t.Count);
+            }
+            EndTable();
+        }
+        TreePop();
+    }
+}
+#endif // #ifndef IMGUI_DISABLE_DEBUG_TOOLS
+
+#else // #if IMGUI_ENABLE_PROFILER
+
+void ImGui::ProfilerNewFrame() {}
+void ImGui::ProfilerEndFrame() {}
+void ImGui::ProfilerBeginScope(ImGuiProfilerPhase, const char*, ImGuiID) {}
+void ImGui::ProfilerEndScope() {}
+void ImGui::ProfilerSetScopeID(ImGuiID) {}
+bool ImGui::SaveProfilerTrace(const char*) { return false; }
+#ifndef IMGUI_DISABLE_DEBUG_TOOLS
+void ImGui::DebugNodeProfiler()
+{
+    TextDisabled("Profiler is compiled out, build with IMGUI_ENABLE_PROFILER (cmake -DIMGUI_PROFILER=ON).");
+}
+#endif
+
+#endif // #if IMGUI_ENABLE_PROFILER
+// Add By Dicky end
+
 // Win32 API IME support (for Asian languages, etc.)
 #if defined(_WIN32) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS) && !defined(IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS)
 
@@ -21050,6 +21773,13 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         TreePop();
     }
 
+    // Frame profiler add by Dicky
+    if (TreeNode("Profiler"))
+    {
+        DebugNodeProfiler();
+        TreePop();
+    }
+
     // Details for Docking
 #ifdef IMGUI_HAS_DOCK
     if (TreeNode("Docking"))
@@ -186,6 +186,7 @@ typedef int ImGuiMouseCursor;       // -> enum ImGuiMouseCursor_     // Enum: A
 typedef int ImGuiSortDirection;     // -> enum ImGuiSortDirection_   // Enum: A sorting direction (ascending or descending)
 typedef int ImGuiStyleVar;          // -> enum ImGuiStyleVar_        // Enum: A variable identifier for styling
 typedef int ImGuiTableBgTarget;     // -> enum ImGuiTableBgTarget_   // Enum: A color target for TableSetBgColor()
+typedef int ImGuiProfilerPhase;     // -> enum ImGuiProfilerPhase_   // Enum: A frame profiler phase (add by Dicky)
 
 // Flags (declared as int for compatibility with old C++, to allow using as flags without overhead, and to not pollute the top of this file)
 // - Tip: Use your programming IDE navigation facilities on the names in the _central column_ below to find the actual flags/enum lists!
@@ -1352,6 +1353,9 @@ enum ImGuiInputTextFlags_
     ImGuiInputTextFlags_CallbackResize      = 1 << 18,  // Callback on buffer capacity changes request (beyond 'buf_size' parameter value), allowing the string to grow. Notify when the string wants to be resized (for string types which hold a cache of their Size). You will be provided a new BufSize in the callback and NEED to honor it. (see misc/cpp/imgui_stdlib.h for an example of using this)
     ImGuiInputTextFlags_CallbackEdit        = 1 << 19,  // Callback on any edit (note that InputText() already returns true on edit, the callback is useful mainly to manipulate the underlying buffer while focus is active)
     ImGuiInputTextFlags_EscapeClearsAll     = 1 << 20,  // Escape key clears content if not empty, and deactivate otherwise (contrast to default behavior of Escape to revert)
+    // add by Dicky for large text
+    ImGuiInputTextFlags_LargeText           = 1 << 21,  // [Multi-line only] Keep a line index and update the UTF-8 buffer incrementally, so that editing and rendering multi-megabyte text only touch the edited/visible lines.
+    // add by Dicky end
 
     // Obsolete names
     //ImGuiInputTextFlags_AlwaysInsertMode  = ImGuiInputTextFlags_AlwaysOverwrite   // [renamed in 1.82] name was not matching behavior
@@ -1913,6 +1917,7 @@ enum ImGuiConfigFlags_
     ImGuiConfigFlags_IsTouchScreen          = 1 << 21,  // Application is using a touch screen instead of a mouse.
 
     // Add By Dicky
+    ImGuiConfigFlags_EnableDamageTracking   = 1 << 29,   // Compare draw output with previous frame and report changed areas in ImDrawData::DamageRects, so the application can skip presenting unchanged frames.
     ImGuiConfigFlags_EnablePowerSavingMode  = 1 << 30,   // Instruct imgui to help save power by not starting new frames when there are no user inputs or if the window is known not to be visible (both features require support in the platform binding).
     ImGuiConfigFlags_EnableLowRefreshMode   = 1 << 31,   // Instruct imgui to help low refresh by not starting new frames when there are no user inputs or if the window is known not to be visible (both features require support in the platform binding).
     // Add By Dicky end
@@ -2370,6 +2375,25 @@ struct ImGuiKeyData
     float       AnalogValue;        // 0.0f..1.0f for gamepad values
 };
 
+// add by Dicky for frame profiler
+// Phases timed by the frame profiler (only when built with IMGUI_ENABLE_PROFILER and io.ConfigProfilerEnabled is set).
+// Times are 'self' times: a phase nested inside another one (e.g. Text inside WindowBegin) is only accounted once.
+enum ImGuiProfilerPhase_
+{
+    ImGuiProfilerPhase_NewFrame,        // NewFrame()
+    ImGuiProfilerPhase_EndFrame,        // EndFrame()
+    ImGuiProfilerPhase_WindowBegin,     // Begin()
+    ImGuiProfilerPhase_WindowEnd,       // End()
+    ImGuiProfilerPhase_StackLayout,     // BeginHorizontal()/BeginVertical() and matching End
+    ImGuiProfilerPhase_TableLayout,     // Table layout and EndTable()
+    ImGuiProfilerPhase_Text,            // ImFont::RenderText()
+    ImGuiProfilerPhase_Render,          // Render()
+    ImGuiProfilerPhase_DrawData,        // Building ImDrawData inside Render()
+    ImGuiProfilerPhase_User,            // User scopes, see IMGUI_PROFILER_USER_SCOPE()
+    ImGuiProfilerPhase_COUNT
+};
+// add by Dicky end
+
 struct ImGuiIO
 {
     //------------------------------------------------------------------
@@ -2429,6 +2453,7 @@ struct ImGuiIO
     // Add by Dicky
     bool        ConfigFlippedMouseWheelAxisX;   // = false;         // flipped mouse wheel x axis value
     bool        ConfigFlippedMouseWheelAxisY;   // = false;         // flipped mouse wheel y axis value
+    bool        ConfigProfilerEnabled;          // = false          // Record per-phase CPU timings every frame. Requires IMGUI_ENABLE_PROFILER, otherwise the profiler is compiled out. See 'Metrics/Debugger->Profiler'.
     // Add By Dicky end
 
     //------------------------------------------------------------------
@@ -2518,6 +2543,10 @@ struct ImGuiIO
     int         MetricsRenderIndices;               // Indices output during last call to Render() = number of triangles * 3
     int         MetricsRenderWindows;               // Number of visible windows
     int         MetricsActiveWindows;               // Number of active windows
+    // add by Dicky for frame profiler
+    float       MetricsProfilerFrameTime;           // CPU time of last profiled frame from NewFrame() to end of Render(), in milliseconds. Requires io.ConfigProfilerEnabled.
+    float       MetricsProfilerPhaseTime[ImGuiProfilerPhase_COUNT]; // CPU time of last profiled frame spent in each ImGuiProfilerPhase_, in milliseconds.
+    // add by Dicky end
     ImVec2      MouseDelta;                         // Mouse delta. Note that this is zero if either current or previous position are invalid (-FLT_MAX,-FLT_MAX), so a disappearing/reappearing mouse won't have a huge delta.
 
     // Legacy: before 1.87, we required backend to fill io.KeyMap[] (imgui->native map) during initialization and io.KeysDown[] (native indices) every frame.
@@ -3243,6 +3272,10 @@ struct ImDrawData
     ImVec2              DisplaySize;        // Size of the viewport to render (== GetMainViewport()->Size for the main viewport, == io.DisplaySize in most single-viewport applications)
     ImVec2              FramebufferScale;   // Amount of pixels for each unit of DisplaySize. Based on io.DisplayFramebufferScale. Generally (1,1) on normal display, (2,2) on OSX with Retina display.
     ImGuiViewport*      OwnerViewport;      // Viewport carrying the ImDrawData instance, might be of use to the renderer (generally not).
+    // add by Dicky for damage tracking (io.ConfigFlags & ImGuiConfigFlags_EnableDamageTracking)
+    bool                DamageValid;        // DamageRects can be trusted. When false, the whole viewport needs to be redrawn (first frame, resize, user callbacks...).
+    ImVector<ImVec4>    DamageRects;        // Areas (x1, y1, x2, y2 in the same space as ImDrawCmd::ClipRect) whose output differs from the previous frame. Valid and empty: nothing changed.
+    // add by Dicky end
 
     // Functions
     ImDrawData()    { Clear(); }
@@ -1965,6 +1965,8 @@ void ImDrawData::Clear()
     CmdLists.resize(0); // The ImDrawList are NOT owned by ImDrawData but e.g. by ImGuiContext, so we don't clear them.
     DisplayPos = DisplaySize = FramebufferScale = ImVec2(0.0f, 0.0f);
     OwnerViewport = NULL;
+    DamageValid = false;    // add by Dicky for damage tracking
+    DamageRects.resize(0);  // add by Dicky for damage tracking
 }
 
 // Important: 'out_list' is generally going to be draw_data->CmdLists, but may be another temporary list
@@ -4164,6 +4166,7 @@ void ImFont::RenderTextEx(ImDrawList* draw_list, float size, const ImVec2& pos,
 void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip) const
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILER_SCOPE(ImGuiProfilerPhase_Text, NULL, 0); // add by Dicky for frame profiler
     ImVec2 offset = g.Style.TexGlyphShadowOffset;
     float spacing = g.Style.TextSpacing;
     if (!FLOAT_IS_ZERO(offset.x) || !FLOAT_IS_ZERO(offset.y))
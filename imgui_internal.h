@@ -195,8 +195,18 @@ typedef void (*ImGuiErrorLogCallback)(void* user_data, const char* fmt, ...);
 // See implementation of this variable in imgui.cpp for comments and details.
 //-----------------------------------------------------------------------------
 
+// add by Dicky for thread local context
+// With IMGUI_THREAD_LOCAL_CONTEXT (cmake -DIMGUI_THREAD_LOCAL_CONTEXT=ON) each thread has its own current context,
+// so N threads can use N different contexts at once. Contexts still can't be shared between threads.
+#if IMGUI_THREAD_LOCAL_CONTEXT
+#define IMGUI_CONTEXT_STORAGE thread_local
+#else
+#define IMGUI_CONTEXT_STORAGE
+#endif
+// add by Dicky end
+
 #ifndef GImGui
-extern IMGUI_API ImGuiContext* GImGui;  // Current implicit context pointer
+extern IMGUI_API IMGUI_CONTEXT_STORAGE ImGuiContext* GImGui;  // Current implicit context pointer // modify by Dicky
 #endif
 
 //-------------------------------------------------------------------------
@@ -1140,10 +1150,15 @@ struct IMGUI_API ImGuiInputTextState
     bool                    SelectedAllMouseLock;   // after a double-click to select all, we ignore further mouse drags to update selection
     bool                    Edited;                 // edited this frame
     ImGuiInputTextFlags     Flags;                  // copy of InputText() flags. may be used to check if e.g. ImGuiInputTextFlags_Password is set.
+    // add by Dicky for large text
+    ImVector<int>           LineStartW;             // [ImGuiInputTextFlags_LargeText] index in TextW of the first character of each line
+    ImVector<int>           LineStartA;             // [ImGuiInputTextFlags_LargeText] offset in TextA of the first character of each line
+    bool                    LineIndexValid;         // line index and TextA are kept in sync by STB_TEXTEDIT_INSERTCHARS/STB_TEXTEDIT_DELETECHARS
+    // add by Dicky end
 
     ImGuiInputTextState()                   { memset(this, 0, sizeof(*this)); }
-    void        ClearText()                 { CurLenW = CurLenA = 0; TextW[0] = 0; TextA[0] = 0; CursorClamp(); }
-    void        ClearFreeMemory()           { TextW.clear(); TextA.clear(); InitialTextA.clear(); }
+    void        ClearText()                 { CurLenW = CurLenA = 0; TextW[0] = 0; TextA[0] = 0; CursorClamp(); if (LineIndexValid) LineIndexBuild(); }
+    void        ClearFreeMemory()           { TextW.clear(); TextA.clear(); InitialTextA.clear(); LineStartW.clear(); LineStartA.clear(); LineIndexValid = false; }
     int         GetUndoAvailCount() const   { return Stb.undostate.undo_point; }
     int         GetRedoAvailCount() const   { return IMSTB_TEXTEDIT_UNDOSTATECOUNT - Stb.undostate.redo_point; }
     void        OnKeyPressed(int key);      // Cannot be inline because we call in code in stb_textedit.h implementation
@@ -1157,6 +1172,11 @@ struct IMGUI_API ImGuiInputTextState
     int         GetSelectionStart() const   { return Stb.select_start; }
     int         GetSelectionEnd() const     { return Stb.select_end; }
     void        SelectAll()                 { Stb.select_start = 0; Stb.cursor = Stb.select_end = CurLenW; Stb.has_preferred_x = 0; }
+
+    // Line index (ImGuiInputTextFlags_LargeText)
+    void        LineIndexBuild();           // Re-encode TextA from TextW and rebuild the line index, O(N). Incremental updates happen in the stb_textedit callbacks.
+    int         LineIndexFind(int pos) const;   // Return line number containing wchar position 'pos', O(log lines)
+    int         LineIndexCount() const      { return LineStartW.Size; }
 };
 
 // Storage for current popup stack
@@ -1682,6 +1702,11 @@ struct ImGuiLayout
     float                       Indent;             // Indent used to align items in vertical layout.
     ImVec2                      StartPos;           // Initial cursor position when BeginLayout is called.
     ImVec2                      StartCursorMaxPos;  // Maximum cursor position when BeginLayout is called.
+    ImGuiID                     ItemsHash;          // Hash of item types, sizes and spring weights measured in EndLayout().
+    bool                        SpringsValid;       // Spring sizes match SpringsItemsHash and SpringsFreeSpace, false when they must be recomputed.
+    ImGuiID                     SpringsItemsHash;   // ItemsHash springs were last balanced against.
+    float                       SpringsFreeSpace;   // Free space springs were last balanced against.
+    float                       AlignExtent;        // Cross axis size items were aligned against in EndLayoutItem().
 
     ImGuiLayout(ImGuiID id, ImGuiLayoutType type)
     {
@@ -1696,6 +1721,11 @@ struct ImGuiLayout
         Indent = 0.0f;
         StartPos = ImVec2(0, 0);
         StartCursorMaxPos = ImVec2(0, 0);
+        ItemsHash = 0;
+        SpringsValid = false;
+        SpringsItemsHash = 0;
+        SpringsFreeSpace = 0.0f;
+        AlignExtent = 0.0f;
     }
 };
 // Add By Dicky end
@@ -1919,6 +1949,29 @@ struct ImGuiDockContext
 // [SECTION] Viewport support
 //-----------------------------------------------------------------------------
 
+// add by Dicky for damage tracking
+// Signature of one ImDrawCmd output, compared between frames to build ImDrawData::DamageRects
+struct ImGuiDamageSignature
+{
+    ImU64               Hash;                   // Hash of clip rect, texture and vertices
+    ImRect              Bounds;                 // Vertices bounding box clipped by ClipRect
+    ImRect              ClipRect;
+    const ImDrawVert*   Vtx;                    // Only valid during the frame the signature was computed, NULL when reused from previous frame
+    int                 VtxCount;
+};
+
+struct ImGuiDamageDrawList
+{
+    const ImDrawList*   DrawList;
+    ImU64               Hash;                   // Hash of whole vertex/index/command buffers
+    int                 SigOffset;              // Range in ImGuiViewportP::DamageSignatures
+    int                 SigCount;
+};
+#ifndef IMGUI_DAMAGE_RECTS_MAX
+#define IMGUI_DAMAGE_RECTS_MAX  8               // Over this number damage rectangles are merged into their bounding box
+#endif
+// add by Dicky end
+
 // ImGuiViewport Private/Internals fields (cardinal sin: we are using inheritance!)
 // Every instance of ImGuiViewport is in fact a ImGuiViewportP.
 struct ImGuiViewportP : public ImGuiViewport
@@ -1944,8 +1997,17 @@ struct ImGuiViewportP : public ImGuiViewport
     ImVec2              WorkOffsetMax;          // Work Area: Offset from Pos+Size to bottom-right corner of Work Area. Generally (0,0) or (0,-status_bar_height).
     ImVec2              BuildWorkOffsetMin;     // Work Area: Offset being built during current frame. Generally >= 0.0f.
     ImVec2              BuildWorkOffsetMax;     // Work Area: Offset being built during current frame. Generally <= 0.0f.
-
-    ImGuiViewportP()                    { Window = NULL; Idx = -1; LastFrameActive = BgFgDrawListsLastFrame[0] = BgFgDrawListsLastFrame[1] = LastFocusedStampCount = -1; LastNameHash = 0; Alpha = LastAlpha = 1.0f; LastFocusedHadNavWindow = false; PlatformMonitor = -1; BgFgDrawLists[0] = BgFgDrawLists[1] = NULL; LastPlatformPos = LastPlatformSize = LastRendererSize = ImVec2(FLT_MAX, FLT_MAX); }
+    // add by Dicky for damage tracking
+    ImVector<ImGuiDamageSignature> DamageSignatures;    // Current frame, in draw list order
+    ImVector<ImGuiDamageSignature> DamageSignaturesPrev;
+    ImVector<ImGuiDamageDrawList> DamageDrawLists;      // Signature ranges per draw list, to skip unchanged draw lists
+    ImVector<ImGuiDamageDrawList> DamageDrawListsPrev;
+    int                 DamageLastFrame;        // Last frame DamageSignatures was updated
+    ImRect              DamageLastDisplayRect;
+    ImVec2              DamageLastFramebufferScale;
+    // add by Dicky end
+
+    ImGuiViewportP()                    { Window = NULL; Idx = -1; LastFrameActive = BgFgDrawListsLastFrame[0] = BgFgDrawListsLastFrame[1] = LastFocusedStampCount = -1; LastNameHash = 0; Alpha = LastAlpha = 1.0f; LastFocusedHadNavWindow = false; PlatformMonitor = -1; BgFgDrawLists[0] = BgFgDrawLists[1] = NULL; LastPlatformPos = LastPlatformSize = LastRendererSize = ImVec2(FLT_MAX, FLT_MAX); DamageLastFrame = -1; }
     ~ImGuiViewportP()                   { if (BgFgDrawLists[0]) IM_DELETE(BgFgDrawLists[0]); if (BgFgDrawLists[1]) IM_DELETE(BgFgDrawLists[1]); }
     void    ClearRequestFlags()         { PlatformRequestClose = PlatformRequestMove = PlatformRequestResize = false; }
 
@@ -2107,6 +2169,77 @@ struct ImGuiIDStackTool
     ImGuiIDStackTool()      { memset(this, 0, sizeof(*this)); CopyToClipboardLastTime = -FLT_MAX; }
 };
 
+// add by Dicky for frame profiler
+// Per-frame CPU timings recorded between NewFrame() and the end of Render(), see ImGuiProfilerPhase_.
+// Everything below is compiled out unless IMGUI_ENABLE_PROFILER is set, and idle unless io.ConfigProfilerEnabled is set.
+#ifndef IMGUI_PROFILER_HISTORY
+#define IMGUI_PROFILER_HISTORY          120     // Number of frames kept in the ring buffer
+#endif
+#ifndef IMGUI_PROFILER_MAX_EVENTS
+#define IMGUI_PROFILER_MAX_EVENTS       4096    // Events recorded per frame. Phase times are still accumulated past that.
+#endif
+
+#if IMGUI_ENABLE_PROFILER
+#define IMGUI_PROFILER_BEGIN(_PHASE, _ID)   ImGui::ProfilerBeginScope(_PHASE, NULL, _ID)
+#define IMGUI_PROFILER_END()                ImGui::ProfilerEndScope()
+#define IMGUI_PROFILER_SET_ID(_ID)          ImGui::ProfilerSetScopeID(_ID)
+#else
+#define IMGUI_PROFILER_BEGIN(_PHASE, _ID)   ((void)0)
+#define IMGUI_PROFILER_END()                ((void)0)
+#define IMGUI_PROFILER_SET_ID(_ID)          ((void)0)
+#endif
+
+struct ImGuiProfilerEvent
+{
+    ImU32               Start;          // Nanoseconds since frame start
+    ImU32               Duration;       // Nanoseconds, including nested scopes
+    ImU32               Self;           // Nanoseconds, excluding nested scopes
+    ImS8                Phase;          // ImGuiProfilerPhase_
+    ImS8                Depth;
+    const char*         Name;           // Static name, or NULL to display ID
+    ImGuiID             ID;             // Window/table/layout ID
+    ImGuiID             WindowID;       // Window the scope was submitted in, used for per-window aggregation
+};
+
+struct ImGuiProfilerFrame
+{
+    int                 FrameCount;     // ImGui frame number, -1 if slot is unused
+    ImU64               Start;          // Ticks in nanoseconds
+    ImU64               End;            // 0 while recording
+    ImU64               PhaseTicks[ImGuiProfilerPhase_COUNT];
+    int                 DroppedEvents;  // Events over IMGUI_PROFILER_MAX_EVENTS
+    ImVector<ImGuiProfilerEvent> Events;
+
+    ImGuiProfilerFrame()                { FrameCount = -1; Start = End = 0; memset(PhaseTicks, 0, sizeof(PhaseTicks)); DroppedEvents = 0; }
+    bool    IsValid() const             { return FrameCount >= 0 && End > Start; }
+    float   GetDuration() const         { return (float)(End - Start) * 1e-6f; }               // ms
+    float   GetPhaseTime(int phase) const { return (float)PhaseTicks[phase] * 1e-6f; }        // ms
+};
+
+struct ImGuiProfilerStackEntry
+{
+    ImU64               Start;
+    ImU64               ChildTicks;
+    const char*         Name;
+    ImGuiID             ID;
+    ImGuiID             WindowID;
+    ImS8                Phase;
+};
+
+struct ImGuiProfiler
+{
+    ImGuiProfilerFrame  Frames[IMGUI_PROFILER_HISTORY];
+    int                 FrameIdx;       // Index of the last frame written in Frames[]
+    bool                FrameActive;    // Recording between ProfilerNewFrame() and ProfilerEndFrame()
+    bool                Paused;         // Freeze history (toggled from Metrics)
+    int                 SelectedFrame;  // Index in Frames[] displayed by Metrics, -1 to follow the last frame
+    ImU64               TimeOrigin;     // Ticks of first recorded frame, used for trace timestamps
+    ImVector<ImGuiProfilerStackEntry> Stack;
+
+    ImGuiProfiler()                     { FrameIdx = 0; FrameActive = Paused = false; SelectedFrame = -1; TimeOrigin = 0; }
+};
+// add by Dicky end
+
 //-----------------------------------------------------------------------------
 // [SECTION] Generic context hooks
 //-----------------------------------------------------------------------------
@@ -2460,6 +2593,9 @@ struct ImGuiContext
     ImGuiIDStackTool        DebugIDStackTool;
     ImGuiDebugAllocInfo     DebugAllocInfo;
     ImGuiDockNode*          DebugHoveredDockNode;               // Hovered dock node.
+#if IMGUI_ENABLE_PROFILER
+    ImGuiProfiler           Profiler;                           // add by Dicky for frame profiler
+#endif
 
     // Misc
     float                   FramerateSecPerFrame[60];           // Calculate estimate of framerate for user over the last 60 frames..
@@ -2723,6 +2859,8 @@ struct IMGUI_API ImGuiWindowTempData
     ImGuiLayoutItem*        CurrentLayoutItem;
     ImVector<ImGuiLayout*>  LayoutStack;
     ImGuiStorage            Layouts;
+    ImVector<ImGuiLayout*>  LayoutsOrder;           // Layouts in last frame submission order, FindLayout() checks it before searching Layouts.
+    int                     LayoutsOrderIdx;
     // stack layout add By Dicky end
 
     // Local parameters stacks
@@ -2956,6 +3094,8 @@ struct IMGUI_API ImGuiTabBar
     ImVec2              FramePadding;           // style.FramePadding locked at the time of BeginTabBar()
     ImVec2              BackupCursorPos;
     ImGuiTextBuffer     TabsNames;              // For non-docking tab bar we re-append names in a contiguous buffer.
+    ImGuiStorage        TabsIndex;              // add by Dicky, tab ID -> last known index in Tabs, used by TabBarFindTabByID() on large tab bars (validated on use, rebuilt on miss)
+    int                 TabsIndexLastFound;     // add by Dicky, index of last tab found by TabBarFindTabByID(), tabs are mostly looked up in order
 
     ImGuiTabBar();
 };
@@ -3828,6 +3968,14 @@ namespace ImGui
     IMGUI_API void          DebugNodeViewport(ImGuiViewportP* viewport);
     IMGUI_API void          DebugRenderKeyboardPreview(ImDrawList* draw_list);
     IMGUI_API void          DebugRenderViewportThumbnail(ImDrawList* draw_list, ImGuiViewportP* viewport, const ImRect& bb);
+    IMGUI_API void          DebugNodeProfiler();                                    // add by Dicky for frame profiler
+
+    // Frame profiler add by Dicky
+    IMGUI_API void          ProfilerNewFrame();
+    IMGUI_API void          ProfilerEndFrame();
+    IMGUI_API void          ProfilerSetScopeID(ImGuiID id);                         // Set object/window ID of innermost scope once known
+    IMGUI_API const char*   ProfilerGetPhaseName(ImGuiProfilerPhase phase);
+    // Frame profiler add by Dicky end
 
     // Obsolete functions
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
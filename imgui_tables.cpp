@@ -763,6 +763,7 @@ void ImGui::TableUpdateLayout(ImGuiTable* table)
 {
     ImGuiContext& g = *GImGui;
     IM_ASSERT(table->IsLayoutLocked == false);
+    IMGUI_PROFILER_SCOPE(ImGuiProfilerPhase_TableLayout, NULL, table->ID); // add by Dicky for frame profiler
 
     const ImGuiTableFlags table_sizing_policy = (table->Flags & ImGuiTableFlags_SizingMask_);
     table->IsDefaultDisplayOrder = true;
@@ -1290,6 +1291,7 @@ void    ImGui::EndTable()
     ImGuiContext& g = *GImGui;
     ImGuiTable* table = g.CurrentTable;
     IM_ASSERT(table != NULL && "Only call EndTable() if BeginTable() returns true!");
+    IMGUI_PROFILER_SCOPE(ImGuiProfilerPhase_TableLayout, NULL, table->ID); // add by Dicky for frame profiler
 
     // This assert would be very useful to catch a common error... unfortunately it would probably trigger in some
     // cases, and for consistency user may sometimes output empty tables (and still benefit from e.g. outer border)
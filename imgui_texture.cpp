@@ -811,6 +811,32 @@ ImPixel ImGetTexturePixel(ImTextureID texture, float x, float y)
     return pixel;
 }
 
+// add by Dicky for software rendering
+static bool WriteImageFile(std::string path, int width, int height, int channels, const void* data)
+{
+    int ret = 0;
+    auto file_suffix = ImGuiHelper::path_filename_suffix(path);
+    if (!file_suffix.empty())
+    {
+        if (file_suffix.compare(".png") == 0 || file_suffix.compare(".PNG") == 0)
+            ret = stbi_write_png(path.c_str(), width, height, channels, data, width * channels);
+        else if (file_suffix.compare(".jpg") == 0 || file_suffix.compare(".JPG") == 0 ||
+                file_suffix.compare(".jpeg") == 0 || file_suffix.compare(".JPEG") == 0)
+            ret = stbi_write_jpg(path.c_str(), width, height, channels, data, width * channels);
+        else if (file_suffix.compare(".bmp") == 0 || file_suffix.compare(".BMP") == 0)
+            ret = stbi_write_bmp(path.c_str(), width, height, channels, data);
+        else if (file_suffix.compare(".tga") == 0 || file_suffix.compare(".TGA") == 0)
+            ret = stbi_write_tga(path.c_str(), width, height, channels, data);
+    }
+    else
+    {
+        path += ".png";
+        ret = stbi_write_png(path.c_str(), width, height, channels, data, width * channels);
+    }
+    return ret != 0;
+}
+// add by Dicky end
+
 bool ImTextureToFile(ImTextureID texture, std::string path)
 {
     int ret = -1;
@@ -832,24 +858,7 @@ bool ImTextureToFile(ImTextureID texture, std::string path)
         return false;
     }
 
-    auto file_suffix = ImGuiHelper::path_filename_suffix(path);
-    if (!file_suffix.empty())
-    {
-        if (file_suffix.compare(".png") == 0 || file_suffix.compare(".PNG") == 0)
-            stbi_write_png(path.c_str(), width, height, channels, data, width * channels);
-        else if (file_suffix.compare(".jpg") == 0 || file_suffix.compare(".JPG") == 0 ||
-                file_suffix.compare(".jpeg") == 0 || file_suffix.compare(".JPEG") == 0)
-            stbi_write_jpg(path.c_str(), width, height, channels, data, width * channels);
-        else if (file_suffix.compare(".bmp") == 0 || file_suffix.compare(".BMP") == 0)
-            stbi_write_bmp(path.c_str(), width, height, channels, data);
-        else if (file_suffix.compare(".tga") == 0 || file_suffix.compare(".TGA") == 0)
-            stbi_write_tga(path.c_str(), width, height, channels, data);
-    }
-    else
-    {
-        path += ".png";
-        stbi_write_png(path.c_str(), width, height, channels, data, width * channels);
-    }
+    WriteImageFile(path, width, height, channels, data); // modify by Dicky
     if (data) IM_FREE(data);
     return true;
 }
@@ -914,6 +923,364 @@ void ImTextureToMat(ImTextureID texture, ImGui::ImMat& mat, ImVec2 offset, ImVec
     }
 }
 
+// add by Dicky for software rendering
+// Triangles are rasterized at pixel centers with 4 bits of sub-pixel precision and the top-left fill rule, so the
+// shared edge of two triangles is blended once. Filled rectangles and glyphs, most of what ImGui draws, are two
+// triangles making an axis aligned quad and are filled as rectangles.
+#define IM_SOFT_SUBPIXEL 16
+
+struct ImSoftTexture
+{
+    const unsigned char* Pixels = nullptr; // RGBA32, or Alpha8 with white color
+    int Width  = 0;
+    int Height = 0;
+    bool Alpha8 = false;
+};
+
+struct ImSoftTarget
+{
+    unsigned char* Pixels = nullptr;
+    int Width  = 0;
+    int Height = 0;
+    int ClipMinX = 0, ClipMinY = 0, ClipMaxX = 0, ClipMaxY = 0; // pixels inside are ClipMin <= p < ClipMax
+};
+
+static inline int ImSoftDiv255(int v) { return ((v + 128) * 257) >> 16; }
+
+// Blends the color over a pixel like glBlendFuncSeparate(SRC_ALPHA, ONE_MINUS_SRC_ALPHA, ONE, ONE_MINUS_SRC_ALPHA)
+static inline void ImSoftBlend(unsigned char* dst, int r, int g, int b, int a)
+{
+    if (a >= 255)
+    {
+        dst[0] = (unsigned char)r; dst[1] = (unsigned char)g; dst[2] = (unsigned char)b; dst[3] = 255;
+        return;
+    }
+    if (a <= 0)
+        return;
+    const int ia = 255 - a;
+    dst[0] = (unsigned char)ImSoftDiv255(r * a + dst[0] * ia);
+    dst[1] = (unsigned char)ImSoftDiv255(g * a + dst[1] * ia);
+    dst[2] = (unsigned char)ImSoftDiv255(b * a + dst[2] * ia);
+    dst[3] = (unsigned char)(a + ImSoftDiv255(dst[3] * ia));
+}
+
+// Nearest texel of the texture at (u,v), white without a texture
+static inline void ImSoftSample(const ImSoftTexture* tex, float u, float v, int* rgba)
+{
+    if (!tex || !tex->Pixels)
+    {
+        rgba[0] = rgba[1] = rgba[2] = rgba[3] = 255;
+        return;
+    }
+    const int x = ImClamp((int)(u * tex->Width), 0, tex->Width - 1);
+    const int y = ImClamp((int)(v * tex->Height), 0, tex->Height - 1);
+    if (tex->Alpha8)
+    {
+        rgba[0] = rgba[1] = rgba[2] = 255;
+        rgba[3] = tex->Pixels[(size_t)y * tex->Width + x];
+        return;
+    }
+    const unsigned char* p = tex->Pixels + ((size_t)y * tex->Width + x) * 4;
+    rgba[0] = p[0]; rgba[1] = p[1]; rgba[2] = p[2]; rgba[3] = p[3];
+}
+
+static inline void ImSoftModulate(ImU32 col, const int* texel, int* rgba)
+{
+    rgba[0] = ImSoftDiv255((int)((col >> IM_COL32_R_SHIFT) & 0xFF) * texel[0]);
+    rgba[1] = ImSoftDiv255((int)((col >> IM_COL32_G_SHIFT) & 0xFF) * texel[1]);
+    rgba[2] = ImSoftDiv255((int)((col >> IM_COL32_B_SHIFT) & 0xFF) * texel[2]);
+    rgba[3] = ImSoftDiv255((int)((col >> IM_COL32_A_SHIFT) & 0xFF) * texel[3]);
+}
+
+// Fills an axis aligned quad from (x0,y0) to (x1,y1) in pixels, with uv going linearly from uv0 to uv1 across it
+static void ImSoftRasterRect(ImSoftTarget& target, const ImSoftTexture* texture, float x0, float y0, float x1, float y1, ImVec2 uv0, ImVec2 uv1, ImU32 col)
+{
+    // the texture is copied out, stores to the pixels could alias it
+    const ImSoftTexture tex_copy = texture ? *texture : ImSoftTexture();
+    const ImSoftTexture* tex = &tex_copy;
+    if (x0 > x1) { ImSwap(x0, x1); ImSwap(uv0.x, uv1.x); }
+    if (y0 > y1) { ImSwap(y0, y1); ImSwap(uv0.y, uv1.y); }
+    // pixels whose center is inside, like the triangles of the quad would cover
+    const int px0 = ImMax(target.ClipMinX, (int)ImCeil(x0 - 0.5f));
+    const int py0 = ImMax(target.ClipMinY, (int)ImCeil(y0 - 0.5f));
+    const int px1 = ImMin(target.ClipMaxX, (int)ImCeil(x1 - 0.5f));
+    const int py1 = ImMin(target.ClipMaxY, (int)ImCeil(y1 - 0.5f));
+    if (px0 >= px1 || py0 >= py1)
+        return;
+    int texel[4], rgba[4];
+    if (uv0.x == uv1.x && uv0.y == uv1.y)
+    {
+        ImSoftSample(tex, uv0.x, uv0.y, texel);
+        ImSoftModulate(col, texel, rgba);
+        if (rgba[3] == 0)
+            return;
+        for (int y = py0; y < py1; y++)
+        {
+            unsigned char* dst = target.Pixels + ((size_t)y * target.Width + px0) * 4;
+            for (int x = px0; x < px1; x++, dst += 4)
+                ImSoftBlend(dst, rgba[0], rgba[1], rgba[2], rgba[3]);
+        }
+        return;
+    }
+    const float du = (uv1.x - uv0.x) / (x1 - x0);
+    const float dv = (uv1.y - uv0.y) / (y1 - y0);
+    for (int y = py0; y < py1; y++)
+    {
+        const float v = uv0.y + (y + 0.5f - y0) * dv;
+        unsigned char* dst = target.Pixels + ((size_t)y * target.Width + px0) * 4;
+        for (int x = px0; x < px1; x++, dst += 4)
+        {
+            ImSoftSample(tex, uv0.x + (x + 0.5f - x0) * du, v, texel);
+            ImSoftModulate(col, texel, rgba);
+            ImSoftBlend(dst, rgba[0], rgba[1], rgba[2], rgba[3]);
+        }
+    }
+}
+
+// Triangles up to this wide test every pixel of their bounding box, wider ones compute the span of each row
+#define IM_SOFT_SCAN_WIDTH 32
+
+static void ImSoftRasterTriangle(ImSoftTarget& target, const ImSoftTexture* texture, const ImDrawVert* v0, const ImDrawVert* v1, const ImDrawVert* v2, const ImVec2& offset, const ImVec2& scale)
+{
+    // inputs are copied out, stores to the pixels could alias them
+    const ImSoftTexture tex_copy = texture ? *texture : ImSoftTexture();
+    const ImSoftTexture* tex = &tex_copy;
+    // fixed point positions
+    ImS64 x[3], y[3];
+    const ImDrawVert* v[3] = { v0, v1, v2 };
+    for (int i = 0; i < 3; i++)
+    {
+        x[i] = (ImS64)ImFloor((v[i]->pos.x - offset.x) * scale.x * IM_SOFT_SUBPIXEL + 0.5f);
+        y[i] = (ImS64)ImFloor((v[i]->pos.y - offset.y) * scale.y * IM_SOFT_SUBPIXEL + 0.5f);
+    }
+    ImS64 area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+    if (area == 0)
+        return;
+    if (area < 0)
+    {
+        ImSwap(x[1], x[2]); ImSwap(y[1], y[2]); ImSwap(v[1], v[2]);
+        area = -area;
+    }
+    const int px0 = ImMax(target.ClipMinX, (int)(ImMin(x[0], ImMin(x[1], x[2])) / IM_SOFT_SUBPIXEL));
+    const int py0 = ImMax(target.ClipMinY, (int)(ImMin(y[0], ImMin(y[1], y[2])) / IM_SOFT_SUBPIXEL));
+    const int px1 = ImMin(target.ClipMaxX, (int)(ImMax(x[0], ImMax(x[1], x[2])) / IM_SOFT_SUBPIXEL) + 1);
+    const int py1 = ImMin(target.ClipMaxY, (int)(ImMax(y[0], ImMax(y[1], y[2])) / IM_SOFT_SUBPIXEL) + 1);
+    if (px0 >= px1 || py0 >= py1)
+        return;
+
+    // edge e is opposite to vertex e, its function is positive inside and weights that vertex
+    ImS64 step_x[3], step_y[3], row[3];
+    const ImS64 cx = (ImS64)px0 * IM_SOFT_SUBPIXEL + IM_SOFT_SUBPIXEL / 2;
+    const ImS64 cy = (ImS64)py0 * IM_SOFT_SUBPIXEL + IM_SOFT_SUBPIXEL / 2;
+    for (int e = 0; e < 3; e++)
+    {
+        const int a = (e + 1) % 3, b = (e + 2) % 3;
+        const ImS64 dx = x[b] - x[a], dy = y[b] - y[a];
+        step_x[e] = -dy * IM_SOFT_SUBPIXEL;
+        step_y[e] = dx * IM_SOFT_SUBPIXEL;
+        // pixels exactly on an edge belong to the triangle only for its top and left edges
+        const bool top_left = dy < 0 || (dy == 0 && dx > 0);
+        row[e] = dx * (cy - y[a]) - dy * (cx - x[a]) - (top_left ? 0 : 1);
+    }
+
+    const ImU32 col0 = v[0]->col;
+    const bool one_color = col0 == v[1]->col && col0 == v[2]->col;
+    const float u[3] = { v[0]->uv.x, v[1]->uv.x, v[2]->uv.x };
+    const float t[3] = { v[0]->uv.y, v[1]->uv.y, v[2]->uv.y };
+    const bool flat = one_color && u[0] == u[1] && u[0] == u[2] && t[0] == t[1] && t[0] == t[2];
+    int flat_rgba[4];
+    if (flat)
+    {
+        int texel[4];
+        ImSoftSample(tex, u[0], t[0], texel);
+        ImSoftModulate(col0, texel, flat_rgba);
+        if (flat_rgba[3] == 0)
+            return;
+    }
+    float col[3][4];
+    for (int i = 0; i < 3; i++)
+        for (int c = 0; c < 4; c++)
+            col[i][c] = (float)((v[i]->col >> (c == 0 ? IM_COL32_R_SHIFT : c == 1 ? IM_COL32_G_SHIFT : c == 2 ? IM_COL32_B_SHIFT : IM_COL32_A_SHIFT)) & 0xFF);
+    const float inv_area = 1.0f / (float)area;
+    // blends the pixel with barycentric weights w0/area and w1/area
+    auto shade = [&](unsigned char* dst, ImS64 w0, ImS64 w1)
+    {
+        if (flat)
+        {
+            ImSoftBlend(dst, flat_rgba[0], flat_rgba[1], flat_rgba[2], flat_rgba[3]);
+            return;
+        }
+        const float l0 = (float)w0 * inv_area, l1 = (float)w1 * inv_area, l2 = 1.0f - l0 - l1;
+        int texel[4], rgba[4];
+        ImSoftSample(tex, u[0] * l0 + u[1] * l1 + u[2] * l2, t[0] * l0 + t[1] * l1 + t[2] * l2, texel);
+        if (one_color)
+            ImSoftModulate(col0, texel, rgba);
+        else
+            for (int c = 0; c < 4; c++)
+                rgba[c] = ImSoftDiv255(ImClamp((int)(col[0][c] * l0 + col[1][c] * l1 + col[2][c] * l2 + 0.5f), 0, 255) * texel[c]);
+        ImSoftBlend(dst, rgba[0], rgba[1], rgba[2], rgba[3]);
+    };
+
+    if (px1 - px0 <= IM_SOFT_SCAN_WIDTH)
+    {
+        for (int py = py0; py < py1; py++)
+        {
+            ImS64 w[3] = { row[0], row[1], row[2] };
+            unsigned char* dst = target.Pixels + ((size_t)py * target.Width + px0) * 4;
+            bool entered = false;
+            for (int px = px0; px < px1; px++, dst += 4)
+            {
+                if ((w[0] | w[1] | w[2]) >= 0)
+                {
+                    entered = true;
+                    shade(dst, w[0], w[1]);
+                }
+                else if (entered)
+                {
+                    // triangles are convex, the rest of the row is outside
+                    break;
+                }
+                w[0] += step_x[0]; w[1] += step_x[1]; w[2] += step_x[2];
+            }
+            row[0] += step_y[0]; row[1] += step_y[1]; row[2] += step_y[2];
+        }
+        return;
+    }
+
+    // pixels of a row inside an edge are where w + n * step_x >= 0, its bound n is estimated in floating point
+    // then made exact with one step each way
+    const ImS64 span = px1 - px0;
+    double inv_step_x[3];
+    for (int e = 0; e < 3; e++)
+        inv_step_x[e] = step_x[e] != 0 ? 1.0 / (double)step_x[e] : 0.0;
+    for (int py = py0; py < py1; py++)
+    {
+        ImS64 first = 0, last = span - 1;
+        for (int e = 0; e < 3; e++)
+        {
+            const ImS64 w = row[e], sx = step_x[e];
+            if (sx > 0)
+            {
+                ImS64 n = ImClamp((ImS64)ceil(-(double)w * inv_step_x[e]), (ImS64)0, span);
+                n += (ImS64)((n < span) & (w + n * sx < 0));
+                n -= (ImS64)((n > 0) & (w + (n - 1) * sx >= 0));
+                first = ImMax(first, n);
+            }
+            else if (sx < 0)
+            {
+                ImS64 n = ImClamp((ImS64)floor(-(double)w * inv_step_x[e]), (ImS64)-1, span - 1);
+                n += (ImS64)((n + 1 < span) & (w + (n + 1) * sx >= 0));
+                n -= (ImS64)((n >= 0) & (w + n * sx < 0));
+                last = ImMin(last, n);
+            }
+            else if (w < 0)
+            {
+                last = -1;
+            }
+        }
+        if (first <= last)
+        {
+            ImS64 w0 = row[0] + first * step_x[0], w1 = row[1] + first * step_x[1];
+            unsigned char* dst = target.Pixels + ((size_t)py * target.Width + px0 + first) * 4;
+            for (ImS64 n = first; n <= last; n++, dst += 4)
+            {
+                shade(dst, w0, w1);
+                w0 += step_x[0]; w1 += step_x[1];
+            }
+        }
+        row[0] += step_y[0]; row[1] += step_y[1]; row[2] += step_y[2];
+    }
+}
+
+// Whether triangles (a,b,c) and (a,c,d) make an axis aligned quad of one color with uv aligned to it, as PrimRect() and PrimRectUV() write them
+static inline bool ImSoftIsRect(const ImDrawVert& a, const ImDrawVert& b, const ImDrawVert& c, const ImDrawVert& d)
+{
+    if (a.col != b.col || a.col != c.col || a.col != d.col)
+        return false;
+    return a.pos.y == b.pos.y && b.pos.x == c.pos.x && c.pos.y == d.pos.y && d.pos.x == a.pos.x &&
+           a.uv.y == b.uv.y && b.uv.x == c.uv.x && c.uv.y == d.uv.y && d.uv.x == a.uv.x;
+}
+
+void ImDrawDataToMat(const ImDrawData* draw_data, ImMat& mat, ImU32 clear_color)
+{
+    const int width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
+    const int height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+    if (width <= 0 || height <= 0)
+    {
+        mat.release();
+        return;
+    }
+    mat.create(width, height, 4, (size_t)1, 4); // keeps the buffer of a mat of the same size
+
+    ImSoftTarget target;
+    target.Pixels = (unsigned char*)mat.data;
+    target.Width = width;
+    target.Height = height;
+    unsigned char clear[4] = { (unsigned char)(clear_color >> IM_COL32_R_SHIFT), (unsigned char)(clear_color >> IM_COL32_G_SHIFT), (unsigned char)(clear_color >> IM_COL32_B_SHIFT), (unsigned char)(clear_color >> IM_COL32_A_SHIFT) };
+    for (size_t i = 0; i < (size_t)width * height; i++)
+        memcpy(target.Pixels + i * 4, clear, 4);
+
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    ImSoftTexture font;
+    font.Pixels = atlas->TexPixelsRGBA32 ? (const unsigned char*)atlas->TexPixelsRGBA32 : atlas->TexPixelsAlpha8;
+    font.Alpha8 = atlas->TexPixelsRGBA32 == nullptr;
+    font.Width = atlas->TexWidth;
+    font.Height = atlas->TexHeight;
+
+    const ImVec2 offset = draw_data->DisplayPos;
+    const ImVec2 scale = draw_data->FramebufferScale;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback != nullptr)
+            {
+                if (pcmd->UserCallback != ImDrawCallback_ResetRenderState)
+                    pcmd->UserCallback(cmd_list, pcmd);
+                continue;
+            }
+            // scissor like the backends do
+            target.ClipMinX = ImMax(0, (int)((pcmd->ClipRect.x - offset.x) * scale.x));
+            target.ClipMinY = ImMax(0, (int)((pcmd->ClipRect.y - offset.y) * scale.y));
+            target.ClipMaxX = ImMin(width, (int)((pcmd->ClipRect.z - offset.x) * scale.x));
+            target.ClipMaxY = ImMin(height, (int)((pcmd->ClipRect.w - offset.y) * scale.y));
+            if (target.ClipMinX >= target.ClipMaxX || target.ClipMinY >= target.ClipMaxY)
+                continue;
+            const ImSoftTexture* tex = pcmd->GetTexID() == atlas->TexID ? &font : nullptr;
+            const ImDrawVert* vtx = cmd_list->VtxBuffer.Data + pcmd->VtxOffset;
+            const ImDrawIdx* idx = cmd_list->IdxBuffer.Data + pcmd->IdxOffset;
+            const unsigned int count = pcmd->ElemCount;
+            for (unsigned int i = 0; i + 2 < count; i += 3)
+            {
+                const ImDrawVert& a = vtx[idx[i]];
+                const ImDrawVert& b = vtx[idx[i + 1]];
+                const ImDrawVert& c = vtx[idx[i + 2]];
+                if (i + 5 < count && idx[i + 3] == idx[i] && idx[i + 4] == idx[i + 2])
+                {
+                    const ImDrawVert& d = vtx[idx[i + 5]];
+                    if (ImSoftIsRect(a, b, c, d))
+                    {
+                        ImSoftRasterRect(target, tex, (a.pos.x - offset.x) * scale.x, (a.pos.y - offset.y) * scale.y, (c.pos.x - offset.x) * scale.x, (c.pos.y - offset.y) * scale.y, a.uv, c.uv, a.col);
+                        i += 3;
+                        continue;
+                    }
+                }
+                ImSoftRasterTriangle(target, tex, &a, &b, &c, offset, scale);
+            }
+        }
+    }
+}
+
+bool ImMatToFile(const ImMat& mat, std::string path)
+{
+    if (mat.empty() || mat.type != IM_DT_INT8 || (mat.c > 1 && mat.elempack != mat.c))
+        return false;
+    return WriteImageFile(path, mat.w, mat.h, mat.c, mat.data);
+}
+// add by Dicky end
+
 void ImShowVideoWindow(ImDrawList *draw_list, ImTextureID texture, ImVec2 pos, ImVec2 size, float zoom_size, float* offset_x, float* offset_y, float* tf_x, float* tf_y, bool bLandscape, bool out_border, const ImVec2& uvMin, const ImVec2& uvMax)
 {
     // draw background
@@ -20,6 +20,12 @@ IMGUI_API bool ImTextureToFile(ImTextureID texture, std::string path);
 IMGUI_API void ImMatToTexture(ImMat mat, ImTextureID& texture);
 IMGUI_API void ImTextureToMat(ImTextureID texture, ImMat& mat, ImVec2 offset = {}, ImVec2 size = {});
 IMGUI_API void ImCopyToTexture(ImTextureID& imtexid, unsigned char* pixels, int width, int height, int channels, int offset_x, int offset_y, bool is_immat=false);
+// add by Dicky for software rendering
+// Rasterizes draw data on the CPU into a 4 channel 8 bit mat of its framebuffer size, with the context that rendered it current.
+// Blends like the renderer backends do, only the font atlas texture is sampled and other textures are drawn white.
+IMGUI_API void ImDrawDataToMat(const ImDrawData* draw_data, ImMat& mat, ImU32 clear_color = IM_COL32_BLACK);
+IMGUI_API bool ImMatToFile(const ImMat& mat, std::string path); // png, jpg, bmp or tga from the path suffix (png without one), 8 bit mats only
+// add by Dicky end
 #if IMGUI_RENDERING_VULKAN && IMGUI_VULKAN_SHADER
 //IMGUI_API ImTextureID ImCreateTexture(VkImageMat & image, double time_stamp = NAN);
 #endif
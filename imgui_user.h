@@ -39,6 +39,35 @@ IMGUI_API void      sleep(float seconds);
 IMGUI_API void      sleep(int ms_seconds);
 } // namespace ImGui
 
+// Frame profiler
+// Disabled by default; build with IMGUI_ENABLE_PROFILER (cmake -DIMGUI_PROFILER=ON) then set io.ConfigProfilerEnabled.
+// Records per-phase CPU timings of the last IMGUI_PROFILER_HISTORY frames, see 'Metrics/Debugger->Profiler'.
+// Scope names are not copied: use string literals.
+#ifndef IMGUI_ENABLE_PROFILER
+#define IMGUI_ENABLE_PROFILER 0
+#endif
+namespace ImGui
+{
+IMGUI_API void      ProfilerBeginScope(ImGuiProfilerPhase phase, const char* name = NULL, ImGuiID id = 0);
+IMGUI_API void      ProfilerEndScope();
+IMGUI_API bool      SaveProfilerTrace(const char* filename);    // Write recorded frames as Chrome trace event JSON (chrome://tracing, ui.perfetto.dev). Return false if nothing was written.
+} // namespace ImGui
+
+struct ImGuiProfilerScope
+{
+    ImGuiProfilerScope(ImGuiProfilerPhase phase, const char* name = NULL, ImGuiID id = 0) { ImGui::ProfilerBeginScope(phase, name, id); }
+    ~ImGuiProfilerScope() { ImGui::ProfilerEndScope(); }
+};
+
+#define IMGUI_PROFILER_CONCAT_IMPL(_A, _B)  _A##_B
+#define IMGUI_PROFILER_CONCAT(_A, _B)       IMGUI_PROFILER_CONCAT_IMPL(_A, _B)
+#if IMGUI_ENABLE_PROFILER
+#define IMGUI_PROFILER_SCOPE(_PHASE, _NAME, _ID)    ImGuiProfilerScope IMGUI_PROFILER_CONCAT(imgui_profiler_scope_, __LINE__)(_PHASE, _NAME, _ID)
+#else
+#define IMGUI_PROFILER_SCOPE(_PHASE, _NAME, _ID)    ((void)0)
+#endif
+#define IMGUI_PROFILER_USER_SCOPE(_NAME)            IMGUI_PROFILER_SCOPE(ImGuiProfilerPhase_User, _NAME, 0)
+
 #include <imgui_texture.h>
 
 #if IMGUI_ICONS
@@ -3814,15 +3814,34 @@ static void STB_TEXTEDIT_DELETECHARS(ImGuiInputTextState* obj, int pos, int n)
     ImWchar* dst = obj->TextW.Data + pos;
 
     // We maintain our buffer length in both UTF-8 and wchar formats
+    const int n_utf8 = ImTextCountUtf8BytesFromStr(dst, dst + n);
+    // add by Dicky for large text
+    if (obj->LineIndexValid)
+    {
+        // Keep TextA and line index in sync: drop lines starting inside the deleted range and shift the following ones
+        const int line_first = obj->LineIndexFind(pos);
+        const int line_last = obj->LineIndexFind(pos + n);
+        const int pos_utf8 = obj->LineStartA[line_first] + ImTextCountUtf8BytesFromStr(obj->TextW.Data + obj->LineStartW[line_first], dst);
+        memmove(obj->TextA.Data + pos_utf8, obj->TextA.Data + pos_utf8 + n_utf8, (size_t)(obj->CurLenA - pos_utf8 - n_utf8 + 1));
+        const int lines_removed = line_last - line_first;
+        if (lines_removed > 0)
+        {
+            obj->LineStartW.erase(obj->LineStartW.Data + line_first + 1, obj->LineStartW.Data + line_last + 1);
+            obj->LineStartA.erase(obj->LineStartA.Data + line_first + 1, obj->LineStartA.Data + line_last + 1);
+        }
+        for (int line_no = line_first + 1; line_no < obj->LineStartW.Size; line_no++)
+        {
+            obj->LineStartW.Data[line_no] -= n;
+            obj->LineStartA.Data[line_no] -= n_utf8;
+        }
+    }
+    // add by Dicky end
     obj->Edited = true;
-    obj->CurLenA -= ImTextCountUtf8BytesFromStr(dst, dst + n);
+    obj->CurLenA -= n_utf8;
     obj->CurLenW -= n;
 
-    // Offset remaining text (FIXME-OPT: Use memmove)
-    const ImWchar* src = obj->TextW.Data + pos + n;
-    while (ImWchar c = *src++)
-        *dst++ = c;
-    *dst = '\0';
+    // Offset remaining text
+    memmove(dst, dst + n, (size_t)(obj->CurLenW - pos + 1) * sizeof(ImWchar));
 }
 
 static bool STB_TEXTEDIT_INSERTCHARS(ImGuiInputTextState* obj, int pos, const ImWchar* new_text, int new_text_len)
@@ -3845,6 +3864,51 @@ static bool STB_TEXTEDIT_INSERTCHARS(ImGuiInputTextState* obj, int pos, const Im
     }
 
     ImWchar* text = obj->TextW.Data;
+    // add by Dicky for large text
+    if (obj->LineIndexValid)
+    {
+        // Keep TextA and line index in sync: shift the following lines and register new lines from the inserted text
+        const int line_no = obj->LineIndexFind(pos);
+        const int pos_utf8 = obj->LineStartA[line_no] + ImTextCountUtf8BytesFromStr(text + obj->LineStartW[line_no], text + pos);
+        if (obj->CurLenA + new_text_len_utf8 + 1 > obj->TextA.Size)
+            obj->TextA.resize(obj->CurLenA + ImMax(new_text_len_utf8 * 2, obj->CurLenA / 2) + 1);
+        char* text_a = obj->TextA.Data;
+        memmove(text_a + pos_utf8 + new_text_len_utf8, text_a + pos_utf8, (size_t)(obj->CurLenA - pos_utf8 + 1));
+        const char backup_c = text_a[pos_utf8 + new_text_len_utf8]; // ImTextStrToUtf8() writes a zero-terminator
+        ImTextStrToUtf8(text_a + pos_utf8, new_text_len_utf8 + 1, new_text, new_text + new_text_len);
+        text_a[pos_utf8 + new_text_len_utf8] = backup_c;
+
+        for (int n = line_no + 1; n < obj->LineStartW.Size; n++)
+        {
+            obj->LineStartW.Data[n] += new_text_len;
+            obj->LineStartA.Data[n] += new_text_len_utf8;
+        }
+        int new_lines = 0;
+        for (int n = 0; n < new_text_len; n++)
+            if (new_text[n] == '\n')
+                new_lines++;
+        if (new_lines > 0)
+        {
+            const int old_count = obj->LineStartW.Size;
+            obj->LineStartW.resize(old_count + new_lines);
+            obj->LineStartA.resize(old_count + new_lines);
+            memmove(obj->LineStartW.Data + line_no + 1 + new_lines, obj->LineStartW.Data + line_no + 1, (size_t)(old_count - line_no - 1) * sizeof(int));
+            memmove(obj->LineStartA.Data + line_no + 1 + new_lines, obj->LineStartA.Data + line_no + 1, (size_t)(old_count - line_no - 1) * sizeof(int));
+            int dst_line = line_no + 1;
+            int offset_utf8 = pos_utf8;
+            const ImWchar* segment_begin = new_text;
+            for (int n = 0; n < new_text_len; n++)
+                if (new_text[n] == '\n')
+                {
+                    offset_utf8 += ImTextCountUtf8BytesFromStr(segment_begin, new_text + n + 1);
+                    segment_begin = new_text + n + 1;
+                    obj->LineStartW.Data[dst_line] = pos + n + 1;
+                    obj->LineStartA.Data[dst_line] = offset_utf8;
+                    dst_line++;
+                }
+        }
+    }
+    // add by Dicky end
     if (pos != text_len)
         memmove(text + pos + new_text_len, text + pos, (size_t)(text_len - pos) * sizeof(ImWchar));
     memcpy(text + pos, new_text, (size_t)new_text_len * sizeof(ImWchar));
@@ -3857,6 +3921,40 @@ static bool STB_TEXTEDIT_INSERTCHARS(ImGuiInputTextState* obj, int pos, const Im
     return true;
 }
 
+// add by Dicky for large text
+// Optional row seeking used by stb_textedit.h: with a line index we can jump close to the target row instead of laying out every row from the top.
+// We position on the row before the target so the regular stb_textedit loop resolves the exact row with identical semantics (e.g. trailing newline).
+static void STB_TEXTEDIT_SEEKROW_CHAR_IMPL(ImGuiInputTextState* obj, int n, int* row_start, int* prev_row_start, float* row_y)
+{
+    *row_start = *prev_row_start = 0;
+    *row_y = 0.0f;
+    if (!obj->LineIndexValid)
+        return;
+    const int line_no = obj->LineIndexFind(n) - 1;
+    if (line_no <= 0)
+        return;
+    *row_start = obj->LineStartW[line_no];
+    *prev_row_start = obj->LineStartW[line_no - 1];
+    *row_y = line_no * obj->Ctx->FontSize;
+}
+
+static void STB_TEXTEDIT_SEEKROW_Y_IMPL(ImGuiInputTextState* obj, float y, int* row_start, float* row_y)
+{
+    *row_start = 0;
+    *row_y = 0.0f;
+    if (!obj->LineIndexValid)
+        return;
+    const float line_height = obj->Ctx->FontSize;
+    const int line_no = ImMin((int)(y / line_height) - 1, obj->LineStartW.Size - 1);
+    if (line_no <= 0)
+        return;
+    *row_start = obj->LineStartW[line_no];
+    *row_y = line_no * line_height;
+}
+#define STB_TEXTEDIT_SEEKROW_CHAR   STB_TEXTEDIT_SEEKROW_CHAR_IMPL  // They need to be #define for stb_textedit.h
+#define STB_TEXTEDIT_SEEKROW_Y      STB_TEXTEDIT_SEEKROW_Y_IMPL
+// add by Dicky end
+
 // We don't use an enum so we can build even with conflicting symbols (if another user of stb_textedit.h leak their STB_TEXTEDIT_K_* symbols)
 #define STB_TEXTEDIT_K_LEFT         0x200000 // keyboard input to move cursor left
 #define STB_TEXTEDIT_K_RIGHT        0x200001 // keyboard input to move cursor right
@@ -3907,6 +4005,48 @@ void ImGuiInputTextState::OnKeyPressed(int key)
     CursorAnimReset();
 }
 
+// add by Dicky for large text
+void ImGuiInputTextState::LineIndexBuild()
+{
+    // TextA is kept at least as large as the end-user buffer capacity so callbacks can write into it
+    TextA.resize(ImMax(ImTextCountUtf8BytesFromStr(TextW.Data, TextW.Data + CurLenW), BufCapacityA) + 1);
+    CurLenA = ImTextStrToUtf8(TextA.Data, TextA.Size, TextW.Data, TextW.Data + CurLenW);
+    TextAIsValid = true;
+
+    LineStartW.resize(0);
+    LineStartA.resize(0);
+    LineStartW.push_back(0);
+    LineStartA.push_back(0);
+    const char* text_a = TextA.Data;
+    const char* text_a_end = text_a + CurLenA;
+    for (const char* p = text_a; (p = (const char*)memchr(p, '\n', (size_t)(text_a_end - p))) != NULL; )
+    {
+        p++;
+        LineStartA.push_back((int)(p - text_a));
+    }
+    // Convert UTF-8 line starts to wchar indices, one line at a time
+    LineStartW.resize(LineStartA.Size);
+    for (int line_no = 1; line_no < LineStartA.Size; line_no++)
+        LineStartW[line_no] = LineStartW[line_no - 1] + ImTextCountCharsFromUtf8(text_a + LineStartA[line_no - 1], text_a + LineStartA[line_no]);
+    LineIndexValid = true;
+}
+
+int ImGuiInputTextState::LineIndexFind(int pos) const
+{
+    IM_ASSERT(LineIndexValid && LineStartW.Size > 0);
+    int lo = 0, hi = LineStartW.Size - 1;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi + 1) >> 1;
+        if (LineStartW[mid] <= pos)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    return lo;
+}
+// add by Dicky end
+
 ImGuiInputTextCallbackData::ImGuiInputTextCallbackData()
 {
     memset(this, 0, sizeof(*this));
@@ -4228,6 +4368,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
     const bool is_password = (flags & ImGuiInputTextFlags_Password) != 0;
     const bool is_undoable = (flags & ImGuiInputTextFlags_NoUndoRedo) == 0;
     const bool is_resizable = (flags & ImGuiInputTextFlags_CallbackResize) != 0;
+    const bool is_large_text = is_multiline && !is_readonly && (flags & ImGuiInputTextFlags_LargeText) != 0; // add by Dicky for large text
     if (is_resizable)
         IM_ASSERT(callback != NULL); // Must provide a callback if you set the ImGuiInputTextFlags_CallbackResize flag!
 
@@ -4274,6 +4415,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         state->TextAIsValid = false;                // TextA is not valid yet (we will display buf until then)
         state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, buf_size, buf, NULL, &buf_end);
         state->CurLenA = (int)(buf_end - buf);      // We can't get the result from ImStrncpy() above because it is not UTF-8 aware. Here we'll cut off malformed UTF-8.
+        state->LineIndexValid = false;              // add by Dicky for large text, built when we become active
 
         if (recycle_state)
         {
@@ -4352,6 +4494,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         state->TextW.resize(buf_size + 1);
         state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, buf, NULL, &buf_end);
         state->CurLenA = (int)(buf_end - buf);
+        state->LineIndexValid = false; // add by Dicky for large text
         state->CursorClamp();
         render_selection &= state->HasSelection();
     }
@@ -4386,6 +4529,14 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         state->BufCapacityA = buf_size;
         state->Flags = flags;
 
+        // add by Dicky for large text
+        // Build line index once on activation (or when the flag is toggled), it is then maintained by STB_TEXTEDIT_INSERTCHARS/STB_TEXTEDIT_DELETECHARS
+        if (is_large_text && !state->LineIndexValid)
+            state->LineIndexBuild();
+        else if (!is_large_text)
+            state->LineIndexValid = false;
+        // add by Dicky end
+
         // Although we are active we don't prevent mouse from hovering other elements unless we are interacting right now with the widget.
         // Down the line we should have a cleaner library-wide concept of Selected vs Active.
         g.ActiveIdAllowOverlap = !io.MouseDown[0];
@@ -4679,7 +4830,13 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         }
 
         // Apply ASCII value
-        if (!is_readonly)
+        if (!is_readonly && state->LineIndexValid)
+        {
+            // add by Dicky for large text, TextA is already in sync, only make sure callbacks can use the full buffer capacity
+            if (state->TextA.Size < state->BufCapacityA + 1)
+                state->TextA.resize(state->BufCapacityA + 1);
+        }
+        else if (!is_readonly)
         {
             state->TextAIsValid = true;
             state->TextA.resize(state->TextW.Size * 4 + 1);
@@ -4774,6 +4931,8 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                             state->TextW.resize(state->TextW.Size + (callback_data.BufTextLen - backup_current_text_length)); // Worse case scenario resize
                         state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, callback_data.Buf, NULL);
                         state->CurLenA = callback_data.BufTextLen;  // Assume correct length and valid UTF-8 from user, saves us an extra strlen()
+                        if (state->LineIndexValid)
+                            state->LineIndexBuild();                // add by Dicky for large text
                         state->CursorAnimReset();
                     }
                 }
@@ -4899,28 +5058,41 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
 
             // Iterate all lines to find our line numbers
             // In multi-line mode, we never exit the loop until all lines are counted, so add one extra to the searches_remaining counter.
-            searches_remaining += is_multiline ? 1 : 0;
             int line_count = 0;
-            //for (const ImWchar* s = text_begin; (s = (const ImWchar*)wcschr((const wchar_t*)s, (wchar_t)'\n')) != NULL; s++)  // FIXME-OPT: Could use this when wchar_t are 16-bit
-            for (const ImWchar* s = text_begin; *s != 0; s++)
-                if (*s == '\n')
-                {
-                    line_count++;
-                    if (searches_result_line_no[0] == -1 && s >= searches_input_ptr[0]) { searches_result_line_no[0] = line_count; if (--searches_remaining <= 0) break; }
-                    if (searches_result_line_no[1] == -1 && s >= searches_input_ptr[1]) { searches_result_line_no[1] = line_count; if (--searches_remaining <= 0) break; }
-                }
-            line_count++;
-            if (searches_result_line_no[0] == -1)
-                searches_result_line_no[0] = line_count;
-            if (searches_result_line_no[1] == -1)
-                searches_result_line_no[1] = line_count;
+            if (state->LineIndexValid)
+            {
+                // add by Dicky for large text, lookup from the line index instead of scanning the whole buffer
+                line_count = state->LineIndexCount();
+                for (int n = 0; n < 2; n++)
+                    if (searches_result_line_no[n] == -1)
+                        searches_result_line_no[n] = state->LineIndexFind((int)(searches_input_ptr[n] - text_begin)) + 1;
+            }
+            else
+            {
+                searches_remaining += is_multiline ? 1 : 0;
+                //for (const ImWchar* s = text_begin; (s = (const ImWchar*)wcschr((const wchar_t*)s, (wchar_t)'\n')) != NULL; s++)  // FIXME-OPT: Could use this when wchar_t are 16-bit
+                for (const ImWchar* s = text_begin; *s != 0; s++)
+                    if (*s == '\n')
+                    {
+                        line_count++;
+                        if (searches_result_line_no[0] == -1 && s >= searches_input_ptr[0]) { searches_result_line_no[0] = line_count; if (--searches_remaining <= 0) break; }
+                        if (searches_result_line_no[1] == -1 && s >= searches_input_ptr[1]) { searches_result_line_no[1] = line_count; if (--searches_remaining <= 0) break; }
+                    }
+                line_count++;
+                if (searches_result_line_no[0] == -1)
+                    searches_result_line_no[0] = line_count;
+                if (searches_result_line_no[1] == -1)
+                    searches_result_line_no[1] = line_count;
+            }
 
             // Calculate 2d position by finding the beginning of the line and measuring distance
-            cursor_offset.x = InputTextCalcTextSizeW(&g, ImStrbolW(searches_input_ptr[0], text_begin), searches_input_ptr[0]).x;
+            const ImWchar* cursor_line_begin = state->LineIndexValid ? text_begin + state->LineStartW[searches_result_line_no[0] - 1] : ImStrbolW(searches_input_ptr[0], text_begin); // modify by Dicky for large text
+            cursor_offset.x = InputTextCalcTextSizeW(&g, cursor_line_begin, searches_input_ptr[0]).x;
             cursor_offset.y = searches_result_line_no[0] * g.FontSize;
             if (searches_result_line_no[1] >= 0)
             {
-                select_start_offset.x = InputTextCalcTextSizeW(&g, ImStrbolW(searches_input_ptr[1], text_begin), searches_input_ptr[1]).x;
+                const ImWchar* select_line_begin = state->LineIndexValid ? text_begin + state->LineStartW[searches_result_line_no[1] - 1] : ImStrbolW(searches_input_ptr[1], text_begin); // modify by Dicky for large text
+                select_start_offset.x = InputTextCalcTextSizeW(&g, select_line_begin, searches_input_ptr[1]).x;
                 select_start_offset.y = searches_result_line_no[1] * g.FontSize;
             }
 
@@ -4979,7 +5151,15 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             {
                 if (rect_pos.y > clip_rect.w + g.FontSize)
                     break;
-                if (rect_pos.y < clip_rect.y)
+                if (rect_pos.y < clip_rect.y && state->LineIndexValid)
+                {
+                    // add by Dicky for large text, jump over all lines above the clip rectangle at once
+                    const int line_skip = ImMax((int)((clip_rect.y - rect_pos.y) / g.FontSize), 1);
+                    const int line_no = state->LineIndexFind((int)(p - text_begin)) + line_skip;
+                    p = (line_no < state->LineIndexCount()) ? ImMin(text_begin + state->LineStartW[line_no], text_selected_end) : text_selected_end;
+                    rect_pos.y += (line_skip - 1) * g.FontSize;
+                }
+                else if (rect_pos.y < clip_rect.y)
                 {
                     //p = (const ImWchar*)wmemchr((const wchar_t*)p, '\n', text_selected_end - p);  // FIXME-OPT: Could use this when wchar_t are 16-bit
                     //p = p ? p + 1 : text_selected_end;
@@ -5007,7 +5187,20 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             ImU32 col = GetColorU32(is_displaying_hint ? ImGuiCol_TextDisabled : ImGuiCol_Text);
             // modify by Dicky, disable text internationalize when user input
             if (!is_displaying_hint) ImGui::PushStyleVar(ImGuiStyleVar_TextInternationalize, 0);
-            draw_window->DrawList->AddText(g.Font, g.FontSize, draw_pos - draw_scroll, col, buf_display, buf_display_end, 0.0f, is_multiline ? NULL : &clip_rect);
+            if (state->LineIndexValid && !is_displaying_hint && buf_display == state->TextA.Data)
+            {
+                // add by Dicky for large text, only submit visible lines
+                const int line_count = state->LineIndexCount();
+                const int line_visible_min = ImClamp((int)((clip_rect.y - draw_pos.y) / g.FontSize), 0, line_count - 1);
+                const int line_visible_max = ImClamp((int)((clip_rect.w - draw_pos.y) / g.FontSize) + 1, line_visible_min, line_count - 1);
+                const char* line_visible_begin = buf_display + state->LineStartA[line_visible_min];
+                const char* line_visible_end = (line_visible_max + 1 < line_count) ? buf_display + state->LineStartA[line_visible_max + 1] : buf_display_end;
+                draw_window->DrawList->AddText(g.Font, g.FontSize, draw_pos - draw_scroll + ImVec2(0.0f, line_visible_min * g.FontSize), col, line_visible_begin, line_visible_end, 0.0f, NULL);
+            }
+            else
+            {
+                draw_window->DrawList->AddText(g.Font, g.FontSize, draw_pos - draw_scroll, col, buf_display, buf_display_end, 0.0f, is_multiline ? NULL : &clip_rect);
+            }
             if (!is_displaying_hint) ImGui::PopStyleVar();
             // modify by Dicky end
         }
@@ -8316,10 +8509,43 @@ static float ImGui::TabBarCalcMaxTabWidth()
 
 ImGuiTabItem* ImGui::TabBarFindTabByID(ImGuiTabBar* tab_bar, ImGuiID tab_id)
 {
-    if (tab_id != 0)
-        for (int n = 0; n < tab_bar->Tabs.Size; n++)
-            if (tab_bar->Tabs[n].ID == tab_id)
-                return &tab_bar->Tabs[n];
+    if (tab_id == 0)
+        return NULL;
+
+    // add by Dicky for large tab bars
+    // Dock nodes holding hundreds of windows look up every tab several times per frame, which is quadratic with a linear scan.
+    // Try the tab following the previous hit (windows of a node are visited in tab order), then the last known index.
+    // Tabs are added, removed and reordered in many places so the index is not maintained there: a stale entry
+    // simply fails the ID check and the whole index is rebuilt after the linear search.
+    const int index_min_tabs = 16;
+    const bool use_index = (tab_bar->Tabs.Size >= index_min_tabs);
+    if (use_index)
+    {
+        int idx = (tab_bar->TabsIndexLastFound + 1 < tab_bar->Tabs.Size) ? tab_bar->TabsIndexLastFound + 1 : 0;
+        if (tab_bar->Tabs[idx].ID != tab_id)
+            idx = tab_bar->TabsIndex.GetInt(tab_id, -1);
+        if (idx >= 0 && idx < tab_bar->Tabs.Size && tab_bar->Tabs[idx].ID == tab_id)
+        {
+            tab_bar->TabsIndexLastFound = idx;
+            return &tab_bar->Tabs[idx];
+        }
+    }
+    // add by Dicky end
+
+    for (int n = 0; n < tab_bar->Tabs.Size; n++)
+        if (tab_bar->Tabs[n].ID == tab_id)
+        {
+            if (use_index) // add by Dicky for large tab bars
+            {
+                tab_bar->TabsIndexLastFound = n;
+                tab_bar->TabsIndex.Data.resize(0);
+                tab_bar->TabsIndex.Data.reserve(tab_bar->Tabs.Size);
+                for (int tab_n = 0; tab_n < tab_bar->Tabs.Size; tab_n++)
+                    tab_bar->TabsIndex.Data.push_back(ImGuiStorage::ImGuiStoragePair(tab_bar->Tabs[tab_n].ID, tab_n));
+                tab_bar->TabsIndex.BuildSortByKey();
+            }
+            return &tab_bar->Tabs[n];
+        }
     return NULL;
 }
 
@@ -175,6 +175,8 @@
 //    STB_TEXTEDIT_K_LINEEND2            secondary keyboard input to move cursor to end of line
 //    STB_TEXTEDIT_K_TEXTSTART2          secondary keyboard input to move cursor to start of text
 //    STB_TEXTEDIT_K_TEXTEND2            secondary keyboard input to move cursor to end of text
+//    STB_TEXTEDIT_SEEKROW_CHAR(obj,n,&row,&prev_row,&y)  [DEAR IMGUI] start row search at a row before character n (e.g. from a line index)
+//    STB_TEXTEDIT_SEEKROW_Y(obj,y,&row,&row_y)           [DEAR IMGUI] start row search at a row above display position y
 //
 // Keyboard input must be encoded as a single integer value; e.g. a character code
 // and some bitflags that represent shift states. to simplify the interface, SHIFT must
@@ -411,6 +413,9 @@ static int stb_text_locate_coord(IMSTB_TEXTEDIT_STRING *str, float x, float y)
    r.num_chars = 0;
 
    // search rows to find one that straddles 'y'
+#ifdef STB_TEXTEDIT_SEEKROW_Y
+   STB_TEXTEDIT_SEEKROW_Y(str, y, &i, &base_y); // [DEAR IMGUI] optional: skip rows above 'y'
+#endif
    while (i < n) {
       STB_TEXTEDIT_LAYOUTROW(&r, str, i);
       if (r.num_chars <= 0)
@@ -539,6 +544,9 @@ static void stb_textedit_find_charpos(StbFindState *find, IMSTB_TEXTEDIT_STRING
 
    // search rows to find the one that straddles character n
    find->y = 0;
+#ifdef STB_TEXTEDIT_SEEKROW_CHAR
+   STB_TEXTEDIT_SEEKROW_CHAR(str, n, &i, &prev_start, &find->y); // [DEAR IMGUI] optional: skip rows before character n
+#endif
 
    for(;;) {
       STB_TEXTEDIT_LAYOUTROW(&r, str, i);
@@ -0,0 +1,153 @@
+// ImGuiFileDialog file list benchmark: writes a folder of empty files (with some sub folders), opens it, then reports
+// the time of the sort on each column and of the search while a query is typed char by char, then erased. The count of
+// files found by each search is checked against FileInfos::SearchForTag. The folder is kept for the next runs.
+//
+// Usage: file_dialog_list_bench [files] [folder] [query]
+#include <imgui.h>
+#include <imgui_helper.h>
+#include <ImGuiFileDialog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+static bool WriteFiles(const std::string& folder, int count)
+{
+    static const char* words[] = { "Report", "photo", "Invoice", "backup", "draft", "Notes", "render", "scan", "Track", "mesh" };
+    static const char* exts[] = { ".txt", ".png", ".JPG", ".cpp", ".h", ".tar.gz", ".json", "" };
+    ImGuiHelper::create_directory(folder);
+    char path[1024];
+    for (int n = 0; n < count; n++)
+    {
+        if (n % 100 == 0)
+        {
+            snprintf(path, IM_ARRAYSIZE(path), "%s/folder_%07d", folder.c_str(), n);
+            ImGuiHelper::create_directory(path);
+            continue;
+        }
+        snprintf(path, IM_ARRAYSIZE(path), "%s/%s_%07d%s", folder.c_str(), words[(n * 7) % IM_ARRAYSIZE(words)], n, exts[(n * 13) % IM_ARRAYSIZE(exts)]);
+        if (ImGuiHelper::file_exists(path))
+            continue;
+        FILE* file = fopen(path, "wb");
+        if (!file)
+            return false;
+        fclose(file);
+    }
+    return true;
+}
+
+class BenchDialog : public ImGuiFileDialog
+{
+public:
+    void Frame()
+    {
+        ImGuiIO& io = ImGui::GetIO();
+        io.DisplaySize = ImVec2(1920, 1080);
+        io.DeltaTime = 1.0f / 60.0f;
+        ImGui::NewFrame();
+        Display("bench", ImGuiWindowFlags_NoCollapse, io.DisplaySize, io.DisplaySize);
+        ImGui::Render();
+    }
+
+    IGFD::FileManager& Files() { return m_FileDialogInternal.fileManager; }
+
+    double Sort(IGFD::FileManager::SortingFieldEnum field, bool ascending)
+    {
+        auto& files = Files();
+        files.sortingField = field;
+        files.sortingDirection[(int)field - 1] = ascending;
+        const double start = ImGui::get_current_time();
+        files.SortFields(m_FileDialogInternal);
+        // a sorting by size or date waits for the details of the files over the next frames
+        while (files.IsFileDetailsPending())
+            Frame();
+        return (ImGui::get_current_time() - start) * 1000.0;
+    }
+
+    // Set the search tag like the search bar, returns the time of the filtering
+    double Search(const std::string& tag, size_t& found, size_t& expected)
+    {
+        auto& search = m_FileDialogInternal.searchManager;
+        snprintf(search.searchBuffer, IM_ARRAYSIZE(search.searchBuffer), "%s", tag.c_str());
+        search.searchTag = search.searchBuffer;
+        const double start = ImGui::get_current_time();
+        Files().ApplyFilteringOnFileList(m_FileDialogInternal);
+        const double end = ImGui::get_current_time();
+        found = Files().GetFilteredListSize();
+        expected = 0;
+        for (size_t i = 0; i < Files().GetFullFileListSize(); i++)
+            expected += Files().GetFullFileAt(i)->SearchForTag(search.searchTag) ? 1 : 0;
+        return (end - start) * 1000.0;
+    }
+};
+
+int main(int argc, char ** argv)
+{
+    int count          = argc > 1 ? atoi(argv[1]) : 500000;
+    std::string folder = argc > 2 ? argv[2] : "file_dialog_list_bench";
+    std::string query  = argc > 3 ? argv[3] : "report_00123";
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    unsigned char* pixels = NULL;
+    int fontWidth = 0, fontHeight = 0;
+    io.Fonts->AddFontDefault();
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &fontWidth, &fontHeight);
+
+    double start = ImGui::get_current_time();
+    if (!WriteFiles(folder, count))
+    {
+        printf("can't write the files in %s\n", folder.c_str());
+        return 1;
+    }
+    printf("%d entries in %s, written in %.2f s\n", count, folder.c_str(), ImGui::get_current_time() - start);
+
+    BenchDialog dialog;
+    auto& files = dialog.Files();
+    start = ImGui::get_current_time();
+    dialog.OpenDialog("bench", "List", ".*", folder + "/");
+    do
+    {
+        dialog.Frame();
+    } while (files.IsScanDirWorking());
+    printf("scan of %zu files: %.1f ms\n", files.GetFullFileListSize(), (ImGui::get_current_time() - start) * 1000.0);
+
+    typedef IGFD::FileManager::SortingFieldEnum Field;
+    printf("sort:\n");
+    printf("  %-28s %8.1f ms\n", "size (with stat of files)", dialog.Sort(Field::FIELD_SIZE, true));
+    const struct { const char* name; Field field; bool ascending; } sorts[] = {
+        { "name ascending", Field::FIELD_FILENAME, true }, { "name descending", Field::FIELD_FILENAME, false },
+        { "type ascending", Field::FIELD_TYPE, true }, { "type descending", Field::FIELD_TYPE, false },
+        { "size ascending", Field::FIELD_SIZE, true }, { "date ascending", Field::FIELD_DATE, true },
+        { "name ascending", Field::FIELD_FILENAME, true },
+    };
+    for (const auto& sort : sorts)
+        printf("  %-28s %8.1f ms\n", sort.name, dialog.Sort(sort.field, sort.ascending));
+
+    printf("search:\n");
+    bool valid = true;
+    std::string tag;
+    auto search = [&](const char* step)
+    {
+        size_t found = 0, expected = 0;
+        const double time = dialog.Search(tag, found, expected);
+        printf("  %-8s %-16s %8.2f ms, %7zu found%s\n", step, ("\"" + tag + "\"").c_str(), time, found, found == expected ? "" : " (mismatch)");
+        valid = valid && found == expected;
+    };
+    for (char c : query)
+    {
+        tag += c;
+        search("type");
+    }
+    while (!tag.empty())
+    {
+        tag.pop_back();
+        search("erase");
+    }
+
+    dialog.Close();
+    ImGui::DestroyContext();
+    return valid ? 0 : 1;
+}
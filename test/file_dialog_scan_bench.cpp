@@ -0,0 +1,117 @@
+// ImGuiFileDialog directory scan benchmark: writes a folder of empty files, then opens it sorted by name and reports
+// the first, slowest and total frame time until all the files are listed. The sorting is then switched to size, which
+// needs the size of each file, and the frames are measured until the list is sorted. At last the folder is opened
+// again already sorted by date, so the scan thread retrieves the dates. The folder is kept for the next runs.
+//
+// Usage: file_dialog_scan_bench [files] [folder]
+#include <imgui.h>
+#include <imgui_helper.h>
+#include <ImGuiFileDialog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+static bool WriteFiles(const std::string& folder, int count)
+{
+    ImGuiHelper::create_directory(folder);
+    char path[1024];
+    for (int n = 0; n < count; n++)
+    {
+        snprintf(path, IM_ARRAYSIZE(path), "%s/file_%07d.txt", folder.c_str(), n);
+        if (ImGuiHelper::file_exists(path))
+            continue;
+        FILE* file = fopen(path, "wb");
+        if (!file)
+            return false;
+        fclose(file);
+    }
+    return true;
+}
+
+class BenchDialog : public ImGuiFileDialog
+{
+public:
+    double Frame()
+    {
+        ImGuiIO& io = ImGui::GetIO();
+        io.DisplaySize = ImVec2(1920, 1080);
+        io.DeltaTime = 1.0f / 60.0f;
+        const double start = ImGui::get_current_time();
+        ImGui::NewFrame();
+        Display("bench", ImGuiWindowFlags_NoCollapse, io.DisplaySize, io.DisplaySize);
+        ImGui::Render();
+        return (ImGui::get_current_time() - start) * 1000.0;
+    }
+
+    IGFD::FileManager& Files() { return m_FileDialogInternal.fileManager; }
+
+    void SetSorting(IGFD::FileManager::SortingFieldEnum field)
+    {
+        Files().sortingField = field;
+        Files().sortingDirection[(int)field - 1] = true;
+    }
+
+    // Like a click on a header, returns the time of the sorting
+    double Sort(IGFD::FileManager::SortingFieldEnum field)
+    {
+        SetSorting(field);
+        const double start = ImGui::get_current_time();
+        Files().SortFields(m_FileDialogInternal);
+        return (ImGui::get_current_time() - start) * 1000.0;
+    }
+
+    // Runs frames while the list is loading, starting with the time already spent by the caller
+    void Measure(const char* name, double first_ms)
+    {
+        double slowest_ms = first_ms, total_ms = first_ms;
+        int frames = 1;
+        while (Files().IsScanDirWorking() || Files().IsFileDetailsPending())
+        {
+            const double ms = Frame();
+            slowest_ms = ms > slowest_ms ? ms : slowest_ms;
+            total_ms += ms;
+            frames++;
+        }
+        printf("  %-26s first %8.1f ms, slowest %8.1f ms, %4d frames, total %8.1f ms, %zu files\n", name, first_ms, slowest_ms, frames, total_ms, Files().GetFullFileListSize());
+    }
+};
+
+int main(int argc, char ** argv)
+{
+    int count          = argc > 1 ? atoi(argv[1]) : 200000;
+    std::string folder = argc > 2 ? argv[2] : "file_dialog_scan_bench";
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    unsigned char* pixels = NULL;
+    int fontWidth = 0, fontHeight = 0;
+    io.Fonts->AddFontDefault();
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &fontWidth, &fontHeight);
+
+    double start = ImGui::get_current_time();
+    if (!WriteFiles(folder, count))
+    {
+        printf("can't write the files in %s\n", folder.c_str());
+        return 1;
+    }
+    printf("%d files in %s, written in %.2f s\n", count, folder.c_str(), ImGui::get_current_time() - start);
+
+    typedef IGFD::FileManager::SortingFieldEnum Field;
+    BenchDialog dialog;
+    dialog.SetSorting(Field::FIELD_FILENAME);
+    dialog.OpenDialog("bench", "Scan", ".*", folder + "/");
+    dialog.Measure("scan sorted by name", dialog.Frame());
+
+    const double sort_ms = dialog.Sort(Field::FIELD_SIZE);
+    dialog.Measure("then sort by size", sort_ms + dialog.Frame());
+    dialog.Close();
+
+    dialog.SetSorting(Field::FIELD_DATE);
+    dialog.OpenDialog("bench", "Scan", ".*", folder + "/");
+    dialog.Measure("scan sorted by date", dialog.Frame());
+    dialog.Close();
+
+    ImGui::DestroyContext();
+    return 0;
+}
@@ -0,0 +1,207 @@
+// ImGuiFileDialog thumbnails benchmark: writes a folder of JPEG images, one out of two with an exif thumbnail like
+// the camera pictures, then opens it in the thumbnails list view and reports the time until every visible row shows
+// its thumbnail, and until every image of the folder has one. The first pass starts with an empty disk cache (cold),
+// the second one reads the thumbnails written by the first one (warm). The folder is kept for the next runs.
+// ImGuiFileDialog must be built with USE_THUMBNAILS.
+//
+// Usage: file_dialog_thumbnails_bench [images] [width] [height] [folder]
+#include <imgui.h>
+#include <imgui_helper.h>
+#include <ImGuiFileDialog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#ifdef USE_THUMBNAILS
+static void WriteToVector(void* context, void* data, int size)
+{
+    std::vector<unsigned char>* out = (std::vector<unsigned char>*)context;
+    out->insert(out->end(), (unsigned char*)data, (unsigned char*)data + size);
+}
+
+static void Put16(std::vector<unsigned char>& out, unsigned int value) { out.push_back((unsigned char)(value >> 8)); out.push_back((unsigned char)value); }
+static void Put32(std::vector<unsigned char>& out, unsigned int value) { Put16(out, value >> 16); Put16(out, value & 0xFFFF); }
+
+// A big endian tiff in an APP1 segment: an empty IFD0, then an IFD1 pointing to the thumbnail
+static std::vector<unsigned char> MakeExifSegment(const std::vector<unsigned char>& thumbnail)
+{
+    std::vector<unsigned char> tiff;
+    tiff.insert(tiff.end(), { 'M', 'M', 0, 42 });
+    Put32(tiff, 8);             // IFD0
+    Put16(tiff, 0);             // no entries
+    Put32(tiff, 14);            // IFD1
+    Put16(tiff, 2);
+    Put16(tiff, 0x0201); Put16(tiff, 4); Put32(tiff, 1); Put32(tiff, 14 + 2 + 2 * 12 + 4);
+    Put16(tiff, 0x0202); Put16(tiff, 4); Put32(tiff, 1); Put32(tiff, (unsigned int)thumbnail.size());
+    Put32(tiff, 0);
+    tiff.insert(tiff.end(), thumbnail.begin(), thumbnail.end());
+    std::vector<unsigned char> segment = { 0xFF, 0xE1 };
+    Put16(segment, (unsigned int)(2 + 6 + tiff.size()));
+    segment.insert(segment.end(), { 'E', 'x', 'i', 'f', 0, 0 });
+    segment.insert(segment.end(), tiff.begin(), tiff.end());
+    return segment;
+}
+
+static bool WriteImages(const std::string& folder, int count, int width, int height)
+{
+    ImGuiHelper::create_directory(folder);
+    std::vector<unsigned char> pixels((size_t)width * height * 3);
+    std::vector<unsigned char> small(160 * 120 * 3);
+    char path[1024];
+    for (int n = 0; n < count; n++)
+    {
+        snprintf(path, IM_ARRAYSIZE(path), "%s/image_%05d.jpg", folder.c_str(), n);
+        if (ImGuiHelper::file_exists(path))
+            continue;
+        for (int y = 0; y < height; y++)
+            for (int x = 0; x < width; x++)
+            {
+                unsigned char* p = &pixels[((size_t)y * width + x) * 3];
+                p[0] = (unsigned char)(x * 255 / width + n);
+                p[1] = (unsigned char)(y * 255 / height + n * 3);
+                p[2] = (unsigned char)((x ^ y) + n * 7);
+            }
+        std::vector<unsigned char> jpeg;
+        stbi_write_jpg_to_func(WriteToVector, &jpeg, width, height, 3, pixels.data(), 90);
+        if (n % 2)
+        {
+            const int smallHeight = 160 * height / width;
+            stbir_resize_uint8(pixels.data(), width, height, 0, small.data(), 160, smallHeight, 0, 3);
+            std::vector<unsigned char> thumbnail;
+            stbi_write_jpg_to_func(WriteToVector, &thumbnail, 160, smallHeight, 3, small.data(), 90);
+            const std::vector<unsigned char> exif = MakeExifSegment(thumbnail);
+            jpeg.insert(jpeg.begin() + 2, exif.begin(), exif.end());
+        }
+        FILE* file = fopen(path, "wb");
+        if (!file)
+            return false;
+        fwrite(jpeg.data(), 1, jpeg.size(), file);
+        fclose(file);
+    }
+    return true;
+}
+
+class BenchDialog : public ImGuiFileDialog
+{
+public:
+    BenchDialog(const std::string& cacheDir)
+    {
+        m_DisplayMode = DisplayModeEnum::THUMBNAILS_LIST;
+        SetThumbnailsCacheDir(cacheDir);
+        SetCreateThumbnailCallback([](IGFD_Thumbnail_Info* info)
+        {
+            info->textureID = (void*)(intptr_t)1;
+            info->isReadyToDisplay = true;
+            info->isReadyToUpload = false;
+            delete[] info->textureFileDatas;
+            info->textureFileDatas = nullptr;
+        });
+        SetDestroyThumbnailCallback([](IGFD_Thumbnail_Info*) {});
+    }
+
+    void Frame()
+    {
+        ImGuiIO& io = ImGui::GetIO();
+        io.DisplaySize = ImVec2(1920, 1080);
+        io.DeltaTime = 1.0f / 60.0f;
+        ImGui::NewFrame();
+        Display("bench", ImGuiWindowFlags_NoCollapse, io.DisplaySize, io.DisplaySize);
+        ImGui::Render();
+        ManageGPUThumbnails();
+    }
+
+    // Counts the thumbnails asked by the drawn rows, and the ones ready
+    void CountThumbnails(int& asked, int& ready)
+    {
+        asked = ready = 0;
+        auto& files = m_FileDialogInternal.fileManager;
+        for (size_t i = 0; i < files.GetFullFileListSize(); i++)
+        {
+            auto infos = files.GetFullFileAt(i);
+            asked += infos->thumbnailInfo.isLoadingOrLoaded ? 1 : 0;
+            ready += infos->thumbnailInfo.isReadyToDisplay ? 1 : 0;
+        }
+    }
+
+    void AskAllThumbnails()
+    {
+        auto& files = m_FileDialogInternal.fileManager;
+        for (size_t i = 0; i < files.GetFullFileListSize(); i++)
+        {
+            auto infos = files.GetFullFileAt(i);
+            if (!infos->thumbnailInfo.isLoadingOrLoaded)
+                m_AddThumbnailToLoad(infos);
+        }
+    }
+
+    bool IsScanning() { return m_FileDialogInternal.fileManager.IsScanDirWorking(); }
+};
+
+static void Bench(const char* name, const std::string& folder, const std::string& cacheDir, int count)
+{
+    BenchDialog dialog(cacheDir);
+    const double start = ImGui::get_current_time();
+    dialog.OpenDialog("bench", "Thumbnails", ".jpg", folder + "/");
+    int asked = 0, ready = 0, frames = 0;
+    do
+    {
+        dialog.Frame();
+        dialog.CountThumbnails(asked, ready);
+        frames++;
+    } while (dialog.IsScanning() || asked == 0 || ready < asked);
+    const double visible = ImGui::get_current_time();
+    const int visibleCount = ready;
+    dialog.AskAllThumbnails();
+    do
+    {
+        dialog.Frame();
+        dialog.CountThumbnails(asked, ready);
+    } while (ready < count);
+    const double all = ImGui::get_current_time();
+    printf("  %-5s %d visible thumbnails in %8.1f ms (%d frames), all %d in %8.1f ms, %.3f ms per image\n", name, visibleCount,
+        (visible - start) * 1000.0, frames, count, (all - start) * 1000.0, (all - visible) * 1000.0 / (count - visibleCount));
+    dialog.Close();
+}
+#endif
+
+int main(int argc, char ** argv)
+{
+#ifdef USE_THUMBNAILS
+    int count          = argc > 1 ? atoi(argv[1]) : 5000;
+    int width          = argc > 2 ? atoi(argv[2]) : 800;
+    int height         = argc > 3 ? atoi(argv[3]) : 600;
+    std::string folder = argc > 4 ? argv[4] : "file_dialog_thumbnails_bench";
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    unsigned char* pixels = NULL;
+    int fontWidth = 0, fontHeight = 0;
+    io.Fonts->AddFontDefault();
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &fontWidth, &fontHeight);
+
+    double start = ImGui::get_current_time();
+    if (!WriteImages(folder, count, width, height))
+    {
+        printf("can't write the images in %s\n", folder.c_str());
+        return 1;
+    }
+    printf("%d images of %dx%d in %s, written in %.2f s\n", count, width, height, folder.c_str(), ImGui::get_current_time() - start);
+
+    // a new cache dir for each run, so the first pass is cold
+    char cacheDir[1024];
+    snprintf(cacheDir, IM_ARRAYSIZE(cacheDir), "%s_cache_%lld", folder.c_str(), (long long)(ImGui::get_current_time() * 1000.0));
+    Bench("cold", folder, cacheDir, count);
+    Bench("warm", folder, cacheDir, count);
+    printf("thumbnails cache in %s\n", cacheDir);
+
+    ImGui::DestroyContext();
+#else
+    (void)argc;
+    (void)argv;
+    printf("ImGuiFileDialog is built without USE_THUMBNAILS\n");
+#endif
+    return 0;
+}
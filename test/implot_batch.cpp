@@ -0,0 +1,162 @@
+// ImPlot batch rendering: renders report charts headless on the CPU with one image context per thread
+// and reports charts per second, split into plotting, rasterizing and PNG encoding. Charts rendered on
+// several threads are checked against the same charts rendered on one thread.
+//
+// Usage: implot_batch [charts] [threads] [width] [height] [output directory]
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <imgui_texture.h>
+#include <implot.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct ChartTimes
+{
+    double Plot = 0;
+    double Raster = 0;
+    double Encode = 0;
+};
+
+static ImU64 HashImage(const ImGui::ImMat& mat)
+{
+    ImU64 hash = 14695981039346656037ull;
+    const unsigned char* p = (const unsigned char*)mat.data;
+    for (size_t i = 0; i < (size_t)mat.w * mat.h * 4; i++)
+        hash = (hash ^ p[i]) * 1099511628211ull;
+    return hash;
+}
+
+// A daily report like chart: a noisy signal with its moving average, threshold crossings and a band
+static void RenderChart(int chart, int width, int height, const char* output, ImGui::ImMat& mat, ImU64* hash, ChartTimes& times)
+{
+    const int count = 10000;
+    std::vector<float> xs(count), ys(count), avg(count), lo(count), hi(count);
+    std::vector<float> peaks_x, peaks_y;
+    unsigned int seed = 7919u * (chart + 1);
+    float sum = 0;
+    for (int i = 0; i < count; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        xs[i] = i * 0.01f;
+        ys[i] = sinf(xs[i] * (0.5f + (chart % 7) * 0.1f)) * (1.0f + (chart % 3)) + ((seed >> 8) / 16777216.0f - 0.5f);
+        sum += ys[i] - (i >= 100 ? ys[i - 100] : 0.0f);
+        avg[i] = sum / ImMin(i + 1, 100);
+        lo[i] = avg[i] - 0.5f;
+        hi[i] = avg[i] + 0.5f;
+        if (ys[i] > hi[i] + 0.2f)
+        {
+            peaks_x.push_back(xs[i]);
+            peaks_y.push_back(ys[i]);
+        }
+    }
+
+    char title[64];
+    snprintf(title, IM_ARRAYSIZE(title), "Report %d", chart);
+    double start = ImGui::get_current_time();
+    double raster_start = start;
+    while (ImPlot::BeginImage(width, height))
+    {
+        if (ImPlot::BeginPlot(title, ImVec2(-1, -1)))
+        {
+            ImPlot::SetupAxes("time [s]", "value [V]");
+            ImPlot::PlotShaded("band", xs.data(), lo.data(), hi.data(), count);
+            ImPlot::PlotLine("signal", xs.data(), ys.data(), count);
+            ImPlot::PlotLine("average", xs.data(), avg.data(), count);
+            ImPlot::PlotScatter("peaks", peaks_x.data(), peaks_y.data(), (int)peaks_x.size());
+            ImPlot::EndPlot();
+        }
+        raster_start = ImGui::get_current_time();
+        ImPlot::EndImage(mat);
+    }
+    double end = ImGui::get_current_time();
+    times.Plot += raster_start - start;
+    times.Raster += end - raster_start;
+    *hash = HashImage(mat);
+    if (output)
+    {
+        char path[1024];
+        snprintf(path, IM_ARRAYSIZE(path), "%s/chart_%05d.png", output, chart);
+        ImGui::ImMatToFile(mat, path);
+        times.Encode += ImGui::get_current_time() - end;
+    }
+}
+
+static void RenderCharts(int first, int step, int charts, int width, int height, const char* output, ImFontAtlas* atlas, ImU64* hashes, ChartTimes* times)
+{
+    ImPlotContext* ctx = ImPlot::CreateImageContext(atlas);
+    ImGui::ImMat mat;
+    for (int chart = first; chart < charts; chart += step)
+        RenderChart(chart, width, height, output, mat, &hashes[chart], *times);
+    ImPlot::DestroyImageContext(ctx);
+}
+
+static double Run(int charts, int threads, int width, int height, const char* output, ImFontAtlas* atlas, std::vector<ImU64>& hashes, ChartTimes& times)
+{
+    hashes.assign(charts, 0);
+    std::vector<ChartTimes> thread_times(threads);
+    double start = ImGui::get_current_time();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++)
+        workers.push_back(std::thread(RenderCharts, t, threads, charts, width, height, output, atlas, hashes.data(), &thread_times[t]));
+    for (int t = 0; t < threads; t++)
+        workers[t].join();
+    double elapsed = ImGui::get_current_time() - start;
+    times = ChartTimes();
+    for (int t = 0; t < threads; t++)
+    {
+        times.Plot += thread_times[t].Plot;
+        times.Raster += thread_times[t].Raster;
+        times.Encode += thread_times[t].Encode;
+    }
+    return elapsed;
+}
+
+static void Report(const char* name, int charts, int threads, double elapsed, const ChartTimes& times)
+{
+    printf("  %-8s %2d thread(s) %8.1f charts/s | per chart plot %6.2f ms, raster %6.2f ms, png %6.2f ms\n", name, threads, charts / elapsed,
+        times.Plot * 1000.0 / charts, times.Raster * 1000.0 / charts, times.Encode * 1000.0 / charts);
+}
+
+int main(int argc, char ** argv)
+{
+    int charts         = argc > 1 ? atoi(argv[1]) : 200;
+    int threads        = argc > 2 ? atoi(argv[2]) : (int)std::thread::hardware_concurrency();
+    int width          = argc > 3 ? atoi(argv[3]) : 800;
+    int height         = argc > 4 ? atoi(argv[4]) : 600;
+    const char* output = argc > 5 ? argv[5] : NULL;
+    threads = ImMax(threads, 1);
+#if !IMGUI_THREAD_LOCAL_CONTEXT
+    if (threads > 1)
+    {
+        printf("contexts are shared by all threads, build with IMGUI_THREAD_LOCAL_CONTEXT to render on %d threads\n", threads);
+        threads = 1;
+    }
+#endif
+
+    // one atlas built up front, shared by the contexts of every thread
+    ImFontAtlas atlas;
+    unsigned char* pixels = NULL;
+    int tex_width = 0, tex_height = 0;
+    atlas.AddFontDefault();
+    atlas.GetTexDataAsRGBA32(&pixels, &tex_width, &tex_height);
+
+    printf("%d charts of %dx%d\n", charts, width, height);
+    std::vector<ImU64> serial_hashes, hashes;
+    ChartTimes times;
+    double elapsed = Run(charts, 1, width, height, output, &atlas, serial_hashes, times);
+    Report("serial", charts, 1, elapsed, times);
+    int mismatches = 0;
+    if (threads > 1)
+    {
+        elapsed = Run(charts, threads, width, height, output, &atlas, hashes, times);
+        Report("parallel", charts, threads, elapsed, times);
+        for (int i = 0; i < charts; i++)
+            mismatches += hashes[i] != serial_hashes[i];
+        printf("  %d of %d charts differ from the serial ones\n", mismatches, charts);
+    }
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,641 @@
+// ImPlot benchmark: runs headless frames plotting huge series and reports frame cost
+// and generated vertices, with and without decimation, and with a min/max pyramid.
+// Heatmaps are measured drawn as quads and colorized for a texture, histograms binned every
+// frame and reused through a data version, streams pushed to a ring buffer and plotted from it.
+// Tick labels are measured on a grid of subplots, cached and generated every frame.
+// Auto-fitting huge series is measured for contiguous and strided arrays, a user callback and a data version.
+// Columns of an array of structs are plotted through a user callback and through column getters, plain, with a
+// validity bitmap and in chunks.
+// Surfaces are measured by grid size with every cell drawn and with the level of detail, whole and zoomed in,
+// and a constant surface and ones holding NaN and infinite samples are checked to only produce finite vertices.
+//
+// Usage: implot_bench [points] [frames] [heatmap size] [histogram samples] [fit points] [surface size]
+#include <imgui.h>
+#include <implot.h>
+#include <implot_internal.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+typedef void (*PlotFunc)(const std::vector<float>& xs, const std::vector<float>& ys, int flags);
+
+static void PlotLineValues(const std::vector<float>&, const std::vector<float>& ys, int flags)
+{
+    ImPlot::PlotLine("signal", ys.data(), (int)ys.size(), 1.0, 0.0, flags);
+}
+
+static void PlotLineXY(const std::vector<float>& xs, const std::vector<float>& ys, int flags)
+{
+    ImPlot::PlotLine("signal", xs.data(), ys.data(), (int)ys.size(), flags | ImPlotLineFlags_SortedX);
+}
+
+static ImPlotPyramid g_pyramid;
+
+static void PlotLinePyramid(const std::vector<float>&, const std::vector<float>&, int flags)
+{
+    ImPlot::PlotLine("signal", g_pyramid, flags);
+}
+
+static void PlotScatterXY(const std::vector<float>& xs, const std::vector<float>& ys, int flags)
+{
+    ImPlot::PlotScatter("signal", xs.data(), ys.data(), (int)ys.size(), flags);
+}
+
+// Samples of an array of structs, plotted as columns
+struct Sample
+{
+    float X;
+    float Y;
+    float Quality;
+};
+
+static std::vector<Sample> g_samples;
+static std::vector<ImU8> g_validity;
+static std::vector<ImPlotColumnChunk<float> > g_chunks_x, g_chunks_y;
+
+static ImPlotPoint SampleGetter(int idx, void* data)
+{
+    const Sample& sample = ((const Sample*)data)[idx];
+    return ImPlotPoint(sample.X, sample.Y);
+}
+
+static void PlotLineCallback(const std::vector<float>&, const std::vector<float>&, int flags)
+{
+    ImPlot::PlotLineG("signal", SampleGetter, g_samples.data(), (int)g_samples.size(), flags | ImPlotLineFlags_SortedX);
+}
+
+static void PlotLineColumns(const std::vector<float>&, const std::vector<float>&, int flags)
+{
+    const int count = (int)g_samples.size();
+    ImPlot::PlotLine("signal", ImPlotColumn<float>(&g_samples[0].X, count, sizeof(Sample)), ImPlotColumn<float>(&g_samples[0].Y, count, sizeof(Sample)), flags | ImPlotLineFlags_SortedX);
+}
+
+static void PlotLineNullable(const std::vector<float>&, const std::vector<float>&, int flags)
+{
+    const int count = (int)g_samples.size();
+    ImPlot::PlotLine("signal", ImPlotColumn<float>(&g_samples[0].X, count, sizeof(Sample)), ImPlotColumn<float>(&g_samples[0].Y, count, sizeof(Sample), g_validity.data()), flags | ImPlotLineFlags_SortedX);
+}
+
+static void PlotLineChunks(const std::vector<float>&, const std::vector<float>&, int flags)
+{
+    ImPlot::PlotLine("signal", ImPlotColumn<float>(g_chunks_x.data(), (int)g_chunks_x.size(), sizeof(Sample)), ImPlotColumn<float>(g_chunks_y.data(), (int)g_chunks_y.size(), sizeof(Sample)), flags | ImPlotLineFlags_SortedX);
+}
+
+// Shows the whole series, a 1% window of it, or zooms from the whole series down to 1e-4 of it while panning
+enum View { View_All, View_Zoom, View_ZoomPan, View_COUNT };
+static const char* ViewNames[View_COUNT] = { "all", "zoom", "pan" };
+
+// Runs frames of a view of the series, returns average frame cost in ms
+static double RunFrames(int frames, PlotFunc plot, const std::vector<float>& xs, const std::vector<float>& ys, int flags, View view, int* vertices)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    const double count = (double)ys.size();
+    double start = ImGui::get_current_time();
+    for (int frame = 0; frame < frames; frame++)
+    {
+        double x_min = 0, x_max = count;
+        if (view == View_Zoom)
+        {
+            x_min = count * 0.4;
+            x_max = count * 0.41;
+        }
+        else if (view == View_ZoomPan)
+        {
+            const double t = frames > 1 ? (double)frame / (frames - 1) : 0.0;
+            const double width = count * pow(1e-4, t);
+            const double center = count * (0.5 + 0.3 * sin(t * 6.0));
+            x_min = center - width * 0.5;
+            x_max = center + width * 0.5;
+        }
+        io.DisplaySize = ImVec2(1920, 1080);
+        io.DeltaTime = 1.0f / 60.0f;
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(io.DisplaySize);
+        ImGui::Begin("Plot", NULL, ImGuiWindowFlags_NoDecoration);
+        if (ImPlot::BeginPlot("##bench", ImVec2(-1, -1)))
+        {
+            ImPlot::SetupAxesLimits(x_min, x_max, -1.5, 1.5, ImPlotCond_Always);
+            plot(xs, ys, flags);
+            ImPlot::EndPlot();
+        }
+        ImGui::End();
+        ImGui::Render();
+    }
+    *vertices = io.MetricsRenderVertices;
+    return (ImGui::get_current_time() - start) * 1000.0 / frames;
+}
+
+static void Bench(const char* name, int frames, PlotFunc plot, const std::vector<float>& xs, const std::vector<float>& ys, int decimate_flags, int no_decimate_flags)
+{
+    // without decimation every point costs up to 50 vertices, skip it when that won't fit in memory
+    const bool run_full = ys.size() <= 4000000;
+    for (int v = 0; v < View_ZoomPan; v++)
+    {
+        int vtx_full = 0, vtx_decimated = 0;
+        double full_ms = run_full ? RunFrames(frames, plot, xs, ys, no_decimate_flags, (View)v, &vtx_full) : 0.0;
+        double decimated_ms = RunFrames(frames, plot, xs, ys, decimate_flags, (View)v, &vtx_decimated);
+        printf("  %-10s %-5s full %9.3f ms %9d vtx | decimated %8.3f ms %8d vtx\n", name, ViewNames[v], full_ms, vtx_full, decimated_ms, vtx_decimated);
+    }
+}
+
+static void BenchPyramid(int frames, const std::vector<float>& xs, const std::vector<float>& ys)
+{
+    double start = ImGui::get_current_time();
+    g_pyramid.Build(ys.data(), (int)ys.size());
+    printf("  pyramid    build %.3f ms\n", (ImGui::get_current_time() - start) * 1000.0);
+    for (int v = 0; v < View_COUNT; v++)
+    {
+        int vtx_scan = 0, vtx_pyramid = 0;
+        double scan_ms = RunFrames(frames, PlotLineValues, xs, ys, 0, (View)v, &vtx_scan);
+        double pyramid_ms = RunFrames(frames, PlotLinePyramid, xs, ys, 0, (View)v, &vtx_pyramid);
+        printf("  pyramid    %-5s scan %9.3f ms %9d vtx | pyramid   %8.3f ms %8d vtx\n", ViewNames[v], scan_ms, vtx_scan, pyramid_ms, vtx_pyramid);
+    }
+    g_pyramid.Clear();
+}
+
+static void RandomLine(float* values, int count, unsigned int* seed)
+{
+    for (int i = 0; i < count; i++)
+    {
+        *seed = *seed * 1664525u + 1013904223u;
+        values[i] = (*seed >> 8) / 16777216.0f;
+    }
+}
+
+// Draws the heatmap as quads, then colorizes it for a texture while static, scrolling by one row per
+// frame like a spectrogram, and fully changing every frame. Texture upload needs a renderer backend,
+// the texture path is measured up to the rows it would upload.
+static void BenchHeatmap(int frames, int size)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    std::vector<float> values((size_t)size * size);
+    unsigned int seed = 7;
+    RandomLine(values.data(), (int)values.size(), &seed);
+
+    double start = ImGui::get_current_time();
+    for (int frame = 0; frame < frames; frame++)
+    {
+        io.DisplaySize = ImVec2(1920, 1080);
+        io.DeltaTime = 1.0f / 60.0f;
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(io.DisplaySize);
+        ImGui::Begin("Plot", NULL, ImGuiWindowFlags_NoDecoration);
+        if (ImPlot::BeginPlot("##heatmap", ImVec2(-1, -1)))
+        {
+            ImPlot::PlotHeatmap("heat", values.data(), size, size, 0, 1, nullptr);
+            ImPlot::EndPlot();
+        }
+        ImGui::End();
+        ImGui::Render();
+    }
+    double quads_ms = (ImGui::get_current_time() - start) * 1000.0 / frames;
+    size_t quads_bytes = (size_t)io.MetricsRenderVertices * sizeof(ImDrawVert) + (size_t)io.MetricsRenderIndices * sizeof(ImDrawIdx);
+    printf("%dx%d heatmap\n", size, size);
+    printf("  quads      %9.3f ms %9d vtx %8.1f MB draw data per frame\n", quads_ms, io.MetricsRenderVertices, quads_bytes / 1048576.0);
+
+    const char* modes[3] = { "static", "scrolling", "changing" };
+    for (int mode = 0; mode < 3; mode++)
+    {
+        ImPlotHeatmapTexture cache;
+        ImPlot::UpdateHeatmapPixels(cache, values.data(), size, size, 0, 1, false);
+        cache.DirtyLines.resize(0);
+        int lines = 0;
+        start = ImGui::get_current_time();
+        for (int frame = 0; frame < frames; frame++)
+        {
+            if (mode == 1)
+            {
+                memmove(values.data(), values.data() + size, sizeof(float) * size * (size - 1));
+                RandomLine(values.data() + (size_t)size * (size - 1), size, &seed);
+            }
+            else if (mode == 2)
+            {
+                RandomLine(values.data(), (int)values.size(), &seed);
+            }
+            lines += ImPlot::UpdateHeatmapPixels(cache, values.data(), size, size, 0, 1, false);
+            cache.DirtyLines.resize(0);
+        }
+        double texture_ms = (ImGui::get_current_time() - start) * 1000.0 / frames;
+        printf("  texture    %9.3f ms %-9s %6.1f rows uploaded per frame %8.1f MB pixels\n", texture_ms, modes[mode], (double)lines / frames, (size_t)size * size * 4 / 1048576.0);
+    }
+}
+
+// Plots a 1D and a 2D histogram of the samples, with a data version the bins are computed once
+static double RunHistogramFrames(int frames, const std::vector<float>& xs, const std::vector<float>& ys, bool two_d, bool versioned)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    double start = ImGui::get_current_time();
+    for (int frame = 0; frame < frames; frame++)
+    {
+        io.DisplaySize = ImVec2(1920, 1080);
+        io.DeltaTime = 1.0f / 60.0f;
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(io.DisplaySize);
+        ImGui::Begin("Plot", NULL, ImGuiWindowFlags_NoDecoration);
+        if (ImPlot::BeginPlot("##histogram", ImVec2(-1, -1)))
+        {
+            if (versioned)
+                ImPlot::SetNextHistogramVersion(1);
+            if (two_d)
+                ImPlot::PlotHistogram2D("hist2d", xs.data(), ys.data(), (int)xs.size(), 100, 100);
+            else
+                ImPlot::PlotHistogram("hist", ys.data(), (int)ys.size(), 200);
+            ImPlot::EndPlot();
+        }
+        ImGui::End();
+        ImGui::Render();
+    }
+    return (ImGui::get_current_time() - start) * 1000.0 / frames;
+}
+
+static void BenchHistogram(int frames, int samples)
+{
+    std::vector<float> xs(samples), ys(samples);
+    unsigned int seed = 11;
+    RandomLine(xs.data(), samples, &seed);
+    RandomLine(ys.data(), samples, &seed);
+    for (int i = 0; i < samples; i++)
+        ys[i] = (ys[i] + xs[i] + ys[(i * 7) % samples]) / 3.0f;
+    printf("%d samples histogram\n", samples);
+    for (int two_d = 0; two_d < 2; two_d++)
+    {
+        double binned_ms = RunHistogramFrames(frames, xs, ys, two_d != 0, false);
+        RunHistogramFrames(1, xs, ys, two_d != 0, true);
+        double versioned_ms = RunHistogramFrames(frames, xs, ys, two_d != 0, true);
+        printf("  %-10s binned %9.3f ms | versioned %8.3f ms\n", two_d ? "2d" : "1d", binned_ms, versioned_ms);
+    }
+}
+
+// Streams 10 MS/s at 60 frames per second keeping a history of the last points: plotted from an
+// ImPlotRingBuffer, or copied out of a scrolling buffer as a consumer holding a mutex would do.
+// Push cost is measured alone, one sample and batches at a time, with one and multiple producers.
+static void BenchRingBuffer(int frames, int points)
+{
+    const int per_frame = 10000000 / 60;
+    std::vector<double> xs(per_frame), ys(per_frame);
+    printf("ring buffer, %d points history, %d samples per frame\n", points, per_frame);
+    for (int multi = 0; multi < 2; multi++)
+    {
+        ImPlotRingBuffer ring(points + per_frame * 2, points, multi != 0);
+        double start = ImGui::get_current_time();
+        for (int i = 0; i < per_frame; i++)
+            ring.Push((double)i, 0.0);
+        double single_ns = (ImGui::get_current_time() - start) * 1e9 / per_frame;
+        ring.Snapshot();
+        start = ImGui::get_current_time();
+        for (int i = 0; i < per_frame; i += 1024)
+            ring.Push(xs.data() + i, ys.data() + i, ImMin(1024, per_frame - i));
+        double batch_ns = (ImGui::get_current_time() - start) * 1e9 / per_frame;
+        printf("  push       %-6s %6.2f ns per sample | batches %6.2f ns per sample\n", multi ? "mpsc" : "spsc", single_ns, batch_ns);
+    }
+
+    ImGuiIO& io = ImGui::GetIO();
+    ImPlotRingBuffer ring(points + per_frame * 2, points);
+    std::vector<double> scroll_xs, scroll_ys, copy_xs(points), copy_ys(points);
+    scroll_xs.reserve(points);
+    scroll_ys.reserve(points);
+    int scroll_offset = 0;
+    double sample = 0;
+    for (int copy = 0; copy < 2; copy++)
+    {
+        double start = ImGui::get_current_time();
+        for (int frame = 0; frame < frames; frame++)
+        {
+            for (int i = 0; i < per_frame; i++, sample++)
+            {
+                xs[i] = sample;
+                ys[i] = sin(sample * 1e-5);
+            }
+            if (copy)
+            {
+                for (int i = 0; i < per_frame; i++)
+                {
+                    if ((int)scroll_xs.size() < points)
+                    {
+                        scroll_xs.push_back(xs[i]);
+                        scroll_ys.push_back(ys[i]);
+                    }
+                    else
+                    {
+                        scroll_xs[scroll_offset] = xs[i];
+                        scroll_ys[scroll_offset] = ys[i];
+                        scroll_offset = (scroll_offset + 1) % points;
+                    }
+                }
+            }
+            else
+            {
+                ring.Push(xs.data(), ys.data(), per_frame);
+            }
+            io.DisplaySize = ImVec2(1920, 1080);
+            io.DeltaTime = 1.0f / 60.0f;
+            ImGui::NewFrame();
+            ImGui::SetNextWindowPos(ImVec2(0, 0));
+            ImGui::SetNextWindowSize(io.DisplaySize);
+            ImGui::Begin("Plot", NULL, ImGuiWindowFlags_NoDecoration);
+            if (ImPlot::BeginPlot("##stream", ImVec2(-1, -1)))
+            {
+                ImPlot::SetupAxesLimits(sample - points, sample, -1.5, 1.5, ImPlotCond_Always);
+                if (copy)
+                {
+                    const int count = (int)scroll_xs.size();
+                    for (int i = 0; i < count; i++)
+                    {
+                        copy_xs[i] = scroll_xs[(scroll_offset + i) % count];
+                        copy_ys[i] = scroll_ys[(scroll_offset + i) % count];
+                    }
+                    ImPlot::PlotLine("stream", copy_xs.data(), copy_ys.data(), count, ImPlotLineFlags_SortedX);
+                }
+                else
+                {
+                    ImPlot::PlotLine("stream", ring, ImPlotLineFlags_SortedX);
+                }
+                ImPlot::EndPlot();
+            }
+            ImGui::End();
+            ImGui::Render();
+        }
+        double frame_ms = (ImGui::get_current_time() - start) * 1000.0 / frames;
+        printf("  %-10s %9.3f ms per frame %8d vtx\n", copy ? "copied" : "ring", frame_ms, io.MetricsRenderVertices);
+    }
+    printf("  ring       %llu pushed, %llu dropped\n", (unsigned long long)ring.GetPushed(), (unsigned long long)ring.GetDropped());
+}
+
+// Plots a small series in every subplot of a grid with a time x axis and a formatted y axis. Still frames
+// reuse the cached ticks, busting the cache every frame generates them, panning changes every axis range.
+static double RunSubplotFrames(int frames, int rows, int cols, const std::vector<float>& ys, bool bust, bool pan)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    double start = ImGui::get_current_time();
+    for (int frame = 0; frame < frames; frame++)
+    {
+        if (bust)
+            ImPlot::BustTickCache();
+        io.DisplaySize = ImVec2(1920, 1080);
+        io.DeltaTime = 1.0f / 60.0f;
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(io.DisplaySize);
+        ImGui::Begin("Plot", NULL, ImGuiWindowFlags_NoDecoration);
+        if (ImPlot::BeginSubplots("##grid", rows, cols, ImVec2(-1, -1)))
+        {
+            for (int i = 0; i < rows * cols; i++)
+            {
+                if (ImPlot::BeginPlot("##cell"))
+                {
+                    const double x0 = 1.7e9 + i * 3600.0 + (pan ? frame * 60.0 : 0.0);
+                    ImPlot::SetupAxisScale(ImAxis_X1, ImPlotScale_Time);
+                    ImPlot::SetupAxisFormat(ImAxis_Y1, "%.2f V");
+                    ImPlot::SetupAxesLimits(x0, x0 + 86400.0, -1.5 - i * 0.01, 1.5, ImPlotCond_Always);
+                    ImPlot::PlotLine("signal", ys.data(), (int)ys.size(), 86400.0 / ys.size(), x0);
+                    ImPlot::EndPlot();
+                }
+            }
+            ImPlot::EndSubplots();
+        }
+        ImGui::End();
+        ImGui::Render();
+    }
+    return (ImGui::get_current_time() - start) * 1000.0 / frames;
+}
+
+static void BenchTicks(int frames, int rows, int cols)
+{
+    std::vector<float> ys(256);
+    for (int i = 0; i < (int)ys.size(); i++)
+        ys[i] = sinf(i * 0.05f);
+    printf("%dx%d subplots ticks\n", rows, cols);
+    RunSubplotFrames(2, rows, cols, ys, false, false);
+    double cached_ms = RunSubplotFrames(frames, rows, cols, ys, false, false);
+    double busted_ms = RunSubplotFrames(frames, rows, cols, ys, true, false);
+    double panned_ms = RunSubplotFrames(frames, rows, cols, ys, false, true);
+    printf("  still      cached %9.3f ms | generated %8.3f ms | panning %8.3f ms\n", cached_ms, busted_ms, panned_ms);
+}
+
+static void BenchColumns(int frames, const std::vector<float>& xs, const std::vector<float>& ys)
+{
+    // one sample in 1000 is null, chunks of 64k samples like record batches
+    const int count = (int)ys.size();
+    const int chunk_size = 65536;
+    g_samples.resize(count);
+    g_validity.assign((count + 7) / 8, 0xFF);
+    for (int i = 0; i < count; i++)
+    {
+        g_samples[i].X = xs[i];
+        g_samples[i].Y = ys[i];
+        g_samples[i].Quality = 1.0f;
+        if (i % 1000 == 999)
+            g_validity[i >> 3] &= (ImU8)~(1 << (i & 7));
+    }
+    for (int i = 0; i < count; i += chunk_size)
+    {
+        const int size = count - i < chunk_size ? count - i : chunk_size;
+        g_chunks_x.push_back(ImPlotColumnChunk<float>(&g_samples[i].X, size));
+        g_chunks_y.push_back(ImPlotColumnChunk<float>(&g_samples[i].Y, size, g_validity.data(), i));
+    }
+    Bench("callback", frames, PlotLineCallback, xs, ys, 0, ImPlotLineFlags_NoDecimate);
+    Bench("column", frames, PlotLineColumns, xs, ys, 0, ImPlotLineFlags_NoDecimate);
+    Bench("nullable", frames, PlotLineNullable, xs, ys, 0, ImPlotLineFlags_NoDecimate);
+    Bench("chunked", frames, PlotLineChunks, xs, ys, 0, ImPlotLineFlags_NoDecimate);
+}
+
+enum FitMode { Fit_Contiguous, Fit_Strided, Fit_Callback, Fit_Versioned, Fit_COUNT };
+static const char* FitNames[Fit_COUNT] = { "contiguous", "strided", "callback", "versioned" };
+
+static ImPlotPoint FitGetter(int idx, void* data)
+{
+    const float* ys = (const float*)data;
+    return ImPlotPoint((double)idx, (double)ys[idx]);
+}
+
+// Plots the series with both axes auto-fitted every frame, *limits receives the fitted y range
+static double RunFitFrames(int frames, const std::vector<float>& ys, FitMode mode, ImPlotRange* limits)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    const int count = (int)ys.size();
+    double start = ImGui::get_current_time();
+    for (int frame = 0; frame < frames; frame++)
+    {
+        io.DisplaySize = ImVec2(1920, 1080);
+        io.DeltaTime = 1.0f / 60.0f;
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(io.DisplaySize);
+        ImGui::Begin("Plot", NULL, ImGuiWindowFlags_NoDecoration);
+        if (ImPlot::BeginPlot("##fit", ImVec2(-1, -1)))
+        {
+            ImPlot::SetupAxes(NULL, NULL, ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+            if (mode == Fit_Strided)
+                ImPlot::PlotLine("signal", ys.data(), count / 2, 2.0, 0.0, 0, 0, 2 * sizeof(float));
+            else if (mode == Fit_Callback)
+                ImPlot::PlotLineG("signal", FitGetter, (void*)ys.data(), count);
+            else
+            {
+                if (mode == Fit_Versioned)
+                    ImPlot::SetNextFitVersion(1);
+                ImPlot::PlotLine("signal", ys.data(), count);
+            }
+            *limits = ImPlot::GetPlotLimits().Y;
+            ImPlot::EndPlot();
+        }
+        ImGui::End();
+        ImGui::Render();
+    }
+    return (ImGui::get_current_time() - start) * 1000.0 / frames;
+}
+
+static void BenchFit(int frames, int points)
+{
+    std::vector<float> ys(points);
+    unsigned int seed = 5;
+    RandomLine(ys.data(), points, &seed);
+    printf("%d points auto-fit\n", points);
+    for (int mode = 0; mode < Fit_COUNT; mode++)
+    {
+        ImPlotRange limits;
+        RunFitFrames(2, ys, (FitMode)mode, &limits);
+        double ms = RunFitFrames(frames, ys, (FitMode)mode, &limits);
+        printf("  %-10s %9.3f ms | y %.6f .. %.6f\n", FitNames[mode], ms, limits.Min, limits.Max);
+    }
+}
+
+// Plots a surface of the given size seen as a whole or zoomed on a corner, returns average frame cost in ms
+static double RunSurfaceFrames(int frames, const std::vector<float>& values, int size, double scale_min, double scale_max, int flags, bool zoom, int* vertices)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    double start = ImGui::get_current_time();
+    for (int frame = 0; frame < frames; frame++)
+    {
+        io.DisplaySize = ImVec2(1920, 1080);
+        io.DeltaTime = 1.0f / 60.0f;
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(io.DisplaySize);
+        ImGui::Begin("Plot", NULL, ImGuiWindowFlags_NoDecoration);
+        if (ImPlot::BeginPlot("##surface", ImVec2(-1, -1), ImPlotFlags_Equal))
+        {
+            if (zoom)
+                ImPlot::SetupAxesLimits(0.3, 0.4, 0.3, 0.4, ImPlotCond_Always);
+            else
+                ImPlot::SetupAxesLimits(-0.2, 1.2, -0.2, 1.2, ImPlotCond_Always);
+            // turned a little every frame so nothing can be reused
+            ImPlot::SetNextSurfaceView(0.5 + frame * 0.01, 0.6);
+            ImPlot::PlotSurface("surface", values.data(), size, size, scale_min, scale_max, ImPlotPoint(0, 0), ImPlotPoint(1, 1), flags);
+            ImPlot::EndPlot();
+        }
+        ImGui::End();
+        ImGui::Render();
+    }
+    *vertices = io.MetricsRenderVertices;
+    return (ImGui::get_current_time() - start) * 1000.0 / frames;
+}
+
+// Frame cost of surfaces by grid size, every cell drawn and reduced to a few pixels each
+static void BenchSurface(int frames, int max_size)
+{
+    for (int size = 256; size <= max_size; size *= 4)
+    {
+        std::vector<float> values((size_t)size * size);
+        for (int r = 0; r < size; r++)
+            for (int c = 0; c < size; c++)
+                values[(size_t)r * size + c] = sinf(r * 12.0f / size) * cosf(c * 9.0f / size);
+        printf("%dx%d surface\n", size, size);
+        for (int zoom = 0; zoom < 2; zoom++)
+        {
+            // every cell of large surfaces costs millions of vertices, skip it when that won't fit in memory
+            const bool run_full = size <= 1024;
+            int vtx_full = 0, vtx_lod = 0;
+            double full_ms = run_full ? RunSurfaceFrames(frames, values, size, -1, 1, ImPlotSurfaceFlags_NoLOD, zoom != 0, &vtx_full) : 0.0;
+            double lod_ms = RunSurfaceFrames(frames, values, size, -1, 1, 0, zoom != 0, &vtx_lod);
+            printf("  surface    %-5s full %9.3f ms %9d vtx | lod       %8.3f ms %8d vtx\n", zoom ? "zoom" : "all", full_ms, vtx_full, lod_ms, vtx_lod);
+        }
+    }
+}
+
+// Draws a constant surface with an automatic scale and ones holding NaN and infinite samples, reports
+// whether all vertices of the last frame are finite. Returns false when one isn't.
+static bool CheckSurfaceValues()
+{
+    const int size = 64;
+    std::vector<float> flat((size_t)size * size, 3.0f), holes((size_t)size * size), infinite((size_t)size * size);
+    for (int r = 0; r < size; r++)
+    {
+        for (int c = 0; c < size; c++)
+        {
+            const float v = sinf(r * 0.2f) * cosf(c * 0.3f);
+            holes[(size_t)r * size + c] = (r * 7 + c * 3) % 11 == 0 ? NAN : v;
+            infinite[(size_t)r * size + c] = (r * 7 + c * 3) % 11 == 0 ? (c & 1 ? INFINITY : -INFINITY) : v;
+        }
+    }
+    const std::vector<float>* fields[] = { &flat, &holes, &infinite };
+    const char* names[] = { "constant", "nan", "inf" };
+    bool ok = true;
+    for (int i = 0; i < 3; i++)
+    {
+        int vertices = 0;
+        RunSurfaceFrames(1, *fields[i], size, 0, 0, ImPlotSurfaceFlags_Mesh, false, &vertices);
+        int bad = 0;
+        ImDrawData* draw_data = ImGui::GetDrawData();
+        for (int n = 0; n < draw_data->CmdListsCount; n++)
+            for (const ImDrawVert& v : draw_data->CmdLists[n]->VtxBuffer)
+                bad += !isfinite(v.pos.x) || !isfinite(v.pos.y);
+        printf("  surface    %-8s %8d vtx, %d not finite: %s\n", names[i], vertices, bad, bad == 0 && vertices > 0 ? "ok" : "FAILED");
+        ok &= bad == 0 && vertices > 0;
+    }
+    return ok;
+}
+
+int main(int argc, char ** argv)
+{
+    int points = argc > 1 ? atoi(argv[1]) : 1000000;
+    int frames = argc > 2 ? atoi(argv[2]) : 10;
+    int heatmap_size = argc > 3 ? atoi(argv[3]) : 1024;
+    int histogram_samples = argc > 4 ? atoi(argv[4]) : 10000000;
+    int fit_points = argc > 5 ? atoi(argv[5]) : 10000000;
+    int surface_size = argc > 6 ? atoi(argv[6]) : 4096;
+
+    ImGui::CreateContext();
+    ImPlot::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    // like the renderer backends, large draw lists need vertex offsets with 16-bit indices
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    unsigned char* pixels = NULL;
+    int width = 0, height = 0;
+    io.Fonts->AddFontDefault();
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    // noisy telemetry like signal
+    std::vector<float> xs(points), ys(points);
+    unsigned int seed = 1;
+    for (int i = 0; i < points; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        xs[i] = (float)i;
+        ys[i] = sinf(i * 0.0001f) + ((seed >> 8) / 16777216.0f - 0.5f) * 0.5f;
+    }
+
+    printf("%d points, %d frames\n", points, frames);
+    Bench("line", frames, PlotLineValues, xs, ys, 0, ImPlotLineFlags_NoDecimate);
+    Bench("line xy", frames, PlotLineXY, xs, ys, 0, ImPlotLineFlags_NoDecimate);
+    Bench("line lttb", frames, PlotLineValues, xs, ys, ImPlotLineFlags_LTTB, ImPlotLineFlags_NoDecimate);
+    Bench("scatter", frames, PlotScatterXY, xs, ys, ImPlotScatterFlags_Decimate, 0);
+    BenchPyramid(frames, xs, ys);
+    BenchColumns(frames, xs, ys);
+    BenchHeatmap(frames, heatmap_size);
+    BenchHistogram(frames, histogram_samples);
+    BenchRingBuffer(frames, points);
+    BenchTicks(frames * 10, 8, 8);
+    BenchFit(frames, fit_points);
+    BenchSurface(frames, surface_size);
+    const bool surfaces_ok = CheckSurfaceValues();
+
+    ImPlot::DestroyContext();
+    ImGui::DestroyContext();
+    return surfaces_ok ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+// ImPlotRingBuffer stress test: producer threads stream samples at a fixed total rate while the
+// main thread runs headless frames plotting the buffer. Every snapshot is checked after the frame
+// for samples overwritten or published out of order; dropped samples are reported, not errors.
+//
+// Usage: implot_ring_stress [rate in samples/s] [seconds] [producers] [history]
+#include <imgui.h>
+#include <implot.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+static const int kBatch = 1024;
+
+// Sample n of producer p has x = n * producers + p, its y is derived from x so torn samples show up
+static double SampleY(double x)
+{
+    return fmod(x * 0.618033988749895, 1.0);
+}
+
+static void Produce(ImPlotRingBuffer* ring, int id, int producers, double rate, double seconds, std::atomic<bool>* stop)
+{
+    std::vector<double> xs(kBatch), ys(kBatch);
+    const double start = ImGui::get_current_time();
+    double n = 0;
+    while (!stop->load())
+    {
+        const double elapsed = ImGui::get_current_time() - start;
+        if (elapsed >= seconds)
+            break;
+        // catch up with the wall clock in batches, then yield
+        const double due = elapsed * rate;
+        if (n >= due)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+        const int count = (int)ImMin((double)kBatch, due - n + 1);
+        for (int i = 0; i < count; i++)
+        {
+            xs[i] = (n + i) * producers + id;
+            ys[i] = SampleY(xs[i]);
+        }
+        ring->Push(xs.data(), ys.data(), count);
+        n += count;
+    }
+}
+
+// Returns the number of bad samples in the snapshot, last_x holds the newest x seen of each producer
+static int CheckSnapshot(const ImPlotRingBuffer& ring, int producers, std::vector<double>& last_x)
+{
+    int errors = 0;
+    std::vector<double> snapshot_x(producers, -1.0);
+    for (int i = 0; i < ring.Size(); i++)
+    {
+        const double x = ring.GetX(i);
+        const int id = (int)fmod(x, (double)producers);
+        if (ring.GetY(i) != SampleY(x) || x <= snapshot_x[id])
+            errors++;
+        snapshot_x[id] = x;
+    }
+    // snapshots only move forward
+    for (int p = 0; p < producers; p++)
+    {
+        if (snapshot_x[p] < last_x[p] && snapshot_x[p] >= 0)
+            errors++;
+        last_x[p] = ImMax(last_x[p], snapshot_x[p]);
+    }
+    return errors;
+}
+
+int main(int argc, char ** argv)
+{
+    double rate    = argc > 1 ? atof(argv[1]) : 10000000.0;
+    double seconds = argc > 2 ? atof(argv[2]) : 3.0;
+    int producers  = argc > 3 ? atoi(argv[3]) : 1;
+    int history    = argc > 4 ? atoi(argv[4]) : 1000000;
+    producers = ImMax(producers, 1);
+
+    ImGui::CreateContext();
+    ImPlot::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    unsigned char* pixels = NULL;
+    int width = 0, height = 0;
+    io.Fonts->AddFontDefault();
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    // room for the history and a quarter second of samples
+    ImPlotRingBuffer ring(history + (int)(rate / 4), history, producers > 1);
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++)
+        threads.push_back(std::thread(Produce, &ring, p, producers, rate / producers, seconds, &stop));
+
+    std::vector<double> last_x(producers, -1.0);
+    int frames = 0, errors = 0;
+    double checked = 0;
+    const double start = ImGui::get_current_time();
+    while (ImGui::get_current_time() - start < seconds)
+    {
+        io.DisplaySize = ImVec2(1920, 1080);
+        io.DeltaTime = 1.0f / 60.0f;
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(io.DisplaySize);
+        ImGui::Begin("Plot", NULL, ImGuiWindowFlags_NoDecoration);
+        if (ImPlot::BeginPlot("##stream", ImVec2(-1, -1)))
+        {
+            ImPlot::PlotLine("stream", ring, producers == 1 ? ImPlotLineFlags_SortedX : 0);
+            ImPlot::EndPlot();
+        }
+        ImGui::End();
+        ImGui::Render();
+        // producers kept writing during the frame, the snapshot must still be intact
+        errors += CheckSnapshot(ring, producers, last_x);
+        checked += ring.Size();
+        frames++;
+    }
+    stop.store(true);
+    for (size_t t = 0; t < threads.size(); t++)
+        threads[t].join();
+    const double elapsed = ImGui::get_current_time() - start;
+
+    const ImU64 pushed = ring.GetPushed(), dropped = ring.GetDropped();
+    printf("%d producer(s) at %.1f MS/s for %.1f s, history %d\n", producers, rate / 1e6, seconds, ring.History);
+    printf("  offered    %.2f MS/s, pushed %llu, dropped %llu (%.3f%%)\n", (pushed + dropped) / seconds / 1e6,
+        (unsigned long long)pushed, (unsigned long long)dropped, pushed + dropped ? 100.0 * dropped / (pushed + dropped) : 0.0);
+    printf("  plotted    %d frames, %.2f ms per frame, %.0f samples checked, %d errors\n", frames, elapsed * 1000.0 / frames, checked, errors);
+
+    ImPlot::DestroyContext();
+    ImGui::DestroyContext();
+    return errors == 0 ? 0 : 1;
+}
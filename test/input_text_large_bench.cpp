@@ -0,0 +1,166 @@
+// InputTextMultiline large text benchmark: loads a generated multi-megabyte UTF-8 log into a multi-line InputText,
+// then plays the same edits (typing, arrows, page up, selections, deletions, undo and redo, clicks) with and without
+// ImGuiInputTextFlags_LargeText and reports the frame time while typing. The buffer and the cursor left by both modes
+// are compared, and the line index of the large text mode is checked against the line breaks of the text. Exits
+// with 1 on a mismatch.
+//
+// Usage: input_text_large_bench [size in MB] [typed characters]
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+static std::vector<char> g_buffer;
+static ImGuiInputTextFlags g_flags = 0;
+
+static void Frame()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1280, 720);
+    io.DeltaTime = 1.0f / 60.0f;
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(1000, 700));
+    ImGui::Begin("Text", NULL, ImGuiWindowFlags_NoSavedSettings);
+    // one widget per mode, so both start unscrolled
+    ImGui::InputTextMultiline(g_flags & ImGuiInputTextFlags_LargeText ? "##large" : "##default", g_buffer.data(), g_buffer.size(), ImVec2(900, 600), g_flags);
+    ImGui::End();
+    ImGui::Render();
+}
+
+static void Click(float x, float y)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.AddMousePosEvent(x, y);
+    Frame();
+    io.AddMouseButtonEvent(0, true);
+    Frame();
+    io.AddMouseButtonEvent(0, false);
+    Frame();
+}
+
+static void Key(ImGuiKey key, ImGuiKey mod = ImGuiKey_None)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    if (mod != ImGuiKey_None)
+        io.AddKeyEvent(mod, true);
+    io.AddKeyEvent(key, true);
+    Frame();
+    io.AddKeyEvent(key, false);
+    if (mod != ImGuiKey_None)
+        io.AddKeyEvent(mod, false);
+    Frame();
+}
+
+static void Type(const char* text)
+{
+    ImGui::GetIO().AddInputCharactersUTF8(text);
+    Frame();
+}
+
+// Lines of ASCII, 2 and 3 bytes characters
+static std::string MakeText(size_t size)
+{
+    std::string text;
+    char line[128];
+    for (int n = 0; text.size() < size; n++)
+    {
+        snprintf(line, IM_ARRAYSIZE(line), "line %d: h\xc3\xa9llo w\xc3\xb6rld \xe4\xb8\xad some more text here\n", n);
+        text += line;
+    }
+    return text;
+}
+
+// Plays the edits, returns the text followed by the cursor and the selection, or an empty string when the line
+// index of the large text mode doesn't match the text
+static std::string RunEdits(const std::string& text, ImGuiInputTextFlags flags, int typed, double* typing_ms)
+{
+    g_flags = flags;
+    g_buffer.assign(text.size() + (1 << 20), 0);
+    memcpy(g_buffer.data(), text.c_str(), text.size());
+
+    Click(100, 100);
+    Type("abc\nX\xc3\xa9");
+    for (int i = 0; i < 30; i++)
+        Key(ImGuiKey_DownArrow);
+    Type("Z");
+    for (int i = 0; i < 3; i++)
+        Key(ImGuiKey_Backspace);
+    Key(ImGuiKey_UpArrow, ImGuiMod_Shift);
+    Key(ImGuiKey_UpArrow, ImGuiMod_Shift);
+    Key(ImGuiKey_Delete);
+    Key(ImGuiKey_End, ImGuiMod_Ctrl);
+    Type("END\n\xe4\xb8\xad");
+    Key(ImGuiKey_PageUp);
+    Key(ImGuiKey_PageUp);
+    Type("pg");
+    Key(ImGuiKey_Z, ImGuiMod_Ctrl);
+    Key(ImGuiKey_Z, ImGuiMod_Ctrl);
+    Key(ImGuiKey_Y, ImGuiMod_Ctrl);
+    Key(ImGuiKey_Home, ImGuiMod_Ctrl);
+    Key(ImGuiKey_Delete);
+    Key(ImGuiKey_Delete);
+    Key(ImGuiKey_End, ImGuiMod_Ctrl);
+    for (int i = 0; i < 5; i++)
+        Key(ImGuiKey_UpArrow);
+    Click(200, 300);
+    Type("CLICK");
+    Key(ImGuiKey_LeftArrow);
+    Type("\n\n");
+    for (int i = 0; i < 10; i++)
+        Key(ImGuiKey_Backspace);
+
+    const double start = ImGui::get_current_time();
+    for (int i = 0; i < typed; i++)
+        Type("q");
+    *typing_ms = (ImGui::get_current_time() - start) * 1000.0 / ImMax(typed, 1);
+
+    ImGuiInputTextState& state = GImGui->InputTextState;
+    bool index_ok = true;
+    if (flags & ImGuiInputTextFlags_LargeText)
+    {
+        const char* text_a = state.TextA.Data;
+        int lines = 1;
+        for (int n = 0; n < state.CurLenA; n++)
+            lines += text_a[n] == '\n';
+        index_ok = state.LineIndexCount() == lines && memcmp(text_a, g_buffer.data(), (size_t)state.CurLenA) == 0;
+        for (int l = 1; l < state.LineIndexCount() && index_ok; l++)
+            index_ok = state.TextW[state.LineStartW[l] - 1] == '\n' && text_a[state.LineStartA[l] - 1] == '\n';
+    }
+    char cursor[64];
+    snprintf(cursor, IM_ARRAYSIZE(cursor), "|%d|%d|%d", state.Stb.cursor, state.Stb.select_start, state.Stb.select_end);
+    ImGui::ClearActiveID();
+    Frame();
+    return index_ok ? std::string(g_buffer.data()) + cursor : std::string();
+}
+
+int main(int argc, char ** argv)
+{
+    int size_mb = argc > 1 ? atoi(argv[1]) : 5;
+    int typed   = argc > 2 ? atoi(argv[2]) : 50;
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    unsigned char* pixels = NULL;
+    int width = 0, height = 0;
+    io.Fonts->AddFontDefault();
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    const std::string text = MakeText((size_t)size_mb << 20);
+    double default_ms = 0.0, large_ms = 0.0;
+    const std::string default_result = RunEdits(text, 0, typed, &default_ms);
+    const std::string large_result = RunEdits(text, ImGuiInputTextFlags_LargeText, typed, &large_ms);
+    const bool index_ok = !large_result.empty();
+    const bool same = index_ok && large_result == default_result;
+    printf("%d MB, %d typed characters\n", size_mb, typed);
+    printf("  default    %8.3f ms per typing frame\n", default_ms);
+    printf("  large text %8.3f ms per typing frame\n", large_ms);
+    printf("  line index %s, text and cursor %s\n", index_ok ? "ok" : "FAILED", same ? "same" : "DIFFERENT");
+
+    ImGui::DestroyContext();
+    return same ? 0 : 1;
+}
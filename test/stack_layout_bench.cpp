@@ -0,0 +1,110 @@
+// Stack layout benchmark: runs headless frames of toolbars made of deeply nested
+// BeginHorizontal()/BeginVertical() layouts with springs, reports frame cost and
+// checks that a window resize settles in the same frame.
+//
+// Usage: stack_layout_bench [depth] [branch] [toolbars] [frames]
+#include <imgui.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static int g_layout_count = 0;
+static float g_end_button_x = 0.0f;
+
+static void NestedLayout(int depth, int branch, int index)
+{
+    ImGui::PushID(index);
+    const bool horizontal = (depth & 1) != 0;
+    if (horizontal)
+        ImGui::BeginHorizontal("h", ImVec2(0, 0), 0.5f);
+    else
+        ImGui::BeginVertical("v", ImVec2(0, 0), 0.5f);
+    g_layout_count++;
+
+    ImGui::Button("A");
+    ImGui::Spring(0.5f);
+    ImGui::Text("level %d", depth);
+    ImGui::Spring();
+    if (depth > 0)
+    {
+        for (int i = 0; i < branch; i++)
+        {
+            NestedLayout(depth - 1, branch, i);
+            ImGui::Spring(1.0f, 2.0f);
+        }
+    }
+    ImGui::Button("Button");
+    ImGui::Spring(0.0f);
+    ImGui::SmallButton("x");
+
+    if (horizontal)
+        ImGui::EndHorizontal();
+    else
+        ImGui::EndVertical();
+    ImGui::PopID();
+}
+
+static double RunFrames(int frames, int depth, int branch, int toolbars, bool resize, float base_width = 1900.0f)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    double start = ImGui::get_current_time();
+    for (int frame = 0; frame < frames; frame++)
+    {
+        io.DisplaySize = ImVec2(1920, 1080);
+        io.DeltaTime = 1.0f / 60.0f;
+        ImGui::NewFrame();
+        // Resizing the window makes every layout solve its springs again
+        float width = resize ? base_width - (float)(frame % 200) : base_width;
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(ImVec2(width, 1060));
+        ImGui::Begin("Toolbars", NULL, ImGuiWindowFlags_NoSavedSettings);
+        g_layout_count = 0;
+        for (int i = 0; i < toolbars; i++)
+        {
+            ImGui::PushID(i);
+            ImGui::BeginHorizontal("toolbar", ImVec2(ImGui::GetContentRegionAvail().x, 0));
+            g_layout_count++;
+            NestedLayout(depth, branch, 0);
+            ImGui::Spring();
+            ImGui::Button("End");
+            if (i == 0)
+                g_end_button_x = ImGui::GetItemRectMin().x;
+            ImGui::EndHorizontal();
+            ImGui::PopID();
+        }
+        ImGui::End();
+        ImGui::Render();
+    }
+    return (ImGui::get_current_time() - start) * 1000.0 / frames;
+}
+
+int main(int argc, char ** argv)
+{
+    int depth    = argc > 1 ? atoi(argv[1]) : 6;
+    int branch   = argc > 2 ? atoi(argv[2]) : 2;
+    int toolbars = argc > 3 ? atoi(argv[3]) : 4;
+    int frames   = argc > 4 ? atoi(argv[4]) : 2000;
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    unsigned char* pixels = NULL;
+    int width = 0, height = 0;
+    io.Fonts->AddFontDefault();
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    RunFrames(20, depth, branch, toolbars, false);
+    double steady_ms = RunFrames(frames, depth, branch, toolbars, false);
+    double resize_ms = RunFrames(frames, depth, branch, toolbars, true);
+    printf("depth %d branch %d toolbars %d: %d layouts, %d vertices\n", depth, branch, toolbars, g_layout_count, io.MetricsRenderVertices);
+    printf("  steady frame  %.4f ms\n", steady_ms);
+    printf("  resized frame %.4f ms\n", resize_ms);
+
+    // Items after a spring must be placed (and hit-tested) at their final position in the frame the window is resized
+    RunFrames(1, depth, branch, toolbars, false, 1500.0f);
+    float first_x = g_end_button_x;
+    RunFrames(1, depth, branch, toolbars, false, 1500.0f);
+    printf("  resize settles in %s frame\n", first_x == g_end_button_x ? "the same" : "the next");
+
+    ImGui::DestroyContext();
+    return 0;
+}
@@ -0,0 +1,460 @@
+// TextEditor document benchmark: opens a generated log file read only with the colorizer off and
+// reports the open time and the first frame, then the cost of random insertions and erasures, the
+// memory used by the document and its piece count. Random edits of a smaller document are checked
+// against the same edits applied to a std::string. Then types into a generated C++ source with the
+// colorizer on and reports the frame times of the keystrokes, and of opening a comment at the top,
+// and the frame times while the source is opened and scrolled, colorized by the colorizer thread of
+// the editor or within the frames, and of jumps through sources of a thousand and of a million lines, which take as
+// long with both. Then types words into a source and cuts half of it, and reports the undo steps,
+// their memory and the time to undo the cut. Then searches the log for a literal, ignoring the case, as a whole word
+// and for a regular expression and reports the throughput in GB/s, and replaces every match of a word and of a regular
+// expression in the source in one undo step, and checks the replacement of matches over the end of a chunk of the
+// search. Last, colorizes generated sources from scratch with the C++, GLSL and Lua
+// definitions and reports the throughput in MB/s.
+//
+// Usage: text_editor_bench [size in MB] [edits] [log file] [source lines]
+#include <imgui.h>
+#include <TextEditor.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <chrono>
+#include <thread>
+
+static unsigned int Random(unsigned int& seed)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return seed >> 8;
+}
+
+static bool WriteLog(const char* path, size_t size)
+{
+    FILE* file = fopen(path, "wb");
+    if (!file)
+        return false;
+    static const char* levels[] = { "INFO ", "DEBUG", "WARN ", "ERROR" };
+    unsigned int seed = 1;
+    char line[256];
+    size_t written = 0;
+    for (int n = 0; written < size; n++)
+    {
+        const int length = snprintf(line, IM_ARRAYSIZE(line), "2024-01-%02d %02d:%02d:%02d.%03d [%s] worker %2d: request %08x done in %u us, %u bytes\n",
+            1 + n / 86400000 % 28, n / 3600000 % 24, n / 60000 % 60, n / 1000 % 60, n % 1000, levels[Random(seed) % 4],
+            Random(seed) % 16, Random(seed), Random(seed) % 100000, Random(seed) % 65536);
+        fwrite(line, 1, length, file);
+        written += length;
+    }
+    fclose(file);
+    return true;
+}
+
+static void Frame(TextEditor& editor)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(io.DisplaySize);
+    ImGui::Begin("Editor", NULL, ImGuiWindowFlags_NoDecoration);
+    editor.Render("##editor");
+    ImGui::End();
+    ImGui::Render();
+}
+
+// A source without block comments after its header, a comment opened at the top runs to the end
+static std::string MakeSource(int lines, bool lua = false)
+{
+    std::string source = lua ? "--[[ generated\n   source ]]\nlocal io = require(\"io\")\n\n" : "/* generated\n   source */\n#include <stdio.h>\n\n";
+    char line[256];
+    for (int n = 0; n * 8 < lines; n++)
+    {
+        if (lua)
+            snprintf(line, IM_ARRAYSIZE(line), "-- function %d\n-- returns a value\nfunction function_%d(value)\n\tlocal name = \"function %d\"\n\tif value == nil then return 0 end\n\treturn value * %d + 0x%x\nend\n\n", n, n, n, n, n);
+        else
+            snprintf(line, IM_ARRAYSIZE(line), "// function %d\n// returns a value\nint function_%d(int value)\n{\n\tconst char* name = \"function %d\";\n\treturn value * %d + 0x%x;\n}\n\n", n, n, n, n, n);
+        source += line;
+    }
+    return source;
+}
+
+// Runs frames until the editor colorized everything, returns the number of frames and the longest one
+static int ColorizeAll(TextEditor& editor, double* longest)
+{
+    int frames = 0;
+    *longest = 0;
+    while (editor.IsColorizing())
+    {
+        const double start = ImGui::get_current_time();
+        Frame(editor);
+        *longest = ImMax(*longest, ImGui::get_current_time() - start);
+        frames++;
+    }
+    return frames;
+}
+
+static void BenchTyping(int lines)
+{
+    TextEditor editor;
+    editor.SetLanguageDefinition(TextEditor::LanguageDefinition::CPlusPlus());
+    editor.SetText(MakeSource(lines));
+    double longest, start = ImGui::get_current_time();
+    int frames = ColorizeAll(editor, &longest);
+    printf("  colorize   %d lines in %.1f ms over %d frames, longest %.2f ms\n", editor.GetTotalLines(), (ImGui::get_current_time() - start) * 1000.0, frames, longest * 1000.0);
+
+    // keystrokes in the middle of the text, one frame each
+    const int keys = 500;
+    const TextEditor::Coordinates where(editor.GetTotalLines() / 2, 0);
+    editor.SetSelection(where, where);
+    editor.SetCursorPosition(where);
+    double total = 0, slowest = 0;
+    for (int i = 0; i < keys; i++)
+    {
+        start = ImGui::get_current_time();
+        editor.InsertText(i % 40 == 39 ? "\n" : "x");
+        ColorizeAll(editor, &longest);
+        const double elapsed = ImGui::get_current_time() - start;
+        total += elapsed;
+        slowest = ImMax(slowest, elapsed);
+    }
+    printf("  typing     %.3f ms per key, slowest %.3f ms\n", total * 1000.0 / keys, slowest * 1000.0);
+
+    // a comment opened at the top changes the state of every line after it
+    const TextEditor::Coordinates top(3, 0);
+    editor.SetSelection(top, top);
+    editor.SetCursorPosition(top);
+    editor.InsertText("/*");
+    start = ImGui::get_current_time();
+    frames = ColorizeAll(editor, &longest);
+    printf("  comment    rescanned in %.1f ms over %d frames, longest %.2f ms\n", (ImGui::get_current_time() - start) * 1000.0, frames, longest * 1000.0);
+}
+
+// Opens a source and scrolls it down a page per frame until the end, the lines get their colors meanwhile
+static void BenchScrolling(const std::string& source, bool threaded)
+{
+    TextEditor editor;
+    editor.SetColorizerThreaded(threaded);
+    editor.SetLanguageDefinition(TextEditor::LanguageDefinition::CPlusPlus());
+    const double start = ImGui::get_current_time();
+    editor.SetText(source);
+    double total = 0, longest = 0, colorized = 0;
+    int frames = 0;
+    for (int line = 0; line < editor.GetTotalLines(); line += 100)
+    {
+        editor.SetCursorPosition(TextEditor::Coordinates(line, 0));
+        const double frame = ImGui::get_current_time();
+        Frame(editor);
+        const double elapsed = ImGui::get_current_time() - frame;
+        total += elapsed;
+        longest = ImMax(longest, elapsed);
+        frames++;
+        if (colorized == 0 && !editor.IsColorizing())
+            colorized = ImGui::get_current_time() - start;
+    }
+    printf("  scroll     %s: %d frames of %.2f ms, longest %.2f ms, colorized after %.1f ms\n", threaded ? "thread" : "frames", frames,
+        total * 1000.0 / ImMax(frames, 1), longest * 1000.0, colorized * 1000.0);
+}
+
+// Types words with backspaces through the keyboard input of the editor, then cuts half of the text, the undo steps
+// hold pieces of the text and not copies. Returns false when undoing everything doesn't give the source back.
+static bool BenchUndo(const std::string& source)
+{
+    TextEditor editor;
+    editor.SetColorizerEnable(false);
+    editor.SetText(source);
+    const TextEditor::Coordinates where(editor.GetTotalLines() / 2, 0);
+    editor.SetSelection(where, where);
+    editor.SetCursorPosition(where);
+    Frame(editor);
+
+    ImGuiIO& io = ImGui::GetIO();
+    const char* words[] = { "int ", "value ", "= ", "count;\n" };
+    int keys = 0;
+    for (int i = 0; i < 2000; i++)
+    {
+        io.AddInputCharactersUTF8(words[i % 4]);
+        keys += (int)strlen(words[i % 4]);
+        Frame(editor);
+        if (i % 10 == 9)
+        {
+            io.AddKeyEvent(ImGuiKey_Backspace, true);
+            Frame(editor);
+            io.AddKeyEvent(ImGuiKey_Backspace, false);
+            Frame(editor);
+            keys++;
+        }
+    }
+    const int steps = editor.GetUndoCount();
+    const size_t typed = editor.GetUndoMemoryUsage();
+
+    const int lines = editor.GetTotalLines();
+    editor.SetSelection(TextEditor::Coordinates(0, 0), TextEditor::Coordinates(lines / 2, 0));
+    const size_t size = editor.GetDocument().GetSize();
+    editor.Cut();
+    const size_t cut = size - editor.GetDocument().GetSize();
+    const size_t memory = editor.GetUndoMemoryUsage() - typed;
+    double start = ImGui::get_current_time();
+    editor.Undo();
+    const double undone = ImGui::get_current_time() - start;
+    printf("  undo       %d keys in %d steps of %.1f KB, cut of %.1f MB in a step of %zu bytes, undone in %.2f ms\n",
+        keys, steps, typed / 1024.0, cut / 1048576.0, memory, undone * 1000.0);
+
+    while (editor.CanUndo())
+        editor.Undo();
+    return editor.GetText() == source;
+}
+
+// Searches the whole text on the threads of the editor, the throughput counts the bytes of the text
+static void BenchFind(TextEditor& editor, const char* name, const char* query, const TextEditor::FindOptions& options)
+{
+    const double start = ImGui::get_current_time();
+    editor.Find(query, options);
+    while (editor.IsFinding())
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    const double elapsed = ImGui::get_current_time() - start;
+    printf("  %-10s %.2f GB/s, %d matches of \"%s\"\n", name, editor.GetDocument().GetSize() / elapsed / (1 << 30),
+        editor.GetFindMatchCount(), query);
+}
+
+// Replaces every match of a query in one undo step. Returns false when undoing it doesn't give the source back.
+static bool BenchReplace(const std::string& source, const char* query, const char* replacement, const TextEditor::FindOptions& options)
+{
+    TextEditor editor;
+    editor.SetColorizerEnable(false);
+    editor.SetText(source);
+    editor.Find(query, options);
+    double start = ImGui::get_current_time();
+    const int count = editor.ReplaceAll(replacement);
+    const double replaced = ImGui::get_current_time() - start;
+    const int steps = editor.GetUndoCount();
+    start = ImGui::get_current_time();
+    editor.Undo();
+    const double undone = ImGui::get_current_time() - start;
+    printf("  replace    %d matches of \"%s\" in %.2f ms, %d undo step of %.1f KB, undone in %.2f ms\n", count, query,
+        replaced * 1000.0, steps, editor.GetUndoMemoryUsage() / 1024.0, undone * 1000.0);
+    return steps == 1 && editor.GetText() == source;
+}
+
+// Searches a query holding a line break in a text of two chunks, the match over the end of the first chunk overlaps
+// the first match of the second one. Returns false when the matches overlap, none goes over the end of the chunk or
+// replacing them all doesn't give the text of the same replacements in a std::string.
+static bool CheckStraddlingReplace()
+{
+    std::string text;
+    for (int n = 0; n < 3 << 20; n++)
+        text += "a\n";
+    const size_t chunkEnd = text.find('\n', 4 << 20) + 1;
+    TextEditor editor;
+    editor.SetColorizerEnable(false);
+    editor.SetText(text);
+    editor.Find("a\na\n");
+    while (editor.IsFinding())
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    std::string expected = text;
+    const int count = editor.GetFindMatchCount();
+    bool straddles = false, overlaps = false;
+    size_t previousEnd = 0;
+    for (int n = count - 1; n >= 0; n--)
+    {
+        // lines of one character and a line break, an offset is twice the line plus the column
+        TextEditor::Coordinates start, end;
+        editor.GetFindMatch(n, start, end);
+        const size_t from = (size_t)start.mLine * 2 + start.mColumn, to = (size_t)end.mLine * 2 + end.mColumn;
+        straddles |= from < chunkEnd && to > chunkEnd;
+        overlaps |= previousEnd != 0 && to > previousEnd;
+        previousEnd = from;
+        expected.replace(from, to - from, "b\n");
+    }
+    const int replaced = editor.ReplaceAll("b\n");
+    const bool ok = straddles && !overlaps && replaced == count && editor.GetText() == expected;
+    printf("  straddle   %d matches over a chunk end, %s\n", count, ok ? "ok" : "FAILED");
+    return ok;
+}
+
+// Scrolls sources of a thousand and of a million lines with the colorizer off, jumping to evenly spaced lines. The
+// frames draw the visible lines only and take as long with both, the width of the content comes from the lines seen.
+static void BenchLargeScrolling()
+{
+    const int sizes[] = { 1000, 1000000 };
+    for (int lines : sizes)
+    {
+        TextEditor editor;
+        editor.SetColorizerEnable(false);
+        editor.SetText(MakeSource(lines));
+        Frame(editor);
+        double total = 0, longest = 0;
+        const int frames = 1000;
+        for (int i = 0; i < frames; i++)
+        {
+            editor.SetCursorPosition(TextEditor::Coordinates((int)((long long)editor.GetTotalLines() * i / frames), 0));
+            const double start = ImGui::get_current_time();
+            Frame(editor);
+            const double elapsed = ImGui::get_current_time() - start;
+            total += elapsed;
+            longest = ImMax(longest, elapsed);
+        }
+        printf("  scroll     %d lines: %d frames of %.3f ms, longest %.3f ms\n", editor.GetTotalLines(), frames,
+            total * 1000.0 / frames, longest * 1000.0);
+    }
+}
+
+// Colorizes a source from scratch, the throughput counts the bytes of the text
+static void BenchThroughput(const char* name, const TextEditor::LanguageDefinition& language, const std::string& source)
+{
+    TextEditor editor;
+    editor.SetLanguageDefinition(language);
+    editor.SetText(source);
+    double longest, start = ImGui::get_current_time();
+    const int frames = ColorizeAll(editor, &longest);
+    const double elapsed = ImGui::get_current_time() - start;
+    printf("  %-10s %.1f MB/s, %d lines over %d frames, longest %.2f ms\n", name, source.size() / elapsed / (1 << 20), editor.GetTotalLines(), frames, longest * 1000.0);
+}
+
+// Returns the number of edits after which the document differs from the string
+static int CheckEdits(int edits)
+{
+    std::string text, model;
+    unsigned int seed = 7;
+    for (int i = 0; i < 100000; i++)
+        text.push_back(Random(seed) % 13 == 0 ? '\n' : 'a' + Random(seed) % 26);
+    TextEditor::Document document;
+    document.SetText(text.data(), text.size());
+    model = text;
+    int errors = 0;
+    for (int i = 0; i < edits; i++)
+    {
+        const size_t offset = Random(seed) % (model.size() + 1);
+        if (Random(seed) % 2 == 0 || model.size() < 100)
+        {
+            const std::string insert = Random(seed) % 4 == 0 ? "new\nline" : "abc";
+            document.Insert(offset, insert.data(), insert.size());
+            model.insert(offset, insert);
+        }
+        else
+        {
+            const size_t end = ImMin(model.size(), offset + Random(seed) % 64);
+            document.Erase(offset, end);
+            model.erase(offset, end - offset);
+        }
+        // compare a random line and the whole text from time to time
+        const int line = (int)(Random(seed) % document.GetLineCount());
+        size_t start = 0;
+        for (int l = 0; l < line; l++)
+            start = model.find('\n', start) + 1;
+        const size_t end = ImMin(model.find('\n', start), model.size());
+        int size;
+        std::string scratch, all;
+        const char* view = document.GetLine(line, &size, scratch);
+        bool same = document.GetLineStart(line) == start && std::string(view, size) == model.substr(start, end - start) &&
+            document.GetLineAt(start) == line && document.GetSize() == model.size();
+        if (i % 1000 == 0)
+        {
+            document.GetText(0, document.GetSize(), all);
+            same = same && all == model;
+        }
+        errors += !same;
+    }
+    return errors;
+}
+
+int main(int argc, char ** argv)
+{
+    size_t megabytes = argc > 1 ? (size_t)atoi(argv[1]) : 500;
+    int edits        = argc > 2 ? atoi(argv[2]) : 10000;
+    const char* path = argc > 3 ? argv[3] : "text_editor_bench.log";
+    int lines        = argc > 4 ? atoi(argv[4]) : 200000;
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    unsigned char* pixels = NULL;
+    int width = 0, height = 0;
+    io.Fonts->AddFontDefault();
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    double start = ImGui::get_current_time();
+    if (!WriteLog(path, megabytes << 20))
+    {
+        printf("can't write %s\n", path);
+        return 1;
+    }
+    printf("%zu MB log written in %.2f s\n", megabytes, ImGui::get_current_time() - start);
+
+    TextEditor* editor = new TextEditor();
+    editor->SetColorizerEnable(false);
+    start = ImGui::get_current_time();
+    if (!editor->OpenFile(path))
+    {
+        printf("can't open %s\n", path);
+        return 1;
+    }
+    const double opened = ImGui::get_current_time();
+    Frame(*editor);
+    const double drawn = ImGui::get_current_time();
+    const TextEditor::Document& document = editor->GetDocument();
+    printf("  open       %8.1f ms, first frame %.2f ms, %d lines\n", (opened - start) * 1000.0, (drawn - opened) * 1000.0, editor->GetTotalLines());
+
+    BenchFind(*editor, "find", "done in 12345 us", TextEditor::FindOptions());
+    BenchFind(*editor, "find icase", "DONE IN 12345 US", TextEditor::FindOptions(false, false));
+    BenchFind(*editor, "find word", "worker  7", TextEditor::FindOptions(false, true, true));
+    BenchFind(*editor, "find regex", "worker 1[0-5]: request 0000", TextEditor::FindOptions(true));
+    editor->ClearFind();
+
+    unsigned int seed = 1;
+    double inserting = 0, erasing = 0;
+    int inserts = 0, erases = 0;
+    for (int i = 0; i < edits; i++)
+    {
+        const int line = (int)(Random(seed) % editor->GetTotalLines());
+        const TextEditor::Coordinates where(line, (int)(Random(seed) % 40));
+        editor->SetSelection(where, where);
+        editor->SetCursorPosition(where);
+        start = ImGui::get_current_time();
+        if (i % 2 == 0)
+        {
+            editor->InsertText(i % 8 == 0 ? "inserted\nline " : "inserted ");
+            inserting += ImGui::get_current_time() - start;
+            inserts++;
+        }
+        else
+        {
+            editor->SetSelection(where, TextEditor::Coordinates(line + (i % 7 == 1), where.mColumn + 5));
+            editor->Delete();
+            erasing += ImGui::get_current_time() - start;
+            erases++;
+        }
+    }
+    start = ImGui::get_current_time();
+    Frame(*editor);
+    printf("  edits      insert %.2f us, erase %.2f us, next frame %.2f ms\n", inserting * 1e6 / ImMax(inserts, 1), erasing * 1e6 / ImMax(erases, 1),
+        (ImGui::get_current_time() - start) * 1000.0);
+    printf("  document   %s, %zu MB of heap, %d pieces after %d edits\n", document.IsMapped() ? "mapped" : "copied",
+        document.GetMemoryUsage() >> 20, document.GetPieceCount(), edits);
+    delete editor;
+
+    const int errors = CheckEdits(edits);
+    printf("  check      %d random edits of a 100 KB document, %d mismatches\n", edits, errors);
+
+    BenchTyping(lines);
+
+    const std::string source = MakeSource(lines);
+    BenchScrolling(source, true);
+    BenchScrolling(source, false);
+    BenchLargeScrolling();
+    const bool undone = BenchUndo(source);
+    if (!undone)
+        printf("  undo       mismatch after undoing every step\n");
+    const bool replaced = BenchReplace(source, "value", "amount", TextEditor::FindOptions(false, true, true)) &&
+        BenchReplace(source, "function_([0-9]+)", "f$1", TextEditor::FindOptions(true)) && CheckStraddlingReplace();
+    if (!replaced)
+        printf("  replace    mismatch after undoing the replacements\n");
+    BenchThroughput("C++", TextEditor::LanguageDefinition::CPlusPlus(), source);
+    BenchThroughput("GLSL", TextEditor::LanguageDefinition::GLSL(), source);
+    BenchThroughput("Lua", TextEditor::LanguageDefinition::Lua(), MakeSource(lines, true));
+
+    remove(path);
+    ImGui::DestroyContext();
+    return errors == 0 && undone && replaced ? 0 : 1;
+}